@@ -33,8 +33,18 @@ architecture neorv32_imem_rtl of neorv32_imem is
   -- application (image) size in bytes --
   constant imem_app_size_c : natural := (application_init_image'length)*4;
 
+  -- ROM initialization: executable file (loaded at elaboration time) or VHDL application image --
+  impure function imem_rom_init_f return mem32_t is
+  begin
+    if (IMEM_FILE'length /= 0) then
+      return mem32_load_f(IMEM_FILE, IMEM_SIZE/4);
+    else
+      return mem32_init_f(application_init_image, IMEM_SIZE/4);
+    end if;
+  end function imem_rom_init_f;
+
   -- ROM - initialized with executable code --
-  constant mem_rom_c : mem32_t(0 to IMEM_SIZE/4-1) := mem32_init_f(application_init_image, IMEM_SIZE/4);
+  constant mem_rom_c : mem32_t(0 to IMEM_SIZE/4-1) := imem_rom_init_f;
 
   -- The memory (RAM) is built from 4 individual byte-wide memories because some synthesis
   -- tools have issues inferring 32-bit memories that provide dedicated byte-enable signals
@@ -50,7 +60,10 @@ begin
     "[NEORV32] Implementing LEGACY processor-internal IMEM as " &
     cond_sel_string_f(IMEM_AS_IROM, "pre-initialized ROM.", "blank RAM.") severity note;
 
-  assert not ((IMEM_AS_IROM = true) and (imem_app_size_c > IMEM_SIZE)) report
+  assert not ((IMEM_AS_IROM = true) and (IMEM_FILE'length /= 0)) report
+    "[NEORV32] Initializing processor-internal IMEM from file '" & IMEM_FILE & "'." severity note;
+
+  assert not ((IMEM_AS_IROM = true) and (IMEM_FILE'length = 0) and (imem_app_size_c > IMEM_SIZE)) report
     "[NEORV32] Application (image = " & natural'image(imem_app_size_c) &
     " bytes) does not fit into processor-internal IMEM (ROM = " & natural'image(IMEM_SIZE) & " bytes)!" severity error;
 
@@ -0,0 +1,128 @@
+-- ================================================================================ --
+-- NEORV32 SoC - Processor-Internal instruction memory (IMEM)                       --
+-- -------------------------------------------------------------------------------- --
+-- Textio architecture style: the memory is initialized during elaboration from the --
+-- plain hex file named by the IMEM_FILE generic (simulation / file-based flows).   --
+-- Changing the executable does not require re-analyzing any VHDL source file.      --
+-- -------------------------------------------------------------------------------- --
+-- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
+-- Copyright (c) NEORV32 contributors.                                              --
+-- Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  --
+-- Licensed under the BSD-3-Clause license, see LICENSE for details.                --
+-- SPDX-License-Identifier: BSD-3-Clause                                            --
+-- ================================================================================ --
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+architecture neorv32_imem_rtl of neorv32_imem is
+
+  -- local signals --
+  signal rdata : std_ulogic_vector(31 downto 0);
+  signal rden  : std_ulogic;
+  signal addr  : std_ulogic_vector(index_size_f(IMEM_SIZE/4)-1 downto 0);
+
+  -- ROM / RAM initialization image (loaded from file) --
+  constant mem_init_c : mem32_t(0 to IMEM_SIZE/4-1) := mem32_load_f(IMEM_FILE, IMEM_SIZE/4);
+
+  -- split initialization image into byte lanes --
+  function mem8_init_f(init : mem32_t; lane : natural) return mem8_t is
+    variable mem_v : mem8_t(0 to init'length-1);
+  begin
+    for i in init'range loop
+      mem_v(i) := init(i)(lane*8+7 downto lane*8);
+    end loop;
+    return mem_v;
+  end function mem8_init_f;
+
+  -- RAM - built from 4 individual byte-wide memories (see default architecture); also
+  -- pre-initialized so the executable can be started right away without a bootloader upload
+  signal mem_ram_b0 : mem8_t(0 to IMEM_SIZE/4-1) := mem8_init_f(mem_init_c, 0);
+  signal mem_ram_b1 : mem8_t(0 to IMEM_SIZE/4-1) := mem8_init_f(mem_init_c, 1);
+  signal mem_ram_b2 : mem8_t(0 to IMEM_SIZE/4-1) := mem8_init_f(mem_init_c, 2);
+  signal mem_ram_b3 : mem8_t(0 to IMEM_SIZE/4-1) := mem8_init_f(mem_init_c, 3);
+
+begin
+
+  -- Sanity Checks --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  assert false report
+    "[NEORV32] Implementing TEXTIO processor-internal IMEM as " &
+    cond_sel_string_f(IMEM_AS_IROM, "ROM", "RAM") & " initialized from file '" & IMEM_FILE & "'." severity note;
+
+  assert not (IMEM_FILE'length = 0) report
+    "[NEORV32] No IMEM initialization file specified (IMEM_FILE generic) - memory will be blank!" severity warning;
+
+
+  -- Implement IMEM as pre-initialized ROM --------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  imem_rom:
+  if (IMEM_AS_IROM = true) generate
+    mem_access: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to infer block RAM
+        rdata <= mem_init_c(to_integer(unsigned(addr)));
+      end if;
+    end process mem_access;
+  end generate;
+
+  -- word aligned access --
+  addr <= bus_req_i.addr(index_size_f(IMEM_SIZE/4)+1 downto 2);
+
+
+  -- Implement IMEM as pre-initialized RAM --------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  imem_ram:
+  if (IMEM_AS_IROM = false) generate
+    mem_access: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to infer block RAM
+        if (bus_req_i.stb = '1') and (bus_req_i.rw = '1') then
+          if (bus_req_i.ben(0) = '1') then -- byte 0
+            mem_ram_b0(to_integer(unsigned(addr))) <= bus_req_i.data(07 downto 00);
+          end if;
+          if (bus_req_i.ben(1) = '1') then -- byte 1
+            mem_ram_b1(to_integer(unsigned(addr))) <= bus_req_i.data(15 downto 08);
+          end if;
+          if (bus_req_i.ben(2) = '1') then -- byte 2
+            mem_ram_b2(to_integer(unsigned(addr))) <= bus_req_i.data(23 downto 16);
+          end if;
+          if (bus_req_i.ben(3) = '1') then -- byte 3
+            mem_ram_b3(to_integer(unsigned(addr))) <= bus_req_i.data(31 downto 24);
+          end if;
+        end if;
+        rdata(07 downto 00) <= mem_ram_b0(to_integer(unsigned(addr)));
+        rdata(15 downto 08) <= mem_ram_b1(to_integer(unsigned(addr)));
+        rdata(23 downto 16) <= mem_ram_b2(to_integer(unsigned(addr)));
+        rdata(31 downto 24) <= mem_ram_b3(to_integer(unsigned(addr)));
+      end if;
+    end process mem_access;
+  end generate;
+
+
+  -- Bus Feedback ---------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  bus_feedback: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      rden          <= '0';
+      bus_rsp_o.ack <= '0';
+    elsif rising_edge(clk_i) then
+      rden <= bus_req_i.stb and (not bus_req_i.rw);
+      if (IMEM_AS_IROM = true) then
+        bus_rsp_o.ack <= bus_req_i.stb and (not bus_req_i.rw); -- read-only!
+      else
+        bus_rsp_o.ack <= bus_req_i.stb;
+      end if;
+    end if;
+  end process bus_feedback;
+
+  bus_rsp_o.data <= rdata when (rden = '1') else (others => '0'); -- output gate
+  bus_rsp_o.err  <= '0'; -- no access error possible
+
+
+end neorv32_imem_rtl;
@@ -13,6 +13,11 @@
 -- memory. After this, the fence request is forwarded to the downstream memory      --
 -- system.                                                                          --
 --                                                                                  --
+-- Cache-block operations (CMO) only affect the single block containing the access  --
+-- address: "clean" writes back the block if it is dirty, "inval" invalidates it    --
+-- and "zero" allocates it and fills it with zeros. CMOs are never forwarded to the --
+-- downstream memory system. A "zero" operation on an uncached address will fail.   --
+--                                                                                  --
 -- Simplified cache architecture ("-->" = direction of access requests):            --
 --                                                                                  --
 --               Direct Access        +----------+                                  --
@@ -69,8 +74,10 @@ architecture neorv32_cache_rtl of neorv32_cache is
     clk_i      : in  std_ulogic;
     req_i      : in  bus_req_t;
     rsp_o      : out bus_rsp_t;
+    dir_i      : in  std_ulogic;
     bus_sync_o : out std_ulogic;
     bus_miss_o : out std_ulogic;
+    bus_cmo_o  : out std_ulogic;
     bus_busy_i : in  std_ulogic;
     dirty_o    : out std_ulogic;
     hit_i      : in  std_ulogic;
@@ -125,9 +132,11 @@ architecture neorv32_cache_rtl of neorv32_cache is
     bus_rsp_i  : in  bus_rsp_t;
     cmd_sync_i : in  std_ulogic;
     cmd_miss_i : in  std_ulogic;
+    cmd_cmo_i  : in  std_ulogic;
     cmd_busy_o : out std_ulogic;
     inval_o    : out std_ulogic;
     new_o      : out std_ulogic;
+    hit_i      : in  std_ulogic;
     dirty_i    : in  std_ulogic;
     base_i     : in  std_ulogic_vector(31 downto 0);
     addr_o     : out std_ulogic_vector(31 downto 0);
@@ -144,7 +153,7 @@ architecture neorv32_cache_rtl of neorv32_cache is
   constant block_size_c : natural := 2**index_size_f(BLOCK_SIZE);
 
   -- bus de-mux control for direct/uncached or caches access --
-  signal dir_acc_d, dir_acc_q : std_ulogic;
+  signal uc_acc, dir_acc_d, dir_acc_q : std_ulogic;
 
   -- internal bus system --
   signal bus_req, dir_req_d, dir_req_q, cache_req : bus_req_t;
@@ -171,14 +180,17 @@ architecture neorv32_cache_rtl of neorv32_cache is
   signal cache_stat_base : std_ulogic_vector(31 downto 0);
 
   -- operation commands --
-  signal cache_cmd_inval, cache_cmd_new, cache_cmd_dirty, bus_cmd_sync, bus_cmd_miss, bus_cmd_busy : std_ulogic;
+  signal cache_cmd_inval, cache_cmd_new, cache_cmd_dirty, bus_cmd_sync, bus_cmd_miss, bus_cmd_cmo, bus_cmd_busy : std_ulogic;
 
 begin
 
   -- Check if Direct/Uncached Access --------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
+  uc_acc <= '1' when (UC_ENABLE = true) and (host_req_i.addr(31 downto 28) >= UC_BEGIN) else '0'; -- uncached memory page
+
   dir_acc_d <= '1' when (UC_ENABLE = true) and -- direct accesses implemented
-                        ((host_req_i.addr(31 downto 28) >= UC_BEGIN) or -- uncached memory page
+                        (host_req_i.cmo = "000") and -- cache-block operations are always handled by the cache
+                        ((uc_acc = '1') or -- uncached memory page
                          (host_req_i.rvso = '1')) else '0'; -- atomic (reservation set) operation
 
   -- request splitter: cached or direct access --
@@ -190,6 +202,7 @@ begin
     -- direct access --
     dir_req_d.stb   <= host_req_i.stb and dir_acc_d;
     dir_req_d.fence <= '0'; -- no fence requests from this side
+    dir_req_d.cmo   <= (others => '0'); -- no cache-block operations from this side
     -- cached access --
     cache_req.stb <= host_req_i.stb and (not dir_acc_d);
   end process req_splitter;
@@ -248,9 +261,11 @@ begin
     -- host access port --
     req_i      => cache_req,            -- request
     rsp_o      => cache_rsp,            -- response
+    dir_i      => uc_acc,               -- access to uncached address space
     -- bus unit interface --
     bus_sync_o => bus_cmd_sync,         -- sync cache and main memory
     bus_miss_o => bus_cmd_miss,         -- cache miss
+    bus_cmo_o  => bus_cmd_cmo,          -- cache-block operation
     bus_busy_i => bus_cmd_busy,         -- bus operation in progress
     -- cache status interface --
     dirty_o    => cache_cmd_dirty,      -- make accessed block dirty
@@ -320,10 +335,12 @@ begin
     -- operation interface --
     cmd_sync_i => bus_cmd_sync,        -- sync cache and main memory
     cmd_miss_i => bus_cmd_miss,        -- cache miss
+    cmd_cmo_i  => bus_cmd_cmo,         -- cache-block operation
     cmd_busy_o => bus_cmd_busy,        -- bus operation in progress
     -- cache status interface --
     inval_o    => cache_cmd_inval,     -- invalidate accessed block
     new_o      => cache_cmd_new,       -- set new cache entry
+    hit_i      => cache_stat_hit,      -- cache hit
     dirty_i    => cache_stat_dirty,    -- accessed block is dirty
     base_i     => cache_stat_base,     -- base address of accessed block
     -- cache data interface --
@@ -378,7 +395,7 @@ end neorv32_cache_rtl;
 -- # ********************************************************************************************* #
 -- # Handle host accesses to the cache (check for hit/miss) or bypass cache if direct/uncached     #
 -- # access. If a cache miss occurs or a fence request is received an according command is sent to #
--- # the bus interface unit.                                                                       #
+-- # the bus interface unit. Cache-block operations are delegated to the bus interface unit.       #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -428,9 +445,11 @@ entity neorv32_cache_host is
     -- host access port --
     req_i      : in  bus_req_t;                      -- request
     rsp_o      : out bus_rsp_t;                      -- response
+    dir_i      : in  std_ulogic;                     -- access to uncached address space
     -- bus unit interface --
     bus_sync_o : out std_ulogic;                     -- sync cache and main memory
     bus_miss_o : out std_ulogic;                     -- cache miss
+    bus_cmo_o  : out std_ulogic;                     -- cache-block operation
     bus_busy_i : in  std_ulogic;                     -- bus operation in progress
     -- cache status interface --
     dirty_o    : out std_ulogic;                     -- make accessed block dirty
@@ -449,7 +468,7 @@ end neorv32_cache_host;
 architecture neorv32_cache_host_rtl of neorv32_cache_host is
 
   -- control engine --
-  type ctrl_state_t is (S_IDLE, S_CHECK, S_WAIT_MISS, S_WAIT_SYNC, S_ERROR);
+  type ctrl_state_t is (S_IDLE, S_CHECK, S_WAIT_MISS, S_WAIT_SYNC, S_CMO_SYNC, S_WAIT_CMO, S_ERROR);
   type ctrl_t is record
     state,    state_nxt    : ctrl_state_t; -- FSM state
     req_buf,  req_buf_nxt  : std_ulogic; -- access request buffer
@@ -477,7 +496,7 @@ begin
 
   -- Control Engine FSM Comb ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  ctrl_engine_comb: process(ctrl, req_i, hit_i, rdata_i, rstat_i, bus_busy_i)
+  ctrl_engine_comb: process(ctrl, req_i, dir_i, hit_i, rdata_i, rstat_i, bus_busy_i)
   begin
     -- control defaults --
     ctrl.state_nxt    <= ctrl.state;
@@ -495,6 +514,7 @@ begin
     -- bus unit command defaults --
     bus_sync_o <= '0';
     bus_miss_o <= '0';
+    bus_cmo_o  <= '0';
 
     -- host interface defaults --
     rsp_o <= rsp_terminate_c;
@@ -519,7 +539,14 @@ begin
       -- ------------------------------------------------------------
         rsp_o.data       <= rdata_i; -- output read data
         ctrl.req_buf_nxt <= '0'; -- access request completed
-        if (hit_i = '1') then
+        if (req_i.cmo /= "000") then -- cache-block operation
+          if (req_i.cmo(cmo_zero_c) = '1') and (dir_i = '1') then -- cannot allocate uncached block
+            ctrl.state_nxt <= S_ERROR;
+          else
+            bus_cmo_o      <= '1'; -- trigger bus unit: cache-block operation
+            ctrl.state_nxt <= S_CMO_SYNC;
+          end if;
+        elsif (hit_i = '1') then
           if (req_i.rw = '1') and (READ_ONLY = false) then -- write access
             dirty_o <= '1'; -- cache block is dirty now
             we_o    <= req_i.ben; -- finalize write access
@@ -545,6 +572,18 @@ begin
           ctrl.state_nxt <= S_CHECK; -- redo cache access
         end if;
 
+      when S_CMO_SYNC => -- bus engine checks the accessed block (cache address is still applied)
+      -- ------------------------------------------------------------
+        ctrl.state_nxt <= S_WAIT_CMO;
+
+      when S_WAIT_CMO => -- wait for bus engine to handle cache-block operation
+      -- ------------------------------------------------------------
+        if (bus_busy_i = '0') then
+          dirty_o        <= req_i.cmo(cmo_zero_c); -- zeroed block has not been written to main memory yet
+          rsp_o.ack      <= '1';
+          ctrl.state_nxt <= S_IDLE;
+        end if;
+
       when S_ERROR => -- access error
       -- ------------------------------------------------------------
         rsp_o.err      <= '1';
@@ -837,10 +876,12 @@ entity neorv32_cache_bus is
     -- operation interface --
     cmd_sync_i  : in  std_ulogic;                     -- sync cache and main memory
     cmd_miss_i  : in  std_ulogic;                     -- cache miss
+    cmd_cmo_i   : in  std_ulogic;                     -- cache-block operation
     cmd_busy_o  : out std_ulogic;                     -- bus operation in progress
     -- cache status interface --
     inval_o     : out std_ulogic;                     -- invalidate accessed block
     new_o       : out std_ulogic;                     -- set new cache entry
+    hit_i       : in  std_ulogic;                     -- cache hit
     dirty_i     : in  std_ulogic;                     -- accessed block is dirty
     base_i      : in  std_ulogic_vector(31 downto 0); -- base address of accessed block
     -- cache data interface --
@@ -862,7 +903,8 @@ architecture neorv32_cache_bus_rtl of neorv32_cache_bus is
 
   -- control fsm --
   type state_t is (S_IDLE, S_CHECK, S_DOWNLOAD_REQ, S_DOWNLOAD_RSP, S_UPLOAD_GET,
-                   S_UPLOAD_REQ, S_UPLOAD_RSP, S_FLUSH_START, S_FLUSH_READ, S_FLUSH_CHECK);
+                   S_UPLOAD_REQ, S_UPLOAD_RSP, S_FLUSH_START, S_FLUSH_READ, S_FLUSH_CHECK,
+                   S_CMO, S_CMO_INVAL, S_ZERO_START, S_ZERO);
   signal state, upret, state_nxt, upret_nxt: state_t;
 
   -- address generator --
@@ -908,7 +950,7 @@ begin
 
   -- Control Engine FSM Comb ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  ctrl_engine_comb: process(state, upret, addr, haddr, baddr, bus_rsp_i, cmd_sync_i, cmd_miss_i, rdata_i, dirty_i)
+  ctrl_engine_comb: process(state, upret, addr, haddr, baddr, host_req_i, bus_rsp_i, cmd_sync_i, cmd_miss_i, cmd_cmo_i, rdata_i, hit_i, dirty_i)
   begin
     -- control engine defaults --
     state_nxt <= state;
@@ -945,6 +987,8 @@ begin
           state_nxt <= S_FLUSH_START;
         elsif (cmd_miss_i = '1') then -- cache miss
           state_nxt <= S_CHECK;
+        elsif (cmd_cmo_i = '1') then -- cache-block operation
+          state_nxt <= S_CMO;
         end if;
 
       when S_CHECK => -- check if accessed block is dirty (cache address is still applied by host controller!)
@@ -1046,6 +1090,53 @@ begin
         end if;
 
 
+      when S_CMO => -- cache-block operation: check accessed block (cache address is still applied by host controller!)
+      -- ------------------------------------------------------------
+        addr_nxt.idx <= baddr.idx; -- index of reference cache block
+        state_nxt    <= S_IDLE;
+        if (READ_ONLY = false) then
+          if (host_req_i.cmo(cmo_zero_c) = '1') then -- zero: allocate block
+            upret_nxt <= S_ZERO_START; -- go straight to S_ZERO_START when S_UPLOAD_GET has completed (if executed)
+            if (hit_i = '0') and (dirty_i = '1') then -- another block is dirty, upload first
+              addr_nxt.tag <= baddr.tag;
+              state_nxt    <= S_UPLOAD_GET;
+            else
+              state_nxt <= S_ZERO_START;
+            end if;
+          elsif (hit_i = '1') then -- clean and/or invalidate block (if cached at all)
+            if (host_req_i.cmo(cmo_clean_c) = '1') and (dirty_i = '1') then -- write back dirty block first
+              addr_nxt.tag <= baddr.tag;
+              upret_nxt    <= S_CMO_INVAL; -- invalidate (if requested) when S_UPLOAD_GET has completed
+              state_nxt    <= S_UPLOAD_GET;
+            else
+              inval_o <= host_req_i.cmo(cmo_inval_c);
+            end if;
+          end if;
+        end if;
+
+      when S_CMO_INVAL => -- cache-block operation: invalidate uploaded block
+      -- ------------------------------------------------------------
+        inval_o   <= host_req_i.cmo(cmo_inval_c);
+        state_nxt <= S_IDLE;
+
+      when S_ZERO_START => -- cache-block operation: allocate host's block
+      -- ------------------------------------------------------------
+        addr_nxt.tag <= haddr.tag;
+        state_nxt    <= S_ZERO;
+
+      when S_ZERO => -- cache-block operation: fill block with zeros
+      -- ------------------------------------------------------------
+        we_o    <= (others => '1'); -- cache: full-word write
+        wdata_o <= (others => '0');
+        swe_o   <= '1'; -- cache: clear status bit (no bus error)
+        wstat_o <= '0';
+        new_o   <= '1'; -- set new block (set tag, make valid, make clean)
+        addr_nxt.ofs <= std_ulogic_vector(unsigned(addr.ofs) + 1);
+        if (and_reduce_f(addr.ofs) = '1') then -- block completed?
+          state_nxt <= S_IDLE;
+        end if;
+
+
       when others => -- undefined
       -- ------------------------------------------------------------
         state_nxt <= S_IDLE;
@@ -1054,7 +1145,7 @@ begin
   end process ctrl_engine_comb;
 
   -- bus arbiter operation in progress (host keeps allying cache address while bus unit reports idle state) --
-  cmd_busy_o <= '0' when (state = S_IDLE) or (state = S_CHECK) else '1';
+  cmd_busy_o <= '0' when (state = S_IDLE) or (state = S_CHECK) or (state = S_CMO) else '1';
 
 
 end neorv32_cache_bus_rtl;
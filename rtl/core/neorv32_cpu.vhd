@@ -35,12 +35,24 @@ entity neorv32_cpu is
     CPU_EXTENSION_RISCV_E      : boolean; -- implement embedded RF extension?
     CPU_EXTENSION_RISCV_M      : boolean; -- implement mul/div extension?
     CPU_EXTENSION_RISCV_U      : boolean; -- implement user mode extension?
+    CPU_EXTENSION_RISCV_Zbc    : boolean; -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   : boolean; -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   : boolean; -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   : boolean; -- implement cryptography crossbar permutation instructions?
+    CPU_EXTENSION_RISCV_Zcb    : boolean; -- implement additional simple compressed instructions?
+    CPU_EXTENSION_RISCV_Zcmp   : boolean; -- implement compressed push/pop and register-move instructions?
     CPU_EXTENSION_RISCV_Zfinx  : boolean; -- implement 32-bit floating-point extension (using INT reg!)
+    CPU_EXTENSION_RISCV_Zicbom : boolean; -- implement cache-block management operations?
+    CPU_EXTENSION_RISCV_Zicboz : boolean; -- implement cache-block zero operation?
     CPU_EXTENSION_RISCV_Zicntr : boolean; -- implement base counters?
     CPU_EXTENSION_RISCV_Zicond : boolean; -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zihpm  : boolean; -- implement hardware performance monitors?
+    CPU_EXTENSION_RISCV_Zknd   : boolean; -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   : boolean; -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   : boolean; -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zmmul  : boolean; -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zxcfu  : boolean; -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd : boolean; -- implement packed-SIMD DSP instructions (subset of 'P')?
     CPU_EXTENSION_RISCV_Sdext  : boolean; -- implement external debug mode extension?
     CPU_EXTENSION_RISCV_Sdtrig : boolean; -- implement trigger module extension?
     CPU_EXTENSION_RISCV_Smpmp  : boolean; -- implement physical memory protection?
@@ -82,7 +94,7 @@ end neorv32_cpu;
 architecture neorv32_cpu_rtl of neorv32_cpu is
 
   -- auto-configuration --
-  constant regfile_rs3_en_c : boolean := CPU_EXTENSION_RISCV_Zxcfu or CPU_EXTENSION_RISCV_Zfinx; -- 3rd register file read port (rs3)
+  constant regfile_rs3_en_c : boolean := CPU_EXTENSION_RISCV_Zxcfu or CPU_EXTENSION_RISCV_Zfinx or CPU_EXTENSION_RISCV_Zxpsimd; -- 3rd register file read port (rs3)
   constant regfile_rs4_en_c : boolean := CPU_EXTENSION_RISCV_Zxcfu; -- 4th register file read port (rs4)
 
   -- control-unit-external CSR interface --
@@ -129,14 +141,26 @@ begin
     cond_sel_string_f(CPU_EXTENSION_RISCV_C,      "c",         "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_B,      "b",         "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_U,      "u",         "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zicbom, "_zicbom",   "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zicboz, "_zicboz",   "" ) &
     cond_sel_string_f(true,                       "_zicsr",    "" ) & -- always enabled
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zicntr, "_zicntr",   "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zicond, "_zicond",   "" ) &
     cond_sel_string_f(true,                       "_zifencei", "" ) & -- always enabled
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zfinx,  "_zfinx",    "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zcb,    "_zcb",      "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zcmp,   "_zcmp",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zbc,    "_zbc",      "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zbkb,   "_zbkb",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zbkc,   "_zbkc",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zbkx,   "_zbkx",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zknd,   "_zknd",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zkne,   "_zkne",     "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zknh,   "_zknh",     "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zihpm,  "_zihpm",    "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zmmul,  "_zmmul",    "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Zxcfu,  "_zxcfu",    "" ) &
+    cond_sel_string_f(CPU_EXTENSION_RISCV_Zxpsimd, "_zxpsimd", "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Sdext,  "_sdext",    "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Sdtrig, "_sdtrig",   "" ) &
     cond_sel_string_f(CPU_EXTENSION_RISCV_Smpmp,  "_smpmp",    "" )
@@ -170,12 +194,24 @@ begin
     CPU_EXTENSION_RISCV_E      => CPU_EXTENSION_RISCV_E,      -- implement embedded RF extension?
     CPU_EXTENSION_RISCV_M      => CPU_EXTENSION_RISCV_M,      -- implement mul/div extension?
     CPU_EXTENSION_RISCV_U      => CPU_EXTENSION_RISCV_U,      -- implement user mode extension?
+    CPU_EXTENSION_RISCV_Zbc    => CPU_EXTENSION_RISCV_Zbc,    -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   => CPU_EXTENSION_RISCV_Zbkb,   -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   => CPU_EXTENSION_RISCV_Zbkc,   -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   => CPU_EXTENSION_RISCV_Zbkx,   -- implement cryptography crossbar permutation instructions?
+    CPU_EXTENSION_RISCV_Zcb    => CPU_EXTENSION_RISCV_Zcb,    -- implement additional simple compressed instructions?
+    CPU_EXTENSION_RISCV_Zcmp   => CPU_EXTENSION_RISCV_Zcmp,   -- implement compressed push/pop and register-move instructions?
     CPU_EXTENSION_RISCV_Zfinx  => CPU_EXTENSION_RISCV_Zfinx,  -- implement 32-bit floating-point extension (using INT reg!)
+    CPU_EXTENSION_RISCV_Zicbom => CPU_EXTENSION_RISCV_Zicbom, -- implement cache-block management operations?
+    CPU_EXTENSION_RISCV_Zicboz => CPU_EXTENSION_RISCV_Zicboz, -- implement cache-block zero operation?
     CPU_EXTENSION_RISCV_Zicntr => CPU_EXTENSION_RISCV_Zicntr, -- implement base counters?
     CPU_EXTENSION_RISCV_Zicond => CPU_EXTENSION_RISCV_Zicond, -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zihpm  => CPU_EXTENSION_RISCV_Zihpm,  -- implement hardware performance monitors?
+    CPU_EXTENSION_RISCV_Zknd   => CPU_EXTENSION_RISCV_Zknd,   -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   => CPU_EXTENSION_RISCV_Zkne,   -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   => CPU_EXTENSION_RISCV_Zknh,   -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zmmul  => CPU_EXTENSION_RISCV_Zmmul,  -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,  -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd => CPU_EXTENSION_RISCV_Zxpsimd, -- implement packed-SIMD DSP instructions (subset of 'P')?
     CPU_EXTENSION_RISCV_Sdext  => CPU_EXTENSION_RISCV_Sdext,  -- implement external debug mode extension?
     CPU_EXTENSION_RISCV_Sdtrig => CPU_EXTENSION_RISCV_Sdtrig, -- implement trigger module extension?
     CPU_EXTENSION_RISCV_Smpmp  => CPU_EXTENSION_RISCV_Smpmp,  -- implement physical memory protection?
@@ -268,10 +304,18 @@ begin
     -- RISC-V CPU Extensions --
     CPU_EXTENSION_RISCV_B      => CPU_EXTENSION_RISCV_B,      -- implement bit-manipulation extension?
     CPU_EXTENSION_RISCV_M      => CPU_EXTENSION_RISCV_M,      -- implement mul/div extension?
+    CPU_EXTENSION_RISCV_Zbc    => CPU_EXTENSION_RISCV_Zbc,    -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   => CPU_EXTENSION_RISCV_Zbkb,   -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   => CPU_EXTENSION_RISCV_Zbkc,   -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   => CPU_EXTENSION_RISCV_Zbkx,   -- implement cryptography crossbar permutation instructions?
     CPU_EXTENSION_RISCV_Zicond => CPU_EXTENSION_RISCV_Zicond, -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zmmul  => CPU_EXTENSION_RISCV_Zmmul,  -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zfinx  => CPU_EXTENSION_RISCV_Zfinx,  -- implement 32-bit floating-point extension (using INT reg!)
+    CPU_EXTENSION_RISCV_Zknd   => CPU_EXTENSION_RISCV_Zknd,   -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   => CPU_EXTENSION_RISCV_Zkne,   -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   => CPU_EXTENSION_RISCV_Zknh,   -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,  -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd => CPU_EXTENSION_RISCV_Zxpsimd, -- implement packed-SIMD DSP instructions (subset of 'P')?
     -- Tuning Options --
     FAST_MUL_EN                => FAST_MUL_EN,                -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              => FAST_SHIFT_EN               -- use barrel shifter for shift operations
@@ -306,7 +350,8 @@ begin
   -- -------------------------------------------------------------------------------------------
   neorv32_cpu_lsu_inst: entity neorv32.neorv32_cpu_lsu
   generic map (
-    AMO_LRSC_ENABLE => CPU_EXTENSION_RISCV_A -- enable atomic LR/SC operations
+    AMO_LRSC_ENABLE => CPU_EXTENSION_RISCV_A, -- enable atomic LR/SC operations
+    CMO_ENABLE      => CPU_EXTENSION_RISCV_Zicbom or CPU_EXTENSION_RISCV_Zicboz -- enable cache-block operations
   )
   port map (
     -- global control --
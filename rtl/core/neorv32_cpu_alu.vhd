@@ -20,10 +20,18 @@ entity neorv32_cpu_alu is
     -- RISC-V CPU Extensions --
     CPU_EXTENSION_RISCV_B      : boolean; -- implement bit-manipulation extension?
     CPU_EXTENSION_RISCV_M      : boolean; -- implement mul/div extension?
+    CPU_EXTENSION_RISCV_Zbc    : boolean; -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   : boolean; -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   : boolean; -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   : boolean; -- implement cryptography crossbar permutation instructions?
     CPU_EXTENSION_RISCV_Zicond : boolean; -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zmmul  : boolean; -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zfinx  : boolean; -- implement 32-bit floating-point extension (using INT reg!)
+    CPU_EXTENSION_RISCV_Zknd   : boolean; -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   : boolean; -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   : boolean; -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zxcfu  : boolean; -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd : boolean; -- implement packed-SIMD DSP instructions (subset of 'P')?
     -- Tuning Options --
     FAST_MUL_EN                : boolean; -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              : boolean  -- use barrel shifter for shift operations
@@ -70,10 +78,10 @@ architecture neorv32_cpu_cpu_rtl of neorv32_cpu_alu is
   signal cp_res     : std_ulogic_vector(XLEN-1 downto 0);
 
   -- co-processor interface --
-  type cp_data_t  is array (0 to 5) of std_ulogic_vector(XLEN-1 downto 0);
+  type cp_data_t  is array (0 to 7) of std_ulogic_vector(XLEN-1 downto 0);
   signal cp_result : cp_data_t; -- co-processor result
-  signal cp_start  : std_ulogic_vector(5 downto 0); -- co-processor trigger
-  signal cp_valid  : std_ulogic_vector(5 downto 0); -- co-processor done
+  signal cp_start  : std_ulogic_vector(7 downto 0); -- co-processor trigger
+  signal cp_valid  : std_ulogic_vector(7 downto 0); -- co-processor done
   signal cp_shamt  : std_ulogic_vector(index_size_f(XLEN)-1 downto 0); -- shift amount
 
   -- CSR proxy --
@@ -142,11 +150,11 @@ begin
 
   -- multi-cycle co-processor operation done? --
   -- > "cp_valid" signal has to be set (for one cycle) one cycle before CP output data (cp_result) is valid
-  cp_done_o <= cp_valid(5) or cp_valid(4) or cp_valid(3) or cp_valid(2) or cp_valid(1) or cp_valid(0);
+  cp_done_o <= cp_valid(7) or cp_valid(6) or cp_valid(5) or cp_valid(4) or cp_valid(3) or cp_valid(2) or cp_valid(1) or cp_valid(0);
 
   -- co-processor result --
   -- > "cp_result" data has to be always zero unless the specific co-processor has been actually triggered
-  cp_res <= cp_result(5) or cp_result(4) or cp_result(3) or cp_result(2) or cp_result(1) or cp_result(0);
+  cp_res <= cp_result(7) or cp_result(6) or cp_result(5) or cp_result(4) or cp_result(3) or cp_result(2) or cp_result(1) or cp_result(0);
 
   -- co-processor CSR read-back --
   -- > "csr_rdata_*" data has to be always zero unless the specific co-processor is actually being accessed
@@ -208,13 +216,19 @@ begin
   end generate;
 
 
-  -- Co-Processor 2: Bit-Manipulation Unit ('B' ISA Extension) ------------------------------
+  -- Co-Processor 2: Bit-Manipulation Unit ('B', 'Zbc' and 'Zbk*' ISA Extensions) -----------
   -- -------------------------------------------------------------------------------------------
   neorv32_cpu_cp_bitmanip_inst_true:
-  if CPU_EXTENSION_RISCV_B generate
+  if CPU_EXTENSION_RISCV_B or CPU_EXTENSION_RISCV_Zbc or CPU_EXTENSION_RISCV_Zbkb or CPU_EXTENSION_RISCV_Zbkc or CPU_EXTENSION_RISCV_Zbkx generate
     neorv32_cpu_cp_bitmanip_inst: entity neorv32.neorv32_cpu_cp_bitmanip
     generic map (
-      FAST_SHIFT_EN => FAST_SHIFT_EN -- use barrel shifter for shift operations
+      B_EN          => CPU_EXTENSION_RISCV_B,    -- implement 'B' instructions
+      ZBC_EN        => CPU_EXTENSION_RISCV_Zbc,  -- implement 'Zbc' instructions
+      ZBKB_EN       => CPU_EXTENSION_RISCV_Zbkb, -- implement 'Zbkb' instructions
+      ZBKC_EN       => CPU_EXTENSION_RISCV_Zbkc, -- implement 'Zbkc' instructions
+      ZBKX_EN       => CPU_EXTENSION_RISCV_Zbkx, -- implement 'Zbkx' instructions
+      FAST_MUL_EN   => FAST_MUL_EN,              -- use parallel carry-less multiplier
+      FAST_SHIFT_EN => FAST_SHIFT_EN             -- use barrel shifter for shift operations
     )
     port map (
       -- global control --
@@ -234,7 +248,7 @@ begin
   end generate;
 
   neorv32_cpu_cp_bitmanip_inst_false:
-  if not CPU_EXTENSION_RISCV_B generate
+  if (not CPU_EXTENSION_RISCV_B) and (not CPU_EXTENSION_RISCV_Zbc) and (not CPU_EXTENSION_RISCV_Zbkb) and (not CPU_EXTENSION_RISCV_Zbkc) and (not CPU_EXTENSION_RISCV_Zbkx) generate
     cp_result(2) <= (others => '0');
     cp_valid(2)  <= '0';
   end generate;
@@ -347,4 +361,64 @@ begin
   end generate;
 
 
+  -- Co-Processor 6: Scalar Cryptography Unit ('Zkn*' ISA Extensions) -----------------------
+  -- -------------------------------------------------------------------------------------------
+  neorv32_cpu_cp_crypto_inst_true:
+  if CPU_EXTENSION_RISCV_Zknd or CPU_EXTENSION_RISCV_Zkne or CPU_EXTENSION_RISCV_Zknh generate
+    neorv32_cpu_cp_crypto_inst: entity neorv32.neorv32_cpu_cp_crypto
+    generic map (
+      ZKND_EN => CPU_EXTENSION_RISCV_Zknd, -- implement AES decryption instructions
+      ZKNE_EN => CPU_EXTENSION_RISCV_Zkne, -- implement AES encryption instructions
+      ZKNH_EN => CPU_EXTENSION_RISCV_Zknh  -- implement SHA-256/512 hash function instructions
+    )
+    port map (
+      -- global control --
+      clk_i   => clk_i,        -- global clock, rising edge
+      rstn_i  => rstn_i,       -- global reset, low-active, async
+      ctrl_i  => ctrl_i,       -- main control bus
+      start_i => cp_start(6),  -- trigger operation
+      -- data input --
+      rs1_i   => rs1_i,        -- rf source 1
+      rs2_i   => rs2_i,        -- rf source 2
+      -- result and status --
+      res_o   => cp_result(6), -- operation result
+      valid_o => cp_valid(6)   -- data output valid
+    );
+  end generate;
+
+  neorv32_cpu_cp_crypto_inst_false:
+  if (not CPU_EXTENSION_RISCV_Zknd) and (not CPU_EXTENSION_RISCV_Zkne) and (not CPU_EXTENSION_RISCV_Zknh) generate
+    cp_result(6) <= (others => '0');
+    cp_valid(6)  <= '0';
+  end generate;
+
+
+  -- Co-Processor 7: Packed-SIMD DSP Unit ('Zxpsimd' ISA Extension) -------------------------
+  -- -------------------------------------------------------------------------------------------
+  neorv32_cpu_cp_simd_inst_true:
+  if CPU_EXTENSION_RISCV_Zxpsimd generate
+    neorv32_cpu_cp_simd_inst: entity neorv32.neorv32_cpu_cp_simd
+    port map (
+      -- global control --
+      clk_i   => clk_i,        -- global clock, rising edge
+      rstn_i  => rstn_i,       -- global reset, low-active, async
+      ctrl_i  => ctrl_i,       -- main control bus
+      start_i => cp_start(7),  -- trigger operation
+      -- data input --
+      rs1_i   => rs1_i,        -- rf source 1
+      rs2_i   => rs2_i,        -- rf source 2
+      rs3_i   => rs3_i,        -- rf source 3 (accumulator = rd)
+      -- result and status --
+      res_o   => cp_result(7), -- operation result
+      valid_o => cp_valid(7)   -- data output valid
+    );
+  end generate;
+
+  neorv32_cpu_cp_simd_inst_false:
+  if not CPU_EXTENSION_RISCV_Zxpsimd generate
+    cp_result(7) <= (others => '0');
+    cp_valid(7)  <= '0';
+  end generate;
+
+
 end neorv32_cpu_cpu_rtl;
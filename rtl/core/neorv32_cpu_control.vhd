@@ -41,12 +41,24 @@ entity neorv32_cpu_control is
     CPU_EXTENSION_RISCV_E      : boolean; -- implement embedded RF extension?
     CPU_EXTENSION_RISCV_M      : boolean; -- implement mul/div extension?
     CPU_EXTENSION_RISCV_U      : boolean; -- implement user mode extension?
+    CPU_EXTENSION_RISCV_Zbc    : boolean; -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   : boolean; -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   : boolean; -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   : boolean; -- implement cryptography crossbar permutation instructions?
+    CPU_EXTENSION_RISCV_Zcb    : boolean; -- implement additional simple compressed instructions?
+    CPU_EXTENSION_RISCV_Zcmp   : boolean; -- implement compressed push/pop and register-move instructions?
     CPU_EXTENSION_RISCV_Zfinx  : boolean; -- implement 32-bit floating-point extension (using INT regs)
+    CPU_EXTENSION_RISCV_Zicbom : boolean; -- implement cache-block management operations?
+    CPU_EXTENSION_RISCV_Zicboz : boolean; -- implement cache-block zero operation?
     CPU_EXTENSION_RISCV_Zicntr : boolean; -- implement base counters?
     CPU_EXTENSION_RISCV_Zicond : boolean; -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zihpm  : boolean; -- implement hardware performance monitors?
+    CPU_EXTENSION_RISCV_Zknd   : boolean; -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   : boolean; -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   : boolean; -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zmmul  : boolean; -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zxcfu  : boolean; -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd : boolean; -- implement packed-SIMD DSP instructions (subset of 'P')?
     CPU_EXTENSION_RISCV_Sdext  : boolean; -- implement external debug mode extension?
     CPU_EXTENSION_RISCV_Sdtrig : boolean; -- implement trigger module extension?
     CPU_EXTENSION_RISCV_Smpmp  : boolean; -- implement physical memory protection?
@@ -106,6 +118,10 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
   constant hpm_cnt_lo_width_c : natural := cond_sel_natural_f(boolean(HPM_CNT_WIDTH < 32), HPM_CNT_WIDTH, 32); -- width low word
   constant hpm_cnt_hi_width_c : natural := natural(cond_sel_int_f(boolean(HPM_CNT_WIDTH > 32), HPM_CNT_WIDTH-32, 0)); -- width high word
 
+  -- co-processor implemented? --
+  constant bitmanip_en_c : boolean := CPU_EXTENSION_RISCV_B or CPU_EXTENSION_RISCV_Zbc or CPU_EXTENSION_RISCV_Zbkb or CPU_EXTENSION_RISCV_Zbkc or CPU_EXTENSION_RISCV_Zbkx;
+  constant crypto_en_c   : boolean := CPU_EXTENSION_RISCV_Zknd or CPU_EXTENSION_RISCV_Zkne or CPU_EXTENSION_RISCV_Zknh;
+
   -- instruction fetch engine --
   type fetch_engine_state_t is (IF_RESTART, IF_REQUEST, IF_PENDING);
   type fetch_engine_t is record
@@ -134,7 +150,10 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     align_clr : std_ulogic;
     ci_i16    : std_ulogic_vector(15 downto 0);
     ci_i32    : std_ulogic_vector(31 downto 0);
-    data      : std_ulogic_vector((2+32)-1 downto 0); -- is_compressed & bus_error & 32-bit instruction
+    ci_uop    : std_ulogic_vector(3 downto 0); -- Zcmp micro-op index
+    ci_more   : std_ulogic; -- more Zcmp micro-ops following
+    more      : std_ulogic; -- current compressed instruction word is not the last micro-op
+    data      : std_ulogic_vector((3+32)-1 downto 0); -- more_uops & is_compressed & bus_error & 32-bit instruction
     valid     : std_ulogic_vector(1 downto 0); -- data word is valid
     ack       : std_ulogic;
   end record;
@@ -151,6 +170,9 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     is_b_imm  : std_ulogic;
     is_b_reg  : std_ulogic;
     is_zicond : std_ulogic;
+    is_k_imm  : std_ulogic;
+    is_k_reg  : std_ulogic;
+    is_p      : std_ulogic;
     rs1_zero  : std_ulogic;
     rd_zero   : std_ulogic;
   end record;
@@ -167,6 +189,8 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     ir_nxt       : std_ulogic_vector(31 downto 0);
     is_ci        : std_ulogic; -- current instruction is de-compressed instruction
     is_ci_nxt    : std_ulogic;
+    is_uop       : std_ulogic; -- current instruction is a micro-op with more micro-ops following
+    is_uop_nxt   : std_ulogic;
     branch_taken : std_ulogic; -- branch condition fulfilled
     pc           : std_ulogic_vector(XLEN-1 downto 0); -- actual PC, corresponding to current executed instruction
     pc_we        : std_ulogic; -- PC update enabled
@@ -397,6 +421,7 @@ begin
   bus_req_o.src   <= '1'; -- source = instruction fetch
   bus_req_o.rvso  <= '0'; -- cannot be a reservation set operation
   bus_req_o.fence <= ctrl.lsu_fence; -- fence(.i) operation, valid without STB being set
+  bus_req_o.cmo   <= (others => '0'); -- instruction fetch is never a cache-block operation
 
 
   -- Instruction Prefetch Buffer (FIFO) -----------------------------------------------------
@@ -438,15 +463,22 @@ begin
   neorv32_cpu_decompressor_inst_true:
   if CPU_EXTENSION_RISCV_C generate
     neorv32_cpu_decompressor_inst: entity neorv32.neorv32_cpu_decompressor
+    generic map (
+      ZCB_EN  => CPU_EXTENSION_RISCV_Zcb,
+      ZCMP_EN => CPU_EXTENSION_RISCV_Zcmp
+    )
     port map (
       ci_instr16_i => issue_engine.ci_i16,
-      ci_instr32_o => issue_engine.ci_i32
+      ci_uop_i     => issue_engine.ci_uop,
+      ci_instr32_o => issue_engine.ci_i32,
+      ci_more_o    => issue_engine.ci_more
     );
   end generate;
 
   neorv32_cpu_decompressor_inst_false:
   if not CPU_EXTENSION_RISCV_C generate
-    issue_engine.ci_i32 <= (others => '0');
+    issue_engine.ci_i32  <= (others => '0');
+    issue_engine.ci_more <= '0';
   end generate;
 
   -- half-word select --
@@ -461,12 +493,19 @@ begin
     issue_engine_fsm_sync: process(rstn_i, clk_i)
     begin
       if (rstn_i = '0') then
-        issue_engine.align <= '0'; -- start aligned after reset
+        issue_engine.align  <= '0'; -- start aligned after reset
+        issue_engine.ci_uop <= (others => '0');
       elsif rising_edge(clk_i) then
         if (fetch_engine.restart = '1') then
-          issue_engine.align <= execute_engine.next_pc(1); -- branch to unaligned address?
+          issue_engine.align  <= execute_engine.next_pc(1); -- branch to unaligned address?
+          issue_engine.ci_uop <= (others => '0'); -- (re-)start micro-op sequence
         elsif (issue_engine.ack = '1') then
-          issue_engine.align <= (issue_engine.align and (not issue_engine.align_clr)) or issue_engine.align_set; -- "RS" flip-flop
+          if (issue_engine.more = '1') then -- stay on this compressed instruction and emit next micro-op
+            issue_engine.ci_uop <= std_ulogic_vector(unsigned(issue_engine.ci_uop) + 1);
+          else
+            issue_engine.align  <= (issue_engine.align and (not issue_engine.align_clr)) or issue_engine.align_set; -- "RS" flip-flop
+            issue_engine.ci_uop <= (others => '0');
+          end if;
         end if;
       end if;
     end process issue_engine_fsm_sync;
@@ -477,25 +516,28 @@ begin
       issue_engine.align_set <= '0';
       issue_engine.align_clr <= '0';
       issue_engine.valid     <= "00";
+      issue_engine.more      <= '0';
       -- start with LOW half-word --
       if (issue_engine.align = '0')  then
         if (ipb.rdata(0)(1 downto 0) /= "11") then -- compressed, use IPB(0) entry
           issue_engine.align_set <= ipb.avail(0); -- start of next instruction word is NOT 32-bit-aligned
           issue_engine.valid(0)  <= ipb.avail(0);
-          issue_engine.data      <= '1' & ipb.rdata(0)(16) & issue_engine.ci_i32;
+          issue_engine.more      <= issue_engine.ci_more;
+          issue_engine.data      <= issue_engine.ci_more & '1' & ipb.rdata(0)(16) & issue_engine.ci_i32;
         else -- aligned uncompressed; use IPB(0) status flags only
           issue_engine.valid <= (others => (ipb.avail(0) and ipb.avail(1)));
-          issue_engine.data  <= '0' & ipb.rdata(0)(16) & ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0);
+          issue_engine.data  <= "00" & ipb.rdata(0)(16) & ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0);
         end if;
       -- start with HIGH half-word --
       else
         if (ipb.rdata(1)(1 downto 0) /= "11") then -- compressed, use IPB(1) entry
           issue_engine.align_clr <= ipb.avail(1); -- start of next instruction word is 32-bit-aligned again
           issue_engine.valid(1)  <= ipb.avail(1);
-          issue_engine.data      <= '1' & ipb.rdata(1)(16) & issue_engine.ci_i32;
+          issue_engine.more      <= issue_engine.ci_more;
+          issue_engine.data      <= issue_engine.ci_more & '1' & ipb.rdata(1)(16) & issue_engine.ci_i32;
         else -- unaligned uncompressed; use IPB(0) status flags only
           issue_engine.valid <= (others => (ipb.avail(0) and ipb.avail(1)));
-          issue_engine.data  <= '0' & ipb.rdata(0)(16) & ipb.rdata(0)(15 downto 0) & ipb.rdata(1)(15 downto 0);
+          issue_engine.data  <= "00" & ipb.rdata(0)(16) & ipb.rdata(0)(15 downto 0) & ipb.rdata(1)(15 downto 0);
         end if;
       end if;
     end process issue_engine_fsm_comb;
@@ -504,13 +546,15 @@ begin
 
   issue_engine_disabled: -- use IPB(0) status flags only
   if not CPU_EXTENSION_RISCV_C generate
-    issue_engine.valid <= (others => ipb.avail(0));
-    issue_engine.data  <= '0' & ipb.rdata(0)(16) & (ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0));
+    issue_engine.valid  <= (others => ipb.avail(0));
+    issue_engine.data   <= "00" & ipb.rdata(0)(16) & (ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0));
+    issue_engine.more   <= '0';
+    issue_engine.ci_uop <= (others => '0');
   end generate; -- /issue_engine_disabled
 
-  -- update IPB FIFOs --
-  ipb.re(0) <= issue_engine.valid(0) and issue_engine.ack;
-  ipb.re(1) <= issue_engine.valid(1) and issue_engine.ack;
+  -- update IPB FIFOs (keep a Zcmp instruction until its last micro-op has been issued) --
+  ipb.re(0) <= issue_engine.valid(0) and issue_engine.ack and (not issue_engine.more);
+  ipb.re(1) <= issue_engine.valid(1) and issue_engine.ack and (not issue_engine.more);
 
 
 -- ****************************************************************************************************************************
@@ -555,6 +599,12 @@ begin
           else
             NULL;
           end if;
+        when opcode_fence_c => -- cache-block operation: address = rs1
+          if CPU_EXTENSION_RISCV_Zicbom or CPU_EXTENSION_RISCV_Zicboz then
+            imm_o <= (others => '0');
+          else
+            NULL;
+          end if;
         when others =>
           NULL;
       end case;
@@ -587,6 +637,7 @@ begin
       execute_engine.state   <= RESTART;
       execute_engine.ir      <= (others => '0');
       execute_engine.is_ci   <= '0';
+      execute_engine.is_uop  <= '0';
       execute_engine.pc      <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
       execute_engine.next_pc <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
       execute_engine.link_pc <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
@@ -595,9 +646,10 @@ begin
       ctrl <= ctrl_nxt;
 
       -- execute engine arbiter --
-      execute_engine.state <= execute_engine.state_nxt;
-      execute_engine.ir    <= execute_engine.ir_nxt;
-      execute_engine.is_ci <= execute_engine.is_ci_nxt;
+      execute_engine.state  <= execute_engine.state_nxt;
+      execute_engine.ir     <= execute_engine.ir_nxt;
+      execute_engine.is_ci  <= execute_engine.is_ci_nxt;
+      execute_engine.is_uop <= execute_engine.is_uop_nxt;
 
       -- current PC: address of instruction being executed --
       if (execute_engine.pc_we = '1') then
@@ -652,9 +704,10 @@ begin
                                  (execute_engine.branch_taken = '1') and -- branch is taken
                                  (alu_add_i(1) = '1') and (not CPU_EXTENSION_RISCV_C) else '0'; -- misaligned destination
 
-  -- PC increment for next LINEAR instruction (+2 for compressed instr., +4 otherwise) --
+  -- PC increment for next LINEAR instruction (+2 for compressed instr., +4 otherwise, +0 for non-final micro-ops) --
   execute_engine.next_pc_inc(XLEN-1 downto 4) <= (others => '0');
-  execute_engine.next_pc_inc(3 downto 0) <= x"4" when ((execute_engine.is_ci = '0') or (not CPU_EXTENSION_RISCV_C)) else x"2";
+  execute_engine.next_pc_inc(3 downto 0) <= x"4" when ((execute_engine.is_ci = '0') or (not CPU_EXTENSION_RISCV_C)) else
+                                            x"0" when (execute_engine.is_uop = '1') and CPU_EXTENSION_RISCV_Zcmp else x"2";
 
   -- PC output --
   curr_pc_o <= execute_engine.pc(XLEN-1 downto 1) & '0'; -- current PC
@@ -674,6 +727,9 @@ begin
     decode_aux.is_b_imm  <= '0';
     decode_aux.is_b_reg  <= '0';
     decode_aux.is_zicond <= '0';
+    decode_aux.is_k_imm  <= '0';
+    decode_aux.is_k_reg  <= '0';
+    decode_aux.is_p      <= '0';
 
     -- ATOMIC instructions --
     if CPU_EXTENSION_RISCV_A and -- implemented at all?
@@ -697,14 +753,15 @@ begin
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0010100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "101") and
                                                                                             (execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "00111")) or -- ORCB
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0100100") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01")) or -- BCLRI / BEXTI
-         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110100") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01")) or -- REV8 / BINVI
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001")) or -- BINVI
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "101") and (execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "11000")) or -- REV8
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0010100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001")) then -- BSETI
         decode_aux.is_b_imm <= '1';
       end if;
       -- register-register operation --
       if ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110000") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01")) or -- ROR / ROL
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000101") and (execute_engine.ir(instr_funct3_msb_c) = '1')) or -- MIN[U] / MAX[U]
-         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "100")) or -- ZEXTH
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "100") and (execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "00000")) or -- ZEXTH
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0100100") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01")) or -- BCLR / BEXT
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001")) or -- BINV
          ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0010100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001")) or -- BSET
@@ -723,6 +780,60 @@ begin
       end if;
     end if;
 
+    -- BITMANIP instruction for cryptography (Zbkb) --
+    if CPU_EXTENSION_RISCV_Zbkb then -- implemented at all?
+      -- register-immediate operation --
+      if ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110000") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "101")) or -- RORI
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110100") and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "101") and ((execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "11000") or (execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "00111"))) or -- REV8 / BREV8
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000100") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01") and (execute_engine.ir(instr_funct12_lsb_c+4 downto instr_funct12_lsb_c) = "01111")) then -- ZIP / UNZIP
+        decode_aux.is_b_imm <= '1';
+      end if;
+      -- register-register operation --
+      if ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0110000") and (execute_engine.ir(instr_funct3_msb_c-1 downto instr_funct3_lsb_c) = "01")) or -- ROR / ROL
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0100000") and (
+           (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "111") or -- ANDN
+           (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "110") or -- ORN
+           (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "100")    -- XORN
+          )) or
+         ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000100") and ((execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "100") or (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "111"))) then -- PACK / PACKH
+        decode_aux.is_b_reg <= '1';
+      end if;
+    end if;
+
+    -- CARRY-LESS MULTIPLICATION instruction (Zbkc) --
+    if CPU_EXTENSION_RISCV_Zbkc and (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000101") and
+       ((execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001") or (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "011")) then -- CLMUL / CLMULH
+      decode_aux.is_b_reg <= '1';
+    end if;
+
+    -- CARRY-LESS MULTIPLICATION instruction (Zbc) --
+    if CPU_EXTENSION_RISCV_Zbc and (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000101") and
+       (execute_engine.ir(instr_funct3_msb_c) = '0') and (execute_engine.ir(instr_funct3_lsb_c+1 downto instr_funct3_lsb_c) /= "00") then -- CLMUL / CLMULR / CLMULH
+      decode_aux.is_b_reg <= '1';
+    end if;
+
+    -- CROSSBAR PERMUTATION instruction (Zbkx) --
+    if CPU_EXTENSION_RISCV_Zbkx and (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0010100") and
+       ((execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "010") or (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "100")) then -- XPERM4 / XPERM8
+      decode_aux.is_b_reg <= '1';
+    end if;
+
+    -- SCALAR CRYPTOGRAPHY instruction (Zknd / Zkne / Zknh) --
+    if (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "000") then
+      if (CPU_EXTENSION_RISCV_Zkne and ((execute_engine.ir(instr_funct7_msb_c-2 downto instr_funct7_lsb_c) = "10001") or -- AES32ESI
+                                        (execute_engine.ir(instr_funct7_msb_c-2 downto instr_funct7_lsb_c) = "10011"))) or -- AES32ESMI
+         (CPU_EXTENSION_RISCV_Zknd and ((execute_engine.ir(instr_funct7_msb_c-2 downto instr_funct7_lsb_c) = "10101") or -- AES32DSI
+                                        (execute_engine.ir(instr_funct7_msb_c-2 downto instr_funct7_lsb_c) = "10111"))) or -- AES32DSMI
+         (CPU_EXTENSION_RISCV_Zknh and (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c+3) = "0101") and
+                                       ((execute_engine.ir(instr_funct7_lsb_c+2) = '0') or (execute_engine.ir(instr_funct7_lsb_c+1) = '1'))) then -- SHA512*
+        decode_aux.is_k_reg <= '1';
+      end if;
+    end if;
+    if CPU_EXTENSION_RISCV_Zknh and (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001") and
+       (execute_engine.ir(instr_funct12_msb_c downto instr_funct12_lsb_c+2) = "0001000000") then -- SHA256SUM0/1 / SHA256SIG0/1
+      decode_aux.is_k_imm <= '1';
+    end if;
+
     -- FLOATING-POINT instructions (Zfinx) --
     if CPU_EXTENSION_RISCV_Zfinx then -- FPU implemented at all?
       if ((execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c+3) = "0000")) or -- FADD.S / FSUB.S
@@ -754,6 +865,26 @@ begin
        (execute_engine.ir(instr_funct3_msb_c) = '1') and (execute_engine.ir(instr_funct3_lsb_c) = '1') then
       decode_aux.is_zicond <= '1';
     end if;
+
+    -- PACKED-SIMD instruction (Zxpsimd) --
+    if CPU_EXTENSION_RISCV_Zxpsimd then
+      if (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "000") then
+        if (execute_engine.ir(instr_funct7_msb_c) = '0') and (execute_engine.ir(instr_funct7_lsb_c+1) = '0') and -- [UR|R|UK|K]ADD/SUB16/8
+           ((execute_engine.ir(instr_funct7_msb_c-1) = '0') or (execute_engine.ir(instr_funct7_lsb_c+4 downto instr_funct7_lsb_c+3) = "00")) then -- ADD/SUB16/8
+          decode_aux.is_p <= '1';
+        end if;
+        if (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "1100100") or -- SMAQA
+           (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "1100110") then -- UMAQA
+          decode_aux.is_p <= '1';
+        end if;
+      end if;
+      if (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "001") then
+        if (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0011100") or -- KMDA
+           (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0100100") then -- KMADA
+          decode_aux.is_p <= '1';
+        end if;
+      end if;
+    end if;
   end process decode_helper;
 
   -- register/uimm5 checks --
@@ -771,8 +902,9 @@ begin
     -- arbiter defaults --
     execute_engine.state_nxt <= execute_engine.state;
     execute_engine.ir_nxt    <= execute_engine.ir;
-    execute_engine.is_ci_nxt <= execute_engine.is_ci;
-    execute_engine.pc_we     <= '0';
+    execute_engine.is_ci_nxt  <= execute_engine.is_ci;
+    execute_engine.is_uop_nxt <= execute_engine.is_uop;
+    execute_engine.pc_we      <= '0';
     --
     issue_engine.ack         <= '0';
     --
@@ -807,7 +939,7 @@ begin
 
     -- ALU operand B: is immediate? --
     case decode_aux.opcode is
-      when opcode_alui_c | opcode_lui_c | opcode_auipc_c | opcode_load_c | opcode_store_c | opcode_amo_c | opcode_branch_c | opcode_jal_c | opcode_jalr_c =>
+      when opcode_alui_c | opcode_lui_c | opcode_auipc_c | opcode_load_c | opcode_store_c | opcode_amo_c | opcode_fence_c | opcode_branch_c | opcode_jal_c | opcode_jalr_c =>
         ctrl_nxt.alu_opb_mux <= '1';
       when others =>
         ctrl_nxt.alu_opb_mux <= '0';
@@ -816,6 +948,8 @@ begin
     -- memory read/write access --
     if CPU_EXTENSION_RISCV_A and (decode_aux.opcode(2) = opcode_amo_c(2)) then -- lr/sc
       ctrl_nxt.lsu_rw <= execute_engine.ir(instr_funct7_lsb_c+2);
+    elsif (CPU_EXTENSION_RISCV_Zicbom or CPU_EXTENSION_RISCV_Zicboz) and (decode_aux.opcode = opcode_fence_c) then -- cache-block operation
+      ctrl_nxt.lsu_rw <= '1'; -- behaves like a store (permission checks, access faults)
     else -- normal load/store
       ctrl_nxt.lsu_rw <= execute_engine.ir(5);
     end if;
@@ -834,7 +968,8 @@ begin
         elsif (issue_engine.valid(0) = '1') or (issue_engine.valid(1) = '1') then -- new instruction word available
           issue_engine.ack         <= '1';
           trap_ctrl.instr_be       <= issue_engine.data(32); -- access fault during instruction fetch
-          execute_engine.is_ci_nxt <= issue_engine.data(33); -- this is a de-compressed instruction
+          execute_engine.is_ci_nxt  <= issue_engine.data(33); -- this is a de-compressed instruction
+          execute_engine.is_uop_nxt <= issue_engine.data(34); -- this is a micro-op that is followed by more micro-ops
           execute_engine.ir_nxt    <= issue_engine.data(31 downto 0); -- instruction word
           execute_engine.pc_we     <= '1'; -- pc <= next_pc
           execute_engine.state_nxt <= EXECUTE;
@@ -889,7 +1024,7 @@ begin
               ctrl_nxt.alu_cp_trig(cp_sel_muldiv_c) <= '1'; -- trigger MULDIV CP
               execute_engine.state_nxt              <= ALU_WAIT;
             -- EXT: co-processor BIT-MANIPULATION operation (multi-cycle) --
-            elsif CPU_EXTENSION_RISCV_B and
+            elsif bitmanip_en_c and
                   (((execute_engine.ir(instr_opcode_lsb_c+5) = opcode_alu_c(5))  and (decode_aux.is_b_reg = '1')) or -- register operation
                    ((execute_engine.ir(instr_opcode_lsb_c+5) = opcode_alui_c(5)) and (decode_aux.is_b_imm = '1'))) then -- immediate operation
               ctrl_nxt.alu_cp_trig(cp_sel_bitmanip_c) <= '1'; -- trigger BITMANIP CP
@@ -898,6 +1033,12 @@ begin
             elsif CPU_EXTENSION_RISCV_Zicond and (decode_aux.is_zicond = '1') and (execute_engine.ir(instr_opcode_lsb_c+5) = opcode_alu_c(5)) then
               ctrl_nxt.alu_cp_trig(cp_sel_cond_c) <= '1'; -- trigger COND CP
               execute_engine.state_nxt            <= ALU_WAIT;
+            -- EXT: co-processor CRYPTOGRAPHY operation (multi-cycle) --
+            elsif crypto_en_c and
+                  (((execute_engine.ir(instr_opcode_lsb_c+5) = opcode_alu_c(5))  and (decode_aux.is_k_reg = '1')) or -- register operation
+                   ((execute_engine.ir(instr_opcode_lsb_c+5) = opcode_alui_c(5)) and (decode_aux.is_k_imm = '1'))) then -- immediate operation
+              ctrl_nxt.alu_cp_trig(cp_sel_crypto_c) <= '1'; -- trigger CRYPTO CP
+              execute_engine.state_nxt              <= ALU_WAIT;
             -- BASE: co-processor SHIFT operation (multi-cycle) --
             elsif (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = funct3_sll_c) or
                   (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = funct3_sr_c) then
@@ -941,6 +1082,11 @@ begin
             ctrl_nxt.alu_cp_trig(cp_sel_cfu_c) <= '1'; -- trigger CFU co-processor
             execute_engine.state_nxt           <= ALU_WAIT; -- will be aborted via monitor exception if CFU not implemented
 
+          -- SIMD: packed-SIMD DSP instructions --
+          when opcode_p_c =>
+            ctrl_nxt.alu_cp_trig(cp_sel_simd_c) <= '1'; -- trigger SIMD co-processor
+            execute_engine.state_nxt            <= ALU_WAIT; -- will be aborted via monitor exception if SIMD unit not implemented
+
           -- environment/CSR operation or ILLEGAL opcode --
           when others =>
             csr.re_nxt               <= '1';
@@ -960,6 +1106,9 @@ begin
       -- ------------------------------------------------------------
         if (trap_ctrl.exc_buf(exc_illegal_c) = '1') then -- abort if illegal instruction
           execute_engine.state_nxt <= DISPATCH;
+        elsif (CPU_EXTENSION_RISCV_Zicbom or CPU_EXTENSION_RISCV_Zicboz) and
+              (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = funct3_cbo_c) then -- cache-block operation
+          execute_engine.state_nxt <= MEM_REQ;
         else
           ctrl_nxt.lsu_fence       <= '1'; -- NOTE: fence == fence.i
           execute_engine.state_nxt <= RESTART; -- reset instruction fetch + IPB (actually only required for fence.i)
@@ -1259,7 +1408,8 @@ begin
               (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000000"))) or -- valid base ALU instruction?
            ((CPU_EXTENSION_RISCV_M or CPU_EXTENSION_RISCV_Zmmul) and (decode_aux.is_m_mul = '1')) or -- valid MUL instruction?
            (CPU_EXTENSION_RISCV_M and (decode_aux.is_m_div = '1')) or -- valid DIV instruction?
-           (CPU_EXTENSION_RISCV_B and (decode_aux.is_b_reg = '1')) or -- valid BITMANIP register instruction?
+           (bitmanip_en_c and (decode_aux.is_b_reg = '1')) or -- valid BITMANIP register instruction?
+           (crypto_en_c and (decode_aux.is_k_reg = '1')) or -- valid CRYPTO register instruction?
            (CPU_EXTENSION_RISCV_Zicond and (decode_aux.is_zicond = '1')) then -- valid CONDITIONAL instruction?
           illegal_cmd <= '0';
         else
@@ -1277,7 +1427,8 @@ begin
              (execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c) = "0000000")) or
             ((execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = funct3_sr_c) and
              ((execute_engine.ir(instr_funct7_msb_c-2 downto instr_funct7_lsb_c) = "00000") and (execute_engine.ir(instr_funct7_msb_c) = '0')))) or -- valid base ALUI instruction?
-           (CPU_EXTENSION_RISCV_B and (decode_aux.is_b_imm = '1')) then -- valid BITMANIP immediate instruction?
+           (bitmanip_en_c and (decode_aux.is_b_imm = '1')) or -- valid BITMANIP immediate instruction?
+           (crypto_en_c and (decode_aux.is_k_imm = '1')) then -- valid CRYPTO immediate instruction?
           illegal_cmd <= '0';
         else
           illegal_cmd <= '1';
@@ -1286,6 +1437,16 @@ begin
       when opcode_fence_c =>
         case execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) is
           when funct3_fence_c | funct3_fencei_c => illegal_cmd <= '0'; -- fence[.i]
+          when funct3_cbo_c => -- cache-block operation; menvcfg is hardwired to zero so M-mode only
+            if (decode_aux.rd_zero = '1') and (csr.privilege = priv_mode_m_c) then
+              case execute_engine.ir(instr_funct12_msb_c downto instr_funct12_lsb_c) is
+                when funct12_cbo_inval_c | funct12_cbo_clean_c | funct12_cbo_flush_c => illegal_cmd <= not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zicbom);
+                when funct12_cbo_zero_c                                              => illegal_cmd <= not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zicboz);
+                when others                                                          => illegal_cmd <= '1';
+              end case;
+            else
+              illegal_cmd <= '1';
+            end if;
           when others                           => illegal_cmd <= '1';
         end case;
 
@@ -1315,6 +1476,9 @@ begin
       when opcode_cust0_c | opcode_cust1_c | opcode_cust2_c | opcode_cust3_c =>
         illegal_cmd <= not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zxcfu); -- all encodings valid if CFU enable
 
+      when opcode_p_c =>
+        illegal_cmd <= (not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zxpsimd)) or (not decode_aux.is_p);
+
       when others =>
         illegal_cmd <= '1'; -- undefined/illegal opcode
 
@@ -1523,6 +1687,7 @@ begin
   -- any "normal" system interrupt? --
   trap_ctrl.irq_fire(0) <= '1' when
     (execute_engine.state = EXECUTE) and -- trigger system IRQ only in EXECUTE state
+    (execute_engine.is_uop = '0') and -- do not interrupt micro-op sequences
     (or_reduce_f(trap_ctrl.irq_buf(irq_firq_15_c downto irq_msi_irq_c)) = '1') and -- pending system IRQ
     ((csr.mstatus_mie = '1') or (csr.privilege = priv_mode_u_c)) and -- IRQ only when in M-mode and MIE=1 OR when in U-mode
     (debug_ctrl.running = '0') and -- no system IRQs when in debug-mode
@@ -1531,13 +1696,13 @@ begin
 
   -- debug-entry halt interrupt? --
   trap_ctrl.irq_fire(1) <= '1' when
-    ((execute_engine.state = EXECUTE) or (execute_engine.state = BRANCHED)) and -- allow halt also after "reset" (#879)
+    (((execute_engine.state = EXECUTE) and (execute_engine.is_uop = '0')) or (execute_engine.state = BRANCHED)) and -- allow halt also after "reset" (#879)
     (trap_ctrl.irq_buf(irq_db_halt_c) = '1') -- pending external halt
     else '0';
 
   -- debug-entry single-step interrupt? --
   trap_ctrl.irq_fire(2) <= '1' when
-    ((execute_engine.state = EXECUTE) or -- trigger single-step in EXECUTE state
+    (((execute_engine.state = EXECUTE) and (execute_engine.is_uop = '0')) or -- trigger single-step in EXECUTE state (after last micro-op)
      ((trap_ctrl.env_entered = '1') and (execute_engine.state = BRANCHED))) and -- also allow triggering when entering a system trap (#887)
     (trap_ctrl.irq_buf(irq_db_step_c) = '1') -- pending single-step halt
     else '0';
@@ -2089,11 +2254,23 @@ begin
         csr_rdata(09) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zihpm);  -- Zihpm: hardware performance monitors
         csr_rdata(10) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Sdext);  -- Sdext: RISC-V (external) debug mode
         csr_rdata(11) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Sdtrig); -- Sdtrig: trigger module
+        csr_rdata(12) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zicbom); -- Zicbom: cache-block management operations
+        csr_rdata(13) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zicboz); -- Zicboz: cache-block zero operation
+        csr_rdata(14) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zcb);    -- Zcb: additional simple compressed instructions
+        csr_rdata(15) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zcmp);   -- Zcmp: compressed push/pop and register-move instructions
+        csr_rdata(16) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zbkb);   -- Zbkb: bit-manipulation instructions for cryptography
+        csr_rdata(17) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zbkc);   -- Zbkc: carry-less multiplication instructions
+        csr_rdata(18) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zbkx);   -- Zbkx: cryptography crossbar permutation instructions
+        csr_rdata(19) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zknd);   -- Zknd: NIST suite AES decryption instructions
+        csr_rdata(21) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zkne);   -- Zkne: NIST suite AES encryption instructions
+        csr_rdata(22) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zknh);   -- Zknh: NIST suite hash function instructions
+        csr_rdata(23) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zbc);    -- Zbc: carry-less multiplication instructions
+        csr_rdata(24) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zxpsimd); -- Zxpsimd: packed-SIMD DSP instructions
         -- misc --
         csr_rdata(20) <= bool_to_ulogic_f(is_simulation_c);            -- is this a simulation?
         -- tuning options --
         csr_rdata(29) <= bool_to_ulogic_f(REGFILE_HW_RST);             -- full hardware reset of register file
-        csr_rdata(30) <= bool_to_ulogic_f(FAST_MUL_EN);                -- DSP-based multiplication (M extensions only)
+        csr_rdata(30) <= bool_to_ulogic_f(FAST_MUL_EN);                -- DSP-based multiplication (M), parallel carry-less multiplication
         csr_rdata(31) <= bool_to_ulogic_f(FAST_SHIFT_EN);              -- parallel logic for shifts (barrel shifters)
 
       -- --------------------------------------------------------------------
@@ -2285,10 +2462,10 @@ begin
   -- RISC-V-specific base counter events (for HPM and base counters) --
   cnt_event(hpmcnt_event_cy_c) <= '1' when (sleep_mode = '0')               else '0'; -- cycle: active cycle
   cnt_event(hpmcnt_event_tm_c) <=                                                '0'; -- time: unused/reserved
-  cnt_event(hpmcnt_event_ir_c) <= '1' when (execute_engine.state = EXECUTE) else '0'; -- instret: retired (==executed) instruction
+  cnt_event(hpmcnt_event_ir_c) <= '1' when (execute_engine.state = EXECUTE) and (execute_engine.is_uop = '0') else '0'; -- instret: retired (==executed) instruction
 
   -- NEORV32-specific counter events (for HPM counters only) --
-  cnt_event(hpmcnt_event_compr_c)    <= '1' when (execute_engine.state = EXECUTE)  and (execute_engine.is_ci = '1')  else '0'; -- executed compressed instruction
+  cnt_event(hpmcnt_event_compr_c)    <= '1' when (execute_engine.state = EXECUTE)  and (execute_engine.is_ci = '1') and (execute_engine.is_uop = '0') else '0'; -- executed compressed instruction
   cnt_event(hpmcnt_event_wait_dis_c) <= '1' when (execute_engine.state = DISPATCH) and (issue_engine.valid   = "00") else '0'; -- instruction dispatch wait cycle
   cnt_event(hpmcnt_event_wait_alu_c) <= '1' when (execute_engine.state = ALU_WAIT)                                   else '0'; -- multi-cycle ALU co-processor wait cycle
   cnt_event(hpmcnt_event_branch_c)   <= '1' when (execute_engine.state = BRANCH)                                     else '0'; -- executed branch instruction
@@ -2374,6 +2551,7 @@ begin
     -- trigger on instruction address match (trigger right BEFORE execution) --
     hw_trigger_match <= '1' when (csr.tdata1_execute = '1') and -- trigger enabled to match on instruction address
                                  (hw_trigger_fired = '0') and -- trigger has not fired yet
+                                 (execute_engine.is_uop = '0') and -- not within a micro-op sequence
                                  (csr.tdata2(XLEN-1 downto 1) = execute_engine.next_pc(XLEN-1 downto 1)) -- address match
                                  else '0';
 
@@ -2425,4 +2603,25 @@ begin
   csr.tdata1_rd(0)            <= '0'; -- load: load address or data matching not supported
 
 
+-- ****************************************************************************************************************************
+-- Simulation Trace Interface (probed by the testbench's co-simulation trace monitor)
+-- ****************************************************************************************************************************
+
+  simulation_trace:
+  if is_simulation_c generate -- for simulation only!
+    signal trace_ir     : std_ulogic_vector(31 downto 0); -- executed instruction (decompressed; bit 1 cleared if compressed)
+    signal trace_mcause : std_ulogic_vector(31 downto 0); -- cause of the trap that is being entered
+    signal trace_mepc   : std_ulogic_vector(XLEN-1 downto 0); -- PC of the trap that is being entered
+    signal trace_debug  : std_ulogic; -- trap enters debug-mode / trap while in debug-mode (no mcause/mepc update)
+  begin
+    trace_ir(31 downto 2)     <= execute_engine.ir(31 downto 2);
+    trace_ir(1)               <= execute_engine.ir(1) and (not execute_engine.is_ci);
+    trace_ir(0)               <= execute_engine.ir(0);
+    trace_mcause(31)          <= trap_ctrl.cause(trap_ctrl.cause'left);
+    trace_mcause(30 downto 5) <= (others => '0');
+    trace_mcause(4 downto 0)  <= trap_ctrl.cause(4 downto 0);
+    trace_mepc                <= trap_ctrl.epc(XLEN-1 downto 1) & '0';
+    trace_debug               <= trap_ctrl.cause(5) or debug_ctrl.running;
+  end generate;
+
 end neorv32_cpu_control_rtl;
@@ -5,6 +5,11 @@
 --  Zba: Address-generation instructions                                            --
 --  Zbb: Basic bit-manipulation instructions                                        --
 --  Zbs: Single-bit instructions                                                    --
+-- Zbc: Carry-less multiplication (clmul, clmulh, clmulr)                           --
+-- Scalar cryptography bit-manipulation sub-extensions:                             --
+--  Zbkb: Bit-manipulation for cryptography (subset of Zbb + pack, brev8, [un]zip)  --
+--  Zbkc: Carry-less multiplication (clmul, clmulh)                                 --
+--  Zbkx: Crossbar permutations (xperm4, xperm8)                                    --
 -- -------------------------------------------------------------------------------- --
 -- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
 -- Copyright (c) NEORV32 contributors.                                              --
@@ -22,6 +27,12 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_cpu_cp_bitmanip is
   generic (
+    B_EN          : boolean; -- implement Zba + Zbb + Zbs
+    ZBC_EN        : boolean; -- implement carry-less multiplication
+    ZBKB_EN       : boolean; -- implement bit-manipulation for cryptography
+    ZBKC_EN       : boolean; -- implement carry-less multiplication for cryptography
+    ZBKX_EN       : boolean; -- implement crossbar permutations
+    FAST_MUL_EN   : boolean; -- use parallel (single-cycle) carry-less multiplier
     FAST_SHIFT_EN : boolean  -- use barrel shifter for shift operations
   );
   port (
@@ -69,11 +80,21 @@ architecture neorv32_cpu_cp_bitmanip_rtl of neorv32_cpu_cp_bitmanip is
   constant op_bext_c  : natural := 13;
   constant op_binv_c  : natural := 14;
   constant op_bset_c  : natural := 15;
+  -- Zbkb - bit interleaving --
+  constant op_zip_c   : natural := 16;
+  -- Zbc/Zbkc - carry-less multiplication --
+  constant op_clmul_c : natural := 17;
+  -- Zbkx - crossbar permutations --
+  constant op_xperm_c : natural := 18;
   --
-  constant op_width_c : natural := 16;
+  constant op_width_c : natural := 19;
+
+  -- instruction groups --
+  constant zbb_en_c   : boolean := B_EN or ZBKB_EN; -- logic with negate, rotate, rev8, zero-extension/pack
+  constant clmul_en_c : boolean := ZBC_EN or ZBKC_EN; -- carry-less multiplication
 
   -- controller --
-  type ctrl_state_t is (S_IDLE, S_START_SHIFT, S_BUSY_SHIFT);
+  type ctrl_state_t is (S_IDLE, S_START_SHIFT, S_BUSY_SHIFT, S_BUSY_CLMUL);
   signal ctrl_state : ctrl_state_t;
   signal cmd        : std_ulogic_vector(op_width_c-1 downto 0);
   signal valid      : std_ulogic;
@@ -101,6 +122,16 @@ architecture neorv32_cpu_cp_bitmanip_rtl of neorv32_cpu_cp_bitmanip is
   signal bs_level : bs_level_t;
   signal bs_shift : std_ulogic_vector(index_size_f(XLEN)-1 downto 0);
 
+  -- carry-less multiplier --
+  type clmul_t is record
+    start : std_ulogic;
+    run   : std_ulogic;
+    cnt   : std_ulogic_vector(index_size_f(XLEN)-1 downto 0); -- iteration counter
+    sreg  : std_ulogic_vector(XLEN-1 downto 0); -- multiplier (rs2) shift register
+    prod  : std_ulogic_vector(2*XLEN-1 downto 0); -- product accumulator
+  end record;
+  signal clmul : clmul_t;
+
   -- operation results --
   type res_t is array (0 to op_width_c-1) of std_ulogic_vector(XLEN-1 downto 0);
   signal res_int, res_out : res_t;
@@ -108,6 +139,9 @@ architecture neorv32_cpu_cp_bitmanip_rtl of neorv32_cpu_cp_bitmanip is
   -- shifted-add and one-hot results --
   signal adder_res, one_hot_res : std_ulogic_vector(XLEN-1 downto 0);
 
+  -- bit interleaving and crossbar permutation results --
+  signal zip_res, unzip_res, xperm4_res, xperm8_res : std_ulogic_vector(XLEN-1 downto 0);
+
 begin
 
   -- Instruction Decoding (One-Hot) ---------------------------------------------------------
@@ -115,27 +149,37 @@ begin
   -- An "operation" decoding logic is used here just to distinguish between the different B instructions.
   -- A more general decoding as well as a valid-instruction-check is performed by the CPU control unit.
 
-  -- Zbb - Basic bit-manipulation instructions --
-  cmd(op_andn_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "11") else '0';
-  cmd(op_orn_c)   <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "10") else '0';
-  cmd(op_xnor_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "00") else '0';
-  cmd(op_max_c)   <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '1') and (ctrl_i.ir_funct3(2) = '1') else '0';
-  cmd(op_zexth_c) <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '0') else '0';
-  cmd(op_orcb_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2 downto 0) = "101") else '0';
-  cmd(op_cz_c)    <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 1) = "00")  and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
-  cmd(op_cpop_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 0) = "010") and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
-  cmd(op_sext_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 1) = "10")  and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
-  cmd(op_rot_c)   <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (((ctrl_i.ir_funct3(2 downto 0) = "001") and (ctrl_i.ir_opcode(5) = '1')) or (ctrl_i.ir_funct3(2 downto 0) = "101")) else '0';
-  cmd(op_rev8_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2 downto 0) = "101") else '0';
+  -- Zbb - Basic bit-manipulation instructions (partly shared with Zbkb) --
+  cmd(op_andn_c)  <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "11") else '0';
+  cmd(op_orn_c)   <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "10") else '0';
+  cmd(op_xnor_c)  <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct3(1 downto 0) = "00") else '0';
+  cmd(op_max_c)   <= '1' when B_EN     and (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '1') and (ctrl_i.ir_funct3(2) = '1') else '0';
+  cmd(op_zexth_c) <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '0') and (ctrl_i.ir_opcode(5) = '1') else '0';
+  cmd(op_orcb_c)  <= '1' when B_EN     and (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2 downto 0) = "101") else '0';
+  cmd(op_cz_c)    <= '1' when B_EN     and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 1) = "00")  and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
+  cmd(op_cpop_c)  <= '1' when B_EN     and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 0) = "010") and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
+  cmd(op_sext_c)  <= '1' when B_EN     and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (ctrl_i.ir_funct12(2 downto 1) = "10")  and (ctrl_i.ir_funct3(2) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
+  cmd(op_rot_c)   <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '0') and (((ctrl_i.ir_funct3(2 downto 0) = "001") and (ctrl_i.ir_opcode(5) = '1')) or (ctrl_i.ir_funct3(2 downto 0) = "101")) else '0';
+  cmd(op_rev8_c)  <= '1' when zbb_en_c and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2 downto 0) = "101") else '0';
 
   -- Zba - Address generation instructions --
-  cmd(op_shadd_c) <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '0') else '0';
+  cmd(op_shadd_c) <= '1' when B_EN and (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '0') else '0';
 
   -- Zbs - Single-bit instructions --
-  cmd(op_bclr_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
-  cmd(op_bext_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '1') else '0';
-  cmd(op_binv_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
-  cmd(op_bset_c)  <= '1' when (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
+  cmd(op_bclr_c)  <= '1' when B_EN and (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
+  cmd(op_bext_c)  <= '1' when B_EN and (ctrl_i.ir_funct12(10 downto 9) = "10") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '1') else '0';
+  cmd(op_binv_c)  <= '1' when B_EN and (ctrl_i.ir_funct12(10 downto 9) = "11") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
+  cmd(op_bset_c)  <= '1' when B_EN and (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '1') and (ctrl_i.ir_funct3(2 downto 0) = "001") else '0';
+
+  -- Zbkb - Bit interleaving (zip / unzip) --
+  cmd(op_zip_c)   <= '1' when ZBKB_EN and (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '0') and (ctrl_i.ir_opcode(5) = '0') else '0';
+
+  -- Zbc/Zbkc - Carry-less multiplication (clmulr is checked by the control unit) --
+  cmd(op_clmul_c) <= '1' when clmul_en_c and (ctrl_i.ir_funct12(10 downto 9) = "00") and (ctrl_i.ir_funct12(5) = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
+
+  -- Zbkx - Crossbar permutations --
+  cmd(op_xperm_c) <= '1' when ZBKX_EN and (ctrl_i.ir_funct12(10 downto 9) = "01") and (ctrl_i.ir_funct12(7) = '1') and
+                              ((ctrl_i.ir_funct3(2 downto 0) = "010") or (ctrl_i.ir_funct3(2 downto 0) = "100")) else '0';
 
 
   -- Co-Processor Controller ----------------------------------------------------------------
@@ -149,10 +193,12 @@ begin
       sha_reg       <= (others => '0');
       less_reg      <= '0';
       shifter.start <= '0';
+      clmul.start   <= '0';
       valid         <= '0';
     elsif rising_edge(clk_i) then
       -- defaults --
       shifter.start <= '0';
+      clmul.start   <= '0';
       valid         <= '0';
 
       -- operand registers --
@@ -172,6 +218,9 @@ begin
             if (not FAST_SHIFT_EN) and ((cmd(op_cz_c) or cmd(op_cpop_c) or cmd(op_rot_c)) = '1') then -- multi-cycle shift operation
               shifter.start <= '1';
               ctrl_state <= S_START_SHIFT;
+            elsif (not FAST_MUL_EN) and (cmd(op_clmul_c) = '1') then -- multi-cycle carry-less multiplication
+              clmul.start <= '1';
+              ctrl_state  <= S_BUSY_CLMUL;
             else
               valid      <= '1';
               ctrl_state <= S_IDLE;
@@ -189,6 +238,13 @@ begin
             ctrl_state <= S_IDLE;
           end if;
 
+        when S_BUSY_CLMUL => -- wait for multi-cycle carry-less multiplication to finish
+        -- ------------------------------------------------------------
+          if ((clmul.start = '0') and (clmul.run = '0')) or (ctrl_i.cpu_trap = '1') then -- abort on trap
+            valid      <= '1';
+            ctrl_state <= S_IDLE;
+          end if;
+
         when others => -- undefined
         -- ------------------------------------------------------------
           ctrl_state <= S_IDLE;
@@ -293,6 +349,100 @@ begin
   end generate; -- /barrel_shifter
 
 
+  -- Carry-Less Multiplier (iterative: one bit per cycle) -----------------------------------
+  -- -------------------------------------------------------------------------------------------
+  clmul_serial:
+  if clmul_en_c and (not FAST_MUL_EN) generate
+
+    clmul_core: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        clmul.run  <= '0';
+        clmul.cnt  <= (others => '0');
+        clmul.sreg <= (others => '0');
+        clmul.prod <= (others => '0');
+      elsif rising_edge(clk_i) then
+        if (clmul.start = '1') then -- trigger new multiplication
+          clmul.run  <= '1';
+          clmul.cnt  <= (others => '0');
+          clmul.sreg <= rs2_reg;
+          clmul.prod <= (others => '0');
+        elsif (clmul.run = '1') then -- process multiplier MSB-first
+          if (clmul.sreg(XLEN-1) = '1') then
+            clmul.prod <= (clmul.prod(2*XLEN-2 downto 0) & '0') xor std_ulogic_vector(resize(unsigned(rs1_reg), 2*XLEN));
+          else
+            clmul.prod <= (clmul.prod(2*XLEN-2 downto 0) & '0');
+          end if;
+          clmul.sreg <= clmul.sreg(XLEN-2 downto 0) & '0';
+          clmul.cnt  <= std_ulogic_vector(unsigned(clmul.cnt) + 1);
+          if (and_reduce_f(clmul.cnt) = '1') then -- all bits processed
+            clmul.run <= '0';
+          end if;
+        end if;
+      end if;
+    end process clmul_core;
+
+  end generate;
+
+
+  -- Carry-Less Multiplier (parallel: XOR tree, single cycle) -------------------------------
+  -- -------------------------------------------------------------------------------------------
+  clmul_parallel:
+  if clmul_en_c and FAST_MUL_EN generate
+
+    clmul_core: process(rs1_reg, rs2_reg)
+      variable prod_v : std_ulogic_vector(2*XLEN-1 downto 0);
+    begin
+      prod_v := (others => '0');
+      for i in 0 to XLEN-1 loop
+        if (rs2_reg(i) = '1') then
+          prod_v := prod_v xor std_ulogic_vector(shift_left(resize(unsigned(rs1_reg), 2*XLEN), i));
+        end if;
+      end loop;
+      clmul.prod <= prod_v;
+    end process clmul_core;
+
+    clmul.run  <= '0';
+    clmul.cnt  <= (others => '0');
+    clmul.sreg <= (others => '0');
+
+  end generate;
+
+  clmul_disabled:
+  if not clmul_en_c generate
+    clmul.run  <= '0';
+    clmul.cnt  <= (others => '0');
+    clmul.sreg <= (others => '0');
+    clmul.prod <= (others => '0');
+  end generate;
+
+
+  -- Crossbar Permutations ------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  xperm_core: process(rs1_reg, rs2_reg)
+    variable idx_v : natural range 0 to 15;
+  begin
+    -- xperm4: nibble-wise lookup --
+    for i in 0 to (XLEN/4)-1 loop
+      idx_v := to_integer(unsigned(rs2_reg(i*4+3 downto i*4)));
+      if (idx_v < (XLEN/4)) then
+        xperm4_res(i*4+3 downto i*4) <= rs1_reg(idx_v*4+3 downto idx_v*4);
+      else
+        xperm4_res(i*4+3 downto i*4) <= (others => '0');
+      end if;
+    end loop;
+    -- xperm8: byte-wise lookup --
+    for i in 0 to (XLEN/8)-1 loop
+      idx_v := to_integer(unsigned(rs2_reg(i*8+3 downto i*8)));
+      if (rs2_reg(i*8+7 downto i*8+4) = "0000") and (idx_v < (XLEN/8)) then
+        xperm8_res(i*8+7 downto i*8) <= rs1_reg(idx_v*8+7 downto idx_v*8);
+      else
+        xperm8_res(i*8+7 downto i*8) <= (others => '0');
+      end if;
+    end loop;
+  end process xperm_core;
+
+
   -- Shifted-Add ----------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   shift_adder: process(rs1_reg, rs2_reg, ctrl_i)
@@ -339,9 +489,10 @@ begin
   res_int(op_sext_c)(15 downto 8)      <= rs1_reg(15 downto 8)    when (ctrl_i.ir_funct12(0) = '1') else (others => rs1_reg(7));
   res_int(op_sext_c)(07 downto 0)      <= rs1_reg(07 downto 0);
 
-  -- zero-extension --
-  res_int(op_zexth_c)(XLEN-1 downto 16) <= (others => '0');
-  res_int(op_zexth_c)(15 downto 0)      <= rs1_reg(15 downto 0);
+  -- zero-extension / pack (zext.h = pack rd, rs1, x0) --
+  res_int(op_zexth_c)(XLEN-1 downto 16) <= (others => '0')      when (ctrl_i.ir_funct3(0) = '1') else rs2_reg(15 downto 0);
+  res_int(op_zexth_c)(15 downto 8)      <= rs2_reg(7 downto 0)  when (ctrl_i.ir_funct3(0) = '1') else rs1_reg(15 downto 8); -- packh / pack
+  res_int(op_zexth_c)(07 downto 0)      <= rs1_reg(7 downto 0);
 
   -- rotate right/left --
   res_int(op_rot_c) <= shifter.sreg;
@@ -352,8 +503,26 @@ begin
     res_int(op_orcb_c)(i*8+7 downto i*8) <= (others => or_reduce_f(rs1_reg(i*8+7 downto i*8)));
   end generate; -- i
 
-  -- reversal.8 (byte swap) --
-  res_int(op_rev8_c) <= bswap_f(rs1_reg);
+  -- reversal.8 (byte swap) / bit-reverse in each byte --
+  res_int(op_rev8_c) <= bswap_f(rs1_reg) when (ctrl_i.ir_funct12(0) = '0') else bswap_f(bit_rev_f(rs1_reg)); -- rev8 / brev8
+
+  -- bit interleaving --
+  bit_interleave_gen:
+  for i in 0 to (XLEN/2)-1 generate
+    zip_res(2*i)          <= rs1_reg(i);
+    zip_res(2*i+1)        <= rs1_reg(i+XLEN/2);
+    unzip_res(i)          <= rs1_reg(2*i);
+    unzip_res(i+XLEN/2)   <= rs1_reg(2*i+1);
+  end generate;
+  res_int(op_zip_c) <= zip_res when (ctrl_i.ir_funct3(2) = '0') else unzip_res; -- zip / unzip
+
+  -- carry-less multiplication --
+  res_int(op_clmul_c) <= clmul.prod(XLEN-1 downto 0)        when (ctrl_i.ir_funct3(1) = '0') else -- clmul
+                         clmul.prod(2*XLEN-2 downto XLEN-1) when (ctrl_i.ir_funct3(0) = '0') else -- clmulr
+                         clmul.prod(2*XLEN-1 downto XLEN); -- clmulh
+
+  -- crossbar permutations --
+  res_int(op_xperm_c) <= xperm4_res when (ctrl_i.ir_funct3(2) = '0') else xperm8_res;
 
   -- address generation instructions --
   res_int(op_shadd_c) <= adder_res;
@@ -384,6 +553,9 @@ begin
   res_out(op_bext_c)  <= res_int(op_bext_c)  when (cmd(op_bext_c)  = '1') else (others => '0');
   res_out(op_binv_c)  <= res_int(op_binv_c)  when (cmd(op_binv_c)  = '1') else (others => '0');
   res_out(op_bset_c)  <= res_int(op_bset_c)  when (cmd(op_bset_c)  = '1') else (others => '0');
+  res_out(op_zip_c)   <= res_int(op_zip_c)   when (cmd(op_zip_c)   = '1') else (others => '0');
+  res_out(op_clmul_c) <= res_int(op_clmul_c) when (cmd(op_clmul_c) = '1') else (others => '0');
+  res_out(op_xperm_c) <= res_int(op_xperm_c) when (cmd(op_xperm_c) = '1') else (others => '0');
 
 
   -- Output Gate ----------------------------------------------------------------------------
@@ -398,7 +570,8 @@ begin
         res_o <= res_out(op_andn_c) or res_out(op_orn_c)  or res_out(op_xnor_c) or res_out(op_cz_c)    or
                  res_out(op_cpop_c) or res_out(op_max_c)  or res_out(op_sext_c) or res_out(op_zexth_c) or
                  res_out(op_rot_c)  or res_out(op_orcb_c) or res_out(op_rev8_c) or res_out(op_shadd_c) or
-                 res_out(op_bclr_c) or res_out(op_bext_c) or res_out(op_binv_c) or res_out(op_bset_c);
+                 res_out(op_bclr_c) or res_out(op_bext_c) or res_out(op_binv_c) or res_out(op_bset_c)  or
+                 res_out(op_zip_c)  or res_out(op_clmul_c) or res_out(op_xperm_c);
       end if;
     end if;
   end process output_gate;
@@ -0,0 +1,267 @@
+-- ================================================================================ --
+-- NEORV32 CPU - Co-Processor: Scalar Cryptography Unit (RISC-V "Zk*" Extensions)   --
+-- -------------------------------------------------------------------------------- --
+-- RISC-V NIST suite scalar cryptography instructions (RV32):                       --
+--  Zkne: AES encryption (aes32esi, aes32esmi)                                      --
+--  Zknd: AES decryption (aes32dsi, aes32dsmi)                                      --
+--  Zknh: SHA-256 and SHA-512 hash functions (sha256*, sha512*)                     --
+-- The bit-manipulation parts of the suite (Zbkb, Zbkc, Zbkx) are implemented by    --
+-- the bit-manipulation co-processor.                                               --
+-- -------------------------------------------------------------------------------- --
+-- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
+-- Copyright (c) NEORV32 contributors.                                              --
+-- Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  --
+-- Licensed under the BSD-3-Clause license, see LICENSE for details.                --
+-- SPDX-License-Identifier: BSD-3-Clause                                            --
+-- ================================================================================ --
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_cpu_cp_crypto is
+  generic (
+    ZKND_EN : boolean; -- implement AES decryption instructions
+    ZKNE_EN : boolean; -- implement AES encryption instructions
+    ZKNH_EN : boolean  -- implement SHA-256/512 hash function instructions
+  );
+  port (
+    -- global control --
+    clk_i   : in  std_ulogic; -- global clock, rising edge
+    rstn_i  : in  std_ulogic; -- global reset, low-active, async
+    ctrl_i  : in  ctrl_bus_t; -- main control bus
+    start_i : in  std_ulogic; -- trigger operation
+    -- data input --
+    rs1_i   : in  std_ulogic_vector(XLEN-1 downto 0); -- rf source 1
+    rs2_i   : in  std_ulogic_vector(XLEN-1 downto 0); -- rf source 2
+    -- result and status --
+    res_o   : out std_ulogic_vector(XLEN-1 downto 0); -- operation result
+    valid_o : out std_ulogic -- data output valid
+  );
+end neorv32_cpu_cp_crypto;
+
+architecture neorv32_cpu_cp_crypto_rtl of neorv32_cpu_cp_crypto is
+
+  -- AES substitution boxes --
+  type sbox_t is array (0 to 255) of std_ulogic_vector(7 downto 0);
+  constant aes_fwd_sbox_c : sbox_t := (
+    x"63", x"7c", x"77", x"7b", x"f2", x"6b", x"6f", x"c5", x"30", x"01", x"67", x"2b", x"fe", x"d7", x"ab", x"76",
+    x"ca", x"82", x"c9", x"7d", x"fa", x"59", x"47", x"f0", x"ad", x"d4", x"a2", x"af", x"9c", x"a4", x"72", x"c0",
+    x"b7", x"fd", x"93", x"26", x"36", x"3f", x"f7", x"cc", x"34", x"a5", x"e5", x"f1", x"71", x"d8", x"31", x"15",
+    x"04", x"c7", x"23", x"c3", x"18", x"96", x"05", x"9a", x"07", x"12", x"80", x"e2", x"eb", x"27", x"b2", x"75",
+    x"09", x"83", x"2c", x"1a", x"1b", x"6e", x"5a", x"a0", x"52", x"3b", x"d6", x"b3", x"29", x"e3", x"2f", x"84",
+    x"53", x"d1", x"00", x"ed", x"20", x"fc", x"b1", x"5b", x"6a", x"cb", x"be", x"39", x"4a", x"4c", x"58", x"cf",
+    x"d0", x"ef", x"aa", x"fb", x"43", x"4d", x"33", x"85", x"45", x"f9", x"02", x"7f", x"50", x"3c", x"9f", x"a8",
+    x"51", x"a3", x"40", x"8f", x"92", x"9d", x"38", x"f5", x"bc", x"b6", x"da", x"21", x"10", x"ff", x"f3", x"d2",
+    x"cd", x"0c", x"13", x"ec", x"5f", x"97", x"44", x"17", x"c4", x"a7", x"7e", x"3d", x"64", x"5d", x"19", x"73",
+    x"60", x"81", x"4f", x"dc", x"22", x"2a", x"90", x"88", x"46", x"ee", x"b8", x"14", x"de", x"5e", x"0b", x"db",
+    x"e0", x"32", x"3a", x"0a", x"49", x"06", x"24", x"5c", x"c2", x"d3", x"ac", x"62", x"91", x"95", x"e4", x"79",
+    x"e7", x"c8", x"37", x"6d", x"8d", x"d5", x"4e", x"a9", x"6c", x"56", x"f4", x"ea", x"65", x"7a", x"ae", x"08",
+    x"ba", x"78", x"25", x"2e", x"1c", x"a6", x"b4", x"c6", x"e8", x"dd", x"74", x"1f", x"4b", x"bd", x"8b", x"8a",
+    x"70", x"3e", x"b5", x"66", x"48", x"03", x"f6", x"0e", x"61", x"35", x"57", x"b9", x"86", x"c1", x"1d", x"9e",
+    x"e1", x"f8", x"98", x"11", x"69", x"d9", x"8e", x"94", x"9b", x"1e", x"87", x"e9", x"ce", x"55", x"28", x"df",
+    x"8c", x"a1", x"89", x"0d", x"bf", x"e6", x"42", x"68", x"41", x"99", x"2d", x"0f", x"b0", x"54", x"bb", x"16"
+  );
+  constant aes_inv_sbox_c : sbox_t := (
+    x"52", x"09", x"6a", x"d5", x"30", x"36", x"a5", x"38", x"bf", x"40", x"a3", x"9e", x"81", x"f3", x"d7", x"fb",
+    x"7c", x"e3", x"39", x"82", x"9b", x"2f", x"ff", x"87", x"34", x"8e", x"43", x"44", x"c4", x"de", x"e9", x"cb",
+    x"54", x"7b", x"94", x"32", x"a6", x"c2", x"23", x"3d", x"ee", x"4c", x"95", x"0b", x"42", x"fa", x"c3", x"4e",
+    x"08", x"2e", x"a1", x"66", x"28", x"d9", x"24", x"b2", x"76", x"5b", x"a2", x"49", x"6d", x"8b", x"d1", x"25",
+    x"72", x"f8", x"f6", x"64", x"86", x"68", x"98", x"16", x"d4", x"a4", x"5c", x"cc", x"5d", x"65", x"b6", x"92",
+    x"6c", x"70", x"48", x"50", x"fd", x"ed", x"b9", x"da", x"5e", x"15", x"46", x"57", x"a7", x"8d", x"9d", x"84",
+    x"90", x"d8", x"ab", x"00", x"8c", x"bc", x"d3", x"0a", x"f7", x"e4", x"58", x"05", x"b8", x"b3", x"45", x"06",
+    x"d0", x"2c", x"1e", x"8f", x"ca", x"3f", x"0f", x"02", x"c1", x"af", x"bd", x"03", x"01", x"13", x"8a", x"6b",
+    x"3a", x"91", x"11", x"41", x"4f", x"67", x"dc", x"ea", x"97", x"f2", x"cf", x"ce", x"f0", x"b4", x"e6", x"73",
+    x"96", x"ac", x"74", x"22", x"e7", x"ad", x"35", x"85", x"e2", x"f9", x"37", x"e8", x"1c", x"75", x"df", x"6e",
+    x"47", x"f1", x"1a", x"71", x"1d", x"29", x"c5", x"89", x"6f", x"b7", x"62", x"0e", x"aa", x"18", x"be", x"1b",
+    x"fc", x"56", x"3e", x"4b", x"c6", x"d2", x"79", x"20", x"9a", x"db", x"c0", x"fe", x"78", x"cd", x"5a", x"f4",
+    x"1f", x"dd", x"a8", x"33", x"88", x"07", x"c7", x"31", x"b1", x"12", x"10", x"59", x"27", x"80", x"ec", x"5f",
+    x"60", x"51", x"7f", x"a9", x"19", x"b5", x"4a", x"0d", x"2d", x"e5", x"7a", x"9f", x"93", x"c9", x"9c", x"ef",
+    x"a0", x"e0", x"3b", x"4d", x"ae", x"2a", x"f5", x"b0", x"c8", x"eb", x"bb", x"3c", x"83", x"53", x"99", x"61",
+    x"17", x"2b", x"04", x"7e", x"ba", x"77", x"d6", x"26", x"e1", x"69", x"14", x"63", x"55", x"21", x"0c", x"7d"
+  );
+
+  -- GF(2^8) multiply by x (modulo x^8 + x^4 + x^3 + x + 1) --
+  function xtime_f(a : std_ulogic_vector(7 downto 0)) return std_ulogic_vector is
+  begin
+    if (a(7) = '1') then
+      return (a(6 downto 0) & '0') xor x"1b";
+    else
+      return (a(6 downto 0) & '0');
+    end if;
+  end function xtime_f;
+
+  -- rotate right / shift right / shift left --
+  function ror_f(a : std_ulogic_vector(31 downto 0); n : natural) return std_ulogic_vector is
+  begin
+    return a(n-1 downto 0) & a(31 downto n);
+  end function ror_f;
+
+  function srl_f(a : std_ulogic_vector(31 downto 0); n : natural) return std_ulogic_vector is
+    variable tmp_v : std_ulogic_vector(31 downto 0);
+  begin
+    tmp_v := (others => '0');
+    tmp_v(31-n downto 0) := a(31 downto n);
+    return tmp_v;
+  end function srl_f;
+
+  function sll_f(a : std_ulogic_vector(31 downto 0); n : natural) return std_ulogic_vector is
+    variable tmp_v : std_ulogic_vector(31 downto 0);
+  begin
+    tmp_v := (others => '0');
+    tmp_v(31 downto n) := a(31-n downto 0);
+    return tmp_v;
+  end function sll_f;
+
+  -- operand buffers --
+  signal rs1_reg, rs2_reg : std_ulogic_vector(XLEN-1 downto 0);
+  signal valid            : std_ulogic;
+
+  -- AES datapath --
+  signal aes_in, aes_so, aes_x2, aes_x4, aes_x8 : std_ulogic_vector(7 downto 0);
+  signal aes_mix, aes_rot, aes_res              : std_ulogic_vector(XLEN-1 downto 0);
+
+  -- SHA datapath --
+  signal sha256_res, sha512_res : std_ulogic_vector(XLEN-1 downto 0);
+
+  -- operation select --
+  signal is_aes, is_sha256 : std_ulogic;
+
+begin
+
+  -- Operand Buffers ------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  operand_buffer: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      rs1_reg <= (others => '0');
+      rs2_reg <= (others => '0');
+      valid   <= '0';
+    elsif rising_edge(clk_i) then
+      if (start_i = '1') then
+        rs1_reg <= rs1_i;
+        rs2_reg <= rs2_i;
+      end if;
+      valid <= start_i;
+    end if;
+  end process operand_buffer;
+
+  -- Instruction Decoding --
+  -- A more general decoding as well as a valid-instruction-check is performed by the CPU control unit.
+  is_aes    <= '1' when (ctrl_i.ir_opcode(5) = '1') and (ctrl_i.ir_funct12(9 downto 8) = "10") else '0'; -- aes32*
+  is_sha256 <= '1' when (ctrl_i.ir_opcode(5) = '0') else '0'; -- sha256* (immediate-type encoding)
+
+
+  -- AES Rounds (Zkne / Zknd) ---------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  aes_enabled:
+  if ZKNE_EN or ZKND_EN generate
+
+    -- byte select (bs = funct7[6:5]) --
+    with ctrl_i.ir_funct12(11 downto 10) select aes_in <=
+      rs2_reg(31 downto 24) when "11",
+      rs2_reg(23 downto 16) when "10",
+      rs2_reg(15 downto 08) when "01",
+      rs2_reg(07 downto 00) when others;
+
+    -- forward/inverse S-box --
+    aes_so <= aes_inv_sbox_c(to_integer(unsigned(aes_in))) when ZKND_EN and ((not ZKNE_EN) or (ctrl_i.ir_funct12(7) = '1')) else
+              aes_fwd_sbox_c(to_integer(unsigned(aes_in)));
+
+    -- partial MixColumns / InvMixColumns: one column of the (inverse) MDS matrix --
+    aes_x2 <= xtime_f(aes_so);
+    aes_x4 <= xtime_f(aes_x2);
+    aes_x8 <= xtime_f(aes_x4);
+    aes_mix_sel: process(ctrl_i, aes_so, aes_x2, aes_x4, aes_x8)
+    begin
+      if (ctrl_i.ir_funct12(6) = '0') then -- aes32esi / aes32dsi: substitution only
+        aes_mix <= x"000000" & aes_so;
+      elsif (ctrl_i.ir_funct12(7) = '0') then -- aes32esmi: {3, 1, 1, 2} * so
+        aes_mix <= (aes_x2 xor aes_so) & aes_so & aes_so & aes_x2;
+      else -- aes32dsmi: {b, d, 9, e} * so
+        aes_mix <= (aes_x8 xor aes_x2 xor aes_so) & (aes_x8 xor aes_x4 xor aes_so) &
+                   (aes_x8 xor aes_so) & (aes_x8 xor aes_x4 xor aes_x2);
+      end if;
+    end process aes_mix_sel;
+
+    -- rotate into byte position and accumulate --
+    with ctrl_i.ir_funct12(11 downto 10) select aes_rot <=
+      aes_mix(07 downto 0) & aes_mix(31 downto 08) when "11",
+      aes_mix(15 downto 0) & aes_mix(31 downto 16) when "10",
+      aes_mix(23 downto 0) & aes_mix(31 downto 24) when "01",
+      aes_mix                                      when others;
+    aes_res <= rs1_reg xor aes_rot;
+
+  end generate;
+
+  aes_disabled:
+  if (not ZKNE_EN) and (not ZKND_EN) generate
+    aes_in  <= (others => '0');
+    aes_so  <= (others => '0');
+    aes_x2  <= (others => '0');
+    aes_x4  <= (others => '0');
+    aes_x8  <= (others => '0');
+    aes_mix <= (others => '0');
+    aes_rot <= (others => '0');
+    aes_res <= (others => '0');
+  end generate;
+
+
+  -- SHA-2 Sigma Functions (Zknh) -----------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  sha_enabled:
+  if ZKNH_EN generate
+
+    -- SHA-256: sum0, sum1, sig0, sig1 --
+    with ctrl_i.ir_funct12(1 downto 0) select sha256_res <=
+      ror_f(rs1_reg,  2) xor ror_f(rs1_reg, 13) xor ror_f(rs1_reg, 22) when "00",
+      ror_f(rs1_reg,  6) xor ror_f(rs1_reg, 11) xor ror_f(rs1_reg, 25) when "01",
+      ror_f(rs1_reg,  7) xor ror_f(rs1_reg, 18) xor srl_f(rs1_reg,  3) when "10",
+      ror_f(rs1_reg, 17) xor ror_f(rs1_reg, 19) xor srl_f(rs1_reg, 10) when others;
+
+    -- SHA-512 (RV32: 64-bit operand split into rs1 / rs2 halves): sum0r, sum1r, sig0l, sig1l, sig0h, sig1h --
+    with ctrl_i.ir_funct12(7 downto 5) select sha512_res <=
+      sll_f(rs1_reg, 25) xor sll_f(rs1_reg, 30) xor srl_f(rs1_reg, 28) xor srl_f(rs2_reg,  7) xor srl_f(rs2_reg,  2) xor sll_f(rs2_reg,  4) when "000",
+      sll_f(rs1_reg, 23) xor srl_f(rs1_reg, 14) xor srl_f(rs1_reg, 18) xor srl_f(rs2_reg,  9) xor sll_f(rs2_reg, 18) xor sll_f(rs2_reg, 14) when "001",
+      srl_f(rs1_reg,  1) xor srl_f(rs1_reg,  7) xor srl_f(rs1_reg,  8) xor sll_f(rs2_reg, 31) xor sll_f(rs2_reg, 25) xor sll_f(rs2_reg, 24) when "010",
+      sll_f(rs1_reg,  3) xor srl_f(rs1_reg,  6) xor srl_f(rs1_reg, 19) xor srl_f(rs2_reg, 29) xor sll_f(rs2_reg, 26) xor sll_f(rs2_reg, 13) when "011",
+      srl_f(rs1_reg,  1) xor srl_f(rs1_reg,  7) xor srl_f(rs1_reg,  8) xor sll_f(rs2_reg, 31) xor sll_f(rs2_reg, 24)                         when "110",
+      sll_f(rs1_reg,  3) xor srl_f(rs1_reg,  6) xor srl_f(rs1_reg, 19) xor srl_f(rs2_reg, 29) xor sll_f(rs2_reg, 13)                         when others;
+
+  end generate;
+
+  sha_disabled:
+  if not ZKNH_EN generate
+    sha256_res <= (others => '0');
+    sha512_res <= (others => '0');
+  end generate;
+
+
+  -- Output Gate ----------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  output_gate: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      res_o <= (others => '0');
+    elsif rising_edge(clk_i) then
+      res_o <= (others => '0'); -- default
+      if (valid = '1') then
+        if (is_sha256 = '1') then
+          res_o <= sha256_res;
+        elsif (is_aes = '1') then
+          res_o <= aes_res;
+        else
+          res_o <= sha512_res;
+        end if;
+      end if;
+    end if;
+  end process output_gate;
+
+  -- valid output --
+  valid_o <= valid;
+
+
+end neorv32_cpu_cp_crypto_rtl;
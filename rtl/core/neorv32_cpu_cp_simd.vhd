@@ -0,0 +1,232 @@
+-- ================================================================================ --
+-- NEORV32 CPU - Co-Processor: Packed-SIMD DSP Unit (NEORV32 "Zxpsimd" Extension)   --
+-- -------------------------------------------------------------------------------- --
+-- Subset of the (draft) RISC-V "P" extension using its OP-P encodings:             --
+--  2x16-bit / 4x8-bit add/sub: wrap-around, halving (signed/unsigned) and          --
+--  saturating (signed/unsigned) - [UR|R|UK|K]ADD/SUB16/8, ADD/SUB16/8              --
+--  2x16-bit dot-product: kmda (rd = sat(sum)), kmada (rd = sat(rd + sum))          --
+--  4x8-bit dot-product:  smaqa / umaqa (rd = rd + sum)                             --
+-- The accumulator (rd) is read via the register file's 3rd read port (rs3_i).      --
+-- -------------------------------------------------------------------------------- --
+-- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
+-- Copyright (c) NEORV32 contributors.                                              --
+-- Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  --
+-- Licensed under the BSD-3-Clause license, see LICENSE for details.                --
+-- SPDX-License-Identifier: BSD-3-Clause                                            --
+-- ================================================================================ --
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_cpu_cp_simd is
+  port (
+    -- global control --
+    clk_i   : in  std_ulogic; -- global clock, rising edge
+    rstn_i  : in  std_ulogic; -- global reset, low-active, async
+    ctrl_i  : in  ctrl_bus_t; -- main control bus
+    start_i : in  std_ulogic; -- trigger operation
+    -- data input --
+    rs1_i   : in  std_ulogic_vector(XLEN-1 downto 0); -- rf source 1
+    rs2_i   : in  std_ulogic_vector(XLEN-1 downto 0); -- rf source 2
+    rs3_i   : in  std_ulogic_vector(XLEN-1 downto 0); -- rf source 3 (accumulator = rd)
+    -- result and status --
+    res_o   : out std_ulogic_vector(XLEN-1 downto 0); -- operation result
+    valid_o : out std_ulogic -- data output valid
+  );
+end neorv32_cpu_cp_simd;
+
+architecture neorv32_cpu_cp_simd_rtl of neorv32_cpu_cp_simd is
+
+  -- instruction decoding --
+  signal is_mac  : std_ulogic; -- dot-product (two-stage)
+  signal is_quad : std_ulogic; -- 4x8-bit dot-product (smaqa/umaqa)
+  signal is_uns  : std_ulogic; -- unsigned 4x8-bit dot-product (umaqa)
+  signal is_acc  : std_ulogic; -- 2x16-bit dot-product accumulates rd (kmada)
+
+  -- operand buffers --
+  signal rs1_reg, rs2_reg, acc_reg : std_ulogic_vector(XLEN-1 downto 0);
+  signal mul_run, valid : std_ulogic;
+
+  -- multipliers --
+  type mul8_t  is array (0 to 3) of signed(17 downto 0);
+  type mul16_t is array (0 to 1) of signed(31 downto 0);
+  signal mul8  : mul8_t;
+  signal mul16 : mul16_t;
+
+  -- results --
+  signal lane_res, mac_res : std_ulogic_vector(XLEN-1 downto 0);
+
+  -- Q31 saturation limits --
+  constant sat_max_c : signed(XLEN+1 downto 0) := to_signed(2**(XLEN-2), XLEN+2) + to_signed(2**(XLEN-2)-1, XLEN+2);
+  constant sat_min_c : signed(XLEN+1 downto 0) := -sat_max_c - 1;
+
+  -- Single-lane addition/subtraction --
+  -- mode: "00" = signed halving, "01" = signed saturating, "10" = unsigned halving, "11" = unsigned saturating
+  function lane_f(a, b : std_ulogic_vector; sub, wrap : std_ulogic; mode : std_ulogic_vector(1 downto 0)) return std_ulogic_vector is
+    constant w_c : natural := a'length;
+    variable a_v, b_v : std_ulogic_vector(w_c-1 downto 0);
+    variable x_v, y_v, s_v : unsigned(w_c downto 0); -- one guard bit
+    variable res_v : std_ulogic_vector(w_c-1 downto 0);
+  begin
+    a_v := a;
+    b_v := b;
+    -- sign/zero extension --
+    if (mode(1) = '0') then
+      x_v := unsigned(a_v(w_c-1) & a_v);
+      y_v := unsigned(b_v(w_c-1) & b_v);
+    else
+      x_v := unsigned('0' & a_v);
+      y_v := unsigned('0' & b_v);
+    end if;
+    -- exact (w+1)-bit sum/difference --
+    if (sub = '1') then
+      s_v := x_v - y_v;
+    else
+      s_v := x_v + y_v;
+    end if;
+    -- result --
+    if (wrap = '1') then -- wrap-around
+      res_v := std_ulogic_vector(s_v(w_c-1 downto 0));
+    elsif (mode(0) = '0') then -- halving
+      res_v := std_ulogic_vector(s_v(w_c downto 1));
+    elsif (mode(1) = '0') then -- signed saturation
+      if (s_v(w_c) /= s_v(w_c-1)) then
+        res_v := (others => not s_v(w_c));
+        res_v(w_c-1) := s_v(w_c);
+      else
+        res_v := std_ulogic_vector(s_v(w_c-1 downto 0));
+      end if;
+    else -- unsigned saturation
+      if (s_v(w_c) = '1') then
+        res_v := (others => not sub); -- overflow: all-ones; underflow: zero
+      else
+        res_v := std_ulogic_vector(s_v(w_c-1 downto 0));
+      end if;
+    end if;
+    return res_v;
+  end function lane_f;
+
+begin
+
+  -- Instruction Decoding -------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- A more general decoding as well as a valid-instruction-check is performed by the CPU control unit.
+  is_mac  <= '1' when (ctrl_i.ir_funct12(11) = '1') or (ctrl_i.ir_funct3(0) = '1') else '0'; -- smaqa/umaqa or kmda/kmada
+  is_quad <= ctrl_i.ir_funct12(11); -- funct7 = 11001x0
+  is_uns  <= ctrl_i.ir_funct12(6);  -- funct7 = 1100110
+  is_acc  <= ctrl_i.ir_funct12(10); -- funct7 = 0100100 (kmada) / 0011100 (kmda)
+
+
+  -- Operand Buffer and Control -------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  operand_buffer: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      rs1_reg <= (others => '0');
+      rs2_reg <= (others => '0');
+      acc_reg <= (others => '0');
+      mul_run <= '0';
+      valid   <= '0';
+    elsif rising_edge(clk_i) then
+      if (start_i = '1') then
+        rs1_reg <= rs1_i;
+        rs2_reg <= rs2_i;
+        acc_reg <= rs3_i;
+      end if;
+      mul_run <= start_i and is_mac; -- dot-products need one additional cycle
+      valid   <= (start_i and (not is_mac)) or mul_run;
+    end if;
+  end process operand_buffer;
+
+
+  -- Packed Addition/Subtraction ------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  lane_core: process(ctrl_i, rs1_reg, rs2_reg)
+  begin
+    -- funct7: [6] = 0, [5] = wrap-around, [4:3] = mode, [2] = 8-bit lanes, [1] = 0, [0] = subtract --
+    if (ctrl_i.ir_funct12(7) = '1') then -- 4x8-bit
+      for i in 0 to 3 loop
+        lane_res(i*8+7 downto i*8) <= lane_f(rs1_reg(i*8+7 downto i*8), rs2_reg(i*8+7 downto i*8),
+                                             ctrl_i.ir_funct12(5), ctrl_i.ir_funct12(10), ctrl_i.ir_funct12(9 downto 8));
+      end loop;
+    else -- 2x16-bit
+      for i in 0 to 1 loop
+        lane_res(i*16+15 downto i*16) <= lane_f(rs1_reg(i*16+15 downto i*16), rs2_reg(i*16+15 downto i*16),
+                                                ctrl_i.ir_funct12(5), ctrl_i.ir_funct12(10), ctrl_i.ir_funct12(9 downto 8));
+      end loop;
+    end if;
+  end process lane_core;
+
+
+  -- Dot-Product Multipliers (first stage) --------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  multiplier: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      mul8  <= (others => (others => '0'));
+      mul16 <= (others => (others => '0'));
+    elsif rising_edge(clk_i) then
+      for i in 0 to 3 loop -- 4x (9x9)-bit: signed or unsigned 8-bit operands
+        mul8(i) <= signed((rs1_reg(i*8+7) and (not is_uns)) & rs1_reg(i*8+7 downto i*8)) *
+                   signed((rs2_reg(i*8+7) and (not is_uns)) & rs2_reg(i*8+7 downto i*8));
+      end loop;
+      for i in 0 to 1 loop -- 2x (16x16)-bit signed
+        mul16(i) <= signed(rs1_reg(i*16+15 downto i*16)) * signed(rs2_reg(i*16+15 downto i*16));
+      end loop;
+    end if;
+  end process multiplier;
+
+
+  -- Dot-Product Accumulation (second stage) ------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  accumulator: process(is_quad, is_acc, mul8, mul16, acc_reg)
+    variable quad_v : signed(XLEN-1 downto 0);
+    variable dual_v : signed(XLEN+1 downto 0);
+  begin
+    -- smaqa/umaqa: wrap-around --
+    quad_v := signed(acc_reg) + resize(mul8(0), XLEN) + resize(mul8(1), XLEN) + resize(mul8(2), XLEN) + resize(mul8(3), XLEN);
+    -- kmda/kmada: Q31 saturation --
+    dual_v := resize(mul16(0), XLEN+2) + resize(mul16(1), XLEN+2);
+    if (is_acc = '1') then
+      dual_v := dual_v + resize(signed(acc_reg), XLEN+2);
+    end if;
+    -- result select --
+    if (is_quad = '1') then
+      mac_res <= std_ulogic_vector(quad_v);
+    elsif (dual_v > sat_max_c) then
+      mac_res <= std_ulogic_vector(sat_max_c(XLEN-1 downto 0));
+    elsif (dual_v < sat_min_c) then
+      mac_res <= std_ulogic_vector(sat_min_c(XLEN-1 downto 0));
+    else
+      mac_res <= std_ulogic_vector(dual_v(XLEN-1 downto 0));
+    end if;
+  end process accumulator;
+
+
+  -- Output Gate ----------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  output_gate: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      res_o <= (others => '0');
+    elsif rising_edge(clk_i) then
+      res_o <= (others => '0'); -- default
+      if (valid = '1') then
+        if (is_mac = '1') then
+          res_o <= mac_res;
+        else
+          res_o <= lane_res;
+        end if;
+      end if;
+    end if;
+  end process output_gate;
+
+  -- valid output --
+  valid_o <= valid;
+
+
+end neorv32_cpu_cp_simd_rtl;
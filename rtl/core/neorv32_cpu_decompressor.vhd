@@ -3,6 +3,10 @@
 -- -------------------------------------------------------------------------------- --
 -- Compressed instructions decoder compatible to the RISC-V C ISA extension.        --
 -- Illegal compressed instructions are output "as-is" but zero-extended.            --
+-- Optional support for the Zcb (additional simple 16-bit instructions) and Zcmp    --
+-- (push/pop and register-move) code-size extensions. Zcmp instructions are split   --
+-- into a sequence of plain 32-bit micro-ops: the micro-op index is provided by     --
+-- the issue engine via ci_uop_i and ci_more_o signals that more micro-ops follow.  --
 -- -------------------------------------------------------------------------------- --
 -- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
 -- Copyright (c) NEORV32 contributors.                                              --
@@ -19,9 +23,15 @@ library neorv32;
 use neorv32.neorv32_package.all;
 
 entity neorv32_cpu_decompressor is
+  generic (
+    ZCB_EN  : boolean := false; -- implement Zcb additional simple instructions
+    ZCMP_EN : boolean := false  -- implement Zcmp push/pop and register-move instructions
+  );
   port (
     ci_instr16_i : in  std_ulogic_vector(15 downto 0); -- compressed instruction
-    ci_instr32_o : out std_ulogic_vector(31 downto 0)  -- decompressed instruction
+    ci_uop_i     : in  std_ulogic_vector(03 downto 0); -- micro-op index (Zcmp only)
+    ci_instr32_o : out std_ulogic_vector(31 downto 0); -- decompressed instruction
+    ci_more_o    : out std_ulogic                      -- more micro-ops following (Zcmp only)
   );
 end neorv32_cpu_decompressor;
 
@@ -52,6 +62,23 @@ architecture neorv32_cpu_decompressor_rtl of neorv32_cpu_decompressor is
   -- intermediates --
   signal illegal : std_ulogic;
   signal decoded : std_ulogic_vector(31 downto 0);
+  signal more    : std_ulogic;
+
+  -- Zcmp micro-op sequencer --
+  type cm_t is record
+    num     : unsigned(3 downto 0); -- number of registers in list
+    adj     : unsigned(6 downto 0); -- stack adjustment in bytes
+    idx     : unsigned(3 downto 0); -- current micro-op index
+    ofs     : unsigned(6 downto 0); -- offset of current register from the top of the frame
+    reg     : std_ulogic_vector(4 downto 0); -- register of current micro-op
+    sr1     : std_ulogic_vector(4 downto 0); -- r1s' (s0..s7)
+    sr2     : std_ulogic_vector(4 downto 0); -- r2s' (s0..s7)
+    imm_st  : std_ulogic_vector(11 downto 0); -- store offset: -ofs
+    imm_ld  : std_ulogic_vector(11 downto 0); -- load offset: adj - ofs
+    imm_dec : std_ulogic_vector(11 downto 0); -- stack pointer decrement: -adj
+    imm_inc : std_ulogic_vector(11 downto 0); -- stack pointer increment: +adj
+  end record;
+  signal cm : cm_t;
 
 begin
 
@@ -84,13 +111,54 @@ begin
   imm12(12 downto 08) <= (others => ci_instr16_i(12)); -- sign extension
 
 
+  -- Zcmp Register List and Stack Frame -----------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+
+  -- number of registers: {ra, s0-sN}; rlist = 15 also includes s10 and s11 --
+  cm.num <= x"d" when (ci_instr16_i(7 downto 4) = "1111") else (unsigned(ci_instr16_i(7 downto 4)) - 3);
+
+  -- 16-byte aligned stack adjustment: base frame + spimm * 16 --
+  cm_adj: process(ci_instr16_i)
+    variable base_v : unsigned(6 downto 0);
+  begin
+    case ci_instr16_i(7 downto 4) is
+      when "0100" | "0101" | "0110" | "0111" => base_v := to_unsigned(16, 7);
+      when "1000" | "1001" | "1010" | "1011" => base_v := to_unsigned(32, 7);
+      when "1111"                            => base_v := to_unsigned(64, 7);
+      when others                            => base_v := to_unsigned(48, 7);
+    end case;
+    cm.adj <= base_v + unsigned("0" & ci_instr16_i(3 downto 2) & "0000");
+  end process cm_adj;
+
+  -- the current micro-op handles list entry "idx"; registers are stored top-down below the old stack pointer --
+  cm.idx <= unsigned(ci_uop_i);
+  cm.ofs <= resize(cm.num - cm.idx, 5) & "00";
+
+  -- 12-bit immediates of the generated micro-ops --
+  cm.imm_st  <= std_ulogic_vector(0 - resize(cm.ofs, 12));
+  cm.imm_ld  <= std_ulogic_vector(resize(cm.adj - cm.ofs, 12));
+  cm.imm_dec <= std_ulogic_vector(0 - resize(cm.adj, 12));
+  cm.imm_inc <= std_ulogic_vector(resize(cm.adj, 12));
+
+  -- list entry to register: ra, s0, s1, s2..s11 (x18..x27) --
+  cm.reg <= "00001" when (cm.idx = 0) else
+            "01000" when (cm.idx = 1) else
+            "01001" when (cm.idx = 2) else
+            std_ulogic_vector(('0' & cm.idx) + 15);
+
+  -- sreg' to register: s0, s1, s2..s7 (x18..x23) --
+  cm.sr1 <= ("0100" & ci_instr16_i(7)) when (ci_instr16_i(9 downto 8) = "00") else ("10" & ci_instr16_i(9 downto 7));
+  cm.sr2 <= ("0100" & ci_instr16_i(2)) when (ci_instr16_i(4 downto 3) = "00") else ("10" & ci_instr16_i(4 downto 2));
+
+
   -- Compressed Instruction Decoder ---------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  decompressor: process(ci_instr16_i, imm20, imm12)
+  decompressor: process(ci_instr16_i, imm20, imm12, cm)
   begin
     -- defaults --
     illegal <= '0';
     decoded <= (others => '0');
+    more    <= '0';
 
     -- actual decoder --
     case ci_instr16_i(ci_opcode_msb_c downto ci_opcode_lsb_c) is
@@ -147,7 +215,40 @@ begin
             decoded(instr_rs1_msb_c downto instr_rs1_lsb_c)       <= "01" & ci_instr16_i(ci_rs1_3_msb_c downto ci_rs1_3_lsb_c); -- x8 - x15
             decoded(instr_rs2_msb_c downto instr_rs2_lsb_c)       <= "01" & ci_instr16_i(ci_rs2_3_msb_c downto ci_rs2_3_lsb_c); -- x8 - x15
 
-          when others => -- "011": C.FLW, "111": C.FSW, "001": C.FLS / C.LQ, "100": reserved, "101": C.FSD / C.SQ
+          when "100" => -- Zcb: C.LBU, C.LHU, C.LH, C.SB, C.SH
+          -- ----------------------------------------------------------------------------------------------------------
+            decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= "01" & ci_instr16_i(ci_rs1_3_msb_c downto ci_rs1_3_lsb_c); -- x8 - x15
+            if (ci_instr16_i(11) = '0') then -- loads
+              decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_load_c;
+              decoded(instr_rd_msb_c downto instr_rd_lsb_c)         <= "01" & ci_instr16_i(ci_rd_3_msb_c downto ci_rd_3_lsb_c); -- x8 - x15
+              decoded(instr_imm12_lsb_c + 1)                        <= ci_instr16_i(5);
+              if (ci_instr16_i(10) = '0') then -- C.LBU
+                decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_lbu_c;
+                decoded(instr_imm12_lsb_c + 0)                        <= ci_instr16_i(6);
+              elsif (ci_instr16_i(6) = '0') then -- C.LHU
+                decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_lhu_c;
+              else -- C.LH
+                decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_lh_c;
+              end if;
+            else -- stores
+              decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_store_c;
+              decoded(instr_rs2_msb_c downto instr_rs2_lsb_c)       <= "01" & ci_instr16_i(ci_rs2_3_msb_c downto ci_rs2_3_lsb_c); -- x8 - x15
+              decoded(08)                                           <= ci_instr16_i(5);
+              if (ci_instr16_i(10) = '0') then -- C.SB
+                decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_sb_c;
+                decoded(07)                                           <= ci_instr16_i(6);
+              else -- C.SH
+                decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_sh_c;
+                if (ci_instr16_i(6) = '1') then -- reserved
+                  illegal <= '1';
+                end if;
+              end if;
+            end if;
+            if (not ZCB_EN) or (ci_instr16_i(12) = '1') then -- Zcb not implemented or reserved
+              illegal <= '1';
+            end if;
+
+          when others => -- "011": C.FLW, "111": C.FSW, "001": C.FLS / C.LQ, "101": C.FSD / C.SQ
           -- ----------------------------------------------------------------------------------------------------------
             illegal <= '1';
 
@@ -294,8 +395,37 @@ begin
                     decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_and_c;
                     decoded(instr_funct7_msb_c downto instr_funct7_lsb_c) <= "0000000";
                 end case;
-                if (ci_instr16_i(12) = '1') then -- reserved instruction space.
-                  illegal <= '1';
+                if (ci_instr16_i(12) = '1') then -- Zcb: C.MUL, C.ZEXT.B, C.SEXT.B, C.ZEXT.H, C.SEXT.H, C.NOT
+                  if (ci_instr16_i(6 downto 5) = "10") then -- C.MUL
+                    decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_subadd_c;
+                    decoded(instr_funct7_msb_c downto instr_funct7_lsb_c) <= "0000001";
+                  else -- unary operations
+                    decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_alui_c;
+                    case ci_instr16_i(4 downto 2) is
+                      when "000" => -- C.ZEXT.B -> andi rd, rd, 0xff
+                        decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_and_c;
+                        decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= x"0ff";
+                      when "001" => -- C.SEXT.B -> sext.b rd, rd (Zbb)
+                        decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_sll_c;
+                        decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= x"604";
+                      when "010" => -- C.ZEXT.H -> zext.h rd, rd (Zbb)
+                        decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_alu_c;
+                        decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_xor_c;
+                        decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= x"080";
+                      when "011" => -- C.SEXT.H -> sext.h rd, rd (Zbb)
+                        decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_sll_c;
+                        decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= x"605";
+                      when others => -- C.NOT -> xori rd, rd, -1
+                        decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_xor_c;
+                        decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= x"fff";
+                    end case;
+                    if (ci_instr16_i(6 downto 5) /= "11") or (ci_instr16_i(4 downto 2) = "100") or (ci_instr16_i(4 downto 3) = "11") then
+                      illegal <= '1'; -- reserved / RV64-only C.ZEXT.W
+                    end if;
+                  end if;
+                  if (not ZCB_EN) then -- Zcb not implemented
+                    illegal <= '1';
+                  end if;
                 end if;
             end case;
 
@@ -397,7 +527,84 @@ begin
               end if;
             end if;
 
-          when others => -- "001"/"101": C.FLDSP / C.LQSP, C.FSDSP / C.SQSP -> illegal
+          when "101" => -- Zcmp: CM.PUSH, CM.POP, CM.POPRET, CM.POPRETZ, CM.MVSA01, CM.MVA01S
+          -- ----------------------------------------------------------------------------------------------------------
+            decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_alui_c; -- default: addi
+            decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_subadd_c;
+            if (ci_instr16_i(12 downto 10) = "011") then -- CM.MVSA01 / CM.MVA01S: two register moves
+              if (cm.idx = 0) then
+                more <= '1';
+              end if;
+              if (ci_instr16_i(6 downto 5) = "01") then -- CM.MVSA01: r1s' <= a0; r2s' <= a1
+                if (cm.idx = 0) then
+                  decoded(instr_rd_msb_c downto instr_rd_lsb_c)   <= cm.sr1;
+                  decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= "01010"; -- a0
+                else
+                  decoded(instr_rd_msb_c downto instr_rd_lsb_c)   <= cm.sr2;
+                  decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= "01011"; -- a1
+                end if;
+                if (cm.sr1 = cm.sr2) then -- reserved
+                  illegal <= '1';
+                end if;
+              else -- CM.MVA01S: a0 <= r1s'; a1 <= r2s'
+                if (cm.idx = 0) then
+                  decoded(instr_rd_msb_c downto instr_rd_lsb_c)   <= "01010"; -- a0
+                  decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= cm.sr1;
+                else
+                  decoded(instr_rd_msb_c downto instr_rd_lsb_c)   <= "01011"; -- a1
+                  decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= cm.sr2;
+                end if;
+              end if;
+              if (ci_instr16_i(5) = '0') then -- reserved
+                illegal <= '1';
+              end if;
+            elsif (ci_instr16_i(12 downto 11) = "11") and (ci_instr16_i(8) = '0') then -- CM.PUSH / CM.POP*: register list
+              decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= "00010"; -- stack pointer
+              if (cm.idx < cm.num) then -- save/restore one register
+                more <= '1';
+                if (ci_instr16_i(10 downto 9) = "00") then -- CM.PUSH: sw reg, -ofs(sp)
+                  decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_store_c;
+                  decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_sw_c;
+                  decoded(instr_rs2_msb_c downto instr_rs2_lsb_c)       <= cm.reg;
+                  decoded(31 downto 25)                                 <= cm.imm_st(11 downto 5);
+                  decoded(11 downto 07)                                 <= cm.imm_st(04 downto 0);
+                else -- CM.POP*: lw reg, (adj-ofs)(sp)
+                  decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_load_c;
+                  decoded(instr_funct3_msb_c downto instr_funct3_lsb_c) <= funct3_lw_c;
+                  decoded(instr_rd_msb_c downto instr_rd_lsb_c)         <= cm.reg;
+                  decoded(instr_imm12_msb_c downto instr_imm12_lsb_c)   <= cm.imm_ld;
+                end if;
+              elsif (cm.idx = cm.num) and (ci_instr16_i(10 downto 9) = "10") then -- CM.POPRETZ: li a0, 0
+                more <= '1';
+                decoded(instr_rd_msb_c downto instr_rd_lsb_c)   <= "01010"; -- a0
+                decoded(instr_rs1_msb_c downto instr_rs1_lsb_c) <= "00000"; -- x0
+              elsif (cm.idx = cm.num) or ((cm.idx = (cm.num + 1)) and (ci_instr16_i(10 downto 9) = "10")) then -- addi sp, sp, +/-adj
+                decoded(instr_rd_msb_c downto instr_rd_lsb_c) <= "00010"; -- stack pointer
+                if (ci_instr16_i(10 downto 9) = "00") then -- CM.PUSH
+                  decoded(instr_imm12_msb_c downto instr_imm12_lsb_c) <= cm.imm_dec;
+                else -- CM.POP*
+                  decoded(instr_imm12_msb_c downto instr_imm12_lsb_c) <= cm.imm_inc;
+                end if;
+                if (ci_instr16_i(10) = '1') then -- CM.POPRET*: return follows
+                  more <= '1';
+                end if;
+              else -- CM.POPRET*: jalr x0, 0(ra)
+                decoded(instr_opcode_msb_c downto instr_opcode_lsb_c) <= opcode_jalr_c;
+                decoded(instr_rs1_msb_c downto instr_rs1_lsb_c)       <= "00001"; -- return address
+                decoded(instr_rd_msb_c downto instr_rd_lsb_c)         <= "00000"; -- discard
+              end if;
+              if (ci_instr16_i(7 downto 4) = "0000") or (ci_instr16_i(7 downto 4) = "0001") or
+                 (ci_instr16_i(7 downto 4) = "0010") or (ci_instr16_i(7 downto 4) = "0011") then -- rlist < 4 -> reserved
+                illegal <= '1';
+              end if;
+            else -- C.FSDSP / reserved
+              illegal <= '1';
+            end if;
+            if (not ZCMP_EN) then -- Zcmp not implemented
+              illegal <= '1';
+            end if;
+
+          when others => -- "001": C.FLDSP / C.LQSP -> illegal
           -- ----------------------------------------------------------------------------------------------------------
             illegal <= '1';
 
@@ -408,6 +615,7 @@ begin
 
   -- output original 16-bit instruction word if illegal instruction --
   ci_instr32_o <= (x"0000" & ci_instr16_i) when (illegal = '1') else decoded;
+  ci_more_o    <= more and (not illegal);
 
 
 end neorv32_cpu_decompressor_rtl;
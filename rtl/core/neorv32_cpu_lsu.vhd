@@ -17,7 +17,8 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_cpu_lsu is
   generic (
-    AMO_LRSC_ENABLE : boolean -- enable atomic LR/SC operations
+    AMO_LRSC_ENABLE : boolean; -- enable atomic LR/SC operations
+    CMO_ENABLE      : boolean  -- enable cache-block operations
   );
   port (
     -- global control --
@@ -47,9 +48,14 @@ architecture neorv32_cpu_lsu_rtl of neorv32_cpu_lsu is
   signal misaligned  : std_ulogic; -- misaligned address
   signal arbiter_req : std_ulogic; -- pending bus request
   signal arbiter_err : std_ulogic; -- access error
+  signal cmo_op      : std_ulogic; -- cache-block operation
 
 begin
 
+  -- cache-block operation (fence opcode, address-only access) --
+  cmo_op <= '1' when CMO_ENABLE and (ctrl_i.ir_opcode = opcode_fence_c) else '0';
+
+
   -- Access Address -------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   mem_addr_reg: process(rstn_i, clk_i)
@@ -60,11 +66,15 @@ begin
     elsif rising_edge(clk_i) then
       if (ctrl_i.lsu_mo_we = '1') then
         mar <= addr_i; -- memory address register
-        case ctrl_i.ir_funct3(1 downto 0) is -- alignment check
-          when "00"   => misaligned <= '0'; -- byte
-          when "01"   => misaligned <= addr_i(0); -- half-word
-          when others => misaligned <= addr_i(1) or addr_i(0); -- word
-        end case;
+        if (cmo_op = '1') then -- cache-block operations use any address within the block
+          misaligned <= '0';
+        else
+          case ctrl_i.ir_funct3(1 downto 0) is -- alignment check
+            when "00"   => misaligned <= '0'; -- byte
+            when "01"   => misaligned <= addr_i(0); -- half-word
+            when others => misaligned <= addr_i(1) or addr_i(0); -- word
+          end case;
+        end if;
       end if;
     end if;
   end process mem_addr_reg;
@@ -82,6 +92,7 @@ begin
       bus_req_o.rw   <= '0';
       bus_req_o.priv <= '0';
       bus_req_o.rvso <= '0';
+      bus_req_o.cmo  <= (others => '0');
     elsif rising_edge(clk_i) then
       if (ctrl_i.lsu_mo_we = '1') then
         -- read/write --
@@ -94,6 +105,14 @@ begin
         else
           bus_req_o.rvso <= '0';
         end if;
+        -- cache-block operation --
+        if (cmo_op = '1') then
+          bus_req_o.cmo(cmo_inval_c) <= not (ctrl_i.ir_funct12(2) or ctrl_i.ir_funct12(0)); -- cbo.inval, cbo.flush
+          bus_req_o.cmo(cmo_clean_c) <= ctrl_i.ir_funct12(1) or ctrl_i.ir_funct12(0); -- cbo.clean, cbo.flush
+          bus_req_o.cmo(cmo_zero_c)  <= ctrl_i.ir_funct12(2); -- cbo.zero
+        else
+          bus_req_o.cmo <= (others => '0');
+        end if;
       end if;
     end if;
   end process mem_type_reg;
@@ -130,7 +149,7 @@ begin
             else
               bus_req_o.ben <= "1100"; -- high half-word
             end if;
-          when others => -- word
+          when others => -- word (or cache-block operation)
             bus_req_o.data <= wdata_i;
             bus_req_o.ben  <= "1111";
         end case;
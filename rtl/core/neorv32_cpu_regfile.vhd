@@ -139,7 +139,8 @@ begin
         rs3_o <= reg_file(to_integer(unsigned(rs3_addr(addr_bits_c-1 downto 0))));
       end if;
     end process rs3_read;
-    rs3_addr <= ctrl_i.ir_funct12(11 downto 7); -- RISC-V compliant
+    rs3_addr <= ctrl_i.rf_rd when (ctrl_i.ir_opcode = opcode_p_c) else -- packed-SIMD: accumulator = rd
+                ctrl_i.ir_funct12(11 downto 7); -- RISC-V compliant
   end generate;
 
   rs3_disable:
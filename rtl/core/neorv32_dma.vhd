@@ -303,6 +303,7 @@ begin
   dma_req_o.addr  <= engine.src_addr when (engine.state = S_READ) else engine.dst_addr;
   dma_req_o.rvso  <= '0'; -- no reservation set operation possible
   dma_req_o.fence <= config.enable and config.fence and engine.done; -- issue FENCE operation when transfer is done
+  dma_req_o.cmo   <= (others => '0'); -- no cache-block operation possible
 
   -- address increment --
   address_inc: process(config.qsel)
@@ -17,8 +17,9 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_imem is
   generic (
-    IMEM_SIZE    : natural; -- processor-internal instruction memory size in bytes, has to be a power of 2
-    IMEM_AS_IROM : boolean  -- implement IMEM as pre-initialized read-only memory?
+    IMEM_SIZE    : natural;      -- processor-internal instruction memory size in bytes, has to be a power of 2
+    IMEM_AS_IROM : boolean;      -- implement IMEM as pre-initialized read-only memory?
+    IMEM_FILE    : string := ""  -- ROM/textio initialization file (plain hex or *.bin), overrides the VHDL image
   );
   port (
     clk_i     : in  std_ulogic; -- global clock line
@@ -112,6 +112,7 @@ begin
   -- -------------------------------------------------------------------------------------------
   x_req_o.addr  <= a_req_i.addr when (arbiter.sel = '0') else b_req_i.addr;
   x_req_o.rvso  <= a_req_i.rvso when (arbiter.sel = '0') else b_req_i.rvso;
+  x_req_o.cmo   <= a_req_i.cmo  when (arbiter.sel = '0') else b_req_i.cmo;
   x_req_o.priv  <= a_req_i.priv when (arbiter.sel = '0') else b_req_i.priv;
   x_req_o.src   <= a_req_i.src  when (arbiter.sel = '0') else b_req_i.src;
   x_req_o.rw    <= a_req_i.rw   when (arbiter.sel = '0') else b_req_i.rw;
@@ -11,6 +11,7 @@
 library ieee;
 use ieee.std_logic_1164.all;
 use ieee.numeric_std.all;
+use std.textio.all;
 
 package neorv32_package is
 
@@ -134,8 +135,14 @@ package neorv32_package is
     priv  : std_ulogic; -- set if privileged (machine-mode) access
     rvso  : std_ulogic; -- set if reservation set operation (atomic LR/SC)
     fence : std_ulogic; -- fence(.i) operation, independent of STB
+    cmo   : std_ulogic_vector(02 downto 0); -- cache-block management operation (see below), valid with STB
   end record;
 
+  -- cache-block management operation (bus_req_t.cmo); an all-zero CMO field is a normal access --
+  constant cmo_inval_c : natural := 0; -- invalidate block
+  constant cmo_clean_c : natural := 1; -- clean block (write-back if dirty)
+  constant cmo_zero_c  : natural := 2; -- zero block
+
   -- bus response --
   type bus_rsp_t is record
     data : std_ulogic_vector(31 downto 0); -- read data
@@ -153,7 +160,8 @@ package neorv32_package is
     src   => '0',
     priv  => '0',
     rvso  => '0',
-    fence => '0'
+    fence => '0',
+    cmo   => (others => '0')
   );
 
   -- endpoint (response) termination --
@@ -230,6 +238,8 @@ package neorv32_package is
   constant opcode_system_c : std_ulogic_vector(6 downto 0) := "1110011"; -- system/csr access
   -- floating point operations --
   constant opcode_fop_c    : std_ulogic_vector(6 downto 0) := "1010011"; -- dual/single operand instruction
+  -- packed-SIMD operations --
+  constant opcode_p_c      : std_ulogic_vector(6 downto 0) := "1110111"; -- OP-P (draft 'P' extension)
   -- official custom RISC-V opcodes - free for custom instructions --
   constant opcode_cust0_c  : std_ulogic_vector(6 downto 0) := "0001011"; -- custom-0
   constant opcode_cust1_c  : std_ulogic_vector(6 downto 0) := "0101011"; -- custom-1
@@ -276,6 +286,7 @@ package neorv32_package is
   -- fence --
   constant funct3_fence_c  : std_ulogic_vector(2 downto 0) := "000"; -- fence - order IO/memory access
   constant funct3_fencei_c : std_ulogic_vector(2 downto 0) := "001"; -- fence.i - instruction stream sync
+  constant funct3_cbo_c    : std_ulogic_vector(2 downto 0) := "010"; -- cbo.* - cache-block operation
 
   -- RISC-V Funct12 - SYSTEM ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -285,6 +296,13 @@ package neorv32_package is
   constant funct12_mret_c   : std_ulogic_vector(11 downto 0) := x"302"; -- mret
   constant funct12_dret_c   : std_ulogic_vector(11 downto 0) := x"7b2"; -- dret
 
+  -- RISC-V Funct12 - MISC-MEM (cache-block operations) -------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  constant funct12_cbo_inval_c : std_ulogic_vector(11 downto 0) := x"000"; -- cbo.inval
+  constant funct12_cbo_clean_c : std_ulogic_vector(11 downto 0) := x"001"; -- cbo.clean
+  constant funct12_cbo_flush_c : std_ulogic_vector(11 downto 0) := x"002"; -- cbo.flush
+  constant funct12_cbo_zero_c  : std_ulogic_vector(11 downto 0) := x"004"; -- cbo.zero
+
   -- RISC-V Floating-Point Stuff ------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   constant float_single_c : std_ulogic_vector(1 downto 0) := "00"; -- single-precision (32-bit)
@@ -491,7 +509,7 @@ package neorv32_package is
     alu_opa_mux  : std_ulogic;                     -- operand A select (0=rs1, 1=PC)
     alu_opb_mux  : std_ulogic;                     -- operand B select (0=rs2, 1=IMM)
     alu_unsigned : std_ulogic;                     -- is unsigned ALU operation
-    alu_cp_trig  : std_ulogic_vector(05 downto 0); -- co-processor trigger (one-hot)
+    alu_cp_trig  : std_ulogic_vector(07 downto 0); -- co-processor trigger (one-hot)
     -- load/store unit --
     lsu_req      : std_ulogic;                     -- trigger memory access request
     lsu_rw       : std_ulogic;                     -- 0: read access, 1: write access
@@ -549,6 +567,8 @@ package neorv32_package is
   constant cp_sel_fpu_c      : natural := 3; -- CP3: floating-point unit ('Zfinx' extension)
   constant cp_sel_cfu_c      : natural := 4; -- CP4: custom instructions CFU ('Zxcfu' extension)
   constant cp_sel_cond_c     : natural := 5; -- CP5: conditional operations ('Zicond' extension)
+  constant cp_sel_crypto_c   : natural := 6; -- CP6: scalar cryptography ('Zkn*' extensions)
+  constant cp_sel_simd_c     : natural := 7; -- CP7: packed-SIMD DSP operations ('Zxpsimd' extension)
 
   -- ALU Function Codes ---------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -696,6 +716,7 @@ package neorv32_package is
   function popcount_f(input : std_ulogic_vector) return natural;
   function leading_zeros_f(input : std_ulogic_vector) return natural;
   impure function mem32_init_f(init : mem32_t; depth : natural) return mem32_t;
+  impure function mem32_load_f(file_name : string; depth : natural) return mem32_t;
 
 -- **********************************************************************************************************
 -- NEORV32 Processor Top Entity (component prototype)
@@ -719,12 +740,24 @@ package neorv32_package is
       CPU_EXTENSION_RISCV_E      : boolean                        := false;
       CPU_EXTENSION_RISCV_M      : boolean                        := false;
       CPU_EXTENSION_RISCV_U      : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zbc    : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zbkb   : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zbkc   : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zbkx   : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zcb    : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zcmp   : boolean                        := false;
       CPU_EXTENSION_RISCV_Zfinx  : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zicbom : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zicboz : boolean                        := false;
       CPU_EXTENSION_RISCV_Zicntr : boolean                        := true;
       CPU_EXTENSION_RISCV_Zicond : boolean                        := false;
       CPU_EXTENSION_RISCV_Zihpm  : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zknd   : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zkne   : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zknh   : boolean                        := false;
       CPU_EXTENSION_RISCV_Zmmul  : boolean                        := false;
       CPU_EXTENSION_RISCV_Zxcfu  : boolean                        := false;
+      CPU_EXTENSION_RISCV_Zxpsimd : boolean                       := false;
       -- Tuning Options --
       FAST_MUL_EN                : boolean                        := false;
       FAST_SHIFT_EN              : boolean                        := false;
@@ -742,6 +775,7 @@ package neorv32_package is
       -- Internal Instruction memory (IMEM) --
       MEM_INT_IMEM_EN            : boolean                        := false;
       MEM_INT_IMEM_SIZE          : natural                        := 16*1024;
+      MEM_INT_IMEM_FILE          : string                         := "";
       -- Internal Data memory (DMEM) --
       MEM_INT_DMEM_EN            : boolean                        := false;
       MEM_INT_DMEM_SIZE          : natural                        := 8*1024;
@@ -1145,6 +1179,109 @@ package body neorv32_package is
     return mem_v;
   end function mem32_init_f;
 
+  -- Initialize mem32_t array from a plain ASCII hex file or a raw binary file -------------
+  -- -------------------------------------------------------------------------------------------
+  -- > hex: one or more 32-bit hex words per line (Verilog "$readmemh" / Xilinx ".mem" style)
+  -- > hex: "@<hex>" sets the (word) address of the following data, "//" starts a comment
+  -- > hex: any other non-hex character is treated as separator
+  -- > "*.bin" files: raw little-endian binary (e.g. "neorv32_raw_exe.bin")
+  impure function mem32_load_f(file_name : string; depth : natural) return mem32_t is
+    type     char_file_t is file of character;
+    file     bin_file  : char_file_t;
+    file     init_file : text;
+    variable status_v  : file_open_status;
+    variable line_v    : line;
+    variable mem_v     : mem32_t(0 to depth-1);
+    variable data_v    : std_ulogic_vector(31 downto 0);
+    variable addr_v    : natural;
+    variable digits_v  : natural;
+    variable is_addr_v : boolean;
+    variable char_v    : character;
+    variable nibble_v  : integer;
+    variable ovfl_v    : boolean;
+  begin
+    mem_v := (others => (others => '0')); -- [IMPORTANT] make sure remaining memory entries are set to zero
+    if (file_name'length = 0) then
+      return mem_v;
+    end if;
+    addr_v := 0;
+    -- raw binary file --
+    if (file_name'length > 4) and (file_name(file_name'right-3 to file_name'right) = ".bin") then
+      file_open(status_v, bin_file, file_name, read_mode);
+      if (status_v /= open_ok) then
+        report "[NEORV32] Cannot open memory initialization file '" & file_name & "'!" severity warning;
+        return mem_v;
+      end if;
+      digits_v := 0; -- byte lane
+      while (endfile(bin_file) = false) and (addr_v < depth) loop
+        read(bin_file, char_v);
+        mem_v(addr_v)(digits_v*8+7 downto digits_v*8) := std_ulogic_vector(to_unsigned(character'pos(char_v), 8));
+        if (digits_v = 3) then
+          digits_v := 0;
+          addr_v   := addr_v + 1;
+        else
+          digits_v := digits_v + 1;
+        end if;
+      end loop;
+      if (endfile(bin_file) = false) then
+        report "[NEORV32] Memory initialization file '" & file_name & "' exceeds memory size!" severity warning;
+      end if;
+      file_close(bin_file);
+      return mem_v;
+    end if;
+    -- plain ASCII hex file --
+    ovfl_v := false;
+    file_open(status_v, init_file, file_name, read_mode);
+    if (status_v /= open_ok) then
+      report "[NEORV32] Cannot open memory initialization file '" & file_name & "'!" severity warning;
+      return mem_v;
+    end if;
+    while (endfile(init_file) = false) loop
+      readline(init_file, line_v);
+      digits_v  := 0;
+      is_addr_v := false;
+      data_v    := (others => '0');
+      for i in 1 to line_v'length+1 loop -- one extra iteration to flush the last token
+        if (i <= line_v'length) then
+          char_v := line_v(i);
+        else
+          char_v := ' ';
+        end if;
+        case char_v is
+          when '0' to '9' => nibble_v := character'pos(char_v) - character'pos('0');
+          when 'a' to 'f' => nibble_v := character'pos(char_v) - character'pos('a') + 10;
+          when 'A' to 'F' => nibble_v := character'pos(char_v) - character'pos('A') + 10;
+          when others     => nibble_v := -1;
+        end case;
+        if (nibble_v >= 0) then -- hex digit
+          data_v   := data_v(27 downto 0) & std_ulogic_vector(to_unsigned(nibble_v, 4));
+          digits_v := digits_v + 1;
+        else -- separator: commit current token
+          if (digits_v /= 0) then
+            if is_addr_v then
+              addr_v := to_integer(unsigned(data_v(30 downto 0)));
+            elsif (addr_v < depth) then
+              mem_v(addr_v) := data_v;
+              addr_v := addr_v + 1;
+            else
+              ovfl_v := true;
+            end if;
+          end if;
+          digits_v  := 0;
+          is_addr_v := (char_v = '@');
+          data_v    := (others => '0');
+          exit when (char_v = '/'); -- rest of line is a comment
+        end if;
+      end loop;
+      deallocate(line_v);
+    end loop;
+    file_close(init_file);
+    if ovfl_v then
+      report "[NEORV32] Memory initialization file '" & file_name & "' exceeds memory size!" severity warning;
+    end if;
+    return mem_v;
+  end function mem32_load_f;
+
 
 end neorv32_package;
 
@@ -40,12 +40,24 @@ entity neorv32_top is
     CPU_EXTENSION_RISCV_E      : boolean                        := false;       -- implement embedded RF extension?
     CPU_EXTENSION_RISCV_M      : boolean                        := false;       -- implement mul/div extension?
     CPU_EXTENSION_RISCV_U      : boolean                        := false;       -- implement user mode extension?
+    CPU_EXTENSION_RISCV_Zbc    : boolean                        := false;       -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb   : boolean                        := false;       -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc   : boolean                        := false;       -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx   : boolean                        := false;       -- implement cryptography crossbar permutation instructions?
+    CPU_EXTENSION_RISCV_Zcb    : boolean                        := false;       -- implement additional simple compressed instructions (requires C)?
+    CPU_EXTENSION_RISCV_Zcmp   : boolean                        := false;       -- implement compressed push/pop and register-move instructions (requires C)?
     CPU_EXTENSION_RISCV_Zfinx  : boolean                        := false;       -- implement 32-bit floating-point extension (using INT regs!)
+    CPU_EXTENSION_RISCV_Zicbom : boolean                        := false;       -- implement cache-block management operations (requires d-cache)?
+    CPU_EXTENSION_RISCV_Zicboz : boolean                        := false;       -- implement cache-block zero operation (requires d-cache)?
     CPU_EXTENSION_RISCV_Zicntr : boolean                        := true;        -- implement base counters?
     CPU_EXTENSION_RISCV_Zicond : boolean                        := false;       -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zihpm  : boolean                        := false;       -- implement hardware performance monitors?
+    CPU_EXTENSION_RISCV_Zknd   : boolean                        := false;       -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne   : boolean                        := false;       -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh   : boolean                        := false;       -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zmmul  : boolean                        := false;       -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zxcfu  : boolean                        := false;       -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd : boolean                       := false;       -- implement packed-SIMD DSP instructions (subset of 'P')?
 
     -- Tuning Options --
     FAST_MUL_EN                : boolean                        := false;       -- use DSPs for M extension's multiplier
@@ -68,6 +80,7 @@ entity neorv32_top is
     -- Internal Instruction memory (IMEM) --
     MEM_INT_IMEM_EN            : boolean                        := false;       -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE          : natural                        := 16*1024;     -- size of processor-internal instruction memory in bytes (use a power of 2)
+    MEM_INT_IMEM_FILE          : string                         := "";          -- IMEM init file (plain hex or *.bin), overrides the VHDL application image
 
     -- Internal Data memory (DMEM) --
     MEM_INT_DMEM_EN            : boolean                        := false;       -- implement processor-internal data memory
@@ -247,6 +260,10 @@ architecture neorv32_top_rtl of neorv32_top is
   constant io_xirq_en_c    : boolean := boolean(XIRQ_NUM_CH > 0);
   constant io_pwm_en_c     : boolean := boolean(IO_PWM_NUM_CH > 0);
   constant cpu_smpmp_c     : boolean := boolean(PMP_NUM_REGIONS > 0);
+  constant cpu_zcb_c       : boolean := CPU_EXTENSION_RISCV_Zcb and CPU_EXTENSION_RISCV_C;
+  constant cpu_zcmp_c      : boolean := CPU_EXTENSION_RISCV_Zcmp and CPU_EXTENSION_RISCV_C;
+  constant cpu_zicbom_c    : boolean := CPU_EXTENSION_RISCV_Zicbom and DCACHE_EN;
+  constant cpu_zicboz_c    : boolean := CPU_EXTENSION_RISCV_Zicboz and DCACHE_EN;
 
   -- convert JEDEC ID to mvendor CSR --
   constant vendorid_c : std_ulogic_vector(31 downto 0) := x"00000" & "0" & JEDEC_ID;
@@ -385,6 +402,14 @@ begin
     assert not ((dmem_size_valid_c = false) and (MEM_INT_DMEM_EN = true)) report
       "[NEORV32] Auto-adjusting invalid DMEM size configuration." severity warning;
 
+    -- cache-block operations --
+    assert not ((CPU_EXTENSION_RISCV_Zicbom or CPU_EXTENSION_RISCV_Zicboz) and (DCACHE_EN = false)) report
+      "[NEORV32] Zicbom/Zicboz ISA extensions require the d-cache - extensions disabled." severity warning;
+
+    -- code-size reduction extensions --
+    assert not ((CPU_EXTENSION_RISCV_Zcb or CPU_EXTENSION_RISCV_Zcmp) and (CPU_EXTENSION_RISCV_C = false)) report
+      "[NEORV32] Zcb/Zcmp ISA extensions require the C extension - extensions disabled." severity warning;
+
   end generate; -- /sanity_checks
 
 
@@ -513,12 +538,24 @@ begin
       CPU_EXTENSION_RISCV_E      => CPU_EXTENSION_RISCV_E,
       CPU_EXTENSION_RISCV_M      => CPU_EXTENSION_RISCV_M,
       CPU_EXTENSION_RISCV_U      => CPU_EXTENSION_RISCV_U,
+      CPU_EXTENSION_RISCV_Zbc    => CPU_EXTENSION_RISCV_Zbc,
+      CPU_EXTENSION_RISCV_Zbkb   => CPU_EXTENSION_RISCV_Zbkb,
+      CPU_EXTENSION_RISCV_Zbkc   => CPU_EXTENSION_RISCV_Zbkc,
+      CPU_EXTENSION_RISCV_Zbkx   => CPU_EXTENSION_RISCV_Zbkx,
+      CPU_EXTENSION_RISCV_Zcb    => cpu_zcb_c,
+      CPU_EXTENSION_RISCV_Zcmp   => cpu_zcmp_c,
       CPU_EXTENSION_RISCV_Zfinx  => CPU_EXTENSION_RISCV_Zfinx,
+      CPU_EXTENSION_RISCV_Zicbom => cpu_zicbom_c,
+      CPU_EXTENSION_RISCV_Zicboz => cpu_zicboz_c,
       CPU_EXTENSION_RISCV_Zicntr => CPU_EXTENSION_RISCV_Zicntr,
       CPU_EXTENSION_RISCV_Zicond => CPU_EXTENSION_RISCV_Zicond,
       CPU_EXTENSION_RISCV_Zihpm  => CPU_EXTENSION_RISCV_Zihpm,
+      CPU_EXTENSION_RISCV_Zknd   => CPU_EXTENSION_RISCV_Zknd,
+      CPU_EXTENSION_RISCV_Zkne   => CPU_EXTENSION_RISCV_Zkne,
+      CPU_EXTENSION_RISCV_Zknh   => CPU_EXTENSION_RISCV_Zknh,
       CPU_EXTENSION_RISCV_Zmmul  => CPU_EXTENSION_RISCV_Zmmul,
       CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,
+      CPU_EXTENSION_RISCV_Zxpsimd => CPU_EXTENSION_RISCV_Zxpsimd,
       CPU_EXTENSION_RISCV_Sdext  => ON_CHIP_DEBUGGER_EN,
       CPU_EXTENSION_RISCV_Sdtrig => ON_CHIP_DEBUGGER_EN,
       CPU_EXTENSION_RISCV_Smpmp  => cpu_smpmp_c,
@@ -804,7 +841,8 @@ begin
       neorv32_int_imem_inst: entity neorv32.neorv32_imem
       generic map (
         IMEM_SIZE    => imem_size_c,
-        IMEM_AS_IROM => imem_as_rom_c
+        IMEM_AS_IROM => imem_as_rom_c,
+        IMEM_FILE    => MEM_INT_IMEM_FILE
       )
       port map (
         clk_i     => clk_i,
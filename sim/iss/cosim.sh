@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+
+# Lock-step co-simulation: check the VUnit testbench's retired-instruction trace against the
+# instruction-set simulator running the same executable.
+#
+# Usage: cosim.sh <main.elf> <neorv32_raw_exe.bin> [additional run.py arguments]
+#
+# The ISS is configured to match the VUnit testbench's processor configuration (see sim/neorv32_tb.vhd).
+# The application should use the UARTs' simulation mode (USER_FLAGS+=-DUART0_SIM_MODE) as the testbench
+# does not check any UART output in co-simulation mode.
+
+# Abort if any command returns != 0
+set -e
+
+if [ $# -lt 2 ]; then
+  echo "Usage: $0 <main.elf> <neorv32_raw_exe.bin> [run.py arguments]"
+  exit 1
+fi
+
+ELF=$(realpath "$1")
+BIN=$(realpath "$2")
+shift 2
+
+if [ -n "$NEORV32_ISS" ]; then
+  ISS=$(realpath "$NEORV32_ISS")
+fi
+
+cd $(dirname "$0")
+
+# compile the ISS if no pre-built one is provided
+if [ -z "$ISS" ]; then
+  ${CC_HOST:-gcc} -O2 neorv32_iss.c -o neorv32_iss
+  ISS=./neorv32_iss
+fi
+
+# the trace is streamed through a named pipe - no trace file is stored
+FIFO=$(mktemp -u /tmp/neorv32_trace.XXXXXX)
+mkfifo "$FIFO"
+trap 'rm -f "$FIFO"' EXIT
+
+$ISS -riscv_c -slow_mul -slow_shift -icache 0 -dcache 0 -imem 32768 -dmem 8192 -check "$FIFO" "$ELF" &
+ISS_PID=$!
+
+set +e
+NEORV32_IMEM_FILE="$BIN" NEORV32_TRACE_FILE="$FIFO" python3 ../run.py "$@"
+SIM_RC=$?
+if [ $SIM_RC -ne 0 ]; then
+  kill $ISS_PID 2> /dev/null # the simulation might have failed before opening the pipe
+fi
+wait $ISS_PID
+ISS_RC=$?
+set -e
+
+if [ $ISS_RC -eq 1 ]; then
+  echo "Co-simulation FAILED (trace mismatch)"
+  exit 1
+fi
+if [ $SIM_RC -ne 0 ] || [ $ISS_RC -ne 0 ]; then
+  echo "Co-simulation FAILED (RTL simulation error)"
+  exit 1
+fi
+echo "Co-simulation OK"
@@ -0,0 +1,1816 @@
+// #################################################################################################
+// # << NEORV32 - Cycle-approximate instruction-set simulator >>                                   #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2023, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+
+
+// Host-side, cycle-approximate instruction-set simulator for NEORV32 executables.
+// Compile: gcc -O2 neorv32_iss.c -o neorv32_iss
+//
+// Models the rv32i_zicsr_zifencei base ISA plus the M, A (lr/sc only), B (Zba/Zbb/Zbs), C, U, Zicond, Zicntr,
+// Zihpm and (if the d-cache is enabled) Zicbom/Zicboz extensions using the per-instruction cycle costs from the data sheet's "Instruction Cycles" section,
+// the direct-mapped write-back i-/d-caches of rtl/core/neorv32_cache.vhd and the subset of the IO map
+// (sw/lib/include/neorv32.h) required by the software framework: SYSINFO, MTIME, GPIO, UART0 and UART1.
+// All other IO devices read as zero. The default configuration matches sim/simple/neorv32_tb.simple.vhd.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// executable signature ("magic word")
+const uint32_t signature = 0x4788CAFE;
+
+// address map (see rtl/core/neorv32_package.vhd)
+#define IMEM_BASE     0x00000000U // processor-internal instruction memory
+#define DMEM_BASE     0x80000000U // processor-internal data memory
+#define UNCACHED_BASE 0xF0000000U // begin of the uncached address space
+#define IO_BASE       0xFFFFE000U // begin of the processor-internal IO space
+
+// modelled IO devices (see sw/lib/include/neorv32.h)
+#define MTIME_BASE   0xFFFFF400U
+#define UART0_BASE   0xFFFFF500U
+#define UART1_BASE   0xFFFFF600U
+#define GPIO_BASE    0xFFFFFC00U
+#define SYSINFO_BASE 0xFFFFFE00U
+
+// hardware version (rtl/core/neorv32_package.vhd: hw_version_c) and architecture ID
+#define HW_VERSION 0x01090901U
+#define ARCH_ID    19
+
+// hardware performance monitors (as configured by the simple testbench)
+#define HPM_NUM   12 // number of HPM counters (3..3+HPM_NUM-1)
+#define HPM_WIDTH 40 // counter width in bits
+
+// implemented counters: cycle, instret, hpmcounter*
+#define CNT_MASK  (5U | (((1U << HPM_NUM) - 1) << 3))
+
+// trap causes (see rtl/core/neorv32_package.vhd)
+enum trap_enum {
+  TRAP_IMA = 0x00000000U, // instruction address misaligned
+  TRAP_IAF = 0x00000001U, // instruction access fault
+  TRAP_IIL = 0x00000002U, // illegal instruction
+  TRAP_BRK = 0x00000003U, // environment breakpoint
+  TRAP_LMA = 0x00000004U, // load address misaligned
+  TRAP_LAF = 0x00000005U, // load access fault
+  TRAP_SMA = 0x00000006U, // store address misaligned
+  TRAP_SAF = 0x00000007U, // store access fault
+  TRAP_ENV = 0x00000008U, // environment call (+ privilege level)
+  TRAP_MTI = 0x80000007U  // machine timer interrupt
+};
+
+// HPM events (see sw/lib/include/neorv32_cpu_csr.h)
+enum hpm_event_enum {
+  EV_CY, EV_TM, EV_IR, EV_COMPR, EV_WAIT_DIS, EV_WAIT_ALU, EV_BRANCH, EV_BRANCHED, EV_LOAD, EV_STORE, EV_WAIT_LSU, EV_TRAP, EV_NUM
+};
+
+// execution costs in clock cycles (see data sheet, section "Instruction Cycles")
+#define CYC_ALU     2  // base ALU operations
+#define CYC_BRANCH  3  // branch not taken
+#define CYC_TAKEN   6  // branch taken, jal, jalr
+#define CYC_MEM     5  // load/store (4 for compressed instructions)
+#define CYC_SYS     3  // ecall, ebreak, wfi, illegal instruction, CSR access
+#define CYC_FENCE   5  // fence, fence.i, mret
+#define CYC_CBO     8  // cache-block operation (cache hit, clean block)
+#define CYC_MULDIV  36 // serial multiplication/division
+#define CYC_FASTMUL 4  // DSP-based multiplication
+#define CYC_BITMAN  4  // bit-manipulation operations
+#define CYC_COND    3  // czero.*
+#define CYC_IRQ     3  // interrupt entry
+
+// cache miss penalty: fixed overhead + per-word bus access
+#define CACHE_MISS_OVERHEAD 4
+
+
+// ----------------------------------------------------------------------------------------------
+// Configuration
+// ----------------------------------------------------------------------------------------------
+
+static struct {
+  uint32_t imem_size;    // IMEM size in bytes
+  uint32_t dmem_size;    // DMEM size in bytes
+  uint32_t clock;        // clock frequency in Hz
+  int      riscv_c;      // C extension implemented
+  int      fast_mul;     // FAST_MUL_EN
+  int      fast_shift;   // FAST_SHIFT_EN
+  uint32_t mem_lat;      // bus cycles per memory word (cache refill / write-back)
+  uint64_t max_cycles;   // simulation time limit (0 = unlimited)
+  int      quiet;        // no summary
+  int      profile;      // print function profile
+} cfg = {32*1024, 8*1024, 100000000, 0, 1, 1, 2, 0, 0, 0};
+
+
+// ----------------------------------------------------------------------------------------------
+// Processor state
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t x[32];      // register file
+static uint32_t pc;         // program counter
+static int      priv;       // privilege level: 3 = machine, 0 = user
+static uint64_t cycles;     // clock cycles since reset
+static uint64_t executed;   // executed instructions
+static int      halted;     // simulation done
+static int      rsv_valid;  // lr/sc reservation
+static uint32_t rsv_addr;
+
+static struct {
+  int      mie, mpie, mpp, mprv, tw; // mstatus
+  uint32_t ie, tvec, counteren, countinhibit, scratch, epc, cause, tval, tinst;
+  uint64_t cycle, instret;
+  uint64_t hpm[16];
+  uint32_t hpmevent[16];
+} csr;
+
+static uint8_t *imem, *dmem;
+
+// IO state
+static uint64_t mtime_offs, mtimecmp;
+static uint32_t gpio_out[2];
+static uint32_t uart_ctrl[2];
+
+// statistics of the current instruction
+static struct {
+  uint32_t cost;            // total execution cycles
+  uint32_t ev[EV_NUM];      // HPM event counts
+  int      rd;              // written register (0 = none)
+  uint32_t rd_val;
+  int      ncsr;            // CSR writes
+  uint16_t csr_addr[4];
+  uint32_t csr_val[4];
+  int      adopt;           // result has to be adopted from the reference trace
+  int      trap;            // trap entered
+} ins;
+
+
+// ----------------------------------------------------------------------------------------------
+// Caches: direct-mapped, write-back, write-allocate
+// ----------------------------------------------------------------------------------------------
+
+typedef struct {
+  int      en;
+  uint32_t blocks;    // number of blocks
+  uint32_t bsize;     // block size in bytes
+  uint32_t *tag;
+  uint8_t  *valid, *dirty;
+  uint64_t hit, miss, wb;
+} cache_t;
+
+static cache_t icache = {1, 64, 32, NULL, NULL, NULL, 0, 0, 0};
+static cache_t dcache = {1, 32, 32, NULL, NULL, NULL, 0, 0, 0};
+
+static void cache_init(cache_t *c) {
+
+  c->tag   = calloc(c->blocks, sizeof(uint32_t));
+  c->valid = calloc(c->blocks, 1);
+  c->dirty = calloc(c->blocks, 1);
+  if ((c->tag == NULL) || (c->valid == NULL) || (c->dirty == NULL)) {
+    fprintf(stderr, "Out of memory!\n");
+    exit(-1);
+  }
+}
+
+// access cache; returns penalty in clock cycles
+static uint32_t cache_access(cache_t *c, uint32_t addr, int write) {
+
+  if ((c->en == 0) || (addr >= UNCACHED_BASE)) {
+    return 0; // direct access
+  }
+
+  uint32_t block = addr / c->bsize;
+  uint32_t index = block % c->blocks;
+  uint32_t penalty = 0;
+
+  if (c->valid[index] && (c->tag[index] == block)) {
+    c->hit++;
+  }
+  else {
+    c->miss++;
+    if (c->valid[index] && c->dirty[index]) { // write-back modified block
+      c->wb++;
+      penalty += (c->bsize / 4) * cfg.mem_lat;
+    }
+    penalty += CACHE_MISS_OVERHEAD + (c->bsize / 4) * cfg.mem_lat; // refill
+    c->tag[index]   = block;
+    c->valid[index] = 1;
+    c->dirty[index] = 0;
+  }
+  if (write) {
+    c->dirty[index] = 1;
+  }
+  return penalty;
+}
+
+// fence: write back all modified blocks and invalidate the entire cache; returns penalty in clock cycles
+static uint32_t cache_flush(cache_t *c) {
+
+  uint32_t i, penalty = 0;
+
+  if (c->en == 0) {
+    return 0;
+  }
+  for (i=0; i<c->blocks; i++) {
+    if (c->valid[i] && c->dirty[i]) {
+      c->wb++;
+      penalty += (c->bsize / 4) * cfg.mem_lat;
+    }
+    c->valid[i] = 0;
+    c->dirty[i] = 0;
+  }
+  return penalty;
+}
+
+
+// cache-block operation (cbo.inval: f12 = 0, cbo.clean: f12 = 1, cbo.flush: f12 = 2, cbo.zero: f12 = 4);
+// returns penalty in clock cycles
+static uint32_t cache_cmo(cache_t *c, uint32_t addr, uint32_t f12) {
+
+  uint32_t block = addr / c->bsize;
+  uint32_t index = block % c->blocks;
+  uint32_t penalty = 0;
+  int hit = c->valid[index] && (c->tag[index] == block);
+
+  if (f12 == 4) { // zero: allocate block without fetching it from main memory
+    if (!hit && c->valid[index] && c->dirty[index]) {
+      c->wb++;
+      penalty += (c->bsize / 4) * cfg.mem_lat;
+    }
+    penalty += c->bsize / 4;
+    c->tag[index]   = block;
+    c->valid[index] = 1;
+    c->dirty[index] = 1;
+  }
+  else if (hit) {
+    if ((f12 != 0) && c->dirty[index]) { // clean/flush: write-back modified block
+      c->wb++;
+      penalty += (c->bsize / 4) * cfg.mem_lat;
+      c->dirty[index] = 0;
+    }
+    if (f12 != 1) { // inval/flush
+      c->valid[index] = 0;
+    }
+  }
+  return penalty;
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Memory system
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t log2_u32(uint32_t v) {
+  uint32_t r = 0;
+  while (v > 1) {
+    v >>= 1;
+    r++;
+  }
+  return r;
+}
+
+static uint64_t mtime_get(void) {
+  return cycles + mtime_offs;
+}
+
+// get pointer to memory location; returns NULL if there is no memory at this address
+static uint8_t *mem_ptr(uint32_t addr, uint32_t size) {
+
+  if ((uint64_t)(addr - IMEM_BASE) + size <= cfg.imem_size) {
+    return &imem[addr - IMEM_BASE];
+  }
+  if ((uint64_t)(addr - DMEM_BASE) + size <= cfg.dmem_size) {
+    return &dmem[addr - DMEM_BASE];
+  }
+  return NULL;
+}
+
+// IO read access (full word); returns 0 if successful
+static int io_read(uint32_t addr, uint32_t *data) {
+
+  uint32_t tmp = 0;
+  uint64_t now = mtime_get();
+
+  switch (addr) {
+    case SYSINFO_BASE + 0:  tmp = cfg.clock; break;
+    case SYSINFO_BASE + 4:  tmp = log2_u32(cfg.imem_size) | (log2_u32(cfg.dmem_size) << 8) | (2U << 24); break;
+    case SYSINFO_BASE + 8:  tmp = (1U << 2) | (1U << 3) | (icache.en << 5) | (dcache.en << 6) |
+                                  (1U << 15) | (1U << 16) | (1U << 17) | (1U << 25); break;
+    case SYSINFO_BASE + 12: tmp = (log2_u32(icache.bsize) << 0) | (log2_u32(icache.blocks) << 4) |
+                                  (log2_u32(dcache.bsize) << 8) | (log2_u32(dcache.blocks) << 12); break;
+    case MTIME_BASE + 0:    tmp = (uint32_t)now; break;
+    case MTIME_BASE + 4:    tmp = (uint32_t)(now >> 32); break;
+    case MTIME_BASE + 8:    tmp = (uint32_t)mtimecmp; break;
+    case MTIME_BASE + 12:   tmp = (uint32_t)(mtimecmp >> 32); break;
+    case UART0_BASE + 0:    tmp = uart_ctrl[0] | (1U << 19) | (1U << 20); break; // TX FIFO always empty
+    case UART1_BASE + 0:    tmp = uart_ctrl[1] | (1U << 19) | (1U << 20); break;
+    case GPIO_BASE + 0:     tmp = gpio_out[0]; break; // output is looped back to input in the testbench
+    case GPIO_BASE + 4:     tmp = gpio_out[1]; break;
+    case GPIO_BASE + 8:     tmp = gpio_out[0]; break;
+    case GPIO_BASE + 12:    tmp = gpio_out[1]; break;
+    default: break; // not modelled: read as zero
+  }
+  *data = tmp;
+  return 0;
+}
+
+// IO write access (full word)
+static void io_write(uint32_t addr, uint32_t data) {
+
+  uint64_t now = mtime_get();
+
+  switch (addr) {
+    case MTIME_BASE + 0:  mtime_offs = ((now & 0xFFFFFFFF00000000ULL) | data) - cycles; break;
+    case MTIME_BASE + 4:  mtime_offs = ((now & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32)) - cycles; break;
+    case MTIME_BASE + 8:  mtimecmp = (mtimecmp & 0xFFFFFFFF00000000ULL) | data; break;
+    case MTIME_BASE + 12: mtimecmp = (mtimecmp & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); break;
+    case UART0_BASE + 0:  uart_ctrl[0] = data & 0x07C0FFFFU; break;
+    case UART1_BASE + 0:  uart_ctrl[1] = data & 0x07C0FFFFU; break;
+    case UART0_BASE + 4:  if (uart_ctrl[0] & 1) { putchar((int)(data & 0xFF)); } break;
+    case UART1_BASE + 4:  if (uart_ctrl[1] & 1) { putchar((int)(data & 0xFF)); } break;
+    case GPIO_BASE + 8:   gpio_out[0] = data; break;
+    case GPIO_BASE + 12:  gpio_out[1] = data; break;
+    default: break; // not modelled: ignore
+  }
+}
+
+// data load; returns 0 if successful
+static int mem_load(uint32_t addr, uint32_t size, uint32_t *data) {
+
+  uint32_t i, tmp = 0;
+  uint8_t *p;
+
+  if (addr >= IO_BASE) {
+    if (io_read(addr & ~3U, &tmp)) {
+      return -1;
+    }
+    *data = tmp >> (8 * (addr & 3));
+    ins.adopt = 1; // non-deterministic source
+    return 0;
+  }
+  p = mem_ptr(addr, size);
+  if (p == NULL) {
+    return -1;
+  }
+  for (i=0; i<size; i++) {
+    tmp |= (uint32_t)p[i] << (8*i);
+  }
+  *data = tmp;
+  return 0;
+}
+
+// data store; returns 0 if successful
+static int mem_store(uint32_t addr, uint32_t size, uint32_t data) {
+
+  uint32_t i;
+  uint8_t *p;
+
+  if (addr >= IO_BASE) {
+    io_write(addr & ~3U, data << (8 * (addr & 3)));
+    return 0;
+  }
+  p = mem_ptr(addr, size);
+  if (p == NULL) {
+    return -1;
+  }
+  for (i=0; i<size; i++) {
+    p[i] = (uint8_t)(data >> (8*i));
+  }
+  if ((addr & ~3U) == rsv_addr) { // any store to the reserved address invalidates the reservation
+    rsv_valid = 0;
+  }
+  return 0;
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Trace output and cross-check against a reference trace
+// ----------------------------------------------------------------------------------------------
+// Trace format, one record per line (all values hexadecimal except the cycle count):
+//   I <cycle> <pc> <instruction> [x<rd>=<value>] [c<csr>=<value> ...]   executed instruction
+//   T <cycle> <mcause> <mepc>                                             trap entry
+
+typedef struct {
+  int      trap;
+  uint64_t cycle;
+  uint32_t a, b;      // pc + instruction / mcause + mepc
+  int      rd;
+  uint32_t rd_val;
+  int      ncsr;
+  uint16_t csr_addr[4];
+  uint32_t csr_val[4];
+  int      valid;
+} rec_t;
+
+static FILE *trace_fp, *check_fp;
+static rec_t ref;             // current (not yet consumed) reference record
+static uint64_t ref_line, checked, ref_cyc_last, iss_cyc_last, dev_sum, dev_max;
+static uint64_t ref_cycles, iss_cycles;
+static uint32_t dev_max_pc;
+static int ref_first = 1;
+
+static int rec_parse(const char *s, rec_t *r) {
+
+  char type;
+  unsigned long long cyc;
+  unsigned int a, b, idx, val;
+  int n;
+
+  memset(r, 0, sizeof(rec_t));
+  if (sscanf(s, " %c %llu %x %x%n", &type, &cyc, &a, &b, &n) != 4) {
+    return -1;
+  }
+  r->trap  = (type == 'T');
+  r->cycle = cyc;
+  r->a     = a;
+  r->b     = b;
+  s += n;
+  while (*s == ' ') {
+    int m;
+    if (sscanf(s, " x%u=%x%n", &idx, &val, &m) == 2) {
+      r->rd = idx;
+      r->rd_val = val;
+    }
+    else if ((sscanf(s, " c%x=%x%n", &idx, &val, &m) == 2) && (r->ncsr < 4)) {
+      r->csr_addr[r->ncsr] = (uint16_t)idx;
+      r->csr_val[r->ncsr++] = val;
+    }
+    else {
+      break;
+    }
+    s += m;
+  }
+  r->valid = 1;
+  return 0;
+}
+
+// get next reference record (without consuming it); returns NULL at end of reference trace
+static rec_t *ref_peek(void) {
+
+  char line[256];
+
+  while (ref.valid == 0) {
+    if (fgets(line, sizeof(line), check_fp) == NULL) {
+      return NULL;
+    }
+    ref_line++;
+    if ((line[0] == '#') || (line[0] == '\n')) {
+      continue;
+    }
+    if (rec_parse(line, &ref)) {
+      fprintf(stderr, "[ISS] Reference trace: syntax error in line %llu!\n", (unsigned long long)ref_line);
+      exit(-1);
+    }
+  }
+  return &ref;
+}
+
+static void rec_print(FILE *fp, const rec_t *r) {
+
+  int i;
+
+  if (r->trap) {
+    fprintf(fp, "T %llu %08x %08x\n", (unsigned long long)r->cycle, r->a, r->b);
+    return;
+  }
+  fprintf(fp, "I %llu %08x %08x", (unsigned long long)r->cycle, r->a, r->b);
+  if (r->rd) {
+    fprintf(fp, " x%d=%08x", r->rd, r->rd_val);
+  }
+  for (i=0; i<r->ncsr; i++) {
+    fprintf(fp, " c%03x=%08x", r->csr_addr[i], r->csr_val[i]);
+  }
+  fprintf(fp, "\n");
+}
+
+// compare simulated record against reference record; returns 0 if identical
+static int rec_compare(const rec_t *r, const rec_t *q) {
+
+  int i;
+
+  if ((r->trap != q->trap) || (r->a != q->a)) {
+    return -1;
+  }
+  if (r->trap) {
+    return (r->b != q->b) ? -1 : 0; // trap cause
+  }
+  if ((r->rd != q->rd) || (r->rd && (r->rd_val != q->rd_val)) || (r->ncsr != q->ncsr)) {
+    return -1;
+  }
+  for (i=0; i<r->ncsr; i++) {
+    if ((r->csr_addr[i] != q->csr_addr[i]) || (r->csr_val[i] != q->csr_val[i])) {
+      return -1;
+    }
+  }
+  return 0; // the instruction word is informational only
+}
+
+static void rec_emit(const rec_t *r) {
+
+  if (trace_fp) {
+    rec_print(trace_fp, r);
+  }
+  if (check_fp == NULL) {
+    return;
+  }
+  rec_t *q = ref_peek();
+  if (q == NULL) {
+    halted = 1;
+    return;
+  }
+  if (rec_compare(r, q)) {
+    fflush(stdout);
+    fprintf(stderr, "[ISS] MISMATCH after %llu checked records (reference line %llu):\n",
+            (unsigned long long)checked, (unsigned long long)ref_line);
+    fprintf(stderr, "[ISS]   reference: ");
+    rec_print(stderr, q);
+    fprintf(stderr, "[ISS]   simulated: ");
+    rec_print(stderr, r);
+    exit(1);
+  }
+  // cycle deviation (executed instructions only)
+  if (r->trap == 0) {
+    if (ref_first == 0) {
+      uint64_t d_ref = q->cycle - ref_cyc_last, d_iss = r->cycle - iss_cyc_last;
+      uint64_t dev = (d_ref > d_iss) ? (d_ref - d_iss) : (d_iss - d_ref);
+      ref_cycles += d_ref;
+      iss_cycles += d_iss;
+      dev_sum += dev;
+      if (dev > dev_max) {
+        dev_max = dev;
+        dev_max_pc = q->a;
+      }
+    }
+    ref_first = 0;
+    ref_cyc_last = q->cycle;
+    iss_cyc_last = r->cycle;
+  }
+  checked++;
+  ref.valid = 0; // consume
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Traps, interrupts and CSRs
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t mstatus_get(void) {
+  return ((uint32_t)csr.mie << 3) | ((uint32_t)csr.mpie << 7) | ((uint32_t)csr.mpp << 11) |
+         ((uint32_t)csr.mprv << 17) | ((uint32_t)csr.tw << 21);
+}
+
+static uint32_t mip_get(void) {
+  return (mtime_get() >= mtimecmp) ? (1U << 7) : 0; // MTIP
+}
+
+static void trap_enter(uint32_t cause, uint32_t epc, uint32_t tval, uint32_t tinst) {
+
+  csr.cause = cause;
+  csr.epc   = epc & ~1U;
+  csr.tval  = tval;
+  csr.tinst = tinst;
+  csr.mpie  = csr.mie;
+  csr.mie   = 0;
+  csr.mpp   = priv;
+  priv      = 3;
+  rsv_valid = 0;
+  if ((cause & 0x80000000U) && ((csr.tvec & 3) == 1)) {
+    pc = (csr.tvec & ~0x7FU) + 4*(cause & 0x1F); // vectored mode
+  }
+  else {
+    pc = csr.tvec & ~3U;
+  }
+  ins.ev[EV_TRAP]++;
+  ins.trap = 1;
+}
+
+// emit trap record
+static void trap_emit(void) {
+
+  rec_t r;
+
+  memset(&r, 0, sizeof(r));
+  r.trap  = 1;
+  r.cycle = cycles;
+  r.a     = csr.cause;
+  r.b     = csr.epc;
+  rec_emit(&r);
+}
+
+static int csr_counter_allowed(uint32_t addr) {
+
+  uint32_t idx = addr & 0x1F;
+
+  if (priv == 3) {
+    return 1;
+  }
+  return (csr.counteren >> idx) & 1;
+}
+
+// CSR read; returns 0 if the CSR exists and is accessible
+static int csr_read(uint32_t addr, uint32_t *data) {
+
+  uint32_t idx = addr & 0x1F;
+
+  if (((addr >> 8) & 3) > (uint32_t)priv) { // privilege check
+    return -1;
+  }
+  switch (addr) {
+    case 0x300: *data = mstatus_get(); return 0;
+    case 0x301: *data = (1U << 30) | (1U << 0) | (1U << 1) | ((uint32_t)cfg.riscv_c << 2) | (1U << 8) | (1U << 12) |
+                        (1U << 20) | (1U << 23); return 0; // MXL=32, A, B, C, I, M, U, X
+    case 0x304: *data = csr.ie; return 0;
+    case 0x305: *data = csr.tvec; return 0;
+    case 0x306: *data = csr.counteren; return 0;
+    case 0x30a: case 0x31a: case 0x310: *data = 0; return 0;
+    case 0x320: *data = csr.countinhibit; return 0;
+    case 0x340: *data = csr.scratch; return 0;
+    case 0x341: *data = csr.epc; return 0;
+    case 0x342: *data = csr.cause; return 0;
+    case 0x343: *data = csr.tval; return 0;
+    case 0x344: *data = mip_get(); ins.adopt = 1; return 0;
+    case 0x34a: *data = csr.tinst; return 0;
+    case 0xb00: case 0xc00:
+      if (!csr_counter_allowed(addr)) return -1;
+      *data = (uint32_t)csr.cycle; ins.adopt = 1; return 0;
+    case 0xb80: case 0xc80:
+      if (!csr_counter_allowed(addr)) return -1;
+      *data = (uint32_t)(csr.cycle >> 32); ins.adopt = 1; return 0;
+    case 0xb02: case 0xc02:
+      if (!csr_counter_allowed(addr)) return -1;
+      *data = (uint32_t)csr.instret; ins.adopt = 1; return 0;
+    case 0xb82: case 0xc82:
+      if (!csr_counter_allowed(addr)) return -1;
+      *data = (uint32_t)(csr.instret >> 32); ins.adopt = 1; return 0;
+    case 0xf11: *data = 0; return 0; // mvendorid
+    case 0xf12: *data = ARCH_ID; return 0; // marchid
+    case 0xf13: *data = HW_VERSION; return 0; // mimpid
+    case 0xf14: case 0xf15: *data = 0; return 0; // mhartid, mconfigptr
+    case 0xfc0: // mxisa: Zicsr, Zifencei, Zicond, Zicntr, Zihpm, Zicbom/Zicboz (with d-cache), is simulation, fast mul/shift
+      *data = (1U << 0) | (1U << 1) | (1U << 6) | (1U << 7) | (1U << 9) | (1U << 20) |
+              ((uint32_t)dcache.en << 12) | ((uint32_t)dcache.en << 13) |
+              ((uint32_t)cfg.fast_mul << 30) | ((uint32_t)cfg.fast_shift << 31);
+      return 0;
+    default: break;
+  }
+  if ((idx >= 3) && (idx < 3+HPM_NUM)) {
+    switch (addr & 0xFE0) {
+      case 0x320: *data = csr.hpmevent[idx]; return 0;
+      case 0xb00: case 0xc00:
+        if (!csr_counter_allowed(addr)) return -1;
+        *data = (uint32_t)csr.hpm[idx]; ins.adopt = 1; return 0;
+      case 0xb80: case 0xc80:
+        if (!csr_counter_allowed(addr)) return -1;
+        *data = (uint32_t)(csr.hpm[idx] >> 32); ins.adopt = 1; return 0;
+      default: break;
+    }
+  }
+  return -1; // not implemented
+}
+
+// CSR write (the CSR has already been checked by csr_read)
+static void csr_write(uint32_t addr, uint32_t data) {
+
+  uint32_t idx = addr & 0x1F;
+  uint64_t hpm_mask = (1ULL << HPM_WIDTH) - 1;
+
+  if (ins.ncsr < 4) {
+    ins.csr_addr[ins.ncsr] = (uint16_t)addr;
+    ins.csr_val[ins.ncsr++] = data;
+  }
+  switch (addr) {
+    case 0x300:
+      csr.mie  = (data >> 3) & 1;
+      csr.mpie = (data >> 7) & 1;
+      csr.mpp  = (data & (3U << 11)) ? 3 : 0; // everything /= U will fall back to M
+      csr.mprv = (data >> 17) & 1;
+      csr.tw   = (data >> 21) & 1;
+      return;
+    case 0x304: csr.ie = data & 0xFFFF0888U; return;
+    case 0x305: csr.tvec = ((data & 3) == 1) ? ((data & ~0x7FU) | 1) : (data & ~3U); return;
+    case 0x306: csr.counteren = (data & CNT_MASK) ? CNT_MASK : 0; return; // single enable flag for all counters
+    case 0x320: csr.countinhibit = data & CNT_MASK; return;
+    case 0x340: csr.scratch = data; return;
+    case 0x341: csr.epc = data & (cfg.riscv_c ? ~1U : ~3U); return;
+    case 0x342: csr.cause = data & 0x8000001FU; return;
+    case 0xb00: csr.cycle = (csr.cycle & 0xFFFFFFFF00000000ULL) | data; return;
+    case 0xb80: csr.cycle = (csr.cycle & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); return;
+    case 0xb02: csr.instret = (csr.instret & 0xFFFFFFFF00000000ULL) | data; return;
+    case 0xb82: csr.instret = (csr.instret & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); return;
+    default: break;
+  }
+  if ((idx >= 3) && (idx < 3+HPM_NUM)) {
+    switch (addr & 0xFE0) {
+      case 0x320: csr.hpmevent[idx] = data & ((1U << EV_NUM) - 1) & ~(1U << EV_TM); return;
+      case 0xb00: csr.hpm[idx] = ((csr.hpm[idx] & 0xFFFFFFFF00000000ULL) | data) & hpm_mask; return;
+      case 0xb80: csr.hpm[idx] = ((csr.hpm[idx] & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32)) & hpm_mask; return;
+      default: break;
+    }
+  }
+  // everything else is read-only or hardwired
+}
+
+// update counters after instruction execution / trap entry
+static void counters_update(void) {
+
+  uint32_t i, e;
+  uint64_t hpm_mask = (1ULL << HPM_WIDTH) - 1;
+
+  ins.ev[EV_CY] = ins.cost;
+  if ((csr.countinhibit & 1) == 0) {
+    csr.cycle += ins.ev[EV_CY];
+  }
+  if ((csr.countinhibit & 4) == 0) {
+    csr.instret += ins.ev[EV_IR];
+  }
+  for (i=3; i<3+HPM_NUM; i++) {
+    if ((csr.countinhibit >> i) & 1) {
+      continue;
+    }
+    for (e=0; e<EV_NUM; e++) {
+      if ((csr.hpmevent[i] >> e) & 1) {
+        csr.hpm[i] = (csr.hpm[i] + ins.ev[e]) & hpm_mask;
+      }
+    }
+  }
+  cycles += ins.cost;
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Compressed instructions: expand to the equivalent 32-bit instruction (0 if illegal)
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t enc_i(int32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+  return (((uint32_t)imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+  return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t op) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | ((i & 0x1F) << 7) | op;
+}
+
+static uint32_t enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 12) & 1) << 31) | (((i >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) |
+         (((i >> 1) & 0xF) << 8) | (((i >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t enc_j(int32_t imm, uint32_t rd) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 20) & 1) << 31) | (((i >> 1) & 0x3FF) << 21) | (((i >> 11) & 1) << 20) |
+         (((i >> 12) & 0xFF) << 12) | (rd << 7) | 0x6F;
+}
+
+static int32_t sext(uint32_t v, int bits) {
+  return (int32_t)(v << (32 - bits)) >> (32 - bits);
+}
+
+static uint32_t c_expand(uint32_t ci) {
+
+  uint32_t f3  = (ci >> 13) & 7;
+  uint32_t rd  = (ci >> 7) & 0x1F, rs2 = (ci >> 2) & 0x1F;   // full register fields
+  uint32_t rdp = ((ci >> 2) & 7) + 8, rs1p = ((ci >> 7) & 7) + 8; // compressed register fields
+  int32_t  imm6 = sext(((ci >> 7) & 0x20) | ((ci >> 2) & 0x1F), 6);
+  uint32_t tmp;
+
+  switch (ci & 3) {
+
+    case 0: // quadrant 0
+      switch (f3) {
+        case 0: // c.addi4spn
+          tmp = ((ci >> 7) & 0x30) | ((ci >> 1) & 0x3C0) | ((ci >> 4) & 0x4) | ((ci >> 2) & 0x8);
+          return (tmp == 0) ? 0 : enc_i((int32_t)tmp, 2, 0, rdp, 0x13);
+        case 2: // c.lw
+          tmp = ((ci >> 7) & 0x38) | ((ci >> 4) & 0x4) | ((ci << 1) & 0x40);
+          return enc_i((int32_t)tmp, rs1p, 2, rdp, 0x03);
+        case 6: // c.sw
+          tmp = ((ci >> 7) & 0x38) | ((ci >> 4) & 0x4) | ((ci << 1) & 0x40);
+          return enc_s((int32_t)tmp, rdp, rs1p, 2, 0x23);
+        default:
+          return 0;
+      }
+
+    case 1: // quadrant 1
+      switch (f3) {
+        case 0: // c.addi / c.nop
+          return enc_i(imm6, rd, 0, rd, 0x13);
+        case 1: // c.jal
+        case 5: // c.j
+          tmp = ((ci >> 1) & 0x800) | ((ci >> 7) & 0x10) | ((ci >> 1) & 0x300) | ((ci << 2) & 0x400) |
+                ((ci >> 1) & 0x40) | ((ci << 1) & 0x80) | ((ci >> 2) & 0xE) | ((ci << 3) & 0x20);
+          return enc_j(sext(tmp, 12), (f3 == 1) ? 1 : 0);
+        case 2: // c.li
+          return enc_i(imm6, 0, 0, rd, 0x13);
+        case 3:
+          if (rd == 2) { // c.addi16sp
+            tmp = ((ci >> 3) & 0x200) | ((ci >> 2) & 0x10) | ((ci << 1) & 0x40) | ((ci << 4) & 0x180) | ((ci << 3) & 0x20);
+            return (tmp == 0) ? 0 : enc_i(sext(tmp, 10), 2, 0, 2, 0x13);
+          }
+          // c.lui
+          return (imm6 == 0) ? 0 : (((uint32_t)imm6 << 12) | (rd << 7) | 0x37);
+        case 4:
+          switch ((ci >> 10) & 3) {
+            case 0: // c.srli
+              return (ci & 0x1000) ? 0 : enc_r(0x00, rs2, rs1p, 5, rs1p, 0x13);
+            case 1: // c.srai
+              return (ci & 0x1000) ? 0 : enc_r(0x20, rs2, rs1p, 5, rs1p, 0x13);
+            case 2: // c.andi
+              return enc_i(imm6, rs1p, 7, rs1p, 0x13);
+            default:
+              if (ci & 0x1000) {
+                return 0;
+              }
+              switch ((ci >> 5) & 3) {
+                case 0:  return enc_r(0x20, rdp, rs1p, 0, rs1p, 0x33); // c.sub
+                case 1:  return enc_r(0x00, rdp, rs1p, 4, rs1p, 0x33); // c.xor
+                case 2:  return enc_r(0x00, rdp, rs1p, 6, rs1p, 0x33); // c.or
+                default: return enc_r(0x00, rdp, rs1p, 7, rs1p, 0x33); // c.and
+              }
+          }
+        default: // c.beqz / c.bnez
+          tmp = ((ci >> 4) & 0x100) | ((ci >> 7) & 0x18) | ((ci << 1) & 0xC0) | ((ci >> 2) & 0x6) | ((ci << 3) & 0x20);
+          return enc_b(sext(tmp, 9), 0, rs1p, (f3 == 6) ? 0 : 1);
+      }
+
+    case 2: // quadrant 2
+      switch (f3) {
+        case 0: // c.slli
+          return (ci & 0x1000) ? 0 : enc_r(0x00, rs2, rd, 1, rd, 0x13);
+        case 2: // c.lwsp
+          tmp = ((ci >> 7) & 0x20) | ((ci >> 2) & 0x1C) | ((ci << 4) & 0xC0);
+          return (rd == 0) ? 0 : enc_i((int32_t)tmp, 2, 2, rd, 0x03);
+        case 4:
+          if ((ci & 0x1000) == 0) {
+            if (rs2 == 0) { // c.jr
+              return (rd == 0) ? 0 : enc_i(0, rd, 0, 0, 0x67);
+            }
+            return enc_r(0x00, rs2, 0, 0, rd, 0x33); // c.mv
+          }
+          if ((rd == 0) && (rs2 == 0)) { // c.ebreak
+            return 0x00100073;
+          }
+          if (rs2 == 0) { // c.jalr
+            return enc_i(0, rd, 0, 1, 0x67);
+          }
+          return enc_r(0x00, rs2, rd, 0, rd, 0x33); // c.add
+        case 6: // c.swsp
+          tmp = ((ci >> 7) & 0x3C) | ((ci >> 1) & 0xC0);
+          return enc_s((int32_t)tmp, rs2, 2, 2, 0x23);
+        default:
+          return 0;
+      }
+
+    default:
+      return 0;
+  }
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Function profile (based on the ELF symbol table)
+// ----------------------------------------------------------------------------------------------
+
+typedef struct {
+  uint32_t addr, size;
+  char     *name;
+  uint64_t cycles, count;
+} sym_t;
+
+static sym_t *sym;
+static uint32_t sym_num, sym_last;
+
+static int sym_cmp_addr(const void *a, const void *b) {
+  const sym_t *p = a, *q = b;
+  return (p->addr > q->addr) - (p->addr < q->addr);
+}
+
+static int sym_cmp_cycles(const void *a, const void *b) {
+  const sym_t *p = a, *q = b;
+  return (p->cycles < q->cycles) - (p->cycles > q->cycles);
+}
+
+// find function containing address; returns NULL if there is none
+static sym_t *sym_find(uint32_t addr) {
+
+  uint32_t lo = 0, hi = sym_num;
+
+  if ((sym_last < sym_num) && (addr >= sym[sym_last].addr) && (addr < sym[sym_last].addr + sym[sym_last].size)) {
+    return &sym[sym_last];
+  }
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (addr < sym[mid].addr) {
+      hi = mid;
+    }
+    else if (addr >= sym[mid].addr + sym[mid].size) {
+      lo = mid + 1;
+    }
+    else {
+      sym_last = mid;
+      return &sym[mid];
+    }
+  }
+  return NULL;
+}
+
+static void prof_update(uint32_t addr) {
+
+  sym_t *s;
+
+  if (cfg.profile && ((s = sym_find(addr)) != NULL)) {
+    s->cycles += ins.cost;
+    s->count++;
+  }
+}
+
+static void prof_print(void) {
+
+  uint32_t i;
+
+  if (sym_num == 0) {
+    fprintf(stderr, "[ISS] No function symbols available for profiling.\n");
+    return;
+  }
+  qsort(sym, sym_num, sizeof(sym_t), sym_cmp_cycles);
+  fprintf(stderr, "[ISS] %-32s %14s %7s %14s %6s\n", "function", "cycles", "%", "instructions", "CPI");
+  for (i=0; (i<sym_num) && (i<32) && sym[i].count; i++) {
+    fprintf(stderr, "[ISS] %-32.32s %14llu %6.2f%% %14llu %6.2f\n", sym[i].name, (unsigned long long)sym[i].cycles,
+            100.0 * (double)sym[i].cycles / (double)(cycles ? cycles : 1), (unsigned long long)sym[i].count,
+            (double)sym[i].cycles / (double)sym[i].count);
+  }
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Instruction execution
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t popcount32(uint32_t v) {
+  uint32_t n = 0;
+  for (; v; v &= v - 1) {
+    n++;
+  }
+  return n;
+}
+
+static uint32_t clz32(uint32_t v) {
+  uint32_t n = 0;
+  if (v == 0) {
+    return 32;
+  }
+  while ((v & 0x80000000U) == 0) {
+    v <<= 1;
+    n++;
+  }
+  return n;
+}
+
+static uint32_t ctz32(uint32_t v) {
+  uint32_t n = 0;
+  if (v == 0) {
+    return 32;
+  }
+  while ((v & 1) == 0) {
+    v >>= 1;
+    n++;
+  }
+  return n;
+}
+
+// serial shifter / fast shifter cycles
+static uint32_t shift_cycles(uint32_t base, uint32_t amount) {
+  if (cfg.fast_shift) {
+    return 4;
+  }
+  return base + ((amount) ? amount : 1);
+}
+
+static void rd_write(uint32_t rd, uint32_t val) {
+
+  if (rd == 0) {
+    return;
+  }
+  if (ins.adopt && check_fp) { // use value observed by the reference for non-deterministic sources
+    rec_t *q = ref_peek();
+    if (q && (q->trap == 0) && (q->rd == (int)rd)) {
+      val = q->rd_val;
+    }
+  }
+  x[rd] = val;
+  ins.rd = rd;
+  ins.rd_val = val;
+}
+
+// 32-bit OP / OP-IMM operations; returns 0 if illegal
+static int alu_op(uint32_t ir, uint32_t a, uint32_t b, int imm, uint32_t *res) {
+
+  uint32_t f3 = (ir >> 12) & 7, f7 = ir >> 25, f12 = ir >> 20, sh = b & 0x1F;
+  uint32_t r = 0, cost = CYC_ALU;
+
+  if (imm && ((f3 == 1) || (f3 == 5)) && (f7 & 1) && (f12 != 0x604) && (f12 != 0x605)) {
+    return 0; // shamt[5] set
+  }
+
+  if ((f3 == 1) || (f3 == 5)) { // shifts and friends
+    if ((f7 == 0x00) && (f3 == 1)) { r = a << sh; cost = shift_cycles(3, sh); }
+    else if ((f7 == 0x00) && (f3 == 5)) { r = a >> sh; cost = shift_cycles(3, sh); }
+    else if ((f7 == 0x20) && (f3 == 5)) { r = (uint32_t)((int32_t)a >> sh); cost = shift_cycles(3, sh); }
+    else if ((f7 == 0x30) && (f3 == 1) && !imm) { r = (a << sh) | (a >> ((32 - sh) & 31)); cost = shift_cycles(4, sh); } // rol
+    else if ((f7 == 0x30) && (f3 == 5)) { r = (a >> sh) | (a << ((32 - sh) & 31)); cost = shift_cycles(4, sh); } // ror[i]
+    else if ((f7 == 0x14) && (f3 == 1)) { r = a | (1U << sh); cost = CYC_BITMAN; } // bset[i]
+    else if ((f7 == 0x24) && (f3 == 1)) { r = a & ~(1U << sh); cost = CYC_BITMAN; } // bclr[i]
+    else if ((f7 == 0x34) && (f3 == 1)) { r = a ^ (1U << sh); cost = CYC_BITMAN; } // binv[i]
+    else if ((f7 == 0x24) && (f3 == 5)) { r = (a >> sh) & 1; cost = CYC_BITMAN; } // bext[i]
+    else if (imm && (f3 == 1) && (f12 == 0x600)) { r = clz32(a); cost = cfg.fast_shift ? 4 : 3 + ((r < 32) ? r + 1 : 32); }
+    else if (imm && (f3 == 1) && (f12 == 0x601)) { r = ctz32(a); cost = cfg.fast_shift ? 4 : 3 + ((r < 32) ? r + 1 : 32); }
+    else if (imm && (f3 == 1) && (f12 == 0x602)) { r = popcount32(a); cost = cfg.fast_shift ? 4 : 36; }
+    else if (imm && (f3 == 1) && (f12 == 0x604)) { r = (uint32_t)(int32_t)(int8_t)a; cost = CYC_BITMAN; }
+    else if (imm && (f3 == 1) && (f12 == 0x605)) { r = (uint32_t)(int32_t)(int16_t)a; cost = CYC_BITMAN; }
+    else if (imm && (f3 == 5) && (f12 == 0x287)) { // orc.b
+      int i;
+      for (i=0; i<4; i++) {
+        r |= ((a >> (8*i)) & 0xFF) ? (0xFFU << (8*i)) : 0;
+      }
+      cost = CYC_BITMAN;
+    }
+    else if (imm && (f3 == 5) && (f12 == 0x698)) { // rev8
+      r = (a >> 24) | ((a >> 8) & 0xFF00) | ((a << 8) & 0xFF0000) | (a << 24);
+      cost = CYC_BITMAN;
+    }
+    else if ((f7 == 0x07) && (f3 == 5) && !imm) { r = (b == 0) ? 0 : a; cost = CYC_COND; } // czero.eqz
+    else if ((f7 == 0x01) && !imm) { goto muldiv; }
+    else { return 0; }
+  }
+  else if (imm) {
+    switch (f3) {
+      case 0: r = a + b; break;
+      case 2: r = ((int32_t)a < (int32_t)b) ? 1 : 0; break;
+      case 3: r = (a < b) ? 1 : 0; break;
+      case 4: r = a ^ b; break;
+      case 6: r = a | b; break;
+      default: r = a & b; break;
+    }
+  }
+  else if (f7 == 0x00) {
+    switch (f3) {
+      case 0: r = a + b; break;
+      case 2: r = ((int32_t)a < (int32_t)b) ? 1 : 0; break;
+      case 3: r = (a < b) ? 1 : 0; break;
+      case 4: r = a ^ b; break;
+      case 6: r = a | b; break;
+      default: r = a & b; break;
+    }
+  }
+  else if (f7 == 0x20) {
+    switch (f3) {
+      case 0: r = a - b; break;
+      case 4: r = ~(a ^ b); cost = CYC_BITMAN; break; // xnor
+      case 6: r = a | ~b; cost = CYC_BITMAN; break; // orn
+      case 7: r = a & ~b; cost = CYC_BITMAN; break; // andn
+      default: return 0;
+    }
+  }
+  else if (f7 == 0x05) {
+    switch (f3) {
+      case 4: r = ((int32_t)a < (int32_t)b) ? a : b; break; // min
+      case 5: r = (a < b) ? a : b; break; // minu
+      case 6: r = ((int32_t)a > (int32_t)b) ? a : b; break; // max
+      case 7: r = (a > b) ? a : b; break; // maxu
+      default: return 0;
+    }
+    cost = CYC_BITMAN;
+  }
+  else if ((f7 == 0x10) && ((f3 == 2) || (f3 == 4) || (f3 == 6))) { // sh1add, sh2add, sh3add
+    r = (a << (f3 >> 1)) + b;
+    cost = CYC_BITMAN;
+  }
+  else if ((f7 == 0x04) && (f3 == 4) && (((ir >> 20) & 0x1F) == 0)) { // zext.h
+    r = a & 0xFFFF;
+    cost = CYC_BITMAN;
+  }
+  else if ((f7 == 0x07) && (f3 == 7)) { // czero.nez
+    r = (b != 0) ? 0 : a;
+    cost = CYC_COND;
+  }
+  else if (f7 == 0x01) {
+muldiv:
+    switch (f3) {
+      case 0: r = a * b; break;
+      case 1: r = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(int32_t)b) >> 32); break;
+      case 2: r = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(uint64_t)b) >> 32); break;
+      case 3: r = (uint32_t)(((uint64_t)a * (uint64_t)b) >> 32); break;
+      case 4: r = (b == 0) ? 0xFFFFFFFFU : ((a == 0x80000000U) && (b == 0xFFFFFFFFU)) ? a : (uint32_t)((int32_t)a / (int32_t)b); break;
+      case 5: r = (b == 0) ? 0xFFFFFFFFU : a / b; break;
+      case 6: r = (b == 0) ? a : ((a == 0x80000000U) && (b == 0xFFFFFFFFU)) ? 0 : (uint32_t)((int32_t)a % (int32_t)b); break;
+      default: r = (b == 0) ? a : a % b; break;
+    }
+    cost = ((f3 < 4) && cfg.fast_mul) ? CYC_FASTMUL : CYC_MULDIV;
+  }
+  else {
+    return 0;
+  }
+
+  if (cost > CYC_ALU) {
+    ins.ev[EV_WAIT_ALU] += cost - CYC_ALU;
+  }
+  ins.cost += cost;
+  *res = r;
+  return 1;
+}
+
+// execute one instruction
+static void step(void) {
+
+  uint32_t ir, ci = 0, is_c = 0, tmp = 0, addr, penalty;
+  uint32_t next, rd, rs1, rs2, f3, a, b;
+  rec_t r;
+
+  memset(&ins, 0, sizeof(ins));
+
+  // instruction fetch
+  if (pc & 1) {
+    trap_enter(TRAP_IMA, pc, 0, 0);
+    ins.cost = CYC_SYS;
+    trap_emit();
+    counters_update();
+    return;
+  }
+  if ((mem_ptr(pc, 2) == NULL) || (pc >= IO_BASE)) {
+    trap_enter(TRAP_IAF, pc, 0, 0);
+    ins.cost = CYC_SYS;
+    trap_emit();
+    counters_update();
+    return;
+  }
+  ci = mem_ptr(pc, 2)[0] | ((uint32_t)mem_ptr(pc, 2)[1] << 8);
+  penalty = cache_access(&icache, pc, 0);
+  if ((ci & 3) != 3) {
+    is_c = 1;
+    ir = c_expand(ci);
+    next = pc + 2;
+  }
+  else {
+    if (mem_ptr(pc + 2, 2) == NULL) {
+      trap_enter(TRAP_IAF, pc, 0, 0);
+      ins.cost = CYC_SYS;
+      trap_emit();
+      counters_update();
+      return;
+    }
+    if (((pc + 2) % icache.bsize) == 0) { // instruction crosses a cache block boundary
+      penalty += cache_access(&icache, pc + 2, 0);
+    }
+    ir = ci | ((uint32_t)mem_ptr(pc + 2, 2)[0] << 16) | ((uint32_t)mem_ptr(pc + 2, 2)[1] << 24);
+    next = pc + 4;
+  }
+  ins.cost = penalty;
+  ins.ev[EV_WAIT_DIS] = penalty;
+  ins.ev[EV_IR] = 1;
+  ins.ev[EV_COMPR] = is_c;
+  executed++;
+
+  rd  = (ir >> 7) & 0x1F;
+  rs1 = (ir >> 15) & 0x1F;
+  rs2 = (ir >> 20) & 0x1F;
+  f3  = (ir >> 12) & 7;
+  a   = x[rs1];
+  b   = x[rs2];
+
+  memset(&r, 0, sizeof(r));
+  r.cycle = cycles;
+  r.a     = pc;
+  r.b     = (is_c && ir) ? (ir & ~2U) : ir;
+
+  if (is_c && (cfg.riscv_c == 0)) {
+    ir = 0; // C extension not implemented
+  }
+
+  switch (ir & 0x7F) {
+
+    case 0x37: // lui
+      rd_write(rd, ir & 0xFFFFF000U);
+      ins.cost += CYC_ALU;
+      break;
+
+    case 0x17: // auipc
+      rd_write(rd, pc + (ir & 0xFFFFF000U));
+      ins.cost += CYC_ALU;
+      break;
+
+    case 0x6F: // jal
+    case 0x67: // jalr
+      if (((ir & 0x7F) == 0x67) && (f3 != 0)) {
+        goto illegal;
+      }
+      if ((ir & 0x7F) == 0x6F) {
+        tmp = pc + (uint32_t)sext(((ir >> 31) << 20) | (((ir >> 12) & 0xFF) << 12) | (((ir >> 20) & 1) << 11) |
+                                  (((ir >> 21) & 0x3FF) << 1), 21);
+      }
+      else {
+        tmp = (a + (uint32_t)sext(ir >> 20, 12)) & ~1U;
+      }
+      ins.ev[EV_BRANCH] = 1;
+      ins.cost += CYC_TAKEN;
+      if (tmp & (cfg.riscv_c ? 1 : 3)) {
+        goto misaligned;
+      }
+      rd_write(rd, next);
+      ins.ev[EV_BRANCHED] = 1;
+      next = tmp;
+      break;
+
+    case 0x63: // branch
+      switch (f3) {
+        case 0:  tmp = (a == b); break;
+        case 1:  tmp = (a != b); break;
+        case 4:  tmp = ((int32_t)a < (int32_t)b); break;
+        case 5:  tmp = ((int32_t)a >= (int32_t)b); break;
+        case 6:  tmp = (a < b); break;
+        case 7:  tmp = (a >= b); break;
+        default: goto illegal;
+      }
+      ins.ev[EV_BRANCH] = 1;
+      if (tmp) {
+        tmp = pc + (uint32_t)sext(((ir >> 31) << 12) | (((ir >> 7) & 1) << 11) | (((ir >> 25) & 0x3F) << 5) |
+                                  (((ir >> 8) & 0xF) << 1), 13);
+        ins.cost += CYC_TAKEN;
+        if (tmp & (cfg.riscv_c ? 1 : 3)) {
+          goto misaligned;
+        }
+        ins.ev[EV_BRANCHED] = 1;
+        next = tmp;
+      }
+      else {
+        ins.cost += CYC_BRANCH;
+      }
+      break;
+
+    case 0x03: // load
+      if ((f3 == 3) || (f3 > 5)) {
+        goto illegal;
+      }
+      addr = a + (uint32_t)sext(ir >> 20, 12);
+      ins.cost += is_c ? (CYC_MEM - 1) : CYC_MEM;
+      ins.ev[EV_LOAD] = 1;
+      if (addr & ((1U << (f3 & 3)) - 1)) {
+        trap_enter(TRAP_LMA, pc, addr, ir);
+        break;
+      }
+      if (mem_load(addr, 1U << (f3 & 3), &tmp)) {
+        trap_enter(TRAP_LAF, pc, addr, ir);
+        break;
+      }
+      penalty = cache_access(&dcache, addr, 0);
+      ins.cost += penalty;
+      ins.ev[EV_WAIT_LSU] = penalty;
+      switch (f3) {
+        case 0:  tmp = (uint32_t)(int32_t)(int8_t)tmp; break;
+        case 1:  tmp = (uint32_t)(int32_t)(int16_t)tmp; break;
+        case 4:  tmp &= 0xFF; break;
+        case 5:  tmp &= 0xFFFF; break;
+        default: break;
+      }
+      rd_write(rd, tmp);
+      break;
+
+    case 0x23: // store
+      if (f3 > 2) {
+        goto illegal;
+      }
+      addr = a + (uint32_t)sext(((ir >> 25) << 5) | ((ir >> 7) & 0x1F), 12);
+      ins.cost += is_c ? (CYC_MEM - 1) : CYC_MEM;
+      ins.ev[EV_STORE] = 1;
+      if (addr & ((1U << f3) - 1)) {
+        trap_enter(TRAP_SMA, pc, addr, ir);
+        break;
+      }
+      if (mem_store(addr, 1U << f3, b)) {
+        trap_enter(TRAP_SAF, pc, addr, ir);
+        break;
+      }
+      penalty = cache_access(&dcache, addr, 1);
+      ins.cost += penalty;
+      ins.ev[EV_WAIT_LSU] = penalty;
+      break;
+
+    case 0x2F: // atomic memory operations: lr.w and sc.w only (bypassing the cache)
+      if ((f3 != 2) || ((((ir >> 27) != 0x02) || (rs2 != 0)) && ((ir >> 27) != 0x03))) {
+        goto illegal;
+      }
+      ins.cost += CYC_MEM;
+      if (a & 3) {
+        trap_enter(((ir >> 27) == 0x02) ? TRAP_LMA : TRAP_SMA, pc, a, ir);
+        break;
+      }
+      if ((ir >> 27) == 0x02) { // lr.w
+        ins.ev[EV_LOAD] = 1;
+        if (mem_load(a, 4, &tmp)) {
+          trap_enter(TRAP_LAF, pc, a, ir);
+          break;
+        }
+        rsv_valid = 1;
+        rsv_addr = a;
+        rd_write(rd, tmp);
+      }
+      else { // sc.w
+        ins.ev[EV_STORE] = 1;
+        if (rsv_valid && (rsv_addr == a)) {
+          if (mem_store(a, 4, b)) {
+            trap_enter(TRAP_SAF, pc, a, ir);
+            break;
+          }
+          tmp = 0;
+        }
+        else {
+          tmp = 1;
+        }
+        rsv_valid = 0;
+        rd_write(rd, tmp);
+      }
+      break;
+
+    case 0x13: // OP-IMM
+      if (!alu_op(ir, a, (uint32_t)sext(ir >> 20, 12), 1, &tmp)) {
+        goto illegal;
+      }
+      rd_write(rd, tmp);
+      break;
+
+    case 0x33: // OP
+      if (!alu_op(ir, a, b, 0, &tmp)) {
+        goto illegal;
+      }
+      rd_write(rd, tmp);
+      break;
+
+    case 0x0F: // fence, fence.i, cbo.*
+      if (f3 == 2) { // cache-block operation: M-mode only (menvcfg is hardwired to zero)
+        if ((rd != 0) || (priv != 3) || (dcache.en == 0) || ((ir >> 20) > 4) || ((ir >> 20) == 3)) {
+          goto illegal;
+        }
+        ins.cost += CYC_CBO;
+        ins.ev[EV_STORE] = 1;
+        if ((ir >> 20) == 4) { // cbo.zero
+          if (a >= UNCACHED_BASE) {
+            trap_enter(TRAP_SAF, pc, a, ir);
+            break;
+          }
+          for (tmp=0; tmp<dcache.bsize; tmp+=4) {
+            mem_store((a & ~(dcache.bsize - 1)) + tmp, 4, 0);
+          }
+        }
+        if (a < UNCACHED_BASE) {
+          penalty = cache_cmo(&dcache, a, ir >> 20);
+          ins.cost += penalty;
+          ins.ev[EV_WAIT_LSU] = penalty;
+        }
+        break;
+      }
+      if (f3 > 1) {
+        goto illegal;
+      }
+      penalty = cache_flush(&dcache) + cache_flush(&icache);
+      ins.cost += CYC_FENCE + penalty;
+      ins.ev[EV_WAIT_LSU] = penalty;
+      break;
+
+    case 0x73: // system
+      if (f3 == 0) {
+        if ((rd != 0) || (rs1 != 0)) {
+          goto illegal;
+        }
+        switch (ir >> 20) {
+          case 0x000: // ecall
+            ins.cost += CYC_SYS;
+            trap_enter(TRAP_ENV + priv, pc, 0, ir);
+            break;
+          case 0x001: // ebreak
+            ins.cost += CYC_SYS;
+            trap_enter(TRAP_BRK, pc, 0, is_c ? (ir & ~2U) : ir);
+            break;
+          case 0x302: // mret
+            if (priv != 3) {
+              goto illegal;
+            }
+            ins.cost += CYC_FENCE;
+            priv     = csr.mpp;
+            csr.mie  = csr.mpie;
+            csr.mpie = 1;
+            if (csr.mpp != 3) {
+              csr.mprv = 0;
+            }
+            csr.mpp  = 0;
+            ins.ev[EV_BRANCHED] = 1;
+            next = csr.epc;
+            break;
+          case 0x105: // wfi
+            if ((priv != 3) && csr.tw) {
+              goto illegal;
+            }
+            ins.cost += CYC_SYS;
+            if (check_fp == NULL) { // sleep until an enabled interrupt becomes pending
+              if ((csr.ie & (1U << 7)) && (mtimecmp > mtime_get())) {
+                ins.cost += (uint32_t)(((mtimecmp - mtime_get()) > 0xFFFFFFF0U) ? 0xFFFFFFF0U : (mtimecmp - mtime_get()));
+              }
+              else if ((csr.ie & mip_get()) == 0) {
+                halted = 1; // no wake-up source
+              }
+            }
+            break;
+          default:
+            goto illegal;
+        }
+      }
+      else if (f3 != 4) { // CSR access
+        uint32_t caddr = ir >> 20, src = (f3 & 4) ? rs1 : a, wr;
+        if (csr_read(caddr, &tmp)) {
+          goto illegal;
+        }
+        wr = ((f3 & 3) == 1) || (rs1 != 0);
+        if (wr && ((caddr >> 10) == 3)) { // read-only CSR
+          goto illegal;
+        }
+        ins.cost += CYC_SYS;
+        if (wr) {
+          switch (f3 & 3) {
+            case 1:  csr_write(caddr, src); break;
+            case 2:  csr_write(caddr, tmp | src); break;
+            default: csr_write(caddr, tmp & ~src); break;
+          }
+        }
+        rd_write(rd, tmp);
+      }
+      else {
+        goto illegal;
+      }
+      break;
+
+    default:
+    illegal:
+      ins.cost += CYC_SYS;
+      ins.rd = 0;
+      ins.ncsr = 0;
+      trap_enter(TRAP_IIL, pc, 0, is_c ? (ir & ~2U) : ir);
+      goto done;
+
+    misaligned:
+      ins.rd = 0;
+      trap_enter(TRAP_IMA, pc, 0, is_c ? (ir & ~2U) : ir);
+      goto done;
+  }
+
+  if (ins.trap == 0) {
+    pc = next;
+  }
+
+done:
+  r.rd     = ins.rd;
+  r.rd_val = ins.rd_val;
+  r.ncsr   = ins.ncsr;
+  memcpy(r.csr_addr, ins.csr_addr, sizeof(r.csr_addr));
+  memcpy(r.csr_val, ins.csr_val, sizeof(r.csr_val));
+  rec_emit(&r);
+  if (ins.trap) {
+    trap_emit();
+  }
+  prof_update(r.a);
+  counters_update();
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Executable loader: ELF (PT_LOAD segments), NEORV32 executable (neorv32_exe.bin) or raw binary
+// ----------------------------------------------------------------------------------------------
+
+static uint32_t get16(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int mem_init(uint32_t addr, const uint8_t *data, uint32_t size) {
+
+  uint8_t *p = mem_ptr(addr, size);
+
+  if (p == NULL) {
+    fprintf(stderr, "[ISS] Executable does not fit into memory (0x%08x, %u bytes)!\n", addr, size);
+    return -1;
+  }
+  if (data) {
+    memcpy(p, data, size);
+  }
+  else {
+    memset(p, 0, size);
+  }
+  return 0;
+}
+
+// load ELF symbol table (functions only)
+static void elf_symbols(const uint8_t *elf, uint32_t elf_size) {
+
+  uint32_t shoff = get32(&elf[0x20]), shentsize = get16(&elf[0x2E]), shnum = get16(&elf[0x30]);
+  uint32_t i, j;
+
+  for (i=0; i<shnum; i++) {
+    const uint8_t *sh = &elf[shoff + i*shentsize];
+    if ((shoff + (i+1)*shentsize) > elf_size) {
+      break;
+    }
+    if ((get32(&sh[4]) != 2) || (get32(&sh[24]) >= shnum)) { // SHT_SYMTAB
+      continue;
+    }
+    const uint8_t *strtab_sh = &elf[shoff + get32(&sh[24])*shentsize];
+    uint32_t sym_offs = get32(&sh[16]), sym_size = get32(&sh[20]);
+    uint32_t str_offs = get32(&strtab_sh[16]), str_size = get32(&strtab_sh[20]);
+    if (((sym_offs + sym_size) > elf_size) || ((str_offs + str_size) > elf_size)) {
+      continue;
+    }
+    sym = realloc(sym, (sym_num + sym_size/16) * sizeof(sym_t));
+    if (sym == NULL) {
+      fprintf(stderr, "Out of memory!\n");
+      exit(-1);
+    }
+    for (j=0; (j+16)<=sym_size; j+=16) {
+      const uint8_t *st = &elf[sym_offs + j];
+      if (((st[12] & 0xF) != 2) || (get32(&st[8]) == 0) || (get32(&st[0]) >= str_size)) { // STT_FUNC with size
+        continue;
+      }
+      sym[sym_num].addr   = get32(&st[4]);
+      sym[sym_num].size   = get32(&st[8]);
+      sym[sym_num].name   = strndup((const char*)&elf[str_offs + get32(&st[0])], str_size - get32(&st[0]));
+      sym[sym_num].cycles = 0;
+      sym[sym_num].count  = 0;
+      sym_num++;
+    }
+  }
+  qsort(sym, sym_num, sizeof(sym_t), sym_cmp_addr);
+}
+
+static int load_executable(const char *name) {
+
+  FILE *fp = fopen(name, "rb");
+  uint8_t *buf;
+  long size;
+  uint32_t i;
+  int err = 0;
+
+  if (fp == NULL) {
+    fprintf(stderr, "[ISS] Input file error (%s)!\n", name);
+    return -1;
+  }
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  rewind(fp);
+  buf = malloc(size + 4);
+  if ((buf == NULL) || (fread(buf, 1, size, fp) != (size_t)size)) {
+    fprintf(stderr, "[ISS] Input file error (%s)!\n", name);
+    fclose(fp);
+    return -1;
+  }
+  fclose(fp);
+
+  if ((size >= 0x34) && (memcmp(buf, "\177ELF", 4) == 0)) { // ELF
+    uint32_t phoff = get32(&buf[0x1C]), phentsize = get16(&buf[0x2A]), phnum = get16(&buf[0x2C]);
+    if ((buf[4] != 1) || (buf[5] != 1) || (get16(&buf[0x12]) != 0xF3)) {
+      fprintf(stderr, "[ISS] Not a 32-bit little-endian RISC-V ELF file (%s)!\n", name);
+      free(buf);
+      return -1;
+    }
+    for (i=0; (i<phnum) && (err == 0); i++) {
+      const uint8_t *ph = &buf[phoff + i*phentsize];
+      uint32_t offs = get32(&ph[4]), paddr = get32(&ph[12]), filesz = get32(&ph[16]), memsz = get32(&ph[20]);
+      if ((get32(&ph[0]) != 1) || (memsz == 0)) { // PT_LOAD only
+        continue;
+      }
+      if ((uint64_t)offs + filesz > (uint64_t)size) {
+        fprintf(stderr, "[ISS] Corrupted ELF file (%s)!\n", name);
+        err = -1;
+        break;
+      }
+      err = mem_init(paddr, &buf[offs], filesz);
+      if ((err == 0) && (memsz > filesz)) {
+        err = mem_init(paddr + filesz, NULL, memsz - filesz);
+      }
+    }
+    elf_symbols(buf, (uint32_t)size);
+  }
+  else if ((size >= 12) && (get32(buf) == signature)) { // NEORV32 executable (image_gen -app_bin)
+    err = mem_init(IMEM_BASE, &buf[12], (uint32_t)size - 12);
+  }
+  else { // raw binary (image_gen -raw_bin)
+    err = mem_init(IMEM_BASE, buf, (uint32_t)size);
+  }
+
+  free(buf);
+  return err;
+}
+
+
+// ----------------------------------------------------------------------------------------------
+// Main
+// ----------------------------------------------------------------------------------------------
+
+static void print_help(const char *prog) {
+  printf("<<< NEORV32 cycle-approximate instruction-set simulator >>>\n"
+         "Usage: %s [options] <executable>\n"
+         "The executable can be an ELF file (main.elf), a NEORV32 executable (neorv32_exe.bin) or a raw binary\n"
+         "(neorv32_raw_exe.bin). UART0/UART1 output is written to stdout, all simulator messages go to stderr.\n"
+         "Options:\n"
+         " -imem <bytes>        IMEM size (default: 32768)\n"
+         " -dmem <bytes>        DMEM size (default: 8192)\n"
+         " -clk <hz>            clock frequency (default: 100000000)\n"
+         " -riscv_c             enable the C extension\n"
+         " -slow_mul            serial multiplier (FAST_MUL_EN = false)\n"
+         " -slow_shift          serial shifter (FAST_SHIFT_EN = false)\n"
+         " -icache <n>x<bytes>  i-cache blocks x block size (default: 64x32; 0 = no i-cache)\n"
+         " -dcache <n>x<bytes>  d-cache blocks x block size (default: 32x32; 0 = no d-cache)\n"
+         " -mem_lat <cycles>    bus cycles per word for cache refills and write-backs (default: 2)\n"
+         " -max <cycles>        stop simulation after the given number of clock cycles\n"
+         " -trace <file>        write execution trace\n"
+         " -check <file>        cross-check against reference trace (file or named pipe)\n"
+         " -prof                print function profile (ELF only)\n"
+         " -q                   no summary\n", prog);
+}
+
+static int parse_cache(const char *s, cache_t *c) {
+
+  unsigned int n = 0, bs = 0;
+
+  if (strcmp(s, "0") == 0) {
+    c->en = 0;
+    return 0;
+  }
+  if ((sscanf(s, "%ux%u", &n, &bs) != 2) || (n == 0) || (n & (n-1)) || (bs < 4) || (bs & (bs-1))) {
+    return -1;
+  }
+  c->en = 1;
+  c->blocks = n;
+  c->bsize = bs;
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+  const char *exe = NULL, *trace = NULL, *check = NULL;
+  int i;
+
+  for (i=1; i<argc; i++) {
+    int more = (i+1) < argc;
+    if      ((strcmp(argv[i], "-imem") == 0) && more) { cfg.imem_size = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-dmem") == 0) && more) { cfg.dmem_size = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-clk") == 0) && more)  { cfg.clock = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if (strcmp(argv[i], "-riscv_c") == 0)        { cfg.riscv_c = 1; }
+    else if (strcmp(argv[i], "-slow_mul") == 0)       { cfg.fast_mul = 0; }
+    else if (strcmp(argv[i], "-slow_shift") == 0)     { cfg.fast_shift = 0; }
+    else if ((strcmp(argv[i], "-icache") == 0) && more) {
+      if (parse_cache(argv[++i], &icache)) { fprintf(stderr, "[ISS] Invalid i-cache configuration!\n"); return -1; }
+    }
+    else if ((strcmp(argv[i], "-dcache") == 0) && more) {
+      if (parse_cache(argv[++i], &dcache)) { fprintf(stderr, "[ISS] Invalid d-cache configuration!\n"); return -1; }
+    }
+    else if ((strcmp(argv[i], "-mem_lat") == 0) && more) { cfg.mem_lat = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-max") == 0) && more)     { cfg.max_cycles = strtoull(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-trace") == 0) && more)   { trace = argv[++i]; }
+    else if ((strcmp(argv[i], "-check") == 0) && more)   { check = argv[++i]; }
+    else if (strcmp(argv[i], "-prof") == 0)              { cfg.profile = 1; }
+    else if (strcmp(argv[i], "-q") == 0)                 { cfg.quiet = 1; }
+    else if ((argv[i][0] != '-') && (exe == NULL))       { exe = argv[i]; }
+    else {
+      print_help(argv[0]);
+      return -1;
+    }
+  }
+  if (exe == NULL) {
+    print_help(argv[0]);
+    return -1;
+  }
+
+  // setup
+  imem = calloc(cfg.imem_size, 1);
+  dmem = calloc(cfg.dmem_size, 1);
+  if ((imem == NULL) || (dmem == NULL)) {
+    fprintf(stderr, "Out of memory!\n");
+    return -1;
+  }
+  cache_init(&icache);
+  cache_init(&dcache);
+  if (load_executable(exe)) {
+    return -1;
+  }
+  if (trace && ((trace_fp = fopen(trace, "w")) == NULL)) {
+    fprintf(stderr, "[ISS] Cannot open trace file (%s)!\n", trace);
+    return -1;
+  }
+  if (check && ((check_fp = fopen(check, "r")) == NULL)) {
+    fprintf(stderr, "[ISS] Cannot open reference trace (%s)!\n", check);
+    return -1;
+  }
+
+  // reset state (see rtl/core/neorv32_cpu_control.vhd)
+  pc       = IMEM_BASE;
+  priv     = 3;
+  csr.tvec = IMEM_BASE;
+  csr.epc  = IMEM_BASE;
+  csr.mpp  = 3;
+
+  // simulation loop
+  while (halted == 0) {
+    if (cfg.max_cycles && (cycles >= cfg.max_cycles)) {
+      fprintf(stderr, "[ISS] Simulation time limit reached.\n");
+      break;
+    }
+    memset(&ins, 0, sizeof(ins));
+    if (check_fp) { // interrupts are taken whenever the reference takes them
+      rec_t *q = ref_peek();
+      if (q == NULL) {
+        break;
+      }
+      if (q->trap && (q->a & 0x80000000U)) {
+        trap_enter(q->a, pc, 0, 0);
+        ins.cost = CYC_IRQ;
+        trap_emit();
+        counters_update();
+        continue;
+      }
+    }
+    else if ((priv != 3) || csr.mie) {
+      if (csr.ie & mip_get() & (1U << 7)) {
+        trap_enter(TRAP_MTI, pc, 0, 0);
+        ins.cost = CYC_IRQ;
+        trap_emit();
+        counters_update();
+        continue;
+      }
+    }
+    step();
+  }
+  fflush(stdout);
+
+  // summary
+  if (cfg.quiet == 0) {
+    fprintf(stderr, "\n[ISS] Executed instructions: %llu\n", (unsigned long long)executed);
+    fprintf(stderr, "[ISS] Clock cycles:          %llu (%.3f ms @ %u Hz)\n", (unsigned long long)cycles,
+            1000.0 * (double)cycles / (double)cfg.clock, cfg.clock);
+    fprintf(stderr, "[ISS] Average CPI:           %.3f\n", (double)cycles / (double)(executed ? executed : 1));
+    if (icache.en) {
+      fprintf(stderr, "[ISS] i-cache:               %llu hits, %llu misses\n",
+              (unsigned long long)icache.hit, (unsigned long long)icache.miss);
+    }
+    if (dcache.en) {
+      fprintf(stderr, "[ISS] d-cache:               %llu hits, %llu misses, %llu write-backs\n",
+              (unsigned long long)dcache.hit, (unsigned long long)dcache.miss, (unsigned long long)dcache.wb);
+    }
+    fprintf(stderr, "[ISS] mscratch (exit code):  0x%08x\n", csr.scratch);
+    if (check_fp) {
+      fprintf(stderr, "[ISS] Cross-check PASSED: %llu records identical\n", (unsigned long long)checked);
+      fprintf(stderr, "[ISS] Cycles (checked range): ISS %llu, reference %llu (%+.2f%%)\n",
+              (unsigned long long)iss_cycles, (unsigned long long)ref_cycles,
+              ref_cycles ? (100.0 * ((double)iss_cycles - (double)ref_cycles) / (double)ref_cycles) : 0.0);
+      fprintf(stderr, "[ISS] Per-instruction deviation: %.3f cycles average, %llu cycles max (at 0x%08x)\n",
+              checked ? (double)dev_sum / (double)checked : 0.0, (unsigned long long)dev_max, dev_max_pc);
+    }
+    if (cfg.profile) {
+      prof_print();
+    }
+  }
+
+  if (trace_fp) {
+    fclose(trace_fp);
+  }
+  if (check_fp) {
+    fclose(check_fp);
+  }
+  return 0;
+}
@@ -31,7 +31,9 @@ use work.uart_rx_pkg.all;
 
 entity neorv32_tb is
   generic (runner_cfg : string := runner_cfg_default;
-           ci_mode : boolean := false);
+           ci_mode : boolean := false;
+           imem_file : string := ""; -- executable file (plain hex or raw *.bin) for the IMEM, VHDL application image if empty
+           trace_file : string := ""); -- retired-instruction trace output (file or named pipe), no trace if empty
 end neorv32_tb;
 
 architecture neorv32_tb_rtl of neorv32_tb is
@@ -64,6 +66,16 @@ architecture neorv32_tb_rtl of neorv32_tb is
   constant irq_trigger_base_addr_c : std_ulogic_vector(31 downto 0) := x"FF000000";
   -- -------------------------------------------------------------------------------------------
 
+  -- external IMEM initialization: executable file or VHDL application image --
+  impure function ext_mem_a_init_f return mem32_t is
+  begin
+    if (imem_file'length /= 0) then
+      return mem32_load_f(imem_file, ext_mem_a_size_c/4);
+    else
+      return mem32_init_f(application_init_image, ext_mem_a_size_c/4);
+    end if;
+  end function ext_mem_a_init_f;
+
   -- internals - hands off! --
   constant uart0_baud_val_c : real := real(f_clock_c) / real(baud0_rate_c);
   constant uart1_baud_val_c : real := real(f_clock_c) / real(baud1_rate_c);
@@ -94,6 +106,11 @@ architecture neorv32_tb_rtl of neorv32_tb is
 
   -- irq --
   signal msi_ring, mei_ring : std_ulogic;
+  signal irq_elapsed        : unsigned(31 downto 0); -- clock cycles since last IRQ assertion
+  signal cycle_cnt          : natural; -- clock cycles since reset
+
+  -- co-simulation trace --
+  signal trace_done : std_ulogic := '0'; -- program has terminated (sleeping with all interrupt sources disabled)
 
   -- SLINK echo --
   signal slink_dat : std_ulogic_vector(31 downto 0);
@@ -147,30 +164,37 @@ begin
     show(uart0_rx_logger, display_handler, pass);
     show(uart1_rx_logger, display_handler, pass);
 
-    if ci_mode then
-      check_uart(net, uart0_rx_handle, nul & nul);
+    if (trace_file'length /= 0) then
+      -- Co-simulation: there is no expected UART output (the application should
+      -- use the UARTs' simulation mode); just run the program until it terminates
+      set_timeout(runner, 10 sec);
+      wait until (trace_done = '1');
     else
-      check_uart(net, uart0_rx_handle, "Blinking LED demo program" & cr & lf);
-    end if;
-
-    if ci_mode then
-      -- No need to send the full expectation in one big chunk
-      check_uart(net, uart1_rx_handle, nul & nul);
-      check_uart(net, uart1_rx_handle, "0/55" & cr & lf);
-    end if;
+      if ci_mode then
+        check_uart(net, uart0_rx_handle, nul & nul);
+      else
+        check_uart(net, uart0_rx_handle, "Blinking LED demo program" & cr & lf);
+      end if;
 
-    -- Wait until all expected data has been received
-    --
-    -- wait_until_idle can take the VC actor as argument but
-    -- the more abstract view is that wait_until_idle is part
-    -- of the sync VCI and to use it a VC must be cast
-    -- to a sync VC
-    wait_until_idle(net, as_sync(uart0_rx_handle));
-    wait_until_idle(net, as_sync(uart1_rx_handle));
+      if ci_mode then
+        -- No need to send the full expectation in one big chunk
+        check_uart(net, uart1_rx_handle, nul & nul);
+        check_uart(net, uart1_rx_handle, "0/55" & cr & lf);
+      end if;
 
-    -- Wait a bit more if some extra unexpected data is produced. If so,
-    -- uart_rx will fail
-    wait for (20 * (1e9 / baud0_rate_c)) * ns;
+      -- Wait until all expected data has been received
+      --
+      -- wait_until_idle can take the VC actor as argument but
+      -- the more abstract view is that wait_until_idle is part
+      -- of the sync VCI and to use it a VC must be cast
+      -- to a sync VC
+      wait_until_idle(net, as_sync(uart0_rx_handle));
+      wait_until_idle(net, as_sync(uart1_rx_handle));
+
+      -- Wait a bit more if some extra unexpected data is produced. If so,
+      -- uart_rx will fail
+      wait for (20 * (1e9 / baud0_rate_c)) * ns;
+    end if;
 
     test_runner_cleanup(runner);
   end process;
@@ -227,6 +251,7 @@ begin
     -- Internal Instruction memory --
     MEM_INT_IMEM_EN              => int_imem_c ,   -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            => imem_size_c,   -- size of processor-internal instruction memory in bytes
+    MEM_INT_IMEM_FILE            => imem_file,     -- executable file for the processor-internal instruction memory
     -- Internal Data memory --
     MEM_INT_DMEM_EN              => int_dmem_c,    -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            => dmem_size_c,   -- size of processor-internal data memory in bytes
@@ -447,7 +472,7 @@ begin
   generate_ext_imem:
   if (int_imem_c = false) generate
     ext_mem_a_access: process(clk_gen)
-      variable ext_ram_a : mem32_t(0 to ext_mem_a_size_c/4-1) := mem32_init_f(application_init_image, ext_mem_a_size_c/4); -- initialized, used to simulate external IMEM
+      variable ext_ram_a : mem32_t(0 to ext_mem_a_size_c/4-1) := ext_mem_a_init_f; -- initialized, used to simulate external IMEM
     begin
       if rising_edge(clk_gen) then
         -- control --
@@ -590,20 +615,145 @@ begin
   irq_trigger: process(rst_gen, clk_gen)
   begin
     if (rst_gen = '0') then
-      msi_ring <= '0';
-      mei_ring <= '0';
+      msi_ring    <= '0';
+      mei_ring    <= '0';
+      irq_elapsed <= (others => '0');
     elsif rising_edge(clk_gen) then
       -- bus interface --
       wb_irq.rdata <= (others => '0');
-      wb_irq.ack   <= wb_irq.cyc and wb_irq.stb and wb_irq.we and and_reduce_f(wb_irq.sel);
+      wb_irq.ack   <= wb_irq.cyc and wb_irq.stb and (not wb_irq.we or and_reduce_f(wb_irq.sel));
       wb_irq.err   <= '0';
       -- trigger RISC-V platform IRQs --
+      irq_elapsed <= irq_elapsed + 1;
       if ((wb_irq.cyc and wb_irq.stb and wb_irq.we and and_reduce_f(wb_irq.sel)) = '1') then
         msi_ring <= wb_irq.wdata(03); -- machine software interrupt
         mei_ring <= wb_irq.wdata(11); -- machine software interrupt
+        if ((wb_irq.wdata(03) and (not msi_ring)) = '1') or ((wb_irq.wdata(11) and (not mei_ring)) = '1') then
+          irq_elapsed <= (others => '0'); -- IRQ pin is asserted in the next cycle
+        end if;
+      end if;
+      -- read-back: clock cycles since last IRQ assertion (for interrupt latency measurements) --
+      if ((wb_irq.cyc and wb_irq.stb and (not wb_irq.we)) = '1') then
+        wb_irq.rdata <= std_ulogic_vector(irq_elapsed);
       end if;
     end if;
   end process irq_trigger;
 
+  -- log IRQ pin assertions with cycle time stamp --
+  irq_timestamp: process(rst_gen, clk_gen)
+    file     file_irq_out : text open write_mode is "neorv32.testbench_irq.out";
+    variable line_v       : line;
+    variable msi_v, mei_v : std_ulogic;
+  begin
+    if (rst_gen = '0') then
+      cycle_cnt <= 0;
+      msi_v     := '0';
+      mei_v     := '0';
+    elsif rising_edge(clk_gen) then
+      cycle_cnt <= cycle_cnt + 1;
+      if (msi_ring = '1') and (msi_v = '0') then
+        write(line_v, string'("MSI @cycle ")); write(line_v, cycle_cnt); write(line_v, string'(" (")); write(line_v, now); write(line_v, string'(")"));
+        writeline(file_irq_out, line_v);
+      end if;
+      if (mei_ring = '1') and (mei_v = '0') then
+        write(line_v, string'("MEI @cycle ")); write(line_v, cycle_cnt); write(line_v, string'(" (")); write(line_v, now); write(line_v, string'(")"));
+        writeline(file_irq_out, line_v);
+      end if;
+      msi_v := msi_ring;
+      mei_v := mei_ring;
+    end if;
+  end process irq_timestamp;
+
+
+  -- Co-Simulation Trace Monitor ------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- Streams one record per executed instruction / trap entry using the record format of the
+  -- instruction-set simulator (sim/iss) so the trace can be checked in lock-step by "neorv32_iss -check":
+  --   I <cycle> <pc> <instruction> [x<rd>=<value>] [c<csr>=<value> ...]
+  --   T <cycle> <mcause> <mepc>
+  trace_monitor_enable:
+  if (trace_file'length /= 0) generate
+    -- CPU internals (VHDL-2008 external names) --
+    alias cpu_ctrl     is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.ctrl : ctrl_bus_t>>;
+    alias cpu_rf_wdata is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.rf_wdata : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_pc       is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.curr_pc : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_csr_we   is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.xcsr_we : std_ulogic>>;
+    alias cpu_csr_addr is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.xcsr_addr : std_ulogic_vector(11 downto 0)>>;
+    alias cpu_csr_data is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.xcsr_wdata : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_event    is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.neorv32_cpu_control_inst.cnt_event : std_ulogic_vector(hpmcnt_event_size_c-1 downto 0)>>;
+    alias cpu_ir       is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.neorv32_cpu_control_inst.simulation_trace.trace_ir : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_mcause   is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.neorv32_cpu_control_inst.simulation_trace.trace_mcause : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_mepc     is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.neorv32_cpu_control_inst.simulation_trace.trace_mepc : std_ulogic_vector(31 downto 0)>>;
+    alias cpu_debug    is <<signal .neorv32_tb.neorv32_top_inst.core_complex.neorv32_cpu_inst.neorv32_cpu_control_inst.simulation_trace.trace_debug : std_ulogic>>;
+  begin
+
+    trace_monitor: process(clk_gen)
+      file     file_trace_out : text open write_mode is trace_file;
+      variable line_v         : line; -- pending instruction record
+      variable csr_v          : line; -- CSR writes of pending instruction
+      variable rd_v           : line; -- register file write-back of pending instruction
+      variable pending_v      : boolean := false;
+      variable mie_v          : std_ulogic_vector(31 downto 0) := (others => '0'); -- shadow copy of the mie CSR
+
+      procedure flush_record is
+      begin
+        if pending_v then
+          if (rd_v /= null) then
+            write(line_v, rd_v.all);
+            deallocate(rd_v);
+          end if;
+          if (csr_v /= null) then
+            write(line_v, csr_v.all);
+            deallocate(csr_v);
+          end if;
+          writeline(file_trace_out, line_v);
+          pending_v := false;
+        end if;
+      end procedure flush_record;
+
+    begin
+      if rising_edge(clk_gen) then
+        -- side effects of the pending instruction (always committed before the next instruction executes) --
+        if pending_v and (cpu_ctrl.rf_wb_en = '1') and (cpu_ctrl.rf_rd /= "00000") then
+          deallocate(rd_v);
+          write(rd_v, string'(" x")); write(rd_v, to_integer(unsigned(cpu_ctrl.rf_rd)));
+          write(rd_v, '=' & to_hstring32_f(cpu_rf_wdata));
+        end if;
+        if (cpu_csr_we = '1') then
+          if pending_v then
+            write(csr_v, string'(" c") & to_hexchar_f(cpu_csr_addr(11 downto 8)) &
+                         to_hexchar_f(cpu_csr_addr(7 downto 4)) & to_hexchar_f(cpu_csr_addr(3 downto 0)));
+            write(csr_v, '=' & to_hstring32_f(cpu_csr_data));
+          end if;
+          if (cpu_csr_addr = csr_mie_c) then
+            mie_v := cpu_csr_data;
+          end if;
+        end if;
+        -- trap entry --
+        if (cpu_ctrl.cpu_trap = '1') and (cpu_debug = '0') then
+          flush_record;
+          write(line_v, string'("T ")); write(line_v, cycle_cnt);
+          write(line_v, ' ' & to_hstring32_f(cpu_mcause) & ' ' & to_hstring32_f(cpu_mepc));
+          writeline(file_trace_out, line_v);
+        end if;
+        -- instruction execution --
+        if (cpu_event(hpmcnt_event_ir_c) = '1') and (cpu_debug = '0') then
+          flush_record;
+          write(line_v, string'("I ")); write(line_v, cycle_cnt);
+          write(line_v, ' ' & to_hstring32_f(cpu_pc) & ' ' & to_hstring32_f(cpu_ir));
+          pending_v := true;
+        end if;
+        -- sleep mode: nothing left to commit; program has terminated if it can never wake up again --
+        if (cpu_ctrl.cpu_sleep = '1') then
+          flush_record;
+          if (mie_v = x"00000000") then
+            trace_done <= '1';
+          end if;
+        end if;
+      end if;
+    end process trace_monitor;
+
+  end generate;
+
 
 end neorv32_tb_rtl;
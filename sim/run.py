@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 
 import json
+import os
 from pathlib import Path
 from vunit import VUnit, VUnitCLI
 
@@ -23,14 +24,18 @@ ROOT = Path(__file__).parent
 
 NEORV32 = PRJ.add_library("neorv32")
 NEORV32.add_source_files([
-    ROOT / "*.vhd",
-    ROOT / ".." / "rtl" / "**" / "*.vhd",
-    # In VUnit <=v4.5.0, the glob search is not recursive,
-    # hence subdir 'mem' is not picked by the previous pattern
-    ROOT / ".." / "rtl" / "core" / "mem" / "*.vhd"
+    file for file in [*ROOT.glob("*.vhd"), *(ROOT / ".." / "rtl").rglob("*.vhd")]
+    # Alternative to neorv32_imem.default.vhd (same architecture name)
+    if file.name != "neorv32_imem.textio.vhd"
 ])
 
 NEORV32.test_bench("neorv32_tb").set_generic("ci_mode", args.ci_mode)
+# Optional executable file loaded into the IMEM at simulation start (no re-analysis of the application image)
+if os.environ.get("NEORV32_IMEM_FILE"):
+    NEORV32.test_bench("neorv32_tb").set_generic("imem_file", str(Path(os.environ["NEORV32_IMEM_FILE"]).resolve()))
+# Optional retired-instruction trace output (file or named pipe) for lock-step co-simulation (see sim/iss/cosim.sh)
+if os.environ.get("NEORV32_TRACE_FILE"):
+    NEORV32.test_bench("neorv32_tb").set_generic("trace_file", str(Path(os.environ["NEORV32_TRACE_FILE"]).resolve()))
 
 PRJ.set_sim_option("disable_ieee_warnings", True)
 PRJ.set_sim_option("ghdl.sim_flags", ["--max-stack-alloc=256"])
@@ -50,7 +55,7 @@ def _gen_vhdl_ls(vu):
             f.write(f"[libraries.{lib.name}]\n")
             files = [str(file).replace('\\', '/') for file in lib._source_files
                 # Conflicts with *.default.vhd
-                if not any(exclude in file for exclude in ('neorv32_imem.simple.vhd', 'neorv32_imem.legacy.vhd', 'neorv32_dmem.legacy.vhd'))
+                if not any(exclude in file for exclude in ('neorv32_imem.simple.vhd', 'neorv32_imem.legacy.vhd', 'neorv32_imem.textio.vhd', 'neorv32_dmem.legacy.vhd'))
             ]
             f.write(f"files = {json.dumps(files, indent=4)}\n")
 
@@ -2,6 +2,12 @@
 
 set -e
 
+# Optional executable file (plain hex or raw *.bin) that is loaded into IMEM at simulation start
+# (instead of the VHDL application image); resolve it before changing the working directory
+if [ -n "$NEORV32_IMEM_FILE" ]; then
+  NEORV32_IMEM_FILE=$(realpath "$NEORV32_IMEM_FILE")
+fi
+
 cd $(dirname "$0")
 
 echo "Tip: Compile application with USER_FLAGS+=-DUART[0/1]_SIM_MODE to auto-enable UART[0/1]'s simulation mode (redirect UART output to simulator console)."
@@ -30,6 +36,14 @@ if [ -z "$1" ]
     GHDL_RUN_ARGS=$@
 fi
 
+if [ -n "$NEORV32_IMEM_FILE" ]; then
+  GHDL_RUN_ARGS="-gIMEM_FILE=$NEORV32_IMEM_FILE $GHDL_RUN_ARGS"
+fi
+
+if [ -n "$NEORV32_FAST_SIM" ]; then
+  GHDL_RUN_ARGS="-gFAST_SIM=true $GHDL_RUN_ARGS"
+fi
+
 echo "Using simulation run arguments: $GHDL_RUN_ARGS";
 
 runcmd="$GHDL -r --work=neorv32 --workdir=build neorv32_tb_simple \
@@ -8,9 +8,16 @@ NEORV32_LOCAL_RTL=${NEORV32_LOCAL_RTL:-../../rtl}
 
 mkdir -p build
 
+# Fast simulation: use the behavioral memory models from this folder instead of the RTL memory architectures
+if [ -n "$NEORV32_FAST_SIM" ]; then
+  NEORV32_MEM_SRC="neorv32_imem.fast.vhd neorv32_dmem.fast.vhd"
+else
+  NEORV32_MEM_SRC="$NEORV32_LOCAL_RTL/core/mem/neorv32_*mem.default.vhd $NEORV32_LOCAL_RTL/core/mem/neorv32_*mem.legacy.vhd"
+fi
+
 ghdl -i --work=neorv32 --workdir=build \
   "$NEORV32_LOCAL_RTL"/core/*.vhd \
-  "$NEORV32_LOCAL_RTL"/core/mem/*.vhd \
+  $NEORV32_MEM_SRC \
   "$NEORV32_LOCAL_RTL"/processor_templates/*.vhd \
   "$NEORV32_LOCAL_RTL"/system_integration/*.vhd \
   "$NEORV32_LOCAL_RTL"/test_setups/*.vhd \
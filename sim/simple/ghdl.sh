@@ -3,6 +3,11 @@
 # Abort if any command returns != 0
 set -e
 
+# Resolve optional IMEM executable file (see ghdl.run.sh) before changing the working directory
+if [ -n "$NEORV32_IMEM_FILE" ]; then
+  export NEORV32_IMEM_FILE=$(realpath "$NEORV32_IMEM_FILE")
+fi
+
 cd $(dirname "$0")
 
 ./ghdl.setup.sh
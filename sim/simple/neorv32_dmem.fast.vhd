@@ -0,0 +1,74 @@
+-- ================================================================================ --
+-- NEORV32 SoC - Processor-Internal Data Memory (DMEM); Fast Simulation Model       --
+-- -------------------------------------------------------------------------------- --
+-- Behavioral simulation-only architecture: the memory is a single process variable --
+-- (no per-byte signal arrays) to speed up simulation. The bus timing is identical  --
+-- to the default architecture so CPU cycle counts do not change.                   --
+-- -------------------------------------------------------------------------------- --
+-- The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              --
+-- Copyright (c) NEORV32 contributors.                                              --
+-- Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  --
+-- Licensed under the BSD-3-Clause license, see LICENSE for details.                --
+-- SPDX-License-Identifier: BSD-3-Clause                                            --
+-- ================================================================================ --
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+architecture neorv32_dmem_rtl of neorv32_dmem is
+
+  -- local signals --
+  signal rdata : std_ulogic_vector(31 downto 0);
+  signal rden  : std_ulogic;
+
+begin
+
+  -- Sanity Checks --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  assert false report
+    "[NEORV32] Implementing FAST-SIMULATION processor-internal DMEM." severity note;
+
+
+  -- Memory Access --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  mem_access: process(clk_i)
+    variable mem_v  : mem32_t(0 to DMEM_SIZE/4-1); -- uninitialized like the default architecture
+    variable addr_v : natural range 0 to DMEM_SIZE/4-1;
+  begin
+    if rising_edge(clk_i) and (bus_req_i.stb = '1') then
+      addr_v := to_integer(unsigned(bus_req_i.addr(index_size_f(DMEM_SIZE/4)+1 downto 2))); -- word aligned
+      if (bus_req_i.rw = '1') then
+        for i in 0 to 3 loop
+          if (bus_req_i.ben(i) = '1') then
+            mem_v(addr_v)(i*8+7 downto i*8) := bus_req_i.data(i*8+7 downto i*8);
+          end if;
+        end loop;
+      else
+        rdata <= mem_v(addr_v);
+      end if;
+    end if;
+  end process mem_access;
+
+
+  -- Bus Feedback ---------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  bus_feedback: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      rden          <= '0';
+      bus_rsp_o.ack <= '0';
+    elsif rising_edge(clk_i) then
+      rden          <= bus_req_i.stb and (not bus_req_i.rw);
+      bus_rsp_o.ack <= bus_req_i.stb;
+    end if;
+  end process bus_feedback;
+
+  bus_rsp_o.data <= rdata when (rden = '1') else (others => '0'); -- output gate
+  bus_rsp_o.err  <= '0'; -- no access error possible
+
+
+end neorv32_dmem_rtl;
@@ -21,7 +21,18 @@ use std.textio.all;
 
 entity neorv32_tb_simple is
   generic (
-    PERFORMANCE_OPTION : natural := 0 -- Set core options for performance measurements
+    PERFORMANCE_OPTION : natural := 0; -- Set core options for performance measurements
+    -- per-option overrides of the PERFORMANCE_OPTION configuration (0 = disabled, 1 = enabled, 2 = use configuration) --
+    OPT_FAST_MUL       : natural := 2; -- FAST_MUL_EN
+    OPT_FAST_SHIFT     : natural := 2; -- FAST_SHIFT_EN
+    OPT_ICACHE         : natural := 2; -- ICACHE_EN
+    OPT_DCACHE         : natural := 2; -- DCACHE_EN
+    OPT_RISCV_C        : natural := 2; -- CPU_EXTENSION_RISCV_C
+    -- executable file (plain hex or raw *.bin) loaded into the (internal or external) IMEM at simulation start;
+    -- the VHDL application image is used if empty --
+    IMEM_FILE          : string  := "";
+    -- fast simulation: omit the bit-level testbench UART receivers (use UART simulation mode instead) --
+    FAST_SIM           : boolean := false
   );
 end neorv32_tb_simple;
 
@@ -34,6 +45,7 @@ architecture neorv32_tb_simple_rtl of neorv32_tb_simple is
   type bool_t is array (0 to num_configs_c-1) of boolean;
   type natural_t is array (0 to num_configs_c-1) of natural;
   type performance_options_type_t is record
+    riscv_c_en_c        : bool_t;
     fast_mul_en_c       : bool_t;
     fast_shift_en_c     : bool_t;
     imem_size_c         : natural_t;
@@ -49,6 +61,7 @@ architecture neorv32_tb_simple_rtl of neorv32_tb_simple is
   -- core performance options --
   constant performance_options_c : performance_options_type_t := (
     --                       default  fast core  area core
+    riscv_c_en_c        => (   false,     false,     false), -- Compressed instructions
     fast_mul_en_c       => (    true,      true,     false), -- Fast multiplication, more area
     fast_shift_en_c     => (    true,      true,     false), -- Fast shifting, more area
     imem_size_c         => ( 32*1024,  128*1024,  128*1024), -- Instruction memory size min. 128kB for performance tests
@@ -81,6 +94,33 @@ architecture neorv32_tb_simple_rtl of neorv32_tb_simple is
   constant irq_trigger_base_addr_c : std_ulogic_vector(31 downto 0) := x"FF000000";
   -- -------------------------------------------------------------------------------------------
 
+  -- option override helper --
+  function opt_sel_f(sel : natural; cfg : boolean) return boolean is
+  begin
+    case sel is
+      when 0      => return false;
+      when 1      => return true;
+      when others => return cfg;
+    end case;
+  end function opt_sel_f;
+
+  -- final core configuration --
+  constant cfg_riscv_c_c    : boolean := opt_sel_f(OPT_RISCV_C,    performance_options_c.riscv_c_en_c(PERFORMANCE_OPTION));
+  constant cfg_fast_mul_c   : boolean := opt_sel_f(OPT_FAST_MUL,   performance_options_c.fast_mul_en_c(PERFORMANCE_OPTION));
+  constant cfg_fast_shift_c : boolean := opt_sel_f(OPT_FAST_SHIFT, performance_options_c.fast_shift_en_c(PERFORMANCE_OPTION));
+  constant cfg_icache_c     : boolean := opt_sel_f(OPT_ICACHE,     performance_options_c.icache_en_c(PERFORMANCE_OPTION));
+  constant cfg_dcache_c     : boolean := opt_sel_f(OPT_DCACHE,     performance_options_c.dcache_en_c(PERFORMANCE_OPTION));
+
+  -- external IMEM initialization: executable file or VHDL application image --
+  impure function ext_mem_a_init_f return mem32_t is
+  begin
+    if (IMEM_FILE'length /= 0) then
+      return mem32_load_f(IMEM_FILE, ext_mem_a_size_c/4);
+    else
+      return mem32_init_f(application_init_image, ext_mem_a_size_c/4);
+    end if;
+  end function ext_mem_a_init_f;
+
   -- internals - hands off! --
   constant uart0_baud_val_c : real := real(f_clock_c) / real(baud0_rate_c);
   constant uart1_baud_val_c : real := real(f_clock_c) / real(baud1_rate_c);
@@ -114,6 +154,8 @@ architecture neorv32_tb_simple_rtl of neorv32_tb_simple is
 
   -- irq --
   signal msi_ring, mei_ring : std_ulogic;
+  signal irq_elapsed        : unsigned(31 downto 0); -- clock cycles since last IRQ assertion
+  signal cycle_cnt          : natural; -- clock cycles since reset
 
   -- SLINK echo --
   signal slink_dat : std_ulogic_vector(31 downto 0);
@@ -172,19 +214,31 @@ begin
     -- RISC-V CPU Extensions --
     CPU_EXTENSION_RISCV_A        => true,          -- implement atomic memory operations extension?
     CPU_EXTENSION_RISCV_B        => true,          -- implement bit-manipulation extension?
-    CPU_EXTENSION_RISCV_C        => false,         -- implement compressed extension?
+    CPU_EXTENSION_RISCV_C        => cfg_riscv_c_c, -- implement compressed extension?
     CPU_EXTENSION_RISCV_E        => false,         -- implement embedded RF extension?
     CPU_EXTENSION_RISCV_M        => true,          -- implement mul/div extension?
     CPU_EXTENSION_RISCV_U        => true,          -- implement user mode extension?
+    CPU_EXTENSION_RISCV_Zbc      => true,          -- implement carry-less multiplication instructions (clmul[h|r])?
+    CPU_EXTENSION_RISCV_Zbkb     => true,          -- implement bit-manipulation instructions for cryptography?
+    CPU_EXTENSION_RISCV_Zbkc     => true,          -- implement carry-less multiplication instructions?
+    CPU_EXTENSION_RISCV_Zbkx     => true,          -- implement cryptography crossbar permutation instructions?
+    CPU_EXTENSION_RISCV_Zcb      => cfg_riscv_c_c, -- implement additional simple compressed instructions (requires C)?
+    CPU_EXTENSION_RISCV_Zcmp     => cfg_riscv_c_c, -- implement compressed push/pop and register-move instructions (requires C)?
     CPU_EXTENSION_RISCV_Zfinx    => true,          -- implement 32-bit floating-point extension (using INT reg!)
+    CPU_EXTENSION_RISCV_Zicbom   => true,          -- implement cache-block management operations (requires d-cache)?
+    CPU_EXTENSION_RISCV_Zicboz   => true,          -- implement cache-block zero operation (requires d-cache)?
     CPU_EXTENSION_RISCV_Zicntr   => true,          -- implement base counters?
     CPU_EXTENSION_RISCV_Zicond   => true,          -- implement integer conditional operations?
     CPU_EXTENSION_RISCV_Zihpm    => true,          -- implement hardware performance monitors?
+    CPU_EXTENSION_RISCV_Zknd     => true,          -- implement NIST suite: AES decryption instructions?
+    CPU_EXTENSION_RISCV_Zkne     => true,          -- implement NIST suite: AES encryption instructions?
+    CPU_EXTENSION_RISCV_Zknh     => true,          -- implement NIST suite: hash function instructions?
     CPU_EXTENSION_RISCV_Zmmul    => false,         -- implement multiply-only M sub-extension?
     CPU_EXTENSION_RISCV_Zxcfu    => true,          -- implement custom (instr.) functions unit?
+    CPU_EXTENSION_RISCV_Zxpsimd  => true,          -- implement packed-SIMD DSP instructions (subset of 'P')?
     -- Extension Options --
-    FAST_MUL_EN                  => performance_options_c.fast_mul_en_c(PERFORMANCE_OPTION), -- use DSPs for M extension's multiplier
-    FAST_SHIFT_EN                => performance_options_c.fast_shift_en_c(PERFORMANCE_OPTION), -- use barrel shifter for shift operations
+    FAST_MUL_EN                  => cfg_fast_mul_c, -- use DSPs for M extension's multiplier
+    FAST_SHIFT_EN                => cfg_fast_shift_c, -- use barrel shifter for shift operations
     REGFILE_HW_RST               => false,         -- no hardware reset
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS              => 5,             -- number of regions (0..16)
@@ -199,15 +253,16 @@ begin
     -- Internal Instruction memory --
     MEM_INT_IMEM_EN              => int_imem_c ,   -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            => performance_options_c.imem_size_c(PERFORMANCE_OPTION),   -- size of processor-internal instruction memory in bytes
+    MEM_INT_IMEM_FILE            => IMEM_FILE,     -- executable file for the processor-internal instruction memory
     -- Internal Data memory --
     MEM_INT_DMEM_EN              => int_dmem_c,    -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            => dmem_size_c,   -- size of processor-internal data memory in bytes
     -- Internal Cache memory --
-    ICACHE_EN                    => performance_options_c.icache_en_c(PERFORMANCE_OPTION),   -- implement instruction cache
+    ICACHE_EN                    => cfg_icache_c,   -- implement instruction cache
     ICACHE_NUM_BLOCKS            => 64,            -- i-cache: number of blocks (min 2), has to be a power of 2
     ICACHE_BLOCK_SIZE            => performance_options_c.icache_block_size_c(PERFORMANCE_OPTION), -- i-cache: block size in bytes (min 4), has to be a power of 2
     -- Internal Data Cache (dCACHE) --
-    DCACHE_EN                    => performance_options_c.dcache_en_c(PERFORMANCE_OPTION),   -- implement data cache
+    DCACHE_EN                    => cfg_dcache_c,   -- implement data cache
     DCACHE_NUM_BLOCKS            => 32,            -- d-cache: number of blocks (min 1), has to be a power of 2
     DCACHE_BLOCK_SIZE            => performance_options_c.dcache_block_size_c(PERFORMANCE_OPTION), -- d-cache: block size in bytes (min 4), has to be a power of 2
     -- External bus interface --
@@ -369,25 +424,28 @@ begin
 
   -- UART Simulation Receiver ---------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  uart0_checker: entity work.uart_rx_simple
-  generic map (
-    name => "uart0",
-    uart_baud_val_c => uart0_baud_val_c
-  )
-  port map (
-    clk => clk_gen,
-    uart_txd => uart0_txd
-  );
-
-  uart1_checker: entity work.uart_rx_simple
-  generic map (
-    name => "uart1",
-    uart_baud_val_c => uart1_baud_val_c
-  )
-  port map (
-    clk => clk_gen,
-    uart_txd => uart1_txd
-  );
+  uart_checkers:
+  if (FAST_SIM = false) generate
+    uart0_checker: entity work.uart_rx_simple
+    generic map (
+      name => "uart0",
+      uart_baud_val_c => uart0_baud_val_c
+    )
+    port map (
+      clk => clk_gen,
+      uart_txd => uart0_txd
+    );
+
+    uart1_checker: entity work.uart_rx_simple
+    generic map (
+      name => "uart1",
+      uart_baud_val_c => uart1_baud_val_c
+    )
+    port map (
+      clk => clk_gen,
+      uart_txd => uart1_txd
+    );
+  end generate;
 
 
   -- Wishbone Fabric ------------------------------------------------------------------------
@@ -434,7 +492,7 @@ begin
   generate_ext_imem:
   if (int_imem_c = false) generate
     ext_mem_a_access: process(clk_gen)
-      variable ext_ram_a : mem32_t(0 to ext_mem_a_size_c/4-1) := mem32_init_f(application_init_image, ext_mem_a_size_c/4); -- initialized, used to simulate external IMEM
+      variable ext_ram_a : mem32_t(0 to ext_mem_a_size_c/4-1) := ext_mem_a_init_f; -- initialized, used to simulate external IMEM
     begin
       if rising_edge(clk_gen) then
         -- control --
@@ -577,20 +635,54 @@ begin
   irq_trigger: process(rst_gen, clk_gen)
   begin
     if (rst_gen = '0') then
-      msi_ring <= '0';
-      mei_ring <= '0';
+      msi_ring    <= '0';
+      mei_ring    <= '0';
+      irq_elapsed <= (others => '0');
     elsif rising_edge(clk_gen) then
       -- bus interface --
       wb_irq.rdata <= (others => '0');
-      wb_irq.ack   <= wb_irq.cyc and wb_irq.stb and wb_irq.we and and_reduce_f(wb_irq.sel);
+      wb_irq.ack   <= wb_irq.cyc and wb_irq.stb and (not wb_irq.we or and_reduce_f(wb_irq.sel));
       wb_irq.err   <= '0';
       -- trigger RISC-V platform IRQs --
+      irq_elapsed <= irq_elapsed + 1;
       if ((wb_irq.cyc and wb_irq.stb and wb_irq.we and and_reduce_f(wb_irq.sel)) = '1') then
         msi_ring <= wb_irq.wdata(03); -- machine software interrupt
         mei_ring <= wb_irq.wdata(11); -- machine software interrupt
+        if ((wb_irq.wdata(03) and (not msi_ring)) = '1') or ((wb_irq.wdata(11) and (not mei_ring)) = '1') then
+          irq_elapsed <= (others => '0'); -- IRQ pin is asserted in the next cycle
+        end if;
+      end if;
+      -- read-back: clock cycles since last IRQ assertion (for interrupt latency measurements) --
+      if ((wb_irq.cyc and wb_irq.stb and (not wb_irq.we)) = '1') then
+        wb_irq.rdata <= std_ulogic_vector(irq_elapsed);
       end if;
     end if;
   end process irq_trigger;
 
+  -- log IRQ pin assertions with cycle time stamp --
+  irq_timestamp: process(rst_gen, clk_gen)
+    file     file_irq_out : text open write_mode is "neorv32.testbench_irq.out";
+    variable line_v       : line;
+    variable msi_v, mei_v : std_ulogic;
+  begin
+    if (rst_gen = '0') then
+      cycle_cnt <= 0;
+      msi_v     := '0';
+      mei_v     := '0';
+    elsif rising_edge(clk_gen) then
+      cycle_cnt <= cycle_cnt + 1;
+      if (msi_ring = '1') and (msi_v = '0') then
+        write(line_v, string'("MSI @cycle ")); write(line_v, cycle_cnt); write(line_v, string'(" (")); write(line_v, now); write(line_v, string'(")"));
+        writeline(file_irq_out, line_v);
+      end if;
+      if (mei_ring = '1') and (mei_v = '0') then
+        write(line_v, string'("MEI @cycle ")); write(line_v, cycle_cnt); write(line_v, string'(" (")); write(line_v, now); write(line_v, string'(")"));
+        writeline(file_irq_out, line_v);
+      end if;
+      msi_v := msi_ring;
+      mei_v := mei_ring;
+    end if;
+  end process irq_timestamp;
+
 
 end neorv32_tb_simple_rtl;
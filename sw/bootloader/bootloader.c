@@ -73,6 +73,21 @@
   #define UART_HW_HANDSHAKE_EN 0
 #endif
 
+/** Set to 1 to enable the block-based high-speed UART upload protocol (command 'f') */
+#ifndef UART_FAST_EN
+  #define UART_FAST_EN 0
+#endif
+
+/** Block size in bytes of the high-speed UART upload protocol (power of two) */
+#ifndef UART_FAST_BLOCK_SIZE
+  #define UART_FAST_BLOCK_SIZE 1024
+#endif
+
+/** Maximum number of consecutive transmission errors before the high-speed upload is aborted */
+#ifndef UART_FAST_RETRIES
+  #define UART_FAST_RETRIES 8
+#endif
+
 /* -------- Status LED -------- */
 
 /** Set to 0 to disable bootloader status LED (heart beat) at GPIO.gpio_o(STATUS_LED_PIN) */
@@ -114,6 +129,11 @@
   #define SPI_FLASH_SECTOR_SIZE 65536 // default = 64kB
 #endif
 
+/** SPI flash page size in bytes (programming granularity) */
+#ifndef SPI_FLASH_PAGE_SIZE
+  #define SPI_FLASH_PAGE_SIZE 256 // default = 256 bytes
+#endif
+
 /** SPI flash clock pre-scaler; see #NEORV32_SPI_CTRL_enum */
 #ifndef SPI_FLASH_CLK_PRSC
   #define SPI_FLASH_CLK_PRSC CLK_PRSC_8
@@ -124,6 +144,18 @@
   #define SPI_BOOT_BASE_ADDR 0x00400000UL
 #endif
 
+/* -------- Executable format -------- */
+
+/** Set to 1 to enable support for compressed executables (neorv32_exe_lz.bin) */
+#ifndef EXE_LZ_EN
+  #define EXE_LZ_EN 0
+#endif
+
+/** Set to 1 to enable support for segment-based executables (neorv32_exe_seg.bin) */
+#ifndef EXE_SEG_EN
+  #define EXE_SEG_EN 0
+#endif
+
 /* -------- XIP configuration -------- */
 
 /** Enable XIP boot options */
@@ -188,6 +220,24 @@ enum SPI_FLASH_SREG_enum {
 };
 
 
+/**********************************************************************//**
+ * High-speed UART upload protocol control characters
+ **************************************************************************/
+enum UART_FAST_enum {
+  UART_FAST_ACK  = 0x06, /**< Request/frame accepted */
+  UART_FAST_NAK  = 0x15, /**< Request/frame rejected (retransmit) */
+  UART_FAST_CAN  = 0x18, /**< Upload aborted */
+  UART_FAST_SYNC = 0x53, /**< Synchronization at new BAUD rate ('S') */
+  UART_FAST_END  = 0xFFFF /**< Block index: end of transfer */
+};
+
+
+/**********************************************************************//**
+ * CRC32 polynomial of the high-speed UART upload protocol (MSB-first, start value 0xFFFFFFFF, no final XOR)
+ **************************************************************************/
+#define UART_FAST_CRC_POLY 0x04C11DB7
+
+
 /**********************************************************************//**
  * NEORV32 executable
  **************************************************************************/
@@ -204,6 +254,21 @@ enum NEORV32_EXECUTABLE_enum {
  **************************************************************************/
 #define EXE_SIGNATURE 0x4788CAFE
 
+/**********************************************************************//**
+ * Valid compressed (LZ) executable identification signature
+ **************************************************************************/
+#define EXE_SIGNATURE_LZ 0x4788CAFF
+
+/**********************************************************************//**
+ * Valid segment-based executable identification signature
+ **************************************************************************/
+#define EXE_SIGNATURE_SEG 0x4788CAFD
+
+/**********************************************************************//**
+ * Segment-based executable: segment descriptor flag for zero-fill segments (no data)
+ **************************************************************************/
+#define EXE_SEG_FILL 0x80000000U
+
 
 /**********************************************************************//**
  * Helper macros
@@ -241,6 +306,29 @@ volatile uint32_t exe_available;
 volatile uint32_t getting_exe;
 
 
+/**********************************************************************//**
+ * Entry address of the available executable.
+ **************************************************************************/
+volatile uint32_t exe_entry;
+
+
+/**********************************************************************//**
+ * Segment-based executables: address of the shadow copy of the bootloader's
+ * own RAM area (data and stack); copied to its final location right before
+ * starting the application. If =0 there is no shadow copy.
+ **************************************************************************/
+volatile uint32_t exe_shadow;
+
+
+/**********************************************************************//**
+ * Bootloader RAM area (from linker script)
+ **************************************************************************/
+/**@{*/
+extern char __crt0_dmem_begin[];
+extern char __crt0_stack_end[];
+/**@}*/
+
+
 /**********************************************************************//**
  * Function prototypes
  **************************************************************************/
@@ -248,17 +336,25 @@ void     __attribute__((interrupt("machine"))) bootloader_trap_handler(void);
 void     print_help(void);
 void     start_app(int boot_xip);
 void     get_exe(int src);
+void     get_exe_fast(void);
+int      uart_fast_getc(void);
+int      uart_fast_get_frame(uint8_t *dst, uint32_t num);
+void     uart_fast_reject(void);
 void     save_exe(void);
-uint32_t get_exe_word(int src, uint32_t addr);
+uint32_t get_image_word(const uint32_t *header, uint32_t offset);
+uint32_t get_exe_word(int src);
+uint8_t  get_exe_byte(int src);
+uint32_t get_exe_length(int src, uint32_t len);
 void     system_error(uint8_t err_code);
 void     print_hex_word(uint32_t num);
 
 // SPI flash driver functions
 void    spi_flash_wakeup(void);
 int     spi_flash_check(void);
-uint8_t spi_flash_read_byte(uint32_t addr);
-void    spi_flash_write_byte(uint32_t addr, uint8_t wdata);
-void    spi_flash_write_word(uint32_t addr, uint32_t wdata);
+void    spi_flash_read_start(uint32_t addr);
+uint8_t spi_flash_read_stream(void);
+void    spi_flash_read_stop(void);
+void    spi_flash_write_page(const uint32_t *header, uint32_t offset, uint32_t num);
 void    spi_flash_erase_sector(uint32_t addr);
 void    spi_flash_write_enable(void);
 void    spi_flash_write_disable(void);
@@ -281,6 +377,8 @@ int main(void) {
 
   exe_available = 0; // global variable for executable size; 0 means there is no exe available
   getting_exe   = 0; // we are not trying to get an executable yet
+  exe_entry     = (uint32_t)EXE_BASE_ADDR;
+  exe_shadow    = 0;
 
   // configure trap handler (bare-metal, no neorv32 rte available)
   neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)(&bootloader_trap_handler));
@@ -406,6 +504,11 @@ int main(void) {
     else if (c == 'u') { // get executable via UART
       get_exe(EXE_STREAM_UART);
     }
+#if (UART_EN != 0) && (UART_FAST_EN != 0)
+    else if (c == 'f') { // get executable via UART using the high-speed block protocol
+      get_exe_fast();
+    }
+#endif
 #if (SPI_EN != 0)
     else if (c == 's') { // program flash from memory (IMEM)
       save_exe();
@@ -454,6 +557,9 @@ void print_help(void) {
              " h: Help\n"
              " r: Restart\n"
              " u: Upload\n"
+#if (UART_EN != 0) && (UART_FAST_EN != 0)
+             " f: Fast upload (host tool)\n"
+#endif
 #if (SPI_EN != 0)
              " s: Store to flash\n"
              " l: Load from flash\n"
@@ -475,7 +581,7 @@ void start_app(int boot_xip) {
   // deactivate global IRQs
   neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
 
-  register uint32_t app_base = (uint32_t)EXE_BASE_ADDR; // default = start at beginning of IMEM
+  register uint32_t app_base = exe_entry; // default = start at beginning of IMEM (entry of segment-based executables)
 #if (XIP_EN != 0)
   if (boot_xip) {
     app_base = (uint32_t)(XIP_MEM_BASE_ADDRESS + SPI_BOOT_BASE_ADDR); // start from XIP mapped address
@@ -496,6 +602,23 @@ void start_app(int boot_xip) {
   // wait for UART0 to finish transmitting
   while (neorv32_uart0_tx_busy());
 
+#if (EXE_SEG_EN != 0)
+  // segment-based executable: copy shadow of the bootloader's RAM area to its final location
+  // and start application (this overrides the bootloader's own variables and stack)
+  register uint32_t shadow = exe_shadow;
+  if ((shadow != 0) && (boot_xip == 0)) {
+    register uint32_t dst = (uint32_t)&__crt0_dmem_begin[0];
+    register uint32_t end = (uint32_t)&__crt0_stack_end[0] + 1;
+    asm volatile ("1: lw   t0, 0(%[src])      \n"
+                  "   sw   t0, 0(%[dst])      \n"
+                  "   addi %[src], %[src], 4  \n"
+                  "   addi %[dst], %[dst], 4  \n"
+                  "   bltu %[dst], %[end], 1b \n"
+                  "   jalr ra, %[app]         \n"
+                  : [src] "+r" (shadow), [dst] "+r" (dst) : [end] "r" (end), [app] "r" (app_base) : "t0", "memory");
+  }
+#endif
+
   // start application
   asm volatile ("jalr ra, %0" : : "r" (app_base));
 
@@ -577,31 +700,128 @@ void get_exe(int src) {
        (spi_flash_check() != 0)) { // check if flash ready (or available at all)
       system_error(ERROR_FLASH);
     }
+
+    // read the whole image using a single (sequential) READ command
+    spi_flash_read_start(addr);
   }
 #endif
 
-  // check if valid image
-  uint32_t signature = get_exe_word(src, addr + EXE_OFFSET_SIGNATURE);
-  if (signature != EXE_SIGNATURE) { // signature
+  // check if valid image (header and data are streamed sequentially)
+  uint32_t signature = get_exe_word(src);
+  if ((signature != EXE_SIGNATURE) // signature
+#if (EXE_LZ_EN != 0)
+      && (signature != EXE_SIGNATURE_LZ)
+#endif
+#if (EXE_SEG_EN != 0)
+      && (signature != EXE_SIGNATURE_SEG)
+#endif
+     ) {
     system_error(ERROR_SIGNATURE);
   }
 
   // image size and checksum
-  uint32_t size  = get_exe_word(src, addr + EXE_OFFSET_SIZE); // size in bytes
-  uint32_t check = get_exe_word(src, addr + EXE_OFFSET_CHECKSUM); // complement sum checksum
+  uint32_t size  = get_exe_word(src); // size in bytes (uncompressed)
+  uint32_t check = get_exe_word(src); // complement sum checksum (of uncompressed data)
 
   // transfer program data
   uint32_t *pnt = (uint32_t*)EXE_BASE_ADDR;
   uint32_t checksum = 0;
   uint32_t d = 0, i = 0;
-  addr = addr + EXE_OFFSET_DATA;
+  exe_entry = (uint32_t)EXE_BASE_ADDR;
+  exe_shadow = 0;
+#if (EXE_SEG_EN != 0)
+  if (signature == EXE_SIGNATURE_SEG) {
+    // segments: [entry] {[address] [length | fill flag] [data]}...
+    // the bootloader's own RAM area is redirected to a shadow copy at the end of DMEM
+    uint32_t win_base = (uint32_t)&__crt0_dmem_begin[0];
+    uint32_t win_size = (uint32_t)&__crt0_stack_end[0] + 1 - win_base;
+    uint32_t shadow = 0, addr, len, offs;
+    if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_MEM_INT_DMEM)) {
+      shadow = win_base + (uint32_t)(1 << NEORV32_SYSINFO->MEM[SYSINFO_MEM_DMEM]) - win_size;
+      for (offs=0; offs<win_size; offs+=4) {
+        *(uint32_t*)(shadow + offs) = 0;
+      }
+    }
+    exe_entry = get_exe_word(src);
+    checksum = exe_entry;
+    i = 4;
+    while (i < size) {
+      addr = get_exe_word(src);
+      len  = get_exe_word(src);
+      checksum += addr + len;
+      i += 8;
+      if ((len & EXE_SEG_FILL) == 0) {
+        i += len;
+      }
+      if (i > size) { // corrupted descriptor
+        system_error(ERROR_CHECKSUM);
+      }
+      for (offs=0; offs<(len & ~EXE_SEG_FILL); offs+=4) {
+        d = (len & EXE_SEG_FILL) ? 0 : get_exe_word(src);
+        checksum += d;
+        pnt = (uint32_t*)(addr + offs);
+        if (((uint32_t)pnt - win_base) < win_size) { // bootloader RAM area
+          if (shadow == 0) {
+            system_error(ERROR_SIZE);
+          }
+          pnt = (uint32_t*)((uint32_t)pnt - win_base + shadow);
+        }
+        else if ((shadow != 0) && (((uint32_t)pnt - shadow) < win_size)) { // shadow copy area
+          system_error(ERROR_SIZE);
+        }
+        *pnt = d;
+      }
+    }
+    exe_shadow = shadow;
+  }
+  else
+#endif
+#if (EXE_LZ_EN != 0)
+  if (signature == EXE_SIGNATURE_LZ) {
+    // streaming LZ decompression: [token] [literals] [offset] [match]...
+    uint8_t *dst = (uint8_t*)EXE_BASE_ADDR;
+    uint32_t token, len;
+    while (i < size) {
+      token = get_exe_byte(src);
+      len = get_exe_length(src, token >> 4); // number of literals
+      if (len > (size - i)) {
+        system_error(ERROR_CHECKSUM);
+      }
+      while (len--) {
+        dst[i++] = get_exe_byte(src);
+      }
+      if (i == size) { // last sequence has no match
+        break;
+      }
+      d  = (uint32_t)get_exe_byte(src) << 0; // match offset (little-endian)
+      d |= (uint32_t)get_exe_byte(src) << 8;
+      len = get_exe_length(src, token & 0xf) + 4; // match length
+      if ((d == 0) || (d > i) || (len > (size - i))) { // corrupted stream
+        system_error(ERROR_CHECKSUM);
+      }
+      while (len--) { // copy match from already decompressed data
+        dst[i] = dst[i - d];
+        i++;
+      }
+    }
+    for (i=0; i<(size/4); i++) {
+      checksum += pnt[i];
+    }
+  }
+  else
+#endif
   while (i < (size/4)) { // in words
-    d = get_exe_word(src, addr);
+    d = get_exe_word(src);
     checksum += d;
     pnt[i++] = d;
-    addr += 4;
   }
 
+#if (SPI_EN != 0)
+  if (src != EXE_STREAM_UART) {
+    spi_flash_read_stop();
+  }
+#endif
+
   // error during transfer?
   if ((checksum + check) != 0) {
     system_error(ERROR_CHECKSUM);
@@ -615,6 +835,244 @@ void get_exe(int src) {
 }
 
 
+/**********************************************************************//**
+ * Get executable via UART using the block-based high-speed upload protocol.
+ *
+ * @note This protocol is driven by the sw/image_gen/uart_upload host tool:
+ * BAUD rate request (32-bit) -> ACK/NAK at default BAUD rate; SYNC at new BAUD
+ * rate -> SYNC + block size (16-bit); header frame (12 bytes + CRC32) -> ACK/NAK;
+ * block frames (index, inverted index, data, CRC32) -> ACK/NAK; end frame
+ * (index 0xFFFF) -> ACK if the executable's checksum is correct. All values are
+ * little-endian.
+ **************************************************************************/
+void get_exe_fast(void) {
+
+#if (UART_EN != 0) && (UART_FAST_EN != 0)
+  const uint16_t prsc[8] = {2, 4, 8, 64, 128, 1024, 2048, 4096}; // UART clock prescalers
+  uint32_t header[3], ctrl, fast, baud, clk, tmp, offs, num, i;
+  uint32_t checksum = 0, errors = 0;
+  int c;
+  uint8_t *dst = (uint8_t*)EXE_BASE_ADDR;
+
+  getting_exe = 1; // to inform trap handler we were trying to get an executable
+
+  // requested BAUD rate; only accept if it can be generated with an error of less than 3%
+  baud = get_exe_word(EXE_STREAM_UART);
+  clk = NEORV32_SYSINFO->CLK;
+  while (neorv32_uart0_tx_busy()); // wait for console echo to complete
+  ctrl = NEORV32_UART0->CTRL; // default configuration
+  if ((baud == 0) || (baud > (clk >> 1))) {
+    PRINT_PUTC(UART_FAST_NAK);
+    getting_exe = 0;
+    return;
+  }
+  neorv32_uart0_setup(baud, 0);
+  fast = NEORV32_UART0->CTRL | (ctrl & (1 << UART_CTRL_HWFC_EN));
+  NEORV32_UART0->CTRL = ctrl;
+  tmp = prsc[(fast >> UART_CTRL_PRSC0) & 7] * (((fast >> UART_CTRL_BAUD0) & 0x3ffU) + 1) * baud; // effective clock
+  tmp = (tmp > clk) ? (tmp - clk) : (clk - tmp);
+  if (tmp > (clk >> 5)) {
+    PRINT_PUTC(UART_FAST_NAK);
+    getting_exe = 0;
+    return;
+  }
+
+  // switch to new BAUD rate and wait for synchronization
+  PRINT_PUTC(UART_FAST_ACK);
+  while (neorv32_uart0_tx_busy());
+  NEORV32_UART0->CTRL = fast;
+  if (uart_fast_getc() != UART_FAST_SYNC) {
+    NEORV32_UART0->CTRL = ctrl;
+    PRINT_TEXT("Sync failed.");
+    getting_exe = 0;
+    return;
+  }
+  PRINT_PUTC(UART_FAST_SYNC);
+  PRINT_PUTC((UART_FAST_BLOCK_SIZE >> 0) & 0xff);
+  PRINT_PUTC((UART_FAST_BLOCK_SIZE >> 8) & 0xff);
+
+  // get header frame
+  while (errors < UART_FAST_RETRIES) {
+    if (uart_fast_get_frame((uint8_t*)header, 12) == 0) {
+      if (header[0] != EXE_SIGNATURE) { // signature
+        PRINT_PUTC(UART_FAST_CAN);
+        while (neorv32_uart0_tx_busy());
+        NEORV32_UART0->CTRL = ctrl;
+        system_error(ERROR_SIGNATURE);
+      }
+      PRINT_PUTC(UART_FAST_ACK);
+      errors = 0;
+      break;
+    }
+    uart_fast_reject();
+    errors++;
+  }
+
+  // get blocks (in any order); only blocks with a CRC error have to be sent again
+  while (errors < UART_FAST_RETRIES) {
+
+    // block index (16-bit) and inverted block index (16-bit)
+    tmp = 0;
+    for (i=0; i<4; i++) {
+      c = uart_fast_getc();
+      if (c < 0) {
+        break;
+      }
+      tmp |= (uint32_t)c << (8*i);
+    }
+    if ((i != 4) || ((((tmp >> 16) ^ tmp) & 0xffff) != 0xffff)) {
+      uart_fast_reject();
+      errors++;
+      continue;
+    }
+    tmp &= 0xffff;
+
+    // end of transfer
+    if (tmp == UART_FAST_END) {
+      for (i=0; i<(header[1]/4); i++) {
+        checksum += ((uint32_t*)EXE_BASE_ADDR)[i];
+      }
+      break;
+    }
+
+    // block data
+    offs = tmp * UART_FAST_BLOCK_SIZE;
+    num = header[1] - offs;
+    if (num > UART_FAST_BLOCK_SIZE) {
+      num = UART_FAST_BLOCK_SIZE;
+    }
+    if ((offs >= header[1]) || uart_fast_get_frame(&dst[offs], num)) {
+      uart_fast_reject();
+      errors++;
+    }
+    else {
+      PRINT_PUTC(UART_FAST_ACK);
+      errors = 0;
+    }
+  }
+
+  // final response and back to default BAUD rate
+  if (errors >= UART_FAST_RETRIES) {
+    PRINT_PUTC(UART_FAST_CAN);
+  }
+  else if ((checksum + header[2]) != 0) {
+    PRINT_PUTC(UART_FAST_NAK);
+  }
+  else {
+    PRINT_PUTC(UART_FAST_ACK);
+  }
+  while (neorv32_uart0_tx_busy());
+  NEORV32_UART0->CTRL = ctrl;
+
+  if (errors >= UART_FAST_RETRIES) {
+    PRINT_TEXT("Aborted.");
+  }
+  else if ((checksum + header[2]) != 0) {
+    system_error(ERROR_CHECKSUM);
+  }
+  else {
+    PRINT_TEXT("OK");
+    exe_available = header[1]; // store exe size
+    exe_entry = (uint32_t)EXE_BASE_ADDR;
+    exe_shadow = 0;
+  }
+
+  getting_exe = 0; // to inform trap handler we are done getting an executable
+#endif
+}
+
+
+/**********************************************************************//**
+ * Get byte from UART with timeout (high-speed upload protocol).
+ *
+ * @return Received byte or -1 if no byte was received within 1/8s.
+ **************************************************************************/
+int uart_fast_getc(void) {
+
+#if (UART_EN != 0) && (UART_FAST_EN != 0)
+  int tmo = neorv32_mtime_available();
+  uint64_t timeout = 0;
+
+  if (tmo) {
+    timeout = neorv32_mtime_get_time() + (uint64_t)(NEORV32_SYSINFO->CLK >> 3);
+  }
+
+  while (1) {
+    if (neorv32_uart0_char_received()) {
+      return (int)(uint8_t)neorv32_uart0_char_received_get();
+    }
+    if (tmo && (neorv32_mtime_get_time() >= timeout)) {
+      return -1;
+    }
+  }
+#else
+  return -1;
+#endif
+}
+
+
+/**********************************************************************//**
+ * Get data frame (data bytes followed by CRC32) of the high-speed upload protocol.
+ * The CRC unit is used if implemented.
+ *
+ * @param[in,out] dst Destination for the data bytes.
+ * @param[in] num Number of data bytes.
+ * @return 0 if frame was received correctly, 1 if timeout or CRC error.
+ **************************************************************************/
+int uart_fast_get_frame(uint8_t *dst, uint32_t num) {
+
+  uint32_t i, j, crc = 0xffffffffU, rx_crc = 0;
+  int c, crc_hw = neorv32_crc_available();
+
+  if (crc_hw) {
+    neorv32_crc_setup(CRC_MODE32, UART_FAST_CRC_POLY, 0xffffffffU);
+  }
+
+  for (i=0; i<num; i++) {
+    c = uart_fast_getc();
+    if (c < 0) {
+      return 1;
+    }
+    dst[i] = (uint8_t)c;
+    if (crc_hw) {
+      neorv32_crc_single((uint8_t)c);
+    }
+    else {
+      crc ^= (uint32_t)c << 24;
+      for (j=0; j<8; j++) {
+        crc = (crc & 0x80000000U) ? ((crc << 1) ^ UART_FAST_CRC_POLY) : (crc << 1);
+      }
+    }
+  }
+  if (crc_hw) {
+    crc = neorv32_crc_get();
+  }
+
+  for (i=0; i<4; i++) {
+    c = uart_fast_getc();
+    if (c < 0) {
+      return 1;
+    }
+    rx_crc |= (uint32_t)c << (8*i);
+  }
+
+  return (rx_crc != crc);
+}
+
+
+/**********************************************************************//**
+ * Reject frame of the high-speed upload protocol: wait until the line is idle
+ * (discarding any remaining data) and request retransmission.
+ **************************************************************************/
+void uart_fast_reject(void) {
+
+  if (neorv32_mtime_available()) {
+    while (uart_fast_getc() >= 0);
+  }
+  PRINT_PUTC(UART_FAST_NAK);
+}
+
+
 /**********************************************************************//**
  * Store content of instruction memory to SPI flash.
  **************************************************************************/
@@ -629,6 +1087,11 @@ void save_exe(void) {
     return;
   }
 
+  if (exe_entry != (uint32_t)EXE_BASE_ADDR) { // segment-based executable, not available as contiguous image
+    PRINT_TEXT("Not supported for segment-based executables.");
+    return;
+  }
+
   uint32_t addr = (uint32_t)SPI_BOOT_BASE_ADDR;
 
   // info and prompt
@@ -651,31 +1114,77 @@ void save_exe(void) {
 
   PRINT_TEXT("\nFlashing... ");
 
-  // clear memory before writing
-  uint32_t num_sectors = (size / (SPI_FLASH_SECTOR_SIZE)) + 1; // clear at least 1 sector
-  uint32_t sector = (uint32_t)SPI_BOOT_BASE_ADDR;
-  while (num_sectors--) {
-    spi_flash_erase_sector(sector);
-    sector += SPI_FLASH_SECTOR_SIZE;
-  }
-
-  // store data from instruction memory and update checksum
-  uint32_t checksum = 0;
+  // image header
+  uint32_t header[3], checksum = 0, i;
   uint32_t *pnt = (uint32_t*)EXE_BASE_ADDR;
-  addr = addr + EXE_OFFSET_DATA;
-  uint32_t i = 0;
-  while (i < size) { // in chunks of 4 bytes
-    uint32_t d = (uint32_t)*pnt++;
-    checksum += d;
-    spi_flash_write_word(addr, d);
-    addr += 4;
-    i += 4;
+  for (i=0; i<(size/4); i++) {
+    checksum += pnt[i];
   }
+  header[0] = EXE_SIGNATURE; // EXE signature
+  header[1] = size; // size
+  header[2] = (~checksum)+1; // checksum (sum complement)
+
+  // process sectors and pages in descending order so the header (first page) is written last
+  uint32_t total = EXE_OFFSET_DATA + size; // image size in bytes
+  uint32_t sector = (total - 1) & ~((uint32_t)(SPI_FLASH_SECTOR_SIZE-1)); // offset of last sector
+  uint32_t dirty[(SPI_FLASH_SECTOR_SIZE/SPI_FLASH_PAGE_SIZE + 31)/32]; // page differs from flash content
+  uint32_t used[(SPI_FLASH_SECTOR_SIZE/SPI_FLASH_PAGE_SIZE + 31)/32]; // page is not blank (all-ones)
+  uint32_t offs, page, end, rdata, wdata, erase;
+
+  while (1) {
+    end = sector + SPI_FLASH_SECTOR_SIZE;
+    if (end > total) {
+      end = total;
+    }
 
-  // write header
-  spi_flash_write_word(SPI_BOOT_BASE_ADDR + EXE_OFFSET_SIGNATURE, EXE_SIGNATURE); // EXE signature
-  spi_flash_write_word(SPI_BOOT_BASE_ADDR + EXE_OFFSET_SIZE, size); // size
-  spi_flash_write_word(SPI_BOOT_BASE_ADDR + EXE_OFFSET_CHECKSUM, (~checksum)+1); // checksum (sum complement)
+    // compare current flash content with new image
+    for (i=0; i<((SPI_FLASH_SECTOR_SIZE/SPI_FLASH_PAGE_SIZE + 31)/32); i++) {
+      dirty[i] = 0;
+      used[i] = 0;
+    }
+    erase = 0;
+    spi_flash_read_start(SPI_BOOT_BASE_ADDR + sector);
+    for (offs=sector; offs<end; offs+=4) {
+      rdata = get_exe_word(EXE_STREAM_FLASH);
+      wdata = get_image_word(header, offs);
+      i = (offs - sector) / SPI_FLASH_PAGE_SIZE;
+      if (rdata != wdata) {
+        dirty[i/32] |= 1 << (i & 31);
+      }
+      if (wdata != 0xffffffffU) {
+        used[i/32] |= 1 << (i & 31);
+      }
+      if ((rdata & wdata) != wdata) { // programming can only clear bits
+        erase = 1;
+      }
+    }
+    spi_flash_read_stop();
+
+    // erase only if required; program only pages that actually have to be changed
+    if (erase) {
+      spi_flash_erase_sector(SPI_BOOT_BASE_ADDR + sector);
+    }
+    page = (end - 1) & ~((uint32_t)(SPI_FLASH_PAGE_SIZE-1));
+    while (1) {
+      i = (page - sector) / SPI_FLASH_PAGE_SIZE;
+      if ((erase ? used[i/32] : dirty[i/32]) & (1 << (i & 31))) {
+        offs = end - page;
+        if (offs > SPI_FLASH_PAGE_SIZE) {
+          offs = SPI_FLASH_PAGE_SIZE;
+        }
+        spi_flash_write_page(header, page, offs);
+      }
+      if (page == sector) {
+        break;
+      }
+      page -= SPI_FLASH_PAGE_SIZE;
+    }
+
+    if (sector == 0) {
+      break;
+    }
+    sector -= SPI_FLASH_SECTOR_SIZE;
+  }
 
   PRINT_TEXT("OK");
 #endif
@@ -683,13 +1192,33 @@ void save_exe(void) {
 
 
 /**********************************************************************//**
- * Get word from executable stream
+ * Get word of the flash image (header + executable from instruction memory).
+ *
+ * @param header Image header (signature, size, checksum).
+ * @param offset Byte offset within the image (word-aligned).
+ * @return 32-bit image data word.
+ **************************************************************************/
+uint32_t get_image_word(const uint32_t *header, uint32_t offset) {
+
+  if (offset < EXE_OFFSET_DATA) {
+    return header[offset/4];
+  }
+  else {
+    return ((uint32_t*)EXE_BASE_ADDR)[(offset - EXE_OFFSET_DATA)/4];
+  }
+}
+
+
+/**********************************************************************//**
+ * Get next word from executable stream
+ *
+ * @note For the SPI flash source the read stream has to be opened
+ * using spi_flash_read_start() before.
  *
  * @param src Source of executable stream data. See #EXE_STREAM_SOURCE_enum.
- * @param addr Address when accessing SPI flash.
  * @return 32-bit data word from stream.
  **************************************************************************/
-uint32_t get_exe_word(int src, uint32_t addr) {
+uint32_t get_exe_word(int src) {
 
   union {
     uint32_t uint32;
@@ -698,18 +1227,50 @@ uint32_t get_exe_word(int src, uint32_t addr) {
 
   uint32_t i;
   for (i=0; i<4; i++) {
-    if (src == EXE_STREAM_UART) {
-      data.uint8[i] = (uint8_t)PRINT_GETC();
-    }
-    else {
-      data.uint8[i] = spi_flash_read_byte(addr + i); // little-endian byte order
-    }
+    data.uint8[i] = get_exe_byte(src); // little-endian byte order
   }
 
   return data.uint32;
 }
 
 
+/**********************************************************************//**
+ * Get next byte from executable stream
+ *
+ * @param src Source of executable stream data. See #EXE_STREAM_SOURCE_enum.
+ * @return 8-bit data byte from stream.
+ **************************************************************************/
+uint8_t get_exe_byte(int src) {
+
+  if (src == EXE_STREAM_UART) {
+    return (uint8_t)PRINT_GETC();
+  }
+  else {
+    return spi_flash_read_stream();
+  }
+}
+
+
+/**********************************************************************//**
+ * Get (extended) length field of compressed executable stream.
+ *
+ * @param src Source of executable stream data. See #EXE_STREAM_SOURCE_enum.
+ * @param len 4-bit length from token; 15 indicates additional length bytes.
+ * @return Decoded length.
+ **************************************************************************/
+uint32_t get_exe_length(int src, uint32_t len) {
+
+  uint32_t tmp;
+  if (len == 15) {
+    do {
+      tmp = get_exe_byte(src);
+      len += tmp;
+    } while (tmp == 255);
+  }
+  return len;
+}
+
+
 /**********************************************************************//**
  * Output system error ID and halt.
  *
@@ -802,22 +1363,40 @@ int spi_flash_check(void) {
 }
 
 /**********************************************************************//**
- * Read byte from SPI flash.
+ * Start sequential read from SPI flash: a single READ command is issued and
+ * the chip select stays asserted; the flash auto-increments the address for
+ * every following byte.
  *
- * @param[in] addr Flash read address.
- * @return Read byte from SPI flash.
+ * @param[in] addr Flash read start address.
  **************************************************************************/
-uint8_t spi_flash_read_byte(uint32_t addr) {
+void spi_flash_read_start(uint32_t addr) {
 
 #if (SPI_EN != 0)
   neorv32_spi_cs_en(SPI_FLASH_CS);
 
   neorv32_spi_trans(SPI_FLASH_CMD_READ);
   spi_flash_write_addr(addr);
-  uint8_t rdata = neorv32_spi_trans(0);
 
-  neorv32_spi_cs_dis();
+  // keep the SPI TX FIFO filled with dummy bytes to read ahead
+  int i;
+  for (i=0; i<neorv32_spi_get_fifo_depth(); i++) {
+    neorv32_spi_put_nonblocking(0);
+  }
+#endif
+}
+
+
+/**********************************************************************//**
+ * Get next byte of sequential SPI flash read.
+ *
+ * @return Read byte from SPI flash.
+ **************************************************************************/
+uint8_t spi_flash_read_stream(void) {
 
+#if (SPI_EN != 0)
+  while ((NEORV32_SPI->CTRL & (1 << SPI_CTRL_RX_AVAIL)) == 0); // wait for data
+  uint8_t rdata = neorv32_spi_get_nonblocking();
+  neorv32_spi_put_nonblocking(0); // request next byte
   return rdata;
 #else
   return 0;
@@ -826,12 +1405,31 @@ uint8_t spi_flash_read_byte(uint32_t addr) {
 
 
 /**********************************************************************//**
- * Write byte to SPI flash.
+ * End sequential read from SPI flash.
+ **************************************************************************/
+void spi_flash_read_stop(void) {
+
+#if (SPI_EN != 0)
+  while (neorv32_spi_busy()); // wait for pending read-ahead transfers
+  while (NEORV32_SPI->CTRL & (1 << SPI_CTRL_RX_AVAIL)) { // discard read-ahead data
+    neorv32_spi_get_nonblocking();
+  }
+  neorv32_spi_cs_dis();
+#endif
+}
+
+
+/**********************************************************************//**
+ * Program (part of) a single SPI flash page with flash image data.
+ *
+ * @note The programmed area must not cross a page boundary. The data is streamed
+ * directly from the image (see get_image_word()) to keep the stack small.
  *
- * @param[in] addr SPI flash read address.
- * @param[in] wdata SPI flash read data.
+ * @param[in] header Image header (signature, size, checksum).
+ * @param[in] offset Byte offset within the image (word-aligned); written to SPI_BOOT_BASE_ADDR + offset.
+ * @param[in] num Number of bytes to write (multiple of 4, max. #SPI_FLASH_PAGE_SIZE).
  **************************************************************************/
-void spi_flash_write_byte(uint32_t addr, uint8_t wdata) {
+void spi_flash_write_page(const uint32_t *header, uint32_t offset, uint32_t num) {
 
 #if (SPI_EN != 0)
   spi_flash_write_enable(); // allow write-access
@@ -839,8 +1437,14 @@ void spi_flash_write_byte(uint32_t addr, uint8_t wdata) {
   neorv32_spi_cs_en(SPI_FLASH_CS);
 
   neorv32_spi_trans(SPI_FLASH_CMD_PAGE_PROGRAM);
-  spi_flash_write_addr(addr);
-  neorv32_spi_trans(wdata);
+  spi_flash_write_addr(SPI_BOOT_BASE_ADDR + offset);
+  uint32_t i, wdata = 0;
+  for (i=0; i<num; i++) {
+    if ((i & 3) == 0) {
+      wdata = get_image_word(header, offset + i);
+    }
+    neorv32_spi_trans((uint8_t)(wdata >> (8*(i & 3))));
+  }
 
   neorv32_spi_cs_dis();
 
@@ -853,31 +1457,6 @@ void spi_flash_write_byte(uint32_t addr, uint8_t wdata) {
 }
 
 
-/**********************************************************************//**
- * Write word to SPI flash.
- *
- * @param addr SPI flash write address.
- * @param wdata SPI flash write data.
- **************************************************************************/
-void spi_flash_write_word(uint32_t addr, uint32_t wdata) {
-
-#if (SPI_EN != 0)
-  union {
-    uint32_t uint32;
-    uint8_t  uint8[sizeof(uint32_t)];
-  } data;
-
-  data.uint32 = wdata;
-
-  // little-endian byte order
-  int i;
-  for (i=0; i<4; i++) {
-    spi_flash_write_byte(addr + i, data.uint8[i]);
-  }
-#endif
-}
-
-
 /**********************************************************************//**
  * Erase sector (64kB) at base address.
  *
@@ -56,6 +56,12 @@ MABI  ?= ilp32
 # User flags for additional configuration (will be added to compiler flags)
 USER_FLAGS ?=
 
+# Dynamic memory allocator: newlib (default) or tlsf (O(1) allocator from neorv32_malloc.c)
+MALLOC ?= newlib
+
+# Memory/string functions: newlib (default) or neorv32 (optimized functions from neorv32_string.c)
+STRING ?= newlib
+
 # Relative or absolute path to the NEORV32 home folder
 NEORV32_HOME ?= ../../..
 NEORV32_LOCAL_RTL ?= $(NEORV32_HOME)/rtl
@@ -66,6 +72,9 @@ GDB_ARGS ?= -ex "target extended-remote localhost:3333"
 # GHDL simulation run arguments
 GHDL_RUN_FLAGS ?=
 
+# Instruction-set simulator arguments
+ISS_FLAGS ?=
+
 
 # -----------------------------------------------------------------------------
 # NEORV32 framework
@@ -82,6 +91,8 @@ NEORV32_EXG_PATH = $(NEORV32_HOME)/sw/image_gen
 NEORV32_RTL_PATH = $(NEORV32_LOCAL_RTL)/core
 # Path to NEORV32 sim folder
 NEORV32_SIM_PATH = $(NEORV32_HOME)/sim/simple
+# Path to NEORV32 instruction-set simulator
+NEORV32_ISS_PATH = $(NEORV32_HOME)/sim/iss
 # Marker file to check for NEORV32 home folder
 NEORV32_HOME_MARKER = $(NEORV32_INC_PATH)/neorv32.h
 
@@ -95,9 +106,14 @@ LD_SCRIPT ?= $(NEORV32_COM_PATH)/neorv32.ld
 
 # Main output files
 APP_EXE  = neorv32_exe.bin
+APP_LZ   = neorv32_exe_lz.bin
+APP_SEG  = neorv32_exe_seg.bin
 APP_ELF  = main.elf
 APP_HEX  = neorv32_raw_exe.hex
 APP_BIN  = neorv32_raw_exe.bin
+APP_MEM  = neorv32_raw_exe.mem
+APP_COE  = neorv32_raw_exe.coe
+APP_MIF  = neorv32_raw_exe.mif
 APP_ASM  = main.asm
 APP_IMG  = neorv32_application_image.vhd
 BOOT_IMG = neorv32_bootloader_image.vhd
@@ -130,10 +146,19 @@ CC_HOST = gcc -Wall -O -g
 # NEORV32 executable image generator
 IMAGE_GEN = $(NEORV32_EXG_PATH)/image_gen
 
+# NEORV32 instruction-set simulator
+ISS = $(NEORV32_ISS_PATH)/neorv32_iss
+
 # Compiler & linker flags
 CC_OPTS  = -march=$(MARCH) -mabi=$(MABI) $(EFFORT) -Wall -ffunction-sections -fdata-sections -nostartfiles -mno-fdiv
 CC_OPTS += -mstrict-align -mbranch-cost=10 -g -Wl,--gc-sections
 CC_OPTS += $(USER_FLAGS)
+ifeq ($(MALLOC),tlsf)
+CC_OPTS += -DNEORV32_MALLOC_TLSF
+endif
+ifeq ($(STRING),neorv32)
+CC_OPTS += -DNEORV32_STRING_OVERRIDE
+endif
 LD_LIBS =  -lm -lc -lgcc
 LD_LIBS += $(USER_LIBS)
 
@@ -160,8 +185,13 @@ NEO_ASFLAGS = $(CC_FLAGS) $(ASFLAGS)
 asm:     $(APP_ASM)
 elf:     $(APP_ELF)
 exe:     $(APP_EXE)
+exe_lz:  $(APP_LZ)
+exe_seg: $(APP_SEG)
 hex:     $(APP_HEX)
 bin:     $(APP_BIN)
+mem:     $(APP_MEM)
+coe:     $(APP_COE)
+mif:     $(APP_MIF)
 compile: $(APP_EXE)
 image:   $(APP_IMG)
 install: image install-$(APP_IMG)
@@ -182,6 +212,10 @@ $(IMAGE_GEN): $(NEORV32_EXG_PATH)/image_gen.c
 	@echo Compiling $(IMAGE_GEN)
 	@$(CC_HOST) $< -o $(IMAGE_GEN)
 
+$(ISS): $(NEORV32_ISS_PATH)/neorv32_iss.c
+	@echo Compiling $(ISS)
+	@$(CC_HOST) $< -o $(ISS)
+
 
 # -----------------------------------------------------------------------------
 # General targets: Assemble, compile, link, dump
@@ -231,6 +265,18 @@ $(APP_EXE): main.bin $(IMAGE_GEN)
 	@echo "Executable ($(APP_EXE)) size in bytes:"
 	@wc -c < $(APP_EXE)
 
+# Generate compressed NEORV32 executable image for upload via bootloader
+$(APP_LZ): main.bin $(IMAGE_GEN)
+	@set -e
+	@$(IMAGE_GEN) -app_lz $< $@ $(shell basename $(CURDIR))
+
+# Generate segment-based NEORV32 executable image (from ELF) for upload via bootloader
+$(APP_SEG): $(APP_ELF) $(IMAGE_GEN)
+	@set -e
+	@$(IMAGE_GEN) -app_seg $< $@ $(shell basename $(CURDIR))
+	@echo "Executable ($(APP_SEG)) size in bytes:"
+	@wc -c < $(APP_SEG)
+
 # Generate NEORV32 executable VHDL boot image
 $(APP_IMG): main.bin $(IMAGE_GEN)
 	@set -e
@@ -252,6 +298,21 @@ $(APP_BIN): main.bin $(IMAGE_GEN)
 	@set -e
 	@$(IMAGE_GEN) -raw_bin $< $@ $(shell basename $(CURDIR))
 
+# Generate NEORV32 RAW executable image as Xilinx/AMD memory file
+$(APP_MEM): main.bin $(IMAGE_GEN)
+	@set -e
+	@$(IMAGE_GEN) -raw_mem $< $@ $(shell basename $(CURDIR))
+
+# Generate NEORV32 RAW executable image as Xilinx/AMD coefficient file
+$(APP_COE): main.bin $(IMAGE_GEN)
+	@set -e
+	@$(IMAGE_GEN) -raw_coe $< $@ $(shell basename $(CURDIR))
+
+# Generate NEORV32 RAW executable image as Intel/Altera memory initialization file
+$(APP_MIF): main.bin $(IMAGE_GEN)
+	@set -e
+	@$(IMAGE_GEN) -raw_mif $< $@ $(shell basename $(CURDIR))
+
 
 # -----------------------------------------------------------------------------
 # Bootloader targets
@@ -306,6 +367,22 @@ sim: $(APP_IMG) install
 	@echo "Simulating processor using simple testbench..."
 	@sh $(NEORV32_SIM_PATH)/ghdl.sh $(GHDL_RUN_FLAGS)
 
+# Load the raw executable at simulation start - no VHDL image install, no re-analysis of the design
+sim_bin: $(APP_BIN)
+	@echo "Simulating processor using simple testbench (loading $(APP_BIN))..."
+	@NEORV32_IMEM_FILE=$(CURDIR)/$(APP_BIN) sh $(NEORV32_SIM_PATH)/ghdl.sh $(GHDL_RUN_FLAGS)
+
+
+# -----------------------------------------------------------------------------
+# Run application in the host-side cycle-approximate instruction-set simulator
+# -----------------------------------------------------------------------------
+iss: $(APP_ELF) $(ISS)
+	@$(ISS) $(ISS_FLAGS) $(APP_ELF)
+
+# Lock-step co-simulation: check the VUnit testbench's instruction trace against the ISS
+cosim: $(APP_ELF) $(APP_BIN) $(ISS)
+	@NEORV32_ISS=$(ISS) sh $(NEORV32_ISS_PATH)/cosim.sh $(APP_ELF) $(APP_BIN)
+
 
 # -----------------------------------------------------------------------------
 # Show final ELF details (just for debugging)
@@ -325,10 +402,10 @@ gdb:
 # Clean up
 # -----------------------------------------------------------------------------
 clean:
-	@rm -f *.elf *.o *.bin *.out *.asm *.vhd *.hex .gdb_history
+	@rm -f *.elf *.o *.bin *.out *.asm *.vhd *.hex *.mem *.coe *.mif .gdb_history
 
 clean_all: clean
-	@rm -f $(OBJ) $(IMAGE_GEN)
+	@rm -f $(OBJ) $(IMAGE_GEN) $(ISS)
 
 
 # -----------------------------------------------------------------------------
@@ -347,6 +424,7 @@ info:
 	@echo "------------------------------------------------------"
 	@echo "NEORV32 home folder (NEORV32_HOME): $(NEORV32_HOME)"
 	@echo "IMAGE_GEN: $(IMAGE_GEN)"
+	@echo "ISS:       $(ISS)"
 	@echo "Core source files:"
 	@echo "$(CORE_SRC)"
 	@echo "Core include folder:"
@@ -378,6 +456,10 @@ info:
 	@echo "------------------------------------------------------"
 	@echo "GHDL_RUN_FLAGS: $(GHDL_RUN_FLAGS)"
 	@echo "------------------------------------------------------"
+	@echo "-- ISS Arguments"
+	@echo "------------------------------------------------------"
+	@echo "ISS_FLAGS:      $(ISS_FLAGS)"
+	@echo "------------------------------------------------------"
 	@echo "-- Libraries"
 	@echo "------------------------------------------------------"
 	@echo "LIBGCC:"
@@ -411,15 +493,23 @@ help:
 	@echo " asm        - compile and generate <$(APP_ASM)> assembly listing file for manual debugging"
 	@echo " elf        - compile and generate <$(APP_ELF)> ELF file"
 	@echo " exe        - compile and generate <$(APP_EXE)> executable for upload via default bootloader (binary file, with header)"
+	@echo " exe_lz     - compile and generate <$(APP_LZ)> compressed executable for upload via bootloader (requires EXE_LZ_EN, binary file, with header)"
+	@echo " exe_seg    - compile and generate <$(APP_SEG)> segment-based executable for upload via bootloader (requires EXE_SEG_EN, binary file, with header)"
 	@echo " bin        - compile and generate <$(APP_BIN)> RAW executable file (binary file, no header)"
 	@echo " hex        - compile and generate <$(APP_HEX)> RAW executable file (hex char file, no header)"
+	@echo " mem        - compile and generate <$(APP_MEM)> RAW executable file (Xilinx/AMD memory file, no header)"
+	@echo " coe        - compile and generate <$(APP_COE)> RAW executable file (Xilinx/AMD coefficient file, no header)"
+	@echo " mif        - compile and generate <$(APP_MIF)> RAW executable file (Intel/Altera memory initialization file, no header)"
 	@echo " image      - compile and generate VHDL IMEM boot image (for application, no header) in local folder"
 	@echo " install    - compile, generate and install VHDL IMEM boot image (for application, no header)"
 	@echo " sim        - in-console simulation using default/simple testbench and GHDL"
+	@echo " sim_bin    - in-console simulation loading <$(APP_BIN)> at simulation start (no VHDL image re-install)"
+	@echo " iss        - run <$(APP_ELF)> in the host-side cycle-approximate instruction-set simulator"
+	@echo " cosim      - lock-step co-simulation of <$(APP_ELF)>: VUnit testbench vs. instruction-set simulator"
 	@echo " all        - exe + install + hex + bin + asm"
 	@echo " elf_info   - show ELF layout info"
 	@echo " clean      - clean up project home folder"
-	@echo " clean_all  - clean up whole project, core libraries and image generator"
+	@echo " clean_all  - clean up whole project, core libraries, image generator and instruction-set simulator"
 	@echo " bl_image   - compile and generate VHDL BOOTROM boot image (for bootloader only, no header) in local folder"
 	@echo " bootloader - compile, generate and install VHDL BOOTROM boot image (for bootloader only, no header)"
 	@echo ""
@@ -429,10 +519,13 @@ help:
 	@echo " EFFORT         - Optimization level: \"$(EFFORT)\""
 	@echo " MARCH          - Machine architecture: \"$(MARCH)\""
 	@echo " MABI           - Machine binary interface: \"$(MABI)\""
+	@echo " MALLOC         - Dynamic memory allocator (newlib/tlsf): \"$(MALLOC)\""
+	@echo " STRING         - Memory/string functions (newlib/neorv32): \"$(STRING)\""
 	@echo " APP_INC        - C include folder(s) [append only]: \"$(APP_INC)\""
 	@echo " ASM_INC        - ASM include folder(s) [append only]: \"$(ASM_INC)\""
 	@echo " RISCV_PREFIX   - Toolchain prefix: \"$(RISCV_PREFIX)\""
 	@echo " NEORV32_HOME   - NEORV32 home folder: \"$(NEORV32_HOME)\""
 	@echo " GDB_ARGS       - GDB (connection) arguments: \"$(GDB_ARGS)\""
 	@echo " GHDL_RUN_FLAGS - GHDL simulation run arguments: \"$(GHDL_RUN_FLAGS)\""
+	@echo " ISS_FLAGS      - Instruction-set simulator arguments: \"$(ISS_FLAGS)\""
 	@echo ""
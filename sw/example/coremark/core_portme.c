@@ -18,6 +18,7 @@ Original Author: Shay Gal-on
 
 /* Ported to the NEORV32 RISC-V Processor by Stephan Nolting, 2024 */
 
+#include <stddef.h>
 #include "coremark.h"
 #include "core_portme.h"
 
@@ -119,12 +120,114 @@ secs_ret time_in_secs(CORE_TICKS ticks) {
     return retval;
 }
 
-ee_u32 default_num_contexts = 1;
+ee_u32 default_num_contexts = MULTITHREAD;
 
 /* Number of available hardware performance monitors */
 uint32_t num_hpm_cnts_global = 0;
 
 
+/* NEORV32-specific: print CoreMark/MHz with three fractional digits */
+static void print_coremark_mhz(ee_u32 iterations, ee_u64 cycles) {
+
+  ee_u64 tmp = 0;
+
+  if (cycles != 0) {
+    tmp = (((ee_u64)iterations) * 1000000000ULL) / cycles; // iterations per MHz * 1000
+  }
+  neorv32_uart0_printf("%u.%u%u%u", (uint32_t)(tmp / 1000), (uint32_t)((tmp / 100) % 10),
+                                    (uint32_t)((tmp / 10) % 10), (uint32_t)(tmp % 10));
+}
+
+
+#if USE_NEORV32_CTX
+/* NEORV32-specific: parallel context backend
+
+        All contexts are registered by <core_start_parallel>. Every hart that
+   participates in the benchmark calls <core_parallel_worker>, which waits at a
+   barrier until all contexts have been launched and then claims and executes
+   pending contexts (context index obtained via an atomic LR/SC increment).
+   <core_stop_parallel> turns the calling hart into a worker until the according
+   context has completed. Hence, a single-hart setup executes all contexts
+   back-to-back while additional harts would execute them concurrently.
+*/
+static core_results *volatile ctx_list[MULTITHREAD]; /* registered contexts */
+static volatile ee_u32 ctx_launched = 0;             /* barrier: number of launched contexts */
+static volatile ee_u32 ctx_next = 0;                 /* index of next context to be claimed */
+static volatile ee_u32 ctx_done[MULTITHREAD];        /* completion flags */
+
+/* atomic increment using LR/SC (if available); returns the pre-increment value */
+static ee_u32 ctx_atomic_inc(volatile ee_u32 *cnt) {
+#if defined __riscv_atomic
+  return neorv32_cpu_amoaddw((uint32_t)cnt, 1);
+#else
+  ee_u32 tmp = *cnt; /* single hart only */
+  *cnt = tmp + 1;
+  return tmp;
+#endif
+}
+
+/* execute a single context and time-stamp it */
+static void ctx_execute(ee_u32 id) {
+
+  core_results *res = ctx_list[id];
+
+  res->port.ctx_start = neorv32_cpu_get_cycle();
+  iterate(res);
+  res->port.ctx_stop = neorv32_cpu_get_cycle();
+  ctx_done[id] = 1;
+}
+
+/* Function : core_parallel_worker
+        Hart entry point: claim and execute contexts until all have been
+   claimed. Returns the number of contexts executed by the calling hart.
+*/
+ee_u32 core_parallel_worker(void) {
+
+  ee_u32 id, cnt = 0;
+
+  while (ctx_launched < default_num_contexts); /* barrier: wait for all contexts */
+
+  while (1) {
+    id = ctx_atomic_inc(&ctx_next);
+    if (id >= default_num_contexts) {
+      break;
+    }
+    ctx_execute(id);
+    cnt++;
+  }
+  return cnt;
+}
+
+/* Function : core_start_parallel
+        Register a context for parallel execution.
+*/
+ee_u8 core_start_parallel(core_results *res) {
+
+  ee_u32 id = ctx_launched; /* contexts are launched by a single hart */
+
+  res->port.portable_id = 1;
+  res->port.ctx_id      = (ee_u8)id;
+  res->port.ctx_start   = 0;
+  res->port.ctx_stop    = 0;
+  ctx_done[id]          = 0;
+  ctx_list[id]          = res;
+  ctx_atomic_inc(&ctx_launched); /* release context */
+  return 0;
+}
+
+/* Function : core_stop_parallel
+        Wait for a context to complete; the calling hart works on pending
+   contexts in the meantime.
+*/
+ee_u8 core_stop_parallel(core_results *res) {
+
+  core_parallel_worker();
+  while (ctx_done[res->port.ctx_id] == 0); /* context executed by another hart */
+  return 0;
+}
+#endif
+
+
 /* Function : portable_init
         Target specific initialization code
         Test for some common mistakes.
@@ -188,6 +291,8 @@ void portable_init(core_portable *p, int *argc, char *argv[]) {
 */
 void portable_fini(core_portable *p) {
 
+    ee_u32 total_iterations = 0;
+
     p->portable_id = 0;
 
     neorv32_uart0_printf("\nNEORV32: Hardware Performance Monitors (low words only)\n");
@@ -204,4 +309,30 @@ void portable_fini(core_portable *p) {
     if (num_hpm_cnts_global > 7)  {neorv32_uart0_printf(" > Load/store wait cycles      : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER10)); }
     if (num_hpm_cnts_global > 8)  {neorv32_uart0_printf(" > Entered traps               : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER11)); }
     neorv32_uart0_printf("\n");
+
+    /* NEORV32-specific: normalized score (based on the iterations actually executed by all contexts) */
+#if USE_NEORV32_CTX
+    ee_u32 i;
+    for (i = 0; i < default_num_contexts; i++) {
+      total_iterations += ctx_list[i]->iterations;
+    }
+#else
+    /* single context: <p> is the port member of results[0] */
+    total_iterations = ((core_results *)((char *)p - offsetof(core_results, port)))->iterations;
+#endif
+    neorv32_uart0_printf("NEORV32: Contexts     : %u\n", (uint32_t)default_num_contexts);
+    neorv32_uart0_printf("NEORV32: CoreMark/MHz : ");
+    print_coremark_mhz(total_iterations, stop_time_val - start_time_val);
+    neorv32_uart0_printf("\n");
+#if USE_NEORV32_CTX
+    for (i = 0; i < default_num_contexts; i++) {
+      ee_u64 ctx_cycles = ctx_list[i]->port.ctx_stop - ctx_list[i]->port.ctx_start;
+      neorv32_uart0_printf("NEORV32: [%u] start @%u, %u cycles, %u iterations, CoreMark/MHz ",
+                           i, (uint32_t)(ctx_list[i]->port.ctx_start - start_time_val),
+                           (uint32_t)ctx_cycles, (uint32_t)ctx_list[i]->iterations);
+      print_coremark_mhz(ctx_list[i]->iterations, ctx_cycles);
+      neorv32_uart0_printf("\n");
+    }
+#endif
+    neorv32_uart0_printf("\n");
 }
@@ -32,7 +32,9 @@ Original Author: Shay Gal-on
 /* NEORV32-specific */
 /************************/
 #define BAUD_RATE  (19200)
+#ifndef ITERATIONS
 #define ITERATIONS (2000)
+#endif
 #define FLAGS_STR  CC_OPTS
 
 /************************/
@@ -142,8 +144,12 @@ typedef ee_u64 CORE_TICKS;
         MEM_STACK - to allocate the data block on the stack (NYI).
 */
 #ifndef MEM_METHOD
+#if (MULTITHREAD > 1)
+#define MEM_METHOD MEM_STACK
+#else
 #define MEM_METHOD MEM_STATIC
 #endif
+#endif
 
 /* Configuration : MULTITHREAD
         Define for parallel execution
@@ -161,12 +167,25 @@ typedef ee_u64 CORE_TICKS;
 
         It is valid to have a different implementation of <core_start_parallel>
    and <core_end_parallel> in <core_portme.c>, to fit a particular architecture.
+
+        NEORV32-specific: the number of contexts can be overridden from the
+   makefile (e.g. USER_FLAGS+=-DMULTITHREAD=4). The NEORV32 context backend
+   (USE_NEORV32_CTX) registers all contexts and then runs them back-to-back
+   through the <core_parallel_worker> loop on the calling hart. There is no
+   per-hart dispatch; the LR/SC-based context counter only prepares the
+   backend for additional harts calling <core_parallel_worker>.
 */
 #ifndef MULTITHREAD
 #define MULTITHREAD 1
+#endif
 #define USE_PTHREAD 0
 #define USE_FORK    0
 #define USE_SOCKET  0
+#if (MULTITHREAD > 1)
+#define USE_NEORV32_CTX 1
+#define PARALLEL_METHOD "NEORV32-CTX"
+#else
+#define USE_NEORV32_CTX 0
 #endif
 
 /* Configuration : MAIN_HAS_NOARGC
@@ -196,15 +215,23 @@ typedef ee_u64 CORE_TICKS;
 #endif
 
 /* Variable : default_num_contexts
-        Not used for this simple port, must cintain the value 1.
+        Number of contexts to execute; equals MULTITHREAD.
 */
 extern ee_u32 default_num_contexts;
 
 typedef struct CORE_PORTABLE_S
 {
-    ee_u8 portable_id;
+    ee_u8  portable_id;
+    ee_u8  ctx_id;      /* NEORV32-specific: context index */
+    ee_u64 ctx_start;   /* NEORV32-specific: context start time stamp (cycles) */
+    ee_u64 ctx_stop;    /* NEORV32-specific: context stop time stamp (cycles) */
 } core_portable;
 
+#if USE_NEORV32_CTX
+/* NEORV32-specific: hart entry point for parallel contexts */
+ee_u32 core_parallel_worker(void);
+#endif
+
 /* target specific init/fini */
 void portable_init(core_portable *p, int *argc, char *argv[]);
 void portable_fini(core_portable *p);
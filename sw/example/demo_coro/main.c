@@ -0,0 +1,198 @@
+// #################################################################################################
+// # << NEORV32 - Cooperative Coroutine Scheduler Demo Program >>                                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_coro/main.c
+ * @author Stephan Nolting
+ * @brief Cooperative coroutine scheduler (neorv32_coro.c) demo and
+ * context switch benchmark.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of yields per coroutine for the context switch benchmark */
+#define NUM_YIELDS 1000
+/** Number of GPTMR ticks for the event demo */
+#define NUM_TICKS 8
+/** Stack size per coroutine in bytes */
+#define STACK_SIZE 512
+/**@}*/
+
+
+/**********************************************************************//**
+ * Coroutines and their stacks
+ **************************************************************************/
+static neorv32_coro_t coro_a, coro_b;
+static uint32_t stack_a[STACK_SIZE/4] __attribute__((aligned(16)));
+static uint32_t stack_b[STACK_SIZE/4] __attribute__((aligned(16)));
+
+// prototypes
+void yield_task(void *arg);
+void tick_task(void *arg);
+void echo_task(void *arg);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension, UART0 and GPTMR.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr is implemented at all
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Cooperative Coroutine Scheduler Demo >>>\n\n");
+
+
+  // --------------------------------------------------------------------------
+  // context switch benchmark: two coroutines yielding to each other
+  // --------------------------------------------------------------------------
+  neorv32_uart0_printf("[1] Context switch benchmark (%u yields per coroutine)\n", (uint32_t)NUM_YIELDS);
+
+  neorv32_coro_create(&coro_a, yield_task, NULL, stack_a, sizeof(stack_a));
+  neorv32_coro_create(&coro_b, yield_task, NULL, stack_b, sizeof(stack_b));
+
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+  uint32_t cycles = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_coro_run();
+  cycles = neorv32_cpu_csr_read(CSR_MCYCLE) - cycles;
+
+  // each yield = two context switches (coroutine -> scheduler -> next coroutine)
+  neorv32_uart0_printf("total cycles:      %u\n", cycles);
+  neorv32_uart0_printf("cycles per yield:  %u\n", cycles / (2*NUM_YIELDS));
+  neorv32_uart0_printf("cycles per switch: %u\n\n", cycles / (4*NUM_YIELDS));
+
+
+  // --------------------------------------------------------------------------
+  // event demo: GPTMR ticks and UART0 RX echo
+  // --------------------------------------------------------------------------
+  if (neorv32_gptmr_available() == 0) {
+    neorv32_uart0_printf("GPTMR not implemented, skipping event demo.\n");
+    return 0;
+  }
+
+  neorv32_uart0_printf("[2] Event demo: %u GPTMR ticks", (uint32_t)NUM_TICKS);
+  neorv32_coro_irq_setup();
+  neorv32_coro_create(&coro_a, tick_task, NULL, stack_a, sizeof(stack_a));
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_IS_SIM)) == 0) { // no UART input in simulation
+    neorv32_uart0_printf(" + UART0 echo (press ESC to end)");
+    neorv32_coro_create(&coro_b, echo_task, NULL, stack_b, sizeof(stack_b));
+  }
+  neorv32_uart0_printf("\n");
+
+  // GPTMR tick every 1/4 second
+  neorv32_gptmr_setup(CLK_PRSC_4096, NEORV32_SYSINFO->CLK / (4096 * 4), 1);
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  neorv32_coro_run(); // sleeps (wfi) while all coroutines are waiting
+
+  neorv32_gptmr_disable();
+  neorv32_uart0_printf("\nProgram completed.\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Benchmark coroutine: yield NUM_YIELDS times.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void yield_task(void *arg) {
+
+  (void)arg;
+  int i;
+  for (i=0; i<NUM_YIELDS; i++) {
+    neorv32_coro_yield();
+  }
+}
+
+
+/**********************************************************************//**
+ * Event coroutine: wait for GPTMR ticks.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void tick_task(void *arg) {
+
+  (void)arg;
+  int i;
+  for (i=0; i<NUM_TICKS; i++) {
+    neorv32_coro_gptmr_wait();
+    neorv32_uart0_putc('.');
+  }
+}
+
+
+/**********************************************************************//**
+ * Event coroutine: echo UART0 RX data until ESC is received.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void echo_task(void *arg) {
+
+  (void)arg;
+  char c;
+  while (1) {
+    c = neorv32_coro_uart0_getc();
+    if (c == 27) { // ESC
+      break;
+    }
+    neorv32_uart0_putc(c);
+  }
+}
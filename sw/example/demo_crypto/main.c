@@ -0,0 +1,699 @@
+// #################################################################################################
+// # << NEORV32 - Scalar Cryptography (Zkn) Demo and Benchmark >>                                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_crypto/main.c
+ * @author Stephan Nolting
+ * @brief Scalar cryptography (Zkne, Zknd, Zknh) demo and benchmark: AES-128 and
+ * SHA-256 using the crypto instructions versus table-based/plain C implementations.
+ *
+ * All results are given in CPU clock cycles (mcycle) and cycles per byte and are
+ * printed in a "key=value" format so they can be parsed by the benchmark runner
+ * (sw/example/performance_tests/run_benchmarks.py).
+ **************************************************************************/
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Benchmark data size in bytes (multiple of 64) */
+#define DATA_SIZE 1024
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Benchmark data
+ **************************************************************************/
+/**@{*/
+static uint32_t buf_in[DATA_SIZE/4];
+static uint32_t buf_out[DATA_SIZE/4];
+static uint32_t buf_chk[DATA_SIZE/4];
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name AES-128 (FIPS-197); state and round keys are little-endian words:
+ * column c = word c, row r = byte r of that word.
+ **************************************************************************/
+/**@{*/
+/** AES-128 expanded key: 11 round keys */
+typedef struct {
+  uint32_t ek[44]; /**< encryption round keys */
+  uint32_t dk[44]; /**< decryption round keys (equivalent inverse cipher, Zknd only) */
+} aes128_ctx_t;
+
+/** Forward S-box */
+static const uint8_t aes_sbox[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/** Combined SubBytes/MixColumns tables ("T-tables") for the table-based reference; generated at runtime */
+static uint32_t aes_te[4][256];
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name SHA-256 (FIPS 180-4)
+ **************************************************************************/
+/**@{*/
+/** Round constants */
+static const uint32_t sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/** Initial hash value */
+static const uint32_t sha256_h0[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/** Compression function of one implementation */
+typedef void (*sha256_blocks_t)(uint32_t *state, const uint8_t *data, uint32_t nblocks);
+/**@}*/
+
+
+// Prototypes
+static uint32_t get_cycle(void);
+static void aes_te_init(void);
+static void aes128_key_expand(aes128_ctx_t *ctx, const uint8_t *key, int with_dec);
+static void aes128_enc_table(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks);
+static void aes128_enc_zkn(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks);
+static void aes128_dec_zkn(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks);
+static void sha256_blocks_ref(uint32_t *state, const uint8_t *data, uint32_t nblocks);
+static void sha256_blocks_zkn(uint32_t *state, const uint8_t *data, uint32_t nblocks);
+static void sha256_digest(sha256_blocks_t f, const uint8_t *msg, uint32_t len, uint32_t *digest);
+static void print_result(const char *alg, const char *impl, uint32_t cycles);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension and UART0. The crypto
+ * variants are only executed if the according ISA extensions are implemented.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  static aes128_ctx_t ctx;
+  uint32_t i, t, xisa, digest[8], state[8];
+  int fails = 0;
+
+  // FIPS-197 appendix C.1 test vector
+  static const uint8_t aes_key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  static const uint8_t aes_pt[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  static const uint8_t aes_ct[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  // FIPS 180-4 example: SHA-256("abc")
+  static const uint32_t sha_abc[8] = {
+    0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad
+  };
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr is implemented
+  xisa = neorv32_cpu_csr_read(CSR_MXISA);
+  if ((xisa & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // no interrupts, make sure all counters are running
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Scalar Cryptography Demo >>>\n\n");
+  neorv32_uart0_printf("Zkne=%u Zknd=%u Zknh=%u bytes=%u\n\n",
+                       (xisa >> CSR_MXISA_ZKNE) & 1, (xisa >> CSR_MXISA_ZKND) & 1, (xisa >> CSR_MXISA_ZKNH) & 1,
+                       (uint32_t)DATA_SIZE);
+
+  // test data
+  for (i=0; i<DATA_SIZE/4; i++) {
+    buf_in[i] = (i * 0x9e3779b9) ^ 0x5a5aa5a5;
+  }
+
+
+  // ----------------------------------------------------------
+  // AES-128 encryption / decryption
+  // ----------------------------------------------------------
+  aes_te_init();
+  aes128_key_expand(&ctx, aes_key, (xisa & (1 << CSR_MXISA_ZKNE)) && (xisa & (1 << CSR_MXISA_ZKND)));
+
+  memcpy(buf_out, aes_pt, 16);
+  aes128_enc_table(&ctx, buf_out, buf_out, 1);
+  if (memcmp(buf_out, aes_ct, 16)) {
+    neorv32_uart0_printf("ERROR! AES-128 (table) test vector mismatch!\n");
+    fails++;
+  }
+
+  t = get_cycle();
+  aes128_enc_table(&ctx, buf_chk, buf_in, DATA_SIZE/16);
+  print_result("aes128_enc", "table", get_cycle() - t);
+
+  if (xisa & (1 << CSR_MXISA_ZKNE)) {
+    memcpy(buf_out, aes_pt, 16);
+    aes128_enc_zkn(&ctx, buf_out, buf_out, 1);
+    if (memcmp(buf_out, aes_ct, 16)) {
+      neorv32_uart0_printf("ERROR! AES-128 (zkne) test vector mismatch!\n");
+      fails++;
+    }
+
+    t = get_cycle();
+    aes128_enc_zkn(&ctx, buf_out, buf_in, DATA_SIZE/16);
+    print_result("aes128_enc", "zkn", get_cycle() - t);
+
+    if (memcmp(buf_out, buf_chk, DATA_SIZE)) {
+      neorv32_uart0_printf("ERROR! AES-128 (zkne) result mismatch!\n");
+      fails++;
+    }
+
+    // decryption requires Zkne for the decryption key schedule
+    if (xisa & (1 << CSR_MXISA_ZKND)) {
+      t = get_cycle();
+      aes128_dec_zkn(&ctx, buf_out, buf_chk, DATA_SIZE/16);
+      print_result("aes128_dec", "zkn", get_cycle() - t);
+
+      if (memcmp(buf_out, buf_in, DATA_SIZE)) {
+        neorv32_uart0_printf("ERROR! AES-128 (zknd) round-trip mismatch!\n");
+        fails++;
+      }
+    }
+  }
+
+
+  // ----------------------------------------------------------
+  // SHA-256 compression
+  // ----------------------------------------------------------
+  sha256_digest(sha256_blocks_ref, (const uint8_t*)"abc", 3, digest);
+  if (memcmp(digest, sha_abc, 32)) {
+    neorv32_uart0_printf("ERROR! SHA-256 (ref) test vector mismatch!\n");
+    fails++;
+  }
+
+  memcpy(state, sha256_h0, 32);
+  t = get_cycle();
+  sha256_blocks_ref(state, (const uint8_t*)buf_in, DATA_SIZE/64);
+  print_result("sha256", "ref", get_cycle() - t);
+  memcpy(buf_chk, state, 32);
+
+  if (xisa & (1 << CSR_MXISA_ZKNH)) {
+    sha256_digest(sha256_blocks_zkn, (const uint8_t*)"abc", 3, digest);
+    if (memcmp(digest, sha_abc, 32)) {
+      neorv32_uart0_printf("ERROR! SHA-256 (zknh) test vector mismatch!\n");
+      fails++;
+    }
+
+    memcpy(state, sha256_h0, 32);
+    t = get_cycle();
+    sha256_blocks_zkn(state, (const uint8_t*)buf_in, DATA_SIZE/64);
+    print_result("sha256", "zkn", get_cycle() - t);
+
+    if (memcmp(buf_chk, state, 32)) {
+      neorv32_uart0_printf("ERROR! SHA-256 (zknh) result mismatch!\n");
+      fails++;
+    }
+  }
+
+  if (fails) {
+    neorv32_uart0_printf("\ndemo_crypto FAILED (%u errors)\n", (uint32_t)fails);
+    return 1;
+  }
+  neorv32_uart0_printf("\ndemo_crypto done\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Read low word of cycle counter.
+ *
+ * @return Current cycle count.
+ **************************************************************************/
+static uint32_t get_cycle(void) {
+  return neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Print benchmark result line.
+ *
+ * @param[in] alg Algorithm name.
+ * @param[in] impl Implementation name.
+ * @param[in] cycles Total cycles for DATA_SIZE bytes.
+ **************************************************************************/
+static void print_result(const char *alg, const char *impl, uint32_t cycles) {
+
+  uint32_t cpb10 = (cycles * 10) / DATA_SIZE;
+  neorv32_uart0_printf("alg=%s impl=%s cycles=%u cpb=%u.%u\n", alg, impl, cycles, cpb10 / 10, cpb10 % 10);
+}
+
+
+// ################################################################################################
+// AES-128
+// ################################################################################################
+
+/**********************************************************************//**
+ * Multiply by x in GF(2^8).
+ *
+ * @param[in] a Field element.
+ * @return a * x.
+ **************************************************************************/
+static inline uint8_t aes_xtime(uint8_t a) {
+  return (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1b : 0x00));
+}
+
+
+/**********************************************************************//**
+ * Generate the T-tables of the table-based reference implementation
+ * (aes_te[r][x] = MixColumns column for S(x) in row r).
+ **************************************************************************/
+static void aes_te_init(void) {
+
+  uint32_t i, s, s2, w;
+
+  for (i=0; i<256; i++) {
+    s  = aes_sbox[i];
+    s2 = aes_xtime((uint8_t)s);
+    w  = ((s2 ^ s) << 24) | (s << 16) | (s << 8) | s2; // {3, 1, 1, 2} * S(x)
+    aes_te[0][i] = w;
+    aes_te[1][i] = (w <<  8) | (w >> 24);
+    aes_te[2][i] = (w << 16) | (w >> 16);
+    aes_te[3][i] = (w << 24) | (w >>  8);
+  }
+}
+
+
+/**********************************************************************//**
+ * AES-128 key expansion.
+ *
+ * @param[in,out] ctx Key context.
+ * @param[in] key 16-byte cipher key.
+ * @param[in] with_dec Also compute the decryption key schedule (requires Zkne + Zknd).
+ **************************************************************************/
+static void aes128_key_expand(aes128_ctx_t *ctx, const uint8_t *key, int with_dec) {
+
+  uint32_t i, t, rcon = 1;
+
+  memcpy(ctx->ek, key, 16);
+  for (i=4; i<44; i++) {
+    t = ctx->ek[i-1];
+    if ((i % 4) == 0) {
+      t = (t >> 8) | (t << 24); // RotWord
+      t = ((uint32_t)aes_sbox[(t >>  0) & 0xff] <<  0) | ((uint32_t)aes_sbox[(t >>  8) & 0xff] <<  8) |
+          ((uint32_t)aes_sbox[(t >> 16) & 0xff] << 16) | ((uint32_t)aes_sbox[(t >> 24) & 0xff] << 24); // SubWord
+      t ^= rcon;
+      rcon = aes_xtime((uint8_t)rcon);
+    }
+    ctx->ek[i] = ctx->ek[i-4] ^ t;
+  }
+
+  // equivalent inverse cipher: reversed round keys, InvMixColumns applied to the middle ones
+  // InvMixColumns(w) = aes32dsmi(InvSubBytes(SubBytes(w))): undo the S-box with aes32esi first
+  if (with_dec) {
+    for (i=0; i<44; i+=4) {
+      memcpy(&ctx->dk[i], &ctx->ek[40-i], 16);
+    }
+    for (i=4; i<40; i++) {
+      t = ctx->dk[i];
+      t = riscv_intrinsic_aes32esi(0, t, 0) ^ riscv_intrinsic_aes32esi(0, t, 1) ^
+          riscv_intrinsic_aes32esi(0, t, 2) ^ riscv_intrinsic_aes32esi(0, t, 3);
+      ctx->dk[i] = riscv_intrinsic_aes32dsmi(0, t, 0) ^ riscv_intrinsic_aes32dsmi(0, t, 1) ^
+                   riscv_intrinsic_aes32dsmi(0, t, 2) ^ riscv_intrinsic_aes32dsmi(0, t, 3);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * AES-128 ECB encryption, table-based C reference (4 KiB T-tables).
+ *
+ * @param[in] ctx Key context.
+ * @param[out] out Ciphertext.
+ * @param[in] in Plaintext.
+ * @param[in] nblocks Number of 16-byte blocks.
+ **************************************************************************/
+static void aes128_enc_table(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks) {
+
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  const uint32_t *rk;
+  int r;
+
+  while (nblocks--) {
+    rk = ctx->ek;
+    s0 = in[0] ^ rk[0];
+    s1 = in[1] ^ rk[1];
+    s2 = in[2] ^ rk[2];
+    s3 = in[3] ^ rk[3];
+
+    for (r=1; r<10; r++) {
+      rk += 4;
+      t0 = rk[0] ^ aes_te[0][s0 & 0xff] ^ aes_te[1][(s1 >> 8) & 0xff] ^ aes_te[2][(s2 >> 16) & 0xff] ^ aes_te[3][s3 >> 24];
+      t1 = rk[1] ^ aes_te[0][s1 & 0xff] ^ aes_te[1][(s2 >> 8) & 0xff] ^ aes_te[2][(s3 >> 16) & 0xff] ^ aes_te[3][s0 >> 24];
+      t2 = rk[2] ^ aes_te[0][s2 & 0xff] ^ aes_te[1][(s3 >> 8) & 0xff] ^ aes_te[2][(s0 >> 16) & 0xff] ^ aes_te[3][s1 >> 24];
+      t3 = rk[3] ^ aes_te[0][s3 & 0xff] ^ aes_te[1][(s0 >> 8) & 0xff] ^ aes_te[2][(s1 >> 16) & 0xff] ^ aes_te[3][s2 >> 24];
+      s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // final round: SubBytes + ShiftRows only
+    rk += 4;
+    out[0] = rk[0] ^ ((uint32_t)aes_sbox[s0 & 0xff]) ^ ((uint32_t)aes_sbox[(s1 >> 8) & 0xff] << 8) ^
+             ((uint32_t)aes_sbox[(s2 >> 16) & 0xff] << 16) ^ ((uint32_t)aes_sbox[s3 >> 24] << 24);
+    out[1] = rk[1] ^ ((uint32_t)aes_sbox[s1 & 0xff]) ^ ((uint32_t)aes_sbox[(s2 >> 8) & 0xff] << 8) ^
+             ((uint32_t)aes_sbox[(s3 >> 16) & 0xff] << 16) ^ ((uint32_t)aes_sbox[s0 >> 24] << 24);
+    out[2] = rk[2] ^ ((uint32_t)aes_sbox[s2 & 0xff]) ^ ((uint32_t)aes_sbox[(s3 >> 8) & 0xff] << 8) ^
+             ((uint32_t)aes_sbox[(s0 >> 16) & 0xff] << 16) ^ ((uint32_t)aes_sbox[s1 >> 24] << 24);
+    out[3] = rk[3] ^ ((uint32_t)aes_sbox[s3 & 0xff]) ^ ((uint32_t)aes_sbox[(s0 >> 8) & 0xff] << 8) ^
+             ((uint32_t)aes_sbox[(s1 >> 16) & 0xff] << 16) ^ ((uint32_t)aes_sbox[s2 >> 24] << 24);
+
+    in  += 4;
+    out += 4;
+  }
+}
+
+
+/**********************************************************************//**
+ * AES-128 ECB encryption using the Zkne instructions (no tables).
+ *
+ * @param[in] ctx Key context.
+ * @param[out] out Ciphertext.
+ * @param[in] in Plaintext.
+ * @param[in] nblocks Number of 16-byte blocks.
+ **************************************************************************/
+static void aes128_enc_zkn(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks) {
+
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  const uint32_t *rk;
+  int r;
+
+  while (nblocks--) {
+    rk = ctx->ek;
+    s0 = in[0] ^ rk[0];
+    s1 = in[1] ^ rk[1];
+    s2 = in[2] ^ rk[2];
+    s3 = in[3] ^ rk[3];
+
+    for (r=1; r<10; r++) {
+      rk += 4;
+      t0 = riscv_intrinsic_aes32esmi(rk[0], s0, 0);
+      t0 = riscv_intrinsic_aes32esmi(t0,    s1, 1);
+      t0 = riscv_intrinsic_aes32esmi(t0,    s2, 2);
+      t0 = riscv_intrinsic_aes32esmi(t0,    s3, 3);
+      t1 = riscv_intrinsic_aes32esmi(rk[1], s1, 0);
+      t1 = riscv_intrinsic_aes32esmi(t1,    s2, 1);
+      t1 = riscv_intrinsic_aes32esmi(t1,    s3, 2);
+      t1 = riscv_intrinsic_aes32esmi(t1,    s0, 3);
+      t2 = riscv_intrinsic_aes32esmi(rk[2], s2, 0);
+      t2 = riscv_intrinsic_aes32esmi(t2,    s3, 1);
+      t2 = riscv_intrinsic_aes32esmi(t2,    s0, 2);
+      t2 = riscv_intrinsic_aes32esmi(t2,    s1, 3);
+      t3 = riscv_intrinsic_aes32esmi(rk[3], s3, 0);
+      t3 = riscv_intrinsic_aes32esmi(t3,    s0, 1);
+      t3 = riscv_intrinsic_aes32esmi(t3,    s1, 2);
+      t3 = riscv_intrinsic_aes32esmi(t3,    s2, 3);
+      s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // final round: SubBytes + ShiftRows only
+    rk += 4;
+    t0 = riscv_intrinsic_aes32esi(rk[0], s0, 0);
+    t0 = riscv_intrinsic_aes32esi(t0,    s1, 1);
+    t0 = riscv_intrinsic_aes32esi(t0,    s2, 2);
+    t0 = riscv_intrinsic_aes32esi(t0,    s3, 3);
+    t1 = riscv_intrinsic_aes32esi(rk[1], s1, 0);
+    t1 = riscv_intrinsic_aes32esi(t1,    s2, 1);
+    t1 = riscv_intrinsic_aes32esi(t1,    s3, 2);
+    t1 = riscv_intrinsic_aes32esi(t1,    s0, 3);
+    t2 = riscv_intrinsic_aes32esi(rk[2], s2, 0);
+    t2 = riscv_intrinsic_aes32esi(t2,    s3, 1);
+    t2 = riscv_intrinsic_aes32esi(t2,    s0, 2);
+    t2 = riscv_intrinsic_aes32esi(t2,    s1, 3);
+    t3 = riscv_intrinsic_aes32esi(rk[3], s3, 0);
+    t3 = riscv_intrinsic_aes32esi(t3,    s0, 1);
+    t3 = riscv_intrinsic_aes32esi(t3,    s1, 2);
+    t3 = riscv_intrinsic_aes32esi(t3,    s2, 3);
+    out[0] = t0; out[1] = t1; out[2] = t2; out[3] = t3;
+
+    in  += 4;
+    out += 4;
+  }
+}
+
+
+/**********************************************************************//**
+ * AES-128 ECB decryption using the Zknd instructions (equivalent inverse cipher).
+ *
+ * @param[in] ctx Key context (including decryption key schedule).
+ * @param[out] out Plaintext.
+ * @param[in] in Ciphertext.
+ * @param[in] nblocks Number of 16-byte blocks.
+ **************************************************************************/
+static void aes128_dec_zkn(const aes128_ctx_t *ctx, uint32_t *out, const uint32_t *in, uint32_t nblocks) {
+
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  const uint32_t *rk;
+  int r;
+
+  while (nblocks--) {
+    rk = ctx->dk;
+    s0 = in[0] ^ rk[0];
+    s1 = in[1] ^ rk[1];
+    s2 = in[2] ^ rk[2];
+    s3 = in[3] ^ rk[3];
+
+    for (r=1; r<10; r++) {
+      rk += 4;
+      t0 = riscv_intrinsic_aes32dsmi(rk[0], s0, 0);
+      t0 = riscv_intrinsic_aes32dsmi(t0,    s3, 1);
+      t0 = riscv_intrinsic_aes32dsmi(t0,    s2, 2);
+      t0 = riscv_intrinsic_aes32dsmi(t0,    s1, 3);
+      t1 = riscv_intrinsic_aes32dsmi(rk[1], s1, 0);
+      t1 = riscv_intrinsic_aes32dsmi(t1,    s0, 1);
+      t1 = riscv_intrinsic_aes32dsmi(t1,    s3, 2);
+      t1 = riscv_intrinsic_aes32dsmi(t1,    s2, 3);
+      t2 = riscv_intrinsic_aes32dsmi(rk[2], s2, 0);
+      t2 = riscv_intrinsic_aes32dsmi(t2,    s1, 1);
+      t2 = riscv_intrinsic_aes32dsmi(t2,    s0, 2);
+      t2 = riscv_intrinsic_aes32dsmi(t2,    s3, 3);
+      t3 = riscv_intrinsic_aes32dsmi(rk[3], s3, 0);
+      t3 = riscv_intrinsic_aes32dsmi(t3,    s2, 1);
+      t3 = riscv_intrinsic_aes32dsmi(t3,    s1, 2);
+      t3 = riscv_intrinsic_aes32dsmi(t3,    s0, 3);
+      s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // final round: InvSubBytes + InvShiftRows only
+    rk += 4;
+    t0 = riscv_intrinsic_aes32dsi(rk[0], s0, 0);
+    t0 = riscv_intrinsic_aes32dsi(t0,    s3, 1);
+    t0 = riscv_intrinsic_aes32dsi(t0,    s2, 2);
+    t0 = riscv_intrinsic_aes32dsi(t0,    s1, 3);
+    t1 = riscv_intrinsic_aes32dsi(rk[1], s1, 0);
+    t1 = riscv_intrinsic_aes32dsi(t1,    s0, 1);
+    t1 = riscv_intrinsic_aes32dsi(t1,    s3, 2);
+    t1 = riscv_intrinsic_aes32dsi(t1,    s2, 3);
+    t2 = riscv_intrinsic_aes32dsi(rk[2], s2, 0);
+    t2 = riscv_intrinsic_aes32dsi(t2,    s1, 1);
+    t2 = riscv_intrinsic_aes32dsi(t2,    s0, 2);
+    t2 = riscv_intrinsic_aes32dsi(t2,    s3, 3);
+    t3 = riscv_intrinsic_aes32dsi(rk[3], s3, 0);
+    t3 = riscv_intrinsic_aes32dsi(t3,    s2, 1);
+    t3 = riscv_intrinsic_aes32dsi(t3,    s1, 2);
+    t3 = riscv_intrinsic_aes32dsi(t3,    s0, 3);
+    out[0] = t0; out[1] = t1; out[2] = t2; out[3] = t3;
+
+    in  += 4;
+    out += 4;
+  }
+}
+
+
+// ################################################################################################
+// SHA-256
+// ################################################################################################
+
+/**********************************************************************//**
+ * Rotate right.
+ *
+ * @param[in] x Operand.
+ * @param[in] n Rotate amount (1..31).
+ * @return Rotated operand.
+ **************************************************************************/
+static inline uint32_t ror32(uint32_t x, uint32_t n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+
+/**********************************************************************//**
+ * Load big-endian word.
+ *
+ * @param[in] p Pointer to 4 bytes.
+ * @return Word.
+ **************************************************************************/
+static inline uint32_t load_be32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+
+/**
+ * SHA-256 compression loop body; the four sigma functions are provided
+ * by the SHA256_* macros of the implementation.
+ */
+#define SHA256_COMPRESS(state, data, nblocks)                                        \
+  uint32_t w[64], a, b, c, d, e, f, g, h, t1, t2;                                   \
+  int i;                                                                            \
+  while (nblocks--) {                                                               \
+    for (i=0; i<16; i++) {                                                          \
+      w[i] = load_be32(data + 4*i);                                                 \
+    }                                                                               \
+    for (i=16; i<64; i++) {                                                         \
+      w[i] = SHA256_SIG1(w[i-2]) + w[i-7] + SHA256_SIG0(w[i-15]) + w[i-16];         \
+    }                                                                               \
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];                         \
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];                         \
+    for (i=0; i<64; i++) {                                                          \
+      t1 = h + SHA256_SUM1(e) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];          \
+      t2 = SHA256_SUM0(a) + ((a & b) ^ (a & c) ^ (b & c));                          \
+      h = g; g = f; f = e; e = d + t1;                                              \
+      d = c; c = b; b = a; a = t1 + t2;                                             \
+    }                                                                               \
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;                     \
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;                     \
+    data += 64;                                                                     \
+  }
+
+
+/**********************************************************************//**
+ * SHA-256 compression, plain C reference.
+ *
+ * @param[in,out] state Hash state (8 words).
+ * @param[in] data Message blocks.
+ * @param[in] nblocks Number of 64-byte blocks.
+ **************************************************************************/
+static void sha256_blocks_ref(uint32_t *state, const uint8_t *data, uint32_t nblocks) {
+
+#define SHA256_SUM0(x) (ror32(x,  2) ^ ror32(x, 13) ^ ror32(x, 22))
+#define SHA256_SUM1(x) (ror32(x,  6) ^ ror32(x, 11) ^ ror32(x, 25))
+#define SHA256_SIG0(x) (ror32(x,  7) ^ ror32(x, 18) ^ ((x) >>  3))
+#define SHA256_SIG1(x) (ror32(x, 17) ^ ror32(x, 19) ^ ((x) >> 10))
+  SHA256_COMPRESS(state, data, nblocks)
+#undef SHA256_SUM0
+#undef SHA256_SUM1
+#undef SHA256_SIG0
+#undef SHA256_SIG1
+}
+
+
+/**********************************************************************//**
+ * SHA-256 compression using the Zknh instructions.
+ *
+ * @param[in,out] state Hash state (8 words).
+ * @param[in] data Message blocks.
+ * @param[in] nblocks Number of 64-byte blocks.
+ **************************************************************************/
+static void sha256_blocks_zkn(uint32_t *state, const uint8_t *data, uint32_t nblocks) {
+
+#define SHA256_SUM0(x) riscv_intrinsic_sha256sum0(x)
+#define SHA256_SUM1(x) riscv_intrinsic_sha256sum1(x)
+#define SHA256_SIG0(x) riscv_intrinsic_sha256sig0(x)
+#define SHA256_SIG1(x) riscv_intrinsic_sha256sig1(x)
+  SHA256_COMPRESS(state, data, nblocks)
+#undef SHA256_SUM0
+#undef SHA256_SUM1
+#undef SHA256_SIG0
+#undef SHA256_SIG1
+}
+
+
+/**********************************************************************//**
+ * SHA-256 digest of a short message (max. 55 bytes, single block).
+ *
+ * @param[in] f Compression function.
+ * @param[in] msg Message.
+ * @param[in] len Message length in bytes (0..55).
+ * @param[out] digest Hash value (8 words).
+ **************************************************************************/
+static void sha256_digest(sha256_blocks_t f, const uint8_t *msg, uint32_t len, uint32_t *digest) {
+
+  uint8_t block[64];
+
+  memset(block, 0, 64);
+  memcpy(block, msg, len);
+  block[len] = 0x80;
+  block[62] = (uint8_t)((len * 8) >> 8);
+  block[63] = (uint8_t)(len * 8);
+
+  memcpy(digest, sha256_h0, 32);
+  f(digest, block, 1);
+}
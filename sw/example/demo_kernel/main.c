@@ -0,0 +1,191 @@
+// #################################################################################################
+// # << NEORV32 - Preemptive Kernel Demo Program >>                                                #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_kernel/main.c
+ * @author Stephan Nolting
+ * @brief Preemptive fixed-priority kernel (neorv32_kernel.c) demo program.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** System tick period in clock cycles */
+#define TICK_CYCLES 20000
+/** Number of messages sent by the producer task */
+#define NUM_MSG 8
+/** Stack size per task in bytes */
+#define STACK_SIZE 1024
+/**@}*/
+
+
+/**********************************************************************//**
+ * Message sent from producer to consumer
+ **************************************************************************/
+typedef struct {
+  uint32_t seq;    // sequence number
+  uint32_t cycles; // mcycle when sent
+} msg_t;
+
+
+/**********************************************************************//**
+ * Tasks, stacks and kernel objects
+ **************************************************************************/
+static neorv32_kernel_task_t task_cons, task_prod, task_spin;
+static uint32_t stack_cons[STACK_SIZE/4] __attribute__((aligned(16)));
+static uint32_t stack_prod[STACK_SIZE/4] __attribute__((aligned(16)));
+static uint32_t stack_spin[STACK_SIZE/4] __attribute__((aligned(16)));
+
+static neorv32_kernel_queue_t queue;
+static msg_t queue_buf[4];
+static neorv32_kernel_sem_t uart_lock;
+static volatile uint32_t spin_cnt = 0;
+
+// prototypes
+void consumer(void *arg);
+void producer(void *arg);
+void spinner(void *arg);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension, MTIME and UART0.
+ *
+ * @return Does not return.
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if MTIME is implemented
+  if (neorv32_mtime_available() == 0) {
+    neorv32_uart0_printf("ERROR! MTIME not implemented!\n");
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Preemptive Kernel Demo >>>\n\n");
+
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+
+  // kernel objects
+  neorv32_kernel_queue_init(&queue, queue_buf, sizeof(msg_t), sizeof(queue_buf)/sizeof(msg_t));
+  neorv32_kernel_sem_init(&uart_lock, 1);
+
+  // tasks: consumer has the highest priority, producer and spinner share the CPU (time slicing)
+  neorv32_kernel_task_create(&task_cons, consumer, NULL, 3, stack_cons, sizeof(stack_cons));
+  neorv32_kernel_task_create(&task_prod, producer, NULL, 1, stack_prod, sizeof(stack_prod));
+  neorv32_kernel_task_create(&task_spin, spinner,  NULL, 1, stack_spin, sizeof(stack_spin));
+
+  neorv32_kernel_start(TICK_CYCLES); // does not return
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Consumer task: receive messages and print the send-to-receive latency
+ * (includes the kernel entry and the context switch).
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void consumer(void *arg) {
+
+  (void)arg;
+  msg_t msg;
+  uint32_t i;
+
+  for (i=0; i<NUM_MSG; i++) {
+    neorv32_kernel_queue_receive(&queue, &msg);
+    uint32_t latency = neorv32_cpu_csr_read(CSR_MCYCLE) - msg.cycles;
+
+    neorv32_kernel_sem_take(&uart_lock);
+    neorv32_uart0_printf("[consumer] msg %u received after %u cycles (tick %u, spinner %u)\n",
+                         msg.seq, latency, neorv32_kernel_get_ticks(), spin_cnt);
+    neorv32_kernel_sem_give(&uart_lock);
+  }
+
+  neorv32_kernel_sem_take(&uart_lock);
+  neorv32_uart0_printf("\nProgram completed.\n");
+  neorv32_kernel_sem_give(&uart_lock);
+}
+
+
+/**********************************************************************//**
+ * Producer task: send a message every two ticks.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void producer(void *arg) {
+
+  (void)arg;
+  msg_t msg;
+  uint32_t i;
+
+  for (i=0; i<NUM_MSG; i++) {
+    neorv32_kernel_sleep(2);
+    msg.seq = i;
+    msg.cycles = neorv32_cpu_csr_read(CSR_MCYCLE);
+    neorv32_kernel_queue_send(&queue, &msg); // consumer preempts producer right here
+  }
+}
+
+
+/**********************************************************************//**
+ * Spinner task: never blocks; only preempted by the system tick.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+void spinner(void *arg) {
+
+  (void)arg;
+  while (task_cons.state != KERNEL_TASK_DONE) {
+    spin_cnt++;
+  }
+}
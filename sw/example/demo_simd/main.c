@@ -0,0 +1,546 @@
+// #################################################################################################
+// # << NEORV32 - Packed-SIMD DSP (Zxpsimd) Demo and Benchmark >>                                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_simd/main.c
+ * @author Stephan Nolting
+ * @brief Packed-SIMD (Zxpsimd) demo and benchmark: typical 8-bit/16-bit audio and
+ * sensor kernels using the packed-SIMD instructions versus plain C implementations.
+ *
+ * All results are given in CPU clock cycles (mcycle) and cycles per sample and are
+ * printed in a "key=value" format so they can be parsed by the benchmark runner
+ * (sw/example/performance_tests/run_benchmarks.py).
+ **************************************************************************/
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of samples per kernel (multiple of 4) */
+#define NUM_SAMPLES 256
+/** Number of FIR filter taps (even) */
+#define FIR_TAPS 16
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Benchmark data; unions are used to access the same data as samples and as packed words
+ **************************************************************************/
+/**@{*/
+/** 16-bit sample buffer */
+typedef union {
+  int16_t  h[NUM_SAMPLES];
+  uint32_t w[NUM_SAMPLES/2];
+} buf16_t;
+
+/** 16-bit sample buffer with FIR_TAPS samples of filter history in front */
+typedef union {
+  int16_t  h[FIR_TAPS + NUM_SAMPLES];
+  uint32_t w[(FIR_TAPS + NUM_SAMPLES)/2];
+} fir16_t;
+
+/** 8-bit sample buffer */
+typedef union {
+  uint8_t  b[NUM_SAMPLES];
+  int8_t   sb[NUM_SAMPLES];
+  uint32_t w[NUM_SAMPLES/4];
+} buf8_t;
+
+static buf16_t in_a, in_b, out_ref, out_simd;
+static fir16_t fir_in;
+static buf8_t  pix_in, pix_ref, pix_simd, vec_a, vec_b;
+
+/** FIR low-pass coefficients (Q15, fc = fs/10, Hamming window, sum = 32768) */
+static const int16_t fir_coeff[FIR_TAPS] = {
+  -114, -159, -139, 291, 1450, 3284, 5246, 6525, 6525, 5246, 3284, 1450, 291, -139, -159, -114
+};
+
+/** Packed (reversed) FIR coefficients: even/odd window alignment */
+static uint32_t fir_ce[FIR_TAPS/2], fir_co[FIR_TAPS/2+1];
+
+/** Biquad low-pass (fc = fs/10, Q = 0.707) coefficients (Q14); a0 = 1 */
+#define BQ_B0   1106
+#define BQ_B1   2211
+#define BQ_B2   1106
+#define BQ_A1 (-18727)
+#define BQ_A2   6763
+/**@}*/
+
+
+// Prototypes
+static uint32_t get_cycle(void);
+static int32_t sat16(int32_t x);
+static void mix16_ref(void);
+static void mix16_simd(void);
+static void bright8_ref(uint8_t offset);
+static void bright8_simd(uint8_t offset);
+static int32_t dot8_ref(void);
+static int32_t dot8_simd(void);
+static void fir16_ref(void);
+static void fir16_init(void);
+static void fir16_simd(void);
+static void biquad_ref(void);
+static void biquad_simd(void);
+static void print_result(const char *alg, const char *impl, uint32_t cycles, uint32_t ref_cycles);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension, the Zxpsimd CPU extension and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  uint32_t i, t, t_ref, xisa, seed;
+  int32_t dot_ref, dot_simd;
+  int fails = 0;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr and Zxpsimd are implemented
+  xisa = neorv32_cpu_csr_read(CSR_MXISA);
+  if ((xisa & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+  if ((xisa & (1 << CSR_MXISA_ZXPSIMD)) == 0) {
+    neorv32_uart0_printf("ERROR! Zxpsimd CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // no interrupts, make sure all counters are running
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Packed-SIMD DSP Demo >>>\n\n");
+  neorv32_uart0_printf("samples=%u fir_taps=%u\n\n", (uint32_t)NUM_SAMPLES, (uint32_t)FIR_TAPS);
+
+  // test data: pseudo-random samples using the full value range (to exercise saturation)
+  seed = 0x12345678;
+  for (i=0; i<NUM_SAMPLES; i++) {
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; // xorshift32
+    in_a.h[i]   = (int16_t)seed;
+    in_b.h[i]   = (int16_t)(seed >> 16);
+    pix_in.b[i] = (uint8_t)(seed >> 8);
+    vec_a.b[i]  = (uint8_t)(seed >> 3);
+    vec_b.b[i]  = (uint8_t)(seed >> 21);
+  }
+  memset(fir_in.h, 0, sizeof(fir_in.h)); // zero filter history
+  for (i=0; i<NUM_SAMPLES; i++) {
+    fir_in.h[FIR_TAPS + i] = in_a.h[i] >> 1;
+  }
+
+
+  // ----------------------------------------------------------
+  // 2x16-bit saturating mixer: y = sat(a + b)
+  // ----------------------------------------------------------
+  t = get_cycle();
+  mix16_ref();
+  t_ref = get_cycle() - t;
+  print_result("mix16", "scalar", t_ref, 0);
+
+  t = get_cycle();
+  mix16_simd();
+  print_result("mix16", "simd", get_cycle() - t, t_ref);
+
+  if (memcmp(out_ref.h, out_simd.h, sizeof(out_ref.h))) {
+    neorv32_uart0_printf("ERROR! mix16 result mismatch!\n");
+    fails++;
+  }
+
+
+  // ----------------------------------------------------------
+  // 4x8-bit unsigned saturating brightness: y = min(p + offset, 255)
+  // ----------------------------------------------------------
+  t = get_cycle();
+  bright8_ref(77);
+  t_ref = get_cycle() - t;
+  print_result("bright8", "scalar", t_ref, 0);
+
+  t = get_cycle();
+  bright8_simd(77);
+  print_result("bright8", "simd", get_cycle() - t, t_ref);
+
+  if (memcmp(pix_ref.b, pix_simd.b, sizeof(pix_ref.b))) {
+    neorv32_uart0_printf("ERROR! bright8 result mismatch!\n");
+    fails++;
+  }
+
+
+  // ----------------------------------------------------------
+  // 4x8-bit signed dot-product: y = sum(a[i] * b[i])
+  // ----------------------------------------------------------
+  t = get_cycle();
+  dot_ref = dot8_ref();
+  t_ref = get_cycle() - t;
+  print_result("dot8", "scalar", t_ref, 0);
+
+  t = get_cycle();
+  dot_simd = dot8_simd();
+  print_result("dot8", "simd", get_cycle() - t, t_ref);
+
+  if (dot_ref != dot_simd) {
+    neorv32_uart0_printf("ERROR! dot8 result mismatch!\n");
+    fails++;
+  }
+
+
+  // ----------------------------------------------------------
+  // 16-bit (Q15) FIR filter
+  // ----------------------------------------------------------
+  fir16_init();
+
+  t = get_cycle();
+  fir16_ref();
+  t_ref = get_cycle() - t;
+  print_result("fir16", "scalar", t_ref, 0);
+
+  t = get_cycle();
+  fir16_simd();
+  print_result("fir16", "simd", get_cycle() - t, t_ref);
+
+  if (memcmp(out_ref.h, out_simd.h, sizeof(out_ref.h))) {
+    neorv32_uart0_printf("ERROR! fir16 result mismatch!\n");
+    fails++;
+  }
+
+
+  // ----------------------------------------------------------
+  // 16-bit (Q14) biquad IIR filter
+  // ----------------------------------------------------------
+  t = get_cycle();
+  biquad_ref();
+  t_ref = get_cycle() - t;
+  print_result("biquad", "scalar", t_ref, 0);
+
+  t = get_cycle();
+  biquad_simd();
+  print_result("biquad", "simd", get_cycle() - t, t_ref);
+
+  if (memcmp(out_ref.h, out_simd.h, sizeof(out_ref.h))) {
+    neorv32_uart0_printf("ERROR! biquad result mismatch!\n");
+    fails++;
+  }
+
+  if (fails) {
+    neorv32_uart0_printf("\ndemo_simd FAILED (%u errors)\n", (uint32_t)fails);
+    return 1;
+  }
+  neorv32_uart0_printf("\ndemo_simd done\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Get current cycle counter value (low word only).
+ *
+ * @return Current mcycle value.
+ **************************************************************************/
+static uint32_t get_cycle(void) {
+  return neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Saturate to signed 16-bit range.
+ *
+ * @param[in] x Input value.
+ * @return x clipped to -32768..32767.
+ **************************************************************************/
+static int32_t sat16(int32_t x) {
+
+  if (x > 32767) {
+    return 32767;
+  }
+  if (x < -32768) {
+    return -32768;
+  }
+  return x;
+}
+
+
+/**********************************************************************//**
+ * Print benchmark result line.
+ *
+ * @param[in] alg Algorithm name.
+ * @param[in] impl Implementation name.
+ * @param[in] cycles Total cycles for NUM_SAMPLES samples.
+ * @param[in] ref_cycles Cycles of the scalar reference (0 = do not print speedup).
+ **************************************************************************/
+static void print_result(const char *alg, const char *impl, uint32_t cycles, uint32_t ref_cycles) {
+
+  uint32_t cps10 = (cycles * 10) / NUM_SAMPLES;
+  neorv32_uart0_printf("alg=%s impl=%s cycles=%u cps=%u.%u", alg, impl, cycles, cps10 / 10, cps10 % 10);
+  if ((ref_cycles != 0) && (cycles != 0)) {
+    uint32_t speedup10 = (ref_cycles * 10) / cycles;
+    neorv32_uart0_printf(" speedup=%u.%u", speedup10 / 10, speedup10 % 10);
+  }
+  neorv32_uart0_printf("\n");
+}
+
+
+// ################################################################################################
+// Mixer and brightness (packed saturating add)
+// ################################################################################################
+
+/**********************************************************************//**
+ * 16-bit saturating mixer - plain C.
+ **************************************************************************/
+static void mix16_ref(void) {
+
+  uint32_t i;
+  for (i=0; i<NUM_SAMPLES; i++) {
+    out_ref.h[i] = (int16_t)sat16((int32_t)in_a.h[i] + (int32_t)in_b.h[i]);
+  }
+}
+
+
+/**********************************************************************//**
+ * 16-bit saturating mixer - Zxpsimd (2 samples per instruction).
+ **************************************************************************/
+static void mix16_simd(void) {
+
+  uint32_t i;
+  for (i=0; i<NUM_SAMPLES/2; i++) {
+    out_simd.w[i] = riscv_intrinsic_kadd16(in_a.w[i], in_b.w[i]);
+  }
+}
+
+
+/**********************************************************************//**
+ * 8-bit saturating brightness adjustment - plain C.
+ *
+ * @param[in] offset Brightness offset.
+ **************************************************************************/
+static void bright8_ref(uint8_t offset) {
+
+  uint32_t i, tmp;
+  for (i=0; i<NUM_SAMPLES; i++) {
+    tmp = (uint32_t)pix_in.b[i] + offset;
+    pix_ref.b[i] = (tmp > 255) ? 255 : (uint8_t)tmp;
+  }
+}
+
+
+/**********************************************************************//**
+ * 8-bit saturating brightness adjustment - Zxpsimd (4 pixels per instruction).
+ *
+ * @param[in] offset Brightness offset.
+ **************************************************************************/
+static void bright8_simd(uint8_t offset) {
+
+  uint32_t i, off4 = offset * 0x01010101U;
+  for (i=0; i<NUM_SAMPLES/4; i++) {
+    pix_simd.w[i] = riscv_intrinsic_ukadd8(pix_in.w[i], off4);
+  }
+}
+
+
+// ################################################################################################
+// Dot-product (packed multiply-accumulate)
+// ################################################################################################
+
+/**********************************************************************//**
+ * 8-bit signed dot-product - plain C.
+ *
+ * @return Dot-product.
+ **************************************************************************/
+static int32_t dot8_ref(void) {
+
+  uint32_t i;
+  int32_t sum = 0;
+  for (i=0; i<NUM_SAMPLES; i++) {
+    sum += (int32_t)vec_a.sb[i] * (int32_t)vec_b.sb[i];
+  }
+  return sum;
+}
+
+
+/**********************************************************************//**
+ * 8-bit signed dot-product - Zxpsimd (4 MACs per instruction).
+ *
+ * @return Dot-product.
+ **************************************************************************/
+static int32_t dot8_simd(void) {
+
+  uint32_t i, sum = 0;
+  for (i=0; i<NUM_SAMPLES/4; i++) {
+    sum = riscv_intrinsic_smaqa(sum, vec_a.w[i], vec_b.w[i]);
+  }
+  return (int32_t)sum;
+}
+
+
+// ################################################################################################
+// FIR filter: y[n] = sat(sum_k(c[k] * x[n-k]) >> 15)
+// ################################################################################################
+
+/**********************************************************************//**
+ * 16-bit FIR filter - plain C.
+ **************************************************************************/
+static void fir16_ref(void) {
+
+  uint32_t n, k;
+  int32_t acc;
+  const int16_t *x;
+
+  for (n=0; n<NUM_SAMPLES; n++) {
+    x = &fir_in.h[FIR_TAPS + n];
+    acc = 0;
+    for (k=0; k<FIR_TAPS; k++) {
+      acc += (int32_t)fir_coeff[k] * (int32_t)x[-(int32_t)k];
+    }
+    out_ref.h[n] = (int16_t)sat16(acc >> 15);
+  }
+}
+
+
+/**********************************************************************//**
+ * Pack the reversed FIR coefficients for the SIMD filter. The sample window of
+ * output n starts at x[n+1]; its word alignment alternates from output to output.
+ * Windows starting at an even index use fir_ce, windows starting at an odd index
+ * start one sample earlier and use fir_co (coefficients shifted by one, zero-padded).
+ **************************************************************************/
+static void fir16_init(void) {
+
+  int16_t cr[FIR_TAPS + 2];
+  uint32_t i;
+
+  // reversed coefficients with one zero in front and at the end
+  cr[0] = 0;
+  cr[FIR_TAPS + 1] = 0;
+  for (i=0; i<FIR_TAPS; i++) {
+    cr[i + 1] = fir_coeff[FIR_TAPS - 1 - i];
+  }
+
+  for (i=0; i<FIR_TAPS/2; i++) {
+    fir_ce[i] = ((uint32_t)(uint16_t)cr[2*i + 1]) | ((uint32_t)(uint16_t)cr[2*i + 2] << 16);
+  }
+  for (i=0; i<FIR_TAPS/2+1; i++) {
+    fir_co[i] = ((uint32_t)(uint16_t)cr[2*i]) | ((uint32_t)(uint16_t)cr[2*i + 1] << 16);
+  }
+}
+
+
+/**********************************************************************//**
+ * 16-bit FIR filter - Zxpsimd (2 MACs per instruction, two outputs per iteration).
+ **************************************************************************/
+static void fir16_simd(void) {
+
+  uint32_t n, k, acc;
+  const uint32_t *x;
+
+  for (n=0; n<NUM_SAMPLES; n+=2) {
+    // even output: window starts at odd index n+1 -> use word-aligned index n
+    x = &fir_in.w[n/2];
+    acc = 0;
+    for (k=0; k<FIR_TAPS/2+1; k++) {
+      acc = riscv_intrinsic_kmada(acc, x[k], fir_co[k]);
+    }
+    out_simd.h[n] = (int16_t)sat16((int32_t)acc >> 15);
+
+    // odd output: window starts at even index n+2
+    x = &fir_in.w[n/2 + 1];
+    acc = 0;
+    for (k=0; k<FIR_TAPS/2; k++) {
+      acc = riscv_intrinsic_kmada(acc, x[k], fir_ce[k]);
+    }
+    out_simd.h[n+1] = (int16_t)sat16((int32_t)acc >> 15);
+  }
+}
+
+
+// ################################################################################################
+// Biquad filter (direct form I): y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+// ################################################################################################
+
+/**********************************************************************//**
+ * 16-bit biquad filter - plain C.
+ **************************************************************************/
+static void biquad_ref(void) {
+
+  uint32_t n;
+  int32_t acc, x0, x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+  for (n=0; n<NUM_SAMPLES; n++) {
+    x0  = in_a.h[n] >> 1;
+    acc = BQ_B0*x0 + BQ_B1*x1 + BQ_B2*x2 - BQ_A1*y1 - BQ_A2*y2;
+    x2 = x1;
+    x1 = x0;
+    y2 = y1;
+    y1 = sat16(acc >> 14);
+    out_ref.h[n] = (int16_t)y1;
+  }
+}
+
+
+/**********************************************************************//**
+ * 16-bit biquad filter - Zxpsimd. The filter state is kept as packed pairs
+ * xp = {x[n-1], x[n]} and yp = {y[n-2], y[n-1]} (high/low half-word).
+ **************************************************************************/
+static void biquad_simd(void) {
+
+  const uint32_t b01  = ((uint32_t)(uint16_t)BQ_B0) | ((uint32_t)(uint16_t)BQ_B1 << 16);
+  const uint32_t b2a1 = ((uint32_t)(uint16_t)BQ_B2) | ((uint32_t)(uint16_t)(-BQ_A1) << 16);
+  const uint32_t a2   =  (uint32_t)(uint16_t)(-BQ_A2);
+  uint32_t n, acc, xp = 0, yp = 0, x2y1;
+
+  for (n=0; n<NUM_SAMPLES; n++) {
+    x2y1 = (xp >> 16) | (yp << 16); // {y[n-1], x[n-2]}
+    xp   = (xp << 16) | (uint16_t)(in_a.h[n] >> 1); // {x[n-1], x[n]}
+    acc  = riscv_intrinsic_kmda(xp, b01);
+    acc  = riscv_intrinsic_kmada(acc, x2y1, b2a1);
+    acc  = riscv_intrinsic_kmada(acc, yp >> 16, a2);
+    yp   = (yp << 16) | (uint16_t)sat16((int32_t)acc >> 14);
+    out_simd.h[n] = (int16_t)yp;
+  }
+}
@@ -78,6 +78,8 @@ extern clock_t	clock();
 long            Begin_Time,
                 End_Time,
                 User_Time;
+uint64_t        Begin_Instret, /* NEORV32-specific */
+                End_Instret;
 float           Microseconds,
                 Dhrystones_Per_Second;
 
@@ -194,6 +196,7 @@ int main (void)
 
   { /* *****  NEORV32-SPECIFIC ***** */
     Begin_Time = (long)neorv32_mtime_get_time();
+    Begin_Instret = neorv32_cpu_get_instret();
   } /* ***** /NEORV32-SPECIFIC ***** */
 
   for (Run_Index = 1; Run_Index <= Number_Of_Runs; ++Run_Index)
@@ -260,6 +263,7 @@ int main (void)
 */
 
   { /* *****  NEORV32-SPECIFIC ***** */
+    End_Instret = neorv32_cpu_get_instret();
     End_Time = (long)neorv32_mtime_get_time();
   } /* ***** /NEORV32-SPECIFIC ***** */
 
@@ -350,6 +354,7 @@ int main (void)
       neorv32_uart0_printf("NEORV32: Total cycles:      %u\n", (uint32_t)User_Time);
       neorv32_uart0_printf("NEORV32: Cycles per second: %u\n", (uint32_t)NEORV32_SYSINFO->CLK);
       neorv32_uart0_printf("NEORV32: Total runs:        %u\n", (uint32_t)Number_Of_Runs);
+      neorv32_uart0_printf("NEORV32: Retired instr.:    %u\n", (uint32_t)(End_Instret - Begin_Instret));
 
       neorv32_uart0_printf("\n");
       neorv32_uart0_printf("NEORV32: DMIPS/s:           %u\n", (uint32_t)dhry_per_sec);
@@ -0,0 +1,395 @@
+// #################################################################################################
+// # << NEORV32 - Interrupt Latency and Jitter Benchmark >>                                        #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file irq_latency/main.c
+ * @author Stephan Nolting
+ * @brief Interrupt latency and jitter benchmark.
+ *
+ * Measures the number of CPU clock cycles (mcycle) from the assertion of an
+ * interrupt request until the first instruction of the according handler
+ * executes. Each interrupt source is measured using two trap entry paths:
+ * - "rte": the NEORV32 runtime environment (neorv32_rte.c) dispatching to
+ *   a handler installed via neorv32_rte_handler_install()
+ * - "raw": a minimal trap entry (mtvec points directly to it) that takes the
+ *   time stamp and jumps to a plain interrupt("machine") C handler
+ *
+ * Each combination is measured while the CPU is idle-looping ("none"), while
+ * the CPU is issuing cache-missing loads and divisions ("cpu") and while the
+ * DMA is copying data in the background ("dma"). The "dma" result is only
+ * printed if the copied data has been verified afterwards. Each result line is printed
+ * in a "key=value" format so it can be parsed by the benchmark runner
+ * (sw/example/performance_tests/run_benchmarks.py).
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of interrupts per measurement */
+#ifndef IRQ_SAMPLES
+#define IRQ_SAMPLES 32
+#endif
+/** Size of the load buffer in bytes (should exceed the data cache), has to be a power of two */
+#ifndef LOAD_BUF_SIZE
+#define LOAD_BUF_SIZE (4*1024)
+#endif
+/** Use the testbench's IRQ trigger (machine external interrupt); simulation only (sim/simple testbench) */
+#if defined(UART0_SIM_MODE) && !defined(IRQ_LATENCY_TB)
+#define IRQ_LATENCY_TB
+#endif
+/** Testbench IRQ trigger register (write: bit 11 = MEI; read: cycles since last IRQ assertion) */
+#define TB_IRQ_TRIGGER (*((volatile uint32_t*) (0xFF000000)))
+/**@}*/
+
+
+/**********************************************************************//**
+ * Interrupt sources, entry paths and background loads
+ **************************************************************************/
+enum irq_src_enum  { SRC_MTIME = 0, SRC_GPTMR = 1, SRC_TB = 2, NUM_SRC = 3 };
+enum irq_path_enum { PATH_RTE = 0, PATH_RAW = 1, NUM_PATH = 2 };
+enum irq_load_enum { LOAD_NONE = 0, LOAD_CPU = 1, LOAD_DMA = 2, NUM_LOAD = 3 };
+
+static const char *src_name[NUM_SRC]   = {"mtime", "gptmr", "tb_mei"};
+static const char *path_name[NUM_PATH] = {"rte", "raw"};
+static const char *load_name[NUM_LOAD] = {"none", "cpu", "dma"};
+
+
+/**********************************************************************//**
+ * Global variables
+ **************************************************************************/
+/** Buffer for generating background load (cache misses and DMA transfers) */
+static uint32_t load_buf[LOAD_BUF_SIZE/4] __attribute__((aligned(64)));
+/** Offset between mcycle and MTIME (both count CPU clock cycles) */
+static uint32_t mtime_offset;
+/** Latency of the last interrupt in cycles */
+static volatile uint32_t irq_latency;
+/** Set by the interrupt handler */
+static volatile uint32_t irq_done;
+/** Sink for the background load so the compiler cannot optimize it away */
+volatile uint32_t load_sink;
+
+
+/**********************************************************************//**
+ * Prototypes
+ **************************************************************************/
+void irq_raw_entry(void);
+void irq_raw_handler(void);
+void irq_rte_handler(void);
+static void irq_evaluate(uint32_t timestamp);
+static void run_benchmark(int src, int path, int load);
+
+
+/**********************************************************************//**
+ * Read low word of cycle counter.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) get_cycle(void) {
+  return neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension, UART0 and MTIME.
+ * GPTMR and DMA are optional.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr is implemented at all
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // check if MTIME is implemented at all
+  if (neorv32_mtime_available() == 0) {
+    neorv32_uart0_printf("ERROR! MTIME not implemented!\n");
+    return 1;
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Interrupt Latency and Jitter Benchmark >>>\n\n");
+  neorv32_uart0_printf("samples=%u load_buf=0x%x size=%u\n\n", (uint32_t)IRQ_SAMPLES, (uint32_t)load_buf, (uint32_t)LOAD_BUF_SIZE);
+
+  // install RTE handlers
+  neorv32_rte_handler_install(RTE_TRAP_MTI, irq_rte_handler);
+  neorv32_rte_handler_install(GPTMR_RTE_ID, irq_rte_handler);
+  neorv32_rte_handler_install(RTE_TRAP_MEI, irq_rte_handler);
+
+  // calibrate mcycle-to-MTIME offset; both counters increment every clock cycle
+  // (the MTIME value is sampled right before the mcycle read below)
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+  uint32_t tmp = NEORV32_MTIME->TIME_LO;
+  mtime_offset = get_cycle() - tmp;
+
+  // disable timer interrupts for now; enable global interrupts
+  neorv32_mtime_set_timecmp(-1);
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  int src, path, load;
+  for (src=0; src<NUM_SRC; src++) {
+
+    if ((src == SRC_GPTMR) && (neorv32_gptmr_available() == 0)) {
+      neorv32_uart0_printf("src=%s skipped (not implemented)\n", src_name[src]);
+      continue;
+    }
+#ifndef IRQ_LATENCY_TB
+    if (src == SRC_TB) {
+      neorv32_uart0_printf("src=%s skipped (simulation only)\n", src_name[src]);
+      continue;
+    }
+#endif
+
+    for (path=0; path<NUM_PATH; path++) {
+      for (load=0; load<NUM_LOAD; load++) {
+        if ((load == LOAD_DMA) && (neorv32_dma_available() == 0)) {
+          continue;
+        }
+        run_benchmark(src, path, load);
+      }
+    }
+  }
+
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_uart0_printf("\nirq_latency done\n");
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Run a single measurement and print the results.
+ *
+ * @param[in] src Interrupt source (#irq_src_enum).
+ * @param[in] path Trap entry path (#irq_path_enum).
+ * @param[in] load Background load (#irq_load_enum).
+ **************************************************************************/
+static void run_benchmark(int src, int path, int load) {
+
+  uint32_t lat_min = 0xffffffff, lat_max = 0, lat_sum = 0;
+  uint32_t lfsr = 0xACE1u, delay, index = 0, dma_runs = 0;
+  uint32_t mtvec = neorv32_cpu_csr_read(CSR_MTVEC);
+  int i;
+
+  // prepare DMA source (lower half) and destination (upper half) buffers
+  if (load == LOAD_DMA) {
+    for (i=0; i<(LOAD_BUF_SIZE/8); i++) {
+      load_buf[i] = 0x9E3779B9u * (uint32_t)(i+1);
+      load_buf[i + (LOAD_BUF_SIZE/8)] = 0;
+    }
+    neorv32_dma_cache_clean((uint32_t)&load_buf[0], LOAD_BUF_SIZE);
+    neorv32_dma_enable();
+  }
+
+  // select trap entry path
+  if (path == PATH_RAW) {
+    neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)&irq_raw_entry);
+  }
+
+  // one additional (first) sample to warm-up the caches
+  for (i=-1; i<IRQ_SAMPLES; i++) {
+
+    // pseudo-random trigger delay to de-correlate trigger and load loop
+    lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+    delay = 256 + (lfsr & 0xff);
+#ifdef IRQ_LATENCY_TB
+    uint32_t countdown = delay >> 3;
+#endif
+    irq_done = 0;
+
+    // arm interrupt source
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    if (src == SRC_MTIME) {
+      neorv32_mtime_set_timecmp(neorv32_mtime_get_time() + delay);
+      neorv32_cpu_csr_write(CSR_MIE, 1 << CSR_MIE_MTIE);
+    }
+    else if (src == SRC_GPTMR) {
+      neorv32_gptmr_setup(CLK_PRSC_2, delay >> 1, 1);
+      neorv32_cpu_csr_write(CSR_MIE, 1 << GPTMR_FIRQ_ENABLE);
+    }
+    else {
+      neorv32_cpu_csr_write(CSR_MIE, 1 << CSR_MIE_MEIE);
+    }
+    neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+    // wait for interrupt while generating background load
+    while (irq_done == 0) {
+#ifdef IRQ_LATENCY_TB
+      if ((src == SRC_TB) && (countdown != 0)) {
+        countdown--;
+        if (countdown == 0) {
+          TB_IRQ_TRIGGER = 1 << 11;
+        }
+      }
+#endif
+      if (load == LOAD_CPU) { // cache-missing loads and multi-cycle divisions
+        load_sink += load_buf[index];
+        index = (index + 16) & ((LOAD_BUF_SIZE/4)-1);
+        load_sink = load_sink / (index | 1);
+      }
+      else if (load == LOAD_DMA) { // keep the DMA busy copying data
+        if (neorv32_dma_status() != DMA_STATUS_BUSY) {
+          neorv32_dma_transfer((uint32_t)&load_buf[0], (uint32_t)&load_buf[LOAD_BUF_SIZE/8], LOAD_BUF_SIZE/8,
+                               DMA_CMD_W2W | DMA_CMD_SRC_INC | DMA_CMD_DST_INC);
+          dma_runs++;
+        }
+      }
+    }
+
+    // collect statistics
+    if (i >= 0) {
+      if (irq_latency < lat_min) { lat_min = irq_latency; }
+      if (irq_latency > lat_max) { lat_max = irq_latency; }
+      lat_sum += irq_latency;
+    }
+  }
+
+  // back to RTE trap entry
+  neorv32_cpu_csr_write(CSR_MTVEC, mtvec);
+
+  // wait for pending background DMA transfer and make sure the DMA actually did copy data
+  if (load == LOAD_DMA) {
+    while (neorv32_dma_status() == DMA_STATUS_BUSY);
+    int dma_ok = (dma_runs != 0) && (neorv32_dma_status() == DMA_STATUS_IDLE) && neorv32_dma_done();
+    neorv32_dma_disable();
+    neorv32_dma_cache_inval((uint32_t)&load_buf[LOAD_BUF_SIZE/8], LOAD_BUF_SIZE/2);
+    for (i=0; i<(LOAD_BUF_SIZE/8); i++) {
+      if (load_buf[i + (LOAD_BUF_SIZE/8)] != load_buf[i]) {
+        dma_ok = 0;
+      }
+    }
+    if (dma_ok == 0) {
+      neorv32_uart0_printf("src=%s path=%s load=%s FAILED (DMA transfers=%u, no valid copy)\n",
+                           src_name[src], path_name[path], load_name[load], dma_runs);
+      return;
+    }
+  }
+
+  neorv32_uart0_printf("src=%s path=%s load=%s min=%u avg=%u max=%u jitter=%u\n",
+                       src_name[src], path_name[path], load_name[load],
+                       lat_min, lat_sum / IRQ_SAMPLES, lat_max, lat_max - lat_min);
+}
+
+
+/**********************************************************************//**
+ * Determine interrupt latency and acknowledge interrupt source.
+ *
+ * The assertion time of the interrupt request is reconstructed from the
+ * source's own counter: MTIME (timecmp + calibrated mcycle offset), GPTMR
+ * (counter value since match, prescaler 2) or the testbench trigger (read-back
+ * of the cycles since assertion).
+ *
+ * @param[in] timestamp mcycle value at handler entry.
+ **************************************************************************/
+static void irq_evaluate(uint32_t timestamp) {
+
+  uint32_t mcause = neorv32_cpu_csr_read(CSR_MCAUSE);
+  uint32_t assertion;
+
+  if (mcause == TRAP_CODE_MTI) {
+    assertion = NEORV32_MTIME->TIMECMP_LO + mtime_offset;
+    neorv32_mtime_set_timecmp(-1); // acknowledge
+  }
+  else if (mcause == GPTMR_TRAP_CODE) {
+    uint32_t elapsed = NEORV32_GPTMR->COUNT << 1;
+    assertion = get_cycle() - elapsed;
+    neorv32_gptmr_disable();
+    neorv32_gptmr_trigger_matched(); // acknowledge
+  }
+  else if (mcause == TRAP_CODE_MEI) {
+    uint32_t elapsed = TB_IRQ_TRIGGER;
+    assertion = get_cycle() - elapsed;
+    TB_IRQ_TRIGGER = 0; // acknowledge
+  }
+  else { // unexpected trap
+    neorv32_cpu_csr_write(CSR_MIE, 0);
+    assertion = timestamp;
+  }
+
+  irq_latency = timestamp - assertion;
+  irq_done = 1;
+}
+
+
+/**********************************************************************//**
+ * RTE interrupt handler. The time stamp is taken right at the beginning.
+ **************************************************************************/
+void irq_rte_handler(void) {
+
+  irq_evaluate(get_cycle());
+}
+
+
+/**********************************************************************//**
+ * Minimal trap entry: take mcycle time stamp (passed via mscratch) and
+ * jump to the actual interrupt handler. Only interrupts are supported.
+ **************************************************************************/
+void __attribute__((naked,aligned(4))) irq_raw_entry(void) {
+
+  asm volatile (
+    "csrw  mscratch, t0     \n"
+    "csrr  t0,       mcycle \n"
+    "csrrw t0,       mscratch, t0 \n"
+    "j     irq_raw_handler  \n"
+  );
+}
+
+
+/**********************************************************************//**
+ * Plain (compiler-generated context save/restore) interrupt handler.
+ **************************************************************************/
+void __attribute__((interrupt("machine"),used)) irq_raw_handler(void) {
+
+  irq_evaluate(neorv32_cpu_csr_read(CSR_MSCRATCH));
+}
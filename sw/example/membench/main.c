@@ -0,0 +1,326 @@
+// #################################################################################################
+// # << NEORV32 - Memory System Microbenchmarks >>                                                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file membench/main.c
+ * @author Stephan Nolting
+ * @brief Memory system microbenchmarks: load-to-use latency, pointer-chase
+ * latency (working-set size and stride sweep) and streaming bandwidth.
+ *
+ * All results are given in CPU clock cycles (mcycle). Each result line is
+ * printed in a "key=value" format so it can be parsed by the benchmark runner
+ * (sw/example/performance_tests/run_benchmarks.py).
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Benchmark buffer size in bytes (maximum working set), has to be a power of two */
+#ifndef MEMBENCH_SIZE
+#define MEMBENCH_SIZE (4*1024)
+#endif
+/** Benchmark buffer base address; use a static buffer in DMEM if not defined
+ *  (e.g. USER_FLAGS+=-DMEMBENCH_BASE=0x80000000 for the testbench's external memory B) */
+//#define MEMBENCH_BASE 0x80000000
+/** Smallest working-set size in bytes */
+#define MIN_WSET 64
+/** Number of timed accesses per pointer-chase measurement */
+#define CHASE_ACCESSES 1024
+/** Number of repetitions per streaming measurement */
+#define STREAM_RUNS 4
+/**@}*/
+
+
+/**********************************************************************//**
+ * Benchmark buffer
+ **************************************************************************/
+#ifdef MEMBENCH_BASE
+static uint32_t *const buffer = (uint32_t*)(MEMBENCH_BASE);
+#else
+static uint32_t buffer[MEMBENCH_SIZE/4] __attribute__((aligned(64)));
+#endif
+
+/** Sink for benchmark results so the compiler cannot optimize the accesses away */
+volatile uint32_t sink;
+
+
+// Prototypes
+static void bench_load_use(void);
+static void bench_chase(uint32_t wset, uint32_t stride);
+static void bench_stream(uint32_t wset);
+static void print_fixed(uint32_t cycles, uint32_t accesses);
+
+
+/**********************************************************************//**
+ * Read low word of cycle counter.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) get_cycle(void) {
+  return neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  uint32_t wset, stride, tmp;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr is implemented
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // no interrupts, make sure all counters are running
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Memory System Microbenchmarks >>>\n\n");
+
+  // show memory system configuration
+  tmp = NEORV32_SYSINFO->CACHE;
+  neorv32_uart0_printf("buffer=0x%x size=%u\n", (uint32_t)buffer, (uint32_t)MEMBENCH_SIZE);
+  if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_ICACHE)) {
+    neorv32_uart0_printf("icache blocks=%u block_size=%u\n",
+                         1 << ((tmp >> SYSINFO_CACHE_INST_NUM_BLOCKS_0) & 0xf),
+                         1 << ((tmp >> SYSINFO_CACHE_INST_BLOCK_SIZE_0) & 0xf));
+  }
+  if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_DCACHE)) {
+    neorv32_uart0_printf("dcache blocks=%u block_size=%u\n",
+                         1 << ((tmp >> SYSINFO_CACHE_DATA_NUM_BLOCKS_0) & 0xf),
+                         1 << ((tmp >> SYSINFO_CACHE_DATA_BLOCK_SIZE_0) & 0xf));
+  }
+  if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_XBUS_CACHE)) {
+    neorv32_uart0_printf("xcache blocks=%u block_size=%u\n",
+                         1 << ((tmp >> SYSINFO_CACHE_XBUS_NUM_BLOCKS_0) & 0xf),
+                         1 << ((tmp >> SYSINFO_CACHE_XBUS_BLOCK_SIZE_0) & 0xf));
+  }
+  neorv32_uart0_printf("\n");
+
+  // load-to-use latency
+  bench_load_use();
+
+  // pointer chase: working-set size and stride sweep
+  for (stride=4; stride<=128; stride<<=1) {
+    for (wset=MIN_WSET; wset<=MEMBENCH_SIZE; wset<<=1) {
+      if (stride < wset) {
+        bench_chase(wset, stride);
+      }
+    }
+  }
+
+  // streaming bandwidth: working-set size sweep
+  for (wset=MIN_WSET; wset<=MEMBENCH_SIZE; wset<<=1) {
+    bench_stream(wset);
+  }
+
+  neorv32_uart0_printf("\nmembench done\n");
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Load-to-use latency: chain of dependent loads to the same (cached) word.
+ * The result includes the issue cost of the load instruction itself.
+ **************************************************************************/
+static void bench_load_use(void) {
+
+  uint32_t i, t_start, t_stop, overhead;
+  uint32_t *p;
+
+  // self-referencing pointer
+  buffer[0] = (uint32_t)&buffer[0];
+  p = (uint32_t*)buffer[0];
+
+  // measure overhead of the timing itself
+  t_start = get_cycle();
+  t_stop = get_cycle();
+  overhead = t_stop - t_start;
+
+  // warm-up
+  p = (uint32_t*)(*p);
+
+  t_start = get_cycle();
+  for (i=0; i<CHASE_ACCESSES/16; i++) {
+    asm volatile (
+      "lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n"
+      "lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n"
+      "lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n"
+      "lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n lw %[p], 0(%[p]) \n"
+      : [p] "+r" (p));
+  }
+  t_stop = get_cycle();
+  sink = (uint32_t)p;
+
+  neorv32_uart0_printf("load_use ");
+  print_fixed(t_stop - t_start - overhead, CHASE_ACCESSES);
+  neorv32_uart0_printf("\n");
+}
+
+
+/**********************************************************************//**
+ * Pointer-chase latency. Each element points to the element "stride" bytes
+ * ahead (wrapping around within the working set).
+ *
+ * @param[in] wset Working-set size in bytes (power of two).
+ * @param[in] stride Access stride in bytes (power of two, >= 4).
+ **************************************************************************/
+static void bench_chase(uint32_t wset, uint32_t stride) {
+
+  uint32_t i, t_start, t_stop;
+  uint32_t *p;
+  uint32_t base = (uint32_t)buffer;
+
+  // build chain
+  for (i=0; i<wset; i+=stride) {
+    buffer[i/4] = base + ((i + stride) & (wset - 1));
+  }
+  asm volatile ("fence"); // make sure the chain is visible in memory (write-back d-cache)
+
+  // warm-up: one complete pass through the working set
+  p = buffer;
+  for (i=0; i<wset/stride; i++) {
+    p = (uint32_t*)(*p);
+  }
+
+  // timed run (unrolled to amortize loop overhead)
+  t_start = get_cycle();
+  for (i=0; i<CHASE_ACCESSES/8; i++) {
+    p = (uint32_t*)(*p); p = (uint32_t*)(*p); p = (uint32_t*)(*p); p = (uint32_t*)(*p);
+    p = (uint32_t*)(*p); p = (uint32_t*)(*p); p = (uint32_t*)(*p); p = (uint32_t*)(*p);
+  }
+  t_stop = get_cycle();
+  sink = (uint32_t)p;
+
+  neorv32_uart0_printf("chase wset=%u stride=%u ", wset, stride);
+  print_fixed(t_stop - t_start, CHASE_ACCESSES);
+  neorv32_uart0_printf("\n");
+}
+
+
+/**********************************************************************//**
+ * Streaming bandwidth: word-wise read, write and copy (first half to second
+ * half of the working set).
+ *
+ * @param[in] wset Working-set size in bytes (power of two).
+ **************************************************************************/
+static void bench_stream(uint32_t wset) {
+
+  uint32_t i, r, t_start, t_stop, sum;
+  uint32_t words = wset / 4;
+  volatile uint32_t *src = buffer;
+  uint32_t *dst;
+
+  // read
+  sum = 0;
+  t_start = get_cycle();
+  for (r=0; r<STREAM_RUNS; r++) {
+    for (i=0; i<words; i+=4) {
+      sum += src[i+0] + src[i+1] + src[i+2] + src[i+3];
+    }
+  }
+  t_stop = get_cycle();
+  sink = sum;
+  neorv32_uart0_printf("stream_read wset=%u ", wset);
+  print_fixed(t_stop - t_start, words * STREAM_RUNS);
+  neorv32_uart0_printf("\n");
+
+  // write
+  dst = buffer;
+  t_start = get_cycle();
+  for (r=0; r<STREAM_RUNS; r++) {
+    for (i=0; i<words; i+=4) {
+      ((volatile uint32_t*)dst)[i+0] = r;
+      ((volatile uint32_t*)dst)[i+1] = r;
+      ((volatile uint32_t*)dst)[i+2] = r;
+      ((volatile uint32_t*)dst)[i+3] = r;
+    }
+  }
+  t_stop = get_cycle();
+  neorv32_uart0_printf("stream_write wset=%u ", wset);
+  print_fixed(t_stop - t_start, words * STREAM_RUNS);
+  neorv32_uart0_printf("\n");
+
+  // copy
+  dst = buffer + words/2;
+  t_start = get_cycle();
+  for (r=0; r<STREAM_RUNS; r++) {
+    for (i=0; i<words/2; i+=2) {
+      ((volatile uint32_t*)dst)[i+0] = src[i+0];
+      ((volatile uint32_t*)dst)[i+1] = src[i+1];
+    }
+  }
+  t_stop = get_cycle();
+  neorv32_uart0_printf("stream_copy wset=%u ", wset);
+  print_fixed(t_stop - t_start, (words/2) * STREAM_RUNS);
+  neorv32_uart0_printf("\n");
+}
+
+
+/**********************************************************************//**
+ * Print "cycles per access" with two fractional digits and total cycles.
+ *
+ * @param[in] cycles Total number of cycles.
+ * @param[in] accesses Number of (word) accesses.
+ **************************************************************************/
+static void print_fixed(uint32_t cycles, uint32_t accesses) {
+
+  uint32_t tmp = (cycles * 100) / accesses;
+
+  neorv32_uart0_printf("cycles=%u accesses=%u cpa=%u.%u%u", cycles, accesses, tmp / 100, (tmp / 10) % 10, tmp % 10);
+}
@@ -0,0 +1,394 @@
+#!/usr/bin/env python3
+
+# ================================================================================ #
+# NEORV32 - Automated cycle-accurate benchmark runner                              #
+# -------------------------------------------------------------------------------- #
+# Builds the benchmark programs, simulates them using the default/simple GHDL      #
+# testbench for a matrix of processor configurations and collects the results     #
+# (cycles, retired instructions, HPM counters, scores) as JSON and CSV.            #
+# -------------------------------------------------------------------------------- #
+# The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              #
+# Copyright (c) NEORV32 contributors.                                              #
+# Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  #
+# Licensed under the BSD-3-Clause license, see LICENSE for details.                #
+# SPDX-License-Identifier: BSD-3-Clause                                            #
+# ================================================================================ #
+
+"""
+Usage examples (from this folder):
+
+  ./run_benchmarks.py                                  # all benchmarks, preset matrix
+  ./run_benchmarks.py -b coremark dhrystone            # selected benchmarks only
+  ./run_benchmarks.py --full-matrix -o results/rev_a   # all option combinations
+  ./run_benchmarks.py --dry-run                        # just show what would be executed
+
+Results are written to <output>.json (one record per benchmark/configuration)
+and <output>.csv (one row per benchmark/configuration/metric).
+"""
+
+import argparse
+import csv
+import itertools
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+NEORV32_HOME = Path(__file__).resolve().parents[3]
+SIM_PATH = NEORV32_HOME / "sim" / "simple"
+EXAMPLE_PATH = NEORV32_HOME / "sw" / "example"
+SIM_OUT_FILE = SIM_PATH / "neorv32.uart0.sim_mode.text.out"
+
+
+# -----------------------------------------------------------------------------
+# Result parsers (operating on the UART0 simulation output)
+# -----------------------------------------------------------------------------
+def _key(name):
+    """Convert a human-readable label into a metric key."""
+    return re.sub(r"[^a-z0-9]+", "_", name.strip().lower()).strip("_")
+
+
+def parse_hpm(text):
+    """HPM report lines like ' > Retired instructions        : 1234'."""
+    res = {}
+    for m in re.finditer(r"^\s*>\s*(.+?)\s*:\s*(\d+)\s*$", text, re.M):
+        res[_key(m.group(1))] = int(m.group(2))
+    return res
+
+
+def parse_coremark(text):
+    res = parse_hpm(text)
+    for pattern, key, conv in (
+        (r"^Iterations\s*:\s*(\d+)", "iterations", int),
+        (r"^Total ticks\s*:\s*(\d+)", "total_kticks", int),
+        (r"CoreMark/MHz\s*:\s*([\d.]+)", "coremark_per_mhz", float),
+    ):
+        m = re.search(pattern, text, re.M)
+        if m:
+            res[key] = conv(m.group(1))
+    res["valid"] = ("[0]crcfinal" in text) and not re.search(r"ERROR! (list|matrix|state) crc", text)
+    return res
+
+
+def parse_dhrystone(text):
+    res = {}
+    for pattern, key in (
+        (r"NEORV32: Total cycles:\s*(\d+)", "active_clock_cycles"),
+        (r"NEORV32: Retired instr\.:\s*(\d+)", "retired_instructions"),
+        (r"NEORV32: Total runs:\s*(\d+)", "iterations"),
+        (r"NEORV32: DMIPS/s/MHz:\s*(\d+)", "dmips_per_mhz"),
+        (r"NEORV32: VAX DMIPS/s:\s*(\d+)", "vax_dmips"),
+    ):
+        m = re.search(pattern, text)
+        if m:
+            res[key] = int(m.group(1))
+    return res
+
+
+def parse_inst_timing(text):
+    """Instruction timing lines like 'add rd,rs1,rs2 inst. 3 cyc'."""
+    res = {}
+    for m in re.finditer(r"^(\S+)\s.*inst\.\s+(\d+)\s+cyc", text, re.M):
+        res["cpi_" + _key(m.group(1))] = int(m.group(2))
+    return res
+
+
+def parse_membench(text):
+    """Memory benchmark lines like 'chase wset=1024 stride=16 cycles=123 accesses=64 cpa=1.92'."""
+    res = {}
+    for m in re.finditer(r"^(\w+)((?:\s+\w+=\d+)*)\s+cycles=\d+\s+accesses=\d+\s+cpa=([\d.]+)", text, re.M):
+        name = m.group(1) + "".join("_" + k[0] + v for k, v in re.findall(r"(\w+)=(\d+)", m.group(2)))
+        res[name + "_cpa"] = float(m.group(3))
+    return res
+
+
+def parse_irq_latency(text):
+    """IRQ latency lines like 'src=mtime path=rte load=none min=40 avg=42 max=47 jitter=7'."""
+    res = {}
+    for m in re.finditer(r"^src=(\w+)\s+path=(\w+)\s+load=(\w+)((?:\s+\w+=\d+)+)", text, re.M):
+        name = "_".join(m.group(1, 2, 3))
+        for k, v in re.findall(r"(\w+)=(\d+)", m.group(4)):
+            res[name + "_" + k] = int(v)
+    return res
+
+
+def parse_string_bench(text):
+    """String benchmark lines like 'impl=neorv32 size=64 align=0 memcpy=80 memmove=96 ...'."""
+    res = {}
+    for m in re.finditer(r"^impl=(\w+)\s+size=(\d+)\s+align=(\d+)((?:\s+\w+=\d+)+)", text, re.M):
+        name = "%s_s%s_a%s" % m.group(1, 2, 3)
+        for k, v in re.findall(r"(\w+)=(\d+)", m.group(4)):
+            res[name + "_" + k] = int(v)
+    return res
+
+
+def parse_demo_crypto(text):
+    """Crypto benchmark lines like 'alg=aes128_enc impl=zkn cycles=12345 cpb=12.0'."""
+    res = {}
+    for m in re.finditer(r"^alg=(\w+)\s+impl=(\w+)\s+cycles=(\d+)\s+cpb=([\d.]+)", text, re.M):
+        res["%s_%s_cpb" % m.group(1, 2)] = float(m.group(4))
+    res["valid"] = "demo_crypto done" in text
+    return res
+
+
+def parse_demo_simd(text):
+    """Packed-SIMD benchmark lines like 'alg=fir16 impl=simd cycles=12345 cps=48.2 speedup=3.1'."""
+    res = {}
+    for m in re.finditer(r"^alg=(\w+)\s+impl=(\w+)\s+cycles=(\d+)\s+cps=([\d.]+)(?:\s+speedup=([\d.]+))?", text, re.M):
+        res["%s_%s_cps" % m.group(1, 2)] = float(m.group(4))
+        if m.group(5):
+            res["%s_speedup" % m.group(1)] = float(m.group(5))
+    res["valid"] = "demo_simd done" in text
+    return res
+
+
+# -----------------------------------------------------------------------------
+# Benchmark and configuration definitions
+# -----------------------------------------------------------------------------
+BENCHMARKS = {
+    "coremark": {
+        "path": "coremark",
+        "march": "rv32im_zicsr_zifencei",
+        "flags": ["-DITERATIONS=10"],
+        "effort": "-O3",
+        # 100 MHz testbench clock: 10 iterations take ~11M cycles with fast mul/shift and
+        # more than 25M cycles with the serial (base) units
+        "stop_time": "200ms",
+        "stop_time_serial": "400ms",
+        "parser": parse_coremark,
+    },
+    "demo_crypto": {
+        "path": "demo_crypto",
+        "march": "rv32i_zicsr_zifencei",
+        "flags": [],
+        "effort": "-O2",
+        "stop_time": "20ms",
+        "parser": parse_demo_crypto,
+    },
+    "demo_simd": {
+        "path": "demo_simd",
+        "march": "rv32im_zicsr_zifencei",
+        "flags": [],
+        "effort": "-O2",
+        "stop_time": "20ms",
+        "parser": parse_demo_simd,
+    },
+    "dhrystone": {
+        "path": "dhrystone",
+        "march": "rv32im_zicsr_zifencei",
+        "flags": ["-DRUN_DHRYSTONE", "-DDHRY_ITERS=1000"],
+        "effort": "-O3",
+        "stop_time": "20ms",
+        "parser": parse_dhrystone,
+    },
+    "membench": {
+        "path": "membench",
+        "march": "rv32i_zicsr_zifencei",
+        "flags": [],
+        "effort": "-O2",
+        "stop_time": "20ms",
+        "parser": parse_membench,
+    },
+    "irq_latency": {
+        "path": "irq_latency",
+        "march": "rv32im_zicsr_zifencei",
+        "flags": [],
+        "effort": "-O2",
+        "stop_time": "20ms",
+        "parser": parse_irq_latency,
+    },
+    "string_bench": {
+        "path": "string_bench",
+        "march": "rv32i_zicsr_zifencei_zbb",
+        "flags": [],
+        "effort": "-O2",
+        "stop_time": "20ms",
+        "parser": parse_string_bench,
+    },
+    "timing_I": {
+        "path": "performance_tests/I",
+        "march": "rv32i_zicsr_zifencei",
+        "flags": ["-DRUN_CHECK", "-DSILENT_MODE", "-Drv32_all"],
+        "effort": "-Os",
+        "stop_time": "4500us",
+        "parser": parse_inst_timing,
+    },
+    "timing_M": {
+        "path": "performance_tests/M",
+        "march": "rv32im_zicsr_zifencei",
+        "flags": ["-DRUN_CHECK", "-DSILENT_MODE", "-Drv32_all"],
+        "effort": "-Os",
+        "stop_time": "1500us",
+        "parser": parse_inst_timing,
+    },
+    "timing_Zfinx": {
+        "path": "performance_tests/Zfinx",
+        "march": "rv32i_zicsr_zifencei_zfinx",
+        "flags": ["-DRUN_CHECK", "-DSILENT_MODE", "-Drv32_all"],
+        "effort": "-Os",
+        "stop_time": "4500us",
+        "parser": parse_inst_timing,
+    },
+}
+
+# testbench generics that can be swept (see sim/simple/neorv32_tb.simple.vhd)
+OPTIONS = ["OPT_ICACHE", "OPT_DCACHE", "OPT_FAST_MUL", "OPT_FAST_SHIFT", "OPT_RISCV_C"]
+
+# default matrix: a few representative configurations (on top of PERFORMANCE_OPTION=1)
+PRESETS = {
+    "base":     {"OPT_ICACHE": 0, "OPT_DCACHE": 0, "OPT_FAST_MUL": 0, "OPT_FAST_SHIFT": 0, "OPT_RISCV_C": 0},
+    "fast":     {"OPT_ICACHE": 0, "OPT_DCACHE": 0, "OPT_FAST_MUL": 1, "OPT_FAST_SHIFT": 1, "OPT_RISCV_C": 0},
+    "fast_c":   {"OPT_ICACHE": 0, "OPT_DCACHE": 0, "OPT_FAST_MUL": 1, "OPT_FAST_SHIFT": 1, "OPT_RISCV_C": 1},
+    "cached":   {"OPT_ICACHE": 1, "OPT_DCACHE": 1, "OPT_FAST_MUL": 1, "OPT_FAST_SHIFT": 1, "OPT_RISCV_C": 0},
+    "cached_c": {"OPT_ICACHE": 1, "OPT_DCACHE": 1, "OPT_FAST_MUL": 1, "OPT_FAST_SHIFT": 1, "OPT_RISCV_C": 1},
+}
+
+
+def full_matrix():
+    """All combinations of the sweepable options."""
+    configs = {}
+    for values in itertools.product((0, 1), repeat=len(OPTIONS)):
+        cfg = dict(zip(OPTIONS, values))
+        name = "_".join(opt[4:].lower() for opt, val in cfg.items() if val) or "base"
+        configs[name] = cfg
+    return configs
+
+
+def add_c_extension(march):
+    """Add the C extension to a MARCH string (single-letter extensions only)."""
+    base, _, rest = march.partition("_")
+    if "c" not in base[4:]:
+        base = base + "c"
+    return base + ("_" + rest if rest else "")
+
+
+# -----------------------------------------------------------------------------
+# Execution
+# -----------------------------------------------------------------------------
+def sim_stop_time(bench, cfg):
+    """Simulation time; benchmarks can define a longer one for the serial multiplier/shifter."""
+    if not (cfg.get("OPT_FAST_MUL", 0) and cfg.get("OPT_FAST_SHIFT", 0)):
+        return bench.get("stop_time_serial", bench["stop_time"])
+    return bench["stop_time"]
+
+
+def run(cmd, cwd, dry_run, verbose):
+    print("  $ " + " ".join(cmd))
+    if dry_run:
+        return 0
+    out = None if verbose else subprocess.DEVNULL
+    return subprocess.run(cmd, cwd=cwd, stdout=out, check=False).returncode
+
+
+def run_benchmark(name, bench, cfg_name, cfg, args):
+    march = add_c_extension(bench["march"]) if cfg.get("OPT_RISCV_C", 0) else bench["march"]
+    bench_dir = EXAMPLE_PATH / bench["path"]
+    flags = ["-DUART0_SIM_MODE"] + bench["flags"] + args.user_flags
+    make = ["make", "-C", str(bench_dir), "MARCH=" + march, "EFFORT=" + bench["effort"]]
+    make += ["USER_FLAGS+=" + f for f in flags]
+    make += ["clean_all", "bin"]
+
+    # the executable is loaded at simulation start, so all runs share one analyzed simulation model
+    generics = ["-gPERFORMANCE_OPTION=%d" % args.performance_option]
+    generics += ["-gIMEM_FILE=%s" % (bench_dir / "neorv32_raw_exe.bin")]
+    generics += ["-g%s=%d" % (opt, val) for opt, val in cfg.items()]
+    sim = ["sh", str(SIM_PATH / "ghdl.sh")] + generics + ["--stop-time=" + sim_stop_time(bench, cfg)]
+
+    record = {"benchmark": name, "config": cfg_name, "march": march, "generics": cfg, "metrics": {}}
+
+    print("[%s @ %s]" % (name, cfg_name))
+    if run(make, NEORV32_HOME, args.dry_run, args.verbose) != 0:
+        record["error"] = "build failed"
+        return record
+    if SIM_OUT_FILE.exists() and not args.dry_run:
+        SIM_OUT_FILE.unlink()
+    t_start = time.time()
+    if run(sim, NEORV32_HOME, args.dry_run, args.verbose) != 0:
+        record["error"] = "simulation failed"
+        return record
+    record["sim_seconds"] = round(time.time() - t_start, 1)
+    if args.dry_run:
+        return record
+
+    text = SIM_OUT_FILE.read_text(errors="replace") if SIM_OUT_FILE.exists() else ""
+    record["metrics"] = bench["parser"](text)
+    if not record["metrics"]:
+        record["error"] = "no results found in simulation output"
+    if args.keep_logs:
+        log = Path(args.output + "_%s_%s.log" % (name, cfg_name))
+        log.write_text(text)
+    return record
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"], cwd=NEORV32_HOME,
+                                       stderr=subprocess.DEVNULL, text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def write_results(records, output):
+    Path(output).parent.mkdir(parents=True, exist_ok=True)
+    summary = {"revision": git_revision(), "date": time.strftime("%Y-%m-%d %H:%M:%S"), "results": records}
+    with open(output + ".json", "w") as f:
+        json.dump(summary, f, indent=2)
+    with open(output + ".csv", "w", newline="") as f:
+        wr = csv.writer(f)
+        wr.writerow(["revision", "benchmark", "config", "march"] + OPTIONS + ["metric", "value"])
+        for rec in records:
+            row = [summary["revision"], rec["benchmark"], rec["config"], rec["march"]]
+            row += [rec["generics"].get(opt, "") for opt in OPTIONS]
+            for metric, value in sorted(rec["metrics"].items()):
+                wr.writerow(row + [metric, value])
+    print("Results written to %s.json and %s.csv" % (output, output))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="NEORV32 benchmark runner (GHDL)")
+    parser.add_argument("-b", "--benchmarks", nargs="+", choices=sorted(BENCHMARKS), default=sorted(BENCHMARKS),
+                        help="benchmarks to run (default: all)")
+    parser.add_argument("-c", "--configs", nargs="+", help="preset configurations to run (default: all presets)")
+    parser.add_argument("--full-matrix", action="store_true", help="run all combinations of %s" % ", ".join(OPTIONS))
+    parser.add_argument("-p", "--performance-option", type=int, default=1,
+                        help="testbench PERFORMANCE_OPTION base configuration (default: 1)")
+    parser.add_argument("-u", "--user-flags", nargs="*", default=[], help="additional USER_FLAGS for all builds")
+    parser.add_argument("-o", "--output", default="benchmark_results", help="output file base name")
+    parser.add_argument("--keep-logs", action="store_true", help="keep the UART0 output of each run")
+    parser.add_argument("--fast-sim", action="store_true",
+                        help="use the fast simulation setup (behavioral memories, same cycle counts)")
+    parser.add_argument("--dry-run", action="store_true", help="only print the commands")
+    parser.add_argument("-v", "--verbose", action="store_true", help="show build and simulation output")
+    args = parser.parse_args()
+
+    if args.fast_sim:
+        os.environ["NEORV32_FAST_SIM"] = "1"  # evaluated by the sim/simple GHDL scripts
+
+    configs = full_matrix() if args.full_matrix else PRESETS
+    if args.configs:
+        unknown = [c for c in args.configs if c not in configs]
+        if unknown:
+            parser.error("unknown configuration(s): %s (available: %s)" % (", ".join(unknown), ", ".join(configs)))
+        configs = {c: configs[c] for c in args.configs}
+
+    os.environ.setdefault("GHDL_DEVNULL", "" if args.verbose else "1")
+
+    records = []
+    for cfg_name, cfg in configs.items():
+        for name in args.benchmarks:
+            records.append(run_benchmark(name, BENCHMARKS[name], cfg_name, cfg, args))
+
+    if not args.dry_run:
+        write_results(records, args.output)
+
+    failed = [r for r in records if "error" in r]
+    for rec in failed:
+        print("FAILED: %s @ %s (%s)" % (rec["benchmark"], rec["config"], rec["error"]))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
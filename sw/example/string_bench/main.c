@@ -0,0 +1,225 @@
+// #################################################################################################
+// # << NEORV32 - String/Memory Function Benchmark >>                                              #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file string_bench/main.c
+ * @author Stephan Nolting
+ * @brief Benchmark of the optimized memory/string functions (neorv32_string.c)
+ * versus newlib's generic implementations.
+ *
+ * All results are given in CPU clock cycles (mcycle) and are printed in a
+ * "key=value" format so they can be parsed by the benchmark runner
+ * (sw/example/performance_tests/run_benchmarks.py).
+ **************************************************************************/
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Largest tested size in bytes */
+#define MAX_SIZE 1024
+/** Number of repetitions per measurement */
+#define RUNS 4
+/**@}*/
+
+
+/**********************************************************************//**
+ * Benchmark buffers
+ **************************************************************************/
+static uint8_t buf_a[MAX_SIZE + 8] __attribute__((aligned(16)));
+static uint8_t buf_b[MAX_SIZE + 8] __attribute__((aligned(16)));
+
+/** Sink for benchmark results so the compiler cannot optimize the calls away */
+volatile uint32_t sink;
+
+
+/**********************************************************************//**
+ * Functions under test; called via volatile pointers so the compiler
+ * cannot replace library calls by inline builtins.
+ **************************************************************************/
+typedef struct {
+  void  *(*memcpy_f)(void*, const void*, size_t);
+  void  *(*memmove_f)(void*, const void*, size_t);
+  void  *(*memset_f)(void*, int, size_t);
+  void  *(*memchr_f)(const void*, int, size_t);
+  size_t (*strlen_f)(const char*);
+  int    (*strcmp_f)(const char*, const char*);
+} funcs_t;
+
+static volatile funcs_t funcs[2] = {
+  { memcpy, memmove, memset, memchr, strlen, strcmp },
+  { neorv32_memcpy, neorv32_memmove, neorv32_memset, neorv32_memchr, neorv32_strlen, neorv32_strcmp }
+};
+
+static const char *const impl_name[2] = {"newlib", "neorv32"};
+
+/** First benchmarked implementation; with STRING=neorv32 the newlib symbols resolve to the optimized functions */
+#ifdef NEORV32_STRING_OVERRIDE
+#define IMPL_FIRST 1
+#else
+#define IMPL_FIRST 0
+#endif
+
+
+// Prototypes
+static void bench(int impl, uint32_t size, uint32_t align);
+
+
+/**********************************************************************//**
+ * Read low word of cycle counter.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) get_cycle(void) {
+  return neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the Zicntr CPU extension and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  uint32_t size, align;
+  int impl;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // check if Zicntr is implemented
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // no interrupts, make sure all counters are running
+  neorv32_cpu_csr_write(CSR_MIE, 0);
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+
+  // allow DMA offloading (only used if NEORV32_STRING_DMA_MIN > 0)
+  if (neorv32_dma_available()) {
+    neorv32_dma_enable();
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 String/Memory Function Benchmark >>>\n\n");
+#if defined __riscv_zbb
+  neorv32_uart0_printf("variant=zbb dma_min=%u\n\n", (uint32_t)NEORV32_STRING_DMA_MIN);
+#else
+  neorv32_uart0_printf("variant=base dma_min=%u\n\n", (uint32_t)NEORV32_STRING_DMA_MIN);
+#endif
+#ifdef NEORV32_STRING_OVERRIDE
+  neorv32_uart0_printf("WARNING! Built with STRING=neorv32: newlib functions are overridden, skipping newlib baseline.\n\n");
+#endif
+
+  for (size=16; size<=MAX_SIZE; size<<=2) {
+    for (align=0; align<2; align++) {
+      for (impl=IMPL_FIRST; impl<2; impl++) {
+        bench(impl, size, align);
+      }
+    }
+  }
+
+  neorv32_uart0_printf("\nstring_bench done\n");
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Run all functions of one implementation for a given size.
+ *
+ * @param[in] impl Implementation (0 = newlib, 1 = neorv32).
+ * @param[in] size Data size in bytes.
+ * @param[in] align 0 = word-aligned source and destination; 1 = source/destination misaligned to each other.
+ **************************************************************************/
+static void bench(int impl, uint32_t size, uint32_t align) {
+
+  uint32_t i, r, t_start, t_res[6];
+  uint8_t *src = buf_a + align;
+  uint8_t *dst = buf_b + 3*align;
+
+  // test data: printable string without the searched char
+  for (i=0; i<MAX_SIZE+8; i++) {
+    buf_a[i] = (uint8_t)('a' + (i % 26));
+    buf_b[i] = buf_a[i];
+  }
+  src[size-1] = '\0';
+  dst[size-1] = '\0';
+
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { funcs[impl].memcpy_f(dst, src, size); }
+  t_res[0] = get_cycle() - t_start;
+
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { funcs[impl].memmove_f(src + 4, src, size - 8); } // overlapping: backward copy
+  t_res[1] = get_cycle() - t_start;
+
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { funcs[impl].memset_f(dst, 'x', size - 1); }
+  t_res[2] = get_cycle() - t_start;
+
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { sink = (uint32_t)funcs[impl].memchr_f(dst, '#', size); }
+  t_res[3] = get_cycle() - t_start;
+
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { sink = (uint32_t)funcs[impl].strlen_f((const char*)dst); }
+  t_res[4] = get_cycle() - t_start;
+
+  memcpy(src, dst, size);
+  t_start = get_cycle();
+  for (r=0; r<RUNS; r++) { sink = (uint32_t)funcs[impl].strcmp_f((const char*)src, (const char*)dst); }
+  t_res[5] = get_cycle() - t_start;
+
+  neorv32_uart0_printf("impl=%s size=%u align=%u memcpy=%u memmove=%u memset=%u memchr=%u strlen=%u strcmp=%u\n",
+                       impl_name[impl], size, align,
+                       t_res[0]/RUNS, t_res[1]/RUNS, t_res[2]/RUNS, t_res[3]/RUNS, t_res[4]/RUNS, t_res[5]/RUNS);
+}
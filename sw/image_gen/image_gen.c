@@ -41,7 +41,155 @@
 // executable signature ("magic word")
 const uint32_t signature = 0x4788CAFE;
 
-enum operation_enum {OP_APP_BIN, OP_APP_IMG, OP_BLD_IMG, OP_RAW_HEX, OP_RAW_BIN};
+// compressed executable signature ("magic word")
+const uint32_t signature_lz = 0x4788CAFF;
+
+// segment-based executable signature ("magic word")
+const uint32_t signature_seg = 0x4788CAFD;
+
+enum operation_enum {OP_APP_BIN, OP_APP_IMG, OP_BLD_IMG, OP_RAW_HEX, OP_RAW_BIN, OP_APP_LZ, OP_APP_SEG, OP_RAW_MEM, OP_RAW_COE, OP_RAW_MIF};
+
+// LZ compression parameters
+#define LZ_MIN_MATCH  4      // minimal match length
+#define LZ_MAX_OFFSET 65535  // maximal match offset (sliding window size)
+#define LZ_HASH_BITS  16     // hash table size (log2)
+
+
+// segment-based executable parameters
+#define SEG_FILL      0x80000000U // segment descriptor: zero-fill segment (no data)
+#define SEG_ZERO_RUN  8           // minimal number of zero words to split a data segment into a zero-fill segment
+#define ELF_PT_LOAD   1           // ELF program header type: loadable segment
+#define ELF_SHT_SYMTAB 2          // ELF section header type: symbol table
+
+
+// get little-endian 16-bit / 32-bit value
+static uint32_t get16(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+
+// get value of ELF symbol; returns 0 if found
+static int elf_symbol(const uint8_t *elf, uint32_t elf_size, const char *name, uint32_t *value) {
+
+  uint32_t shoff = get32(&elf[0x20]), shentsize = get16(&elf[0x2E]), shnum = get16(&elf[0x30]);
+  uint32_t i, j;
+
+  for (i=0; i<shnum; i++) {
+    const uint8_t *sh = &elf[shoff + i*shentsize];
+    if ((shoff + (i+1)*shentsize) > elf_size) {
+      break;
+    }
+    if ((get32(&sh[4]) != ELF_SHT_SYMTAB) || (get32(&sh[24]) >= shnum)) {
+      continue;
+    }
+    const uint8_t *strtab_sh = &elf[shoff + get32(&sh[24])*shentsize];
+    uint32_t sym_offs = get32(&sh[16]), sym_size = get32(&sh[20]);
+    uint32_t str_offs = get32(&strtab_sh[16]), str_size = get32(&strtab_sh[20]);
+    if (((sym_offs + sym_size) > elf_size) || ((str_offs + str_size) > elf_size)) {
+      continue;
+    }
+    for (j=0; (j+16)<=sym_size; j+=16) {
+      uint32_t st_name = get32(&elf[sym_offs + j]);
+      if ((st_name < str_size) && (strncmp((const char*)&elf[str_offs + st_name], name, str_size - st_name) == 0)) {
+        *value = get32(&elf[sym_offs + j + 4]);
+        return 0;
+      }
+    }
+  }
+  return -1;
+}
+
+
+// append word to segment-based executable payload
+static void seg_put(uint32_t **buf, uint32_t *num, uint32_t *cap, uint32_t data) {
+
+  if (*num == *cap) {
+    *cap = (*cap) ? (2 * (*cap)) : 1024;
+    *buf = realloc(*buf, (*cap) * sizeof(uint32_t));
+    if (*buf == NULL) {
+      printf("Out of memory!");
+      exit(-5);
+    }
+  }
+  (*buf)[(*num)++] = data;
+}
+
+
+// write LZ length extension bytes
+static void lz_put_length(FILE *output, uint32_t len) {
+
+  while (len >= 255) {
+    fputc(255, output);
+    len -= 255;
+  }
+  fputc((unsigned char)len, output);
+}
+
+
+// write LZ sequence: token, literals, offset and match length
+static void lz_put_sequence(FILE *output, const uint8_t *lit, uint32_t lit_len, uint32_t offset, uint32_t match_len) {
+
+  uint32_t ml = (match_len != 0) ? (match_len - LZ_MIN_MATCH) : 0;
+  uint8_t token = (uint8_t)(((lit_len < 15) ? lit_len : 15) << 4);
+  token |= (uint8_t)((ml < 15) ? ml : 15);
+  fputc(token, output);
+  if (lit_len >= 15) {
+    lz_put_length(output, lit_len - 15);
+  }
+  fwrite(lit, 1, lit_len, output);
+  if (match_len != 0) {
+    fputc((unsigned char)((offset >> 0) & 0xFF), output);
+    fputc((unsigned char)((offset >> 8) & 0xFF), output);
+    if (ml >= 15) {
+      lz_put_length(output, ml - 15);
+    }
+  }
+}
+
+
+// LZ4-style greedy compression; returns size of the compressed stream in bytes
+static uint32_t lz_compress(FILE *output, const uint8_t *src, uint32_t len) {
+
+  uint32_t *table = malloc(sizeof(uint32_t) << LZ_HASH_BITS);
+  uint32_t pos = 0, anchor = 0, cand, hash, match;
+  long start = ftell(output);
+
+  if (table == NULL) {
+    return 0;
+  }
+  memset(table, 0xff, sizeof(uint32_t) << LZ_HASH_BITS);
+
+  while ((pos + LZ_MIN_MATCH) <= len) {
+    hash = (uint32_t)(src[pos] | (src[pos+1] << 8) | (src[pos+2] << 16) | ((uint32_t)src[pos+3] << 24));
+    hash = (hash * 2654435761U) >> (32 - LZ_HASH_BITS);
+    cand = table[hash];
+    table[hash] = pos;
+    if ((cand != 0xffffffffU) && ((pos - cand) <= LZ_MAX_OFFSET) && (memcmp(&src[cand], &src[pos], LZ_MIN_MATCH) == 0)) {
+      match = LZ_MIN_MATCH;
+      while (((pos + match) < len) && (src[cand + match] == src[pos + match])) {
+        match++;
+      }
+      lz_put_sequence(output, &src[anchor], pos - anchor, pos - cand, match);
+      pos += match;
+      anchor = pos;
+    }
+    else {
+      pos++;
+    }
+  }
+
+  // final literals-only sequence (omitted if the last match ends exactly at the end of the data)
+  if (anchor < len) {
+    lz_put_sequence(output, &src[anchor], len - anchor, 0, 0);
+  }
+
+  free(table);
+  return (uint32_t)(ftell(output) - start);
+}
 
 int main(int argc, char *argv[]) {
 
@@ -50,11 +198,16 @@ int main(int argc, char *argv[]) {
            "Three arguments are required.\n"
            "1st: Operation\n"
            " -app_bin : Generate application executable binary (binary file, little-endian, with header) \n"
+           " -app_lz  : Generate compressed application executable binary (binary file, little-endian, with header, LZ compression) \n"
+           " -app_seg : Generate segment-based application executable binary from ELF file (binary file, little-endian, with header) \n"
            " -app_img : Generate application raw executable memory image (vhdl package body file, no header)\n"
-           " -raw_hex : Generate application raw executable (ASCII hex file, no header)\n"
+           " -raw_hex : Generate application raw executable (ASCII hex file, no header, Verilog $readmemh compatible)\n"
            " -raw_bin : Generate application raw executable (binary file, no header)\n"
+           " -raw_mem : Generate application raw executable (Xilinx/AMD memory file .mem, no header)\n"
+           " -raw_coe : Generate application raw executable (Xilinx/AMD coefficient file .coe, no header)\n"
+           " -raw_mif : Generate application raw executable (Intel/Altera memory initialization file .mif, no header)\n"
            " -bld_img : Generate bootloader raw executable memory image (vhdl package body file, no header)\n"
-           "2nd: Input file (raw binary image)\n"
+           "2nd: Input file (raw binary image; ELF file for -app_seg)\n"
            "3rd: Output file\n"
            "4th: Project name or folder (optional)\n");
     return 0;
@@ -73,6 +226,11 @@ int main(int argc, char *argv[]) {
   else if (strcmp(argv[1], "-bld_img") == 0) { operation = OP_BLD_IMG; }
   else if (strcmp(argv[1], "-raw_hex") == 0) { operation = OP_RAW_HEX; }
   else if (strcmp(argv[1], "-raw_bin") == 0) { operation = OP_RAW_BIN; }
+  else if (strcmp(argv[1], "-app_lz")  == 0) { operation = OP_APP_LZ; }
+  else if (strcmp(argv[1], "-app_seg") == 0) { operation = OP_APP_SEG; }
+  else if (strcmp(argv[1], "-raw_mem") == 0) { operation = OP_RAW_MEM; }
+  else if (strcmp(argv[1], "-raw_coe") == 0) { operation = OP_RAW_COE; }
+  else if (strcmp(argv[1], "-raw_mif") == 0) { operation = OP_RAW_MIF; }
   else {
     printf("Invalid operation!");
     return -1;
@@ -208,6 +366,163 @@ int main(int argc, char *argv[]) {
   }
 
 
+  // --------------------------------------------------------------------------
+  // Generate compressed BINARY executable (with header!) for bootloader upload
+  // --------------------------------------------------------------------------
+  if (operation == OP_APP_LZ) {
+
+    // get whole (word-padded) image; size and checksum refer to the uncompressed data
+    size = (uint32_t)((raw_exe_size + 3) & ~3UL);
+    uint8_t *image = calloc(size, 1);
+    if ((image == NULL) || (fread(image, 1, raw_exe_size, input) != raw_exe_size)) {
+      printf("Input file error!");
+      free(image);
+      fclose(input);
+      fclose(output);
+      return -2;
+    }
+    checksum = 0;
+    for (i=0; i<size; i+=4) {
+      tmp  = (uint32_t)(image[i+0] << 0);
+      tmp |= (uint32_t)(image[i+1] << 8);
+      tmp |= (uint32_t)(image[i+2] << 16);
+      tmp |= (uint32_t)(image[i+3] << 24);
+      checksum += tmp; // checksum: sum complement
+    }
+    checksum = (~checksum) + 1;
+
+    // header: signature
+    fputc((unsigned char)((signature_lz >>  0) & 0xFF), output);
+    fputc((unsigned char)((signature_lz >>  8) & 0xFF), output);
+    fputc((unsigned char)((signature_lz >> 16) & 0xFF), output);
+    fputc((unsigned char)((signature_lz >> 24) & 0xFF), output);
+    // header: size (uncompressed)
+    fputc((unsigned char)((size >>  0) & 0xFF), output);
+    fputc((unsigned char)((size >>  8) & 0xFF), output);
+    fputc((unsigned char)((size >> 16) & 0xFF), output);
+    fputc((unsigned char)((size >> 24) & 0xFF), output);
+    // header: checksum (sum complement of uncompressed data)
+    fputc((unsigned char)((checksum >>  0) & 0xFF), output);
+    fputc((unsigned char)((checksum >>  8) & 0xFF), output);
+    fputc((unsigned char)((checksum >> 16) & 0xFF), output);
+    fputc((unsigned char)((checksum >> 24) & 0xFF), output);
+
+    // compressed data stream
+    tmp = lz_compress(output, image, size);
+    free(image);
+    if (tmp == 0) {
+      printf("Compression error!");
+      fclose(input);
+      fclose(output);
+      return -5;
+    }
+    printf("Compressed %u bytes to %u bytes (%u%%)\n", (unsigned int)size, (unsigned int)tmp, (unsigned int)((100ULL * tmp) / size));
+  }
+
+
+  // --------------------------------------------------------------------------
+  // Generate segment-based BINARY executable (with header!) from ELF file
+  // --------------------------------------------------------------------------
+  if (operation == OP_APP_SEG) {
+
+    uint8_t *elf = malloc(input_size);
+    uint32_t *payload = NULL, num = 0, cap = 0;
+    uint32_t entry = 0, bss_start = 0, bss_end = 0, addr, len, run, k;
+
+    // get and check ELF file (32-bit, little-endian, RISC-V)
+    if ((elf == NULL) || (fread(elf, 1, input_size, input) != input_size) || (input_size < 0x34) ||
+        (memcmp(elf, "\x7f" "ELF", 4) != 0) || (elf[4] != 1) || (elf[5] != 1) || (get16(&elf[0x12]) != 0xF3)) {
+      printf("Input file is not a 32-bit little-endian RISC-V ELF file!");
+      free(elf);
+      fclose(input);
+      fclose(output);
+      return -2;
+    }
+
+    // crt0 entry point that skips the .data copy and .bss clear loops
+    if ((elf_symbol(elf, input_size, "__crt0_entry_segments", &entry) != 0) ||
+        (elf_symbol(elf, input_size, "__crt0_bss_start", &bss_start) != 0) ||
+        (elf_symbol(elf, input_size, "__crt0_bss_end", &bss_end) != 0)) {
+      printf("Missing crt0 symbols (__crt0_entry_segments, __crt0_bss_start, __crt0_bss_end)!");
+      free(elf);
+      fclose(input);
+      fclose(output);
+      return -2;
+    }
+    seg_put(&payload, &num, &cap, entry);
+
+    // data segments: initialized content of all loadable program segments at their final (virtual) address;
+    // runs of zero words are replaced by zero-fill segments
+    uint32_t phoff = get32(&elf[0x1C]), phentsize = get16(&elf[0x2A]), phnum = get16(&elf[0x2C]);
+    for (i=0; (i<phnum) && ((phoff + (i+1)*phentsize) <= input_size); i++) {
+      const uint8_t *ph = &elf[phoff + i*phentsize];
+      uint32_t p_offset = get32(&ph[4]), p_vaddr = get32(&ph[8]), p_filesz = get32(&ph[16]);
+      if ((get32(&ph[0]) != ELF_PT_LOAD) || (p_filesz == 0) || ((p_offset + p_filesz) > input_size)) {
+        continue;
+      }
+      uint32_t words = (p_filesz + 3) / 4;
+      uint32_t *data = calloc(words, sizeof(uint32_t));
+      if (data == NULL) {
+        printf("Out of memory!");
+        return -5;
+      }
+      for (k=0; k<p_filesz; k++) {
+        data[k/4] |= (uint32_t)elf[p_offset + k] << (8*(k%4));
+      }
+      k = 0;
+      while (k < words) {
+        for (run=0; ((k+run) < words) && (data[k+run] == 0); run++);
+        if (run >= SEG_ZERO_RUN) { // zero-fill segment
+          seg_put(&payload, &num, &cap, p_vaddr + 4*k);
+          seg_put(&payload, &num, &cap, SEG_FILL | (4*run));
+          k += run;
+          continue;
+        }
+        // data segment until the next long run of zero words
+        addr = k;
+        while (k < words) {
+          for (run=0; ((k+run) < words) && (data[k+run] == 0); run++);
+          if (run >= SEG_ZERO_RUN) {
+            break;
+          }
+          k += (run) ? run : 1;
+        }
+        len = k - addr;
+        seg_put(&payload, &num, &cap, p_vaddr + 4*addr);
+        seg_put(&payload, &num, &cap, 4*len);
+        while (addr < k) {
+          seg_put(&payload, &num, &cap, data[addr++]);
+        }
+      }
+      free(data);
+    }
+
+    // .bss: zero-fill segment
+    if (bss_end > bss_start) {
+      seg_put(&payload, &num, &cap, bss_start);
+      seg_put(&payload, &num, &cap, SEG_FILL | ((bss_end - bss_start + 3) & ~3U));
+    }
+    free(elf);
+
+    // header: signature, payload size in bytes, checksum (sum complement of all payload words)
+    size = 4*num;
+    checksum = 0;
+    for (k=0; k<num; k++) {
+      checksum += payload[k];
+    }
+    checksum = (~checksum) + 1;
+    uint32_t hdr[3] = {signature_seg, size, checksum};
+    for (k=0; k<(3+num); k++) {
+      tmp = (k < 3) ? hdr[k] : payload[k-3];
+      fputc((unsigned char)((tmp >>  0) & 0xFF), output);
+      fputc((unsigned char)((tmp >>  8) & 0xFF), output);
+      fputc((unsigned char)((tmp >> 16) & 0xFF), output);
+      fputc((unsigned char)((tmp >> 24) & 0xFF), output);
+    }
+    free(payload);
+  }
+
+
   // --------------------------------------------------------------------------
   // Generate APPLICATION's executable memory initialization file (no header!)
   // => VHDL package body
@@ -327,6 +642,7 @@ int main(int argc, char *argv[]) {
   // --------------------------------------------------------------------------
   if (operation == OP_RAW_HEX) {
 
+    memset(buffer, 0, 4);
     while(fread(&buffer, sizeof(unsigned char), 4, input) != 0) {
       tmp  = (uint32_t)(buffer[0] << 0);
       tmp |= (uint32_t)(buffer[1] << 8);
@@ -334,6 +650,7 @@ int main(int argc, char *argv[]) {
       tmp |= (uint32_t)(buffer[3] << 24);
       sprintf(tmp_string, "%08x\n", (unsigned int)tmp);
       fputs(tmp_string, output);
+      memset(buffer, 0, 4); // zero-pad incomplete last word
     }
   }
 
@@ -349,6 +666,62 @@ int main(int argc, char *argv[]) {
   }
 
 
+  // --------------------------------------------------------------------------
+  // Generate raw APPLICATION's executable memory initialization file for
+  // vendor memory generators / $readmemh-style loaders (no header!)
+  // --------------------------------------------------------------------------
+  if ((operation == OP_RAW_MEM) || (operation == OP_RAW_COE) || (operation == OP_RAW_MIF)) {
+
+    unsigned int depth = (input_size + 3) / 4; // incomplete last word is zero-padded
+
+    // preamble
+    if (operation == OP_RAW_MEM) {
+      fputs("@00000000\n", output); // word address
+    }
+    else if (operation == OP_RAW_COE) {
+      fputs("memory_initialization_radix=16;\n"
+            "memory_initialization_vector=\n", output);
+    }
+    else {
+      sprintf(tmp_string, "-- NEORV32 executable image: %s\n"
+                          "WIDTH=32;\n"
+                          "DEPTH=%u;\n"
+                          "ADDRESS_RADIX=HEX;\n"
+                          "DATA_RADIX=HEX;\n"
+                          "CONTENT BEGIN\n", argv[2], depth);
+      fputs(tmp_string, output);
+    }
+
+    // data words
+    for (i=0; i<depth; i++) {
+      memset(buffer, 0, 4);
+      if (fread(&buffer, sizeof(unsigned char), 4, input) == 0) {
+        printf("Unexpected input file end!\n");
+        break;
+      }
+      tmp  = (uint32_t)(buffer[0] << 0);
+      tmp |= (uint32_t)(buffer[1] << 8);
+      tmp |= (uint32_t)(buffer[2] << 16);
+      tmp |= (uint32_t)(buffer[3] << 24);
+      if (operation == OP_RAW_MEM) {
+        sprintf(tmp_string, "%08x\n", (unsigned int)tmp);
+      }
+      else if (operation == OP_RAW_COE) {
+        sprintf(tmp_string, "%08x%s\n", (unsigned int)tmp, (i == (depth-1)) ? ";" : ",");
+      }
+      else {
+        sprintf(tmp_string, "  %x : %08x;\n", i, (unsigned int)tmp);
+      }
+      fputs(tmp_string, output);
+    }
+
+    // postamble
+    if (operation == OP_RAW_MIF) {
+      fputs("END;\n", output);
+    }
+  }
+
+
   // --------------------------------------------------------------------------
   // Done, clean up
   // --------------------------------------------------------------------------
@@ -0,0 +1,440 @@
+// #################################################################################################
+// # << NEORV32 - High-speed UART executable upload tool >>                                        #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2023, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+
+// Host tool for the block-based high-speed UART upload protocol of the default NEORV32 bootloader (command 'f').
+// Compile: gcc -O2 uart_upload.c -o uart_upload
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// executable signatures ("magic words"); the high-speed protocol only supports plain executables
+const uint32_t signature     = 0x4788CAFE;
+const uint32_t signature_lz  = 0x4788CAFF;
+const uint32_t signature_seg = 0x4788CAFD;
+
+// protocol control characters (see bootloader)
+enum protocol_enum {
+  PROT_ACK  = 0x06,  // request/frame accepted
+  PROT_NAK  = 0x15,  // request/frame rejected (retransmit)
+  PROT_CAN  = 0x18,  // upload aborted
+  PROT_SYNC = 0x53,  // synchronization at new BAUD rate
+  PROT_END  = 0xFFFF // block index: end of transfer
+};
+
+// upload result
+enum result_enum {RES_OK, RES_RETRY, RES_ERROR};
+
+#define CRC_POLY 0x04C11DB7 // CRC32 polynomial (MSB-first, start value 0xFFFFFFFF, no final XOR)
+#define RETRIES  8          // maximum number of retransmissions per frame
+#define IDLE_MS  3000       // console timeout; longer than the bootloader's abort time (UART_FAST_RETRIES * 1/4s)
+
+// supported BAUD rates (descending)
+static const struct {
+  uint32_t baud;
+  speed_t  speed;
+} baud_list[] = {
+#ifdef B4000000
+  {4000000, B4000000},
+#endif
+#ifdef B3000000
+  {3000000, B3000000},
+#endif
+#ifdef B2500000
+  {2500000, B2500000},
+#endif
+#ifdef B2000000
+  {2000000, B2000000},
+#endif
+#ifdef B1500000
+  {1500000, B1500000},
+#endif
+#ifdef B1152000
+  {1152000, B1152000},
+#endif
+#ifdef B1000000
+  {1000000, B1000000},
+#endif
+#ifdef B921600
+  {921600, B921600},
+#endif
+#ifdef B576000
+  {576000, B576000},
+#endif
+#ifdef B500000
+  {500000, B500000},
+#endif
+#ifdef B460800
+  {460800, B460800},
+#endif
+  {230400, B230400},
+  {115200, B115200},
+  {57600, B57600},
+  {38400, B38400},
+  {19200, B19200},
+  {9600, B9600}
+};
+
+#define BAUD_LIST_SIZE (sizeof(baud_list) / sizeof(baud_list[0]))
+
+
+// configure serial port: raw mode, 8N1, no flow control
+static int set_baud(int fd, speed_t speed) {
+
+  struct termios tty;
+
+  if (tcgetattr(fd, &tty) != 0) {
+    return -1;
+  }
+  cfmakeraw(&tty);
+  tty.c_cflag |= CLOCAL | CREAD;
+  tty.c_cflag &= ~(CSTOPB | CRTSCTS);
+  tty.c_cc[VMIN] = 0;
+  tty.c_cc[VTIME] = 0;
+  cfsetispeed(&tty, speed);
+  cfsetospeed(&tty, speed);
+  return tcsetattr(fd, TCSANOW, &tty);
+}
+
+
+// get byte from serial port; returns -1 on timeout
+static int get_byte(int fd, int timeout_ms) {
+
+  struct pollfd pfd = {fd, POLLIN, 0};
+  uint8_t c;
+
+  if ((poll(&pfd, 1, timeout_ms) > 0) && (read(fd, &c, 1) == 1)) {
+    return (int)c;
+  }
+  return -1;
+}
+
+
+// discard received data until the line is idle
+static void flush_input(int fd, int idle_ms) {
+
+  while (get_byte(fd, idle_ms) >= 0);
+  tcflush(fd, TCIFLUSH);
+}
+
+
+// wait for the bootloader's console prompt at the default BAUD rate; returns -1 on timeout
+// (after a failed transfer the bootloader keeps retrying at the fast BAUD rate until it aborts)
+static int wait_prompt(int fd) {
+
+  static const char prompt[] = "CMD:> ";
+  int c, i = 0;
+
+  while ((c = get_byte(fd, IDLE_MS)) >= 0) {
+    i = (c == prompt[i]) ? (i + 1) : ((c == prompt[0]) ? 1 : 0);
+    if (prompt[i] == '\0') {
+      return 0;
+    }
+  }
+  return -1;
+}
+
+
+// back to default BAUD rate after a failed transfer and wait until the bootloader is ready again
+static int fallback(int fd, speed_t boot_speed) {
+
+  set_baud(fd, boot_speed);
+  if (wait_prompt(fd)) {
+    printf("No bootloader response.\n");
+    return RES_ERROR;
+  }
+  return RES_RETRY;
+}
+
+
+// send data
+static int put_data(int fd, const uint8_t *data, uint32_t num) {
+
+  ssize_t n;
+
+  while (num) {
+    n = write(fd, data, num);
+    if (n <= 0) {
+      return -1;
+    }
+    data += n;
+    num -= (uint32_t)n;
+  }
+  return 0;
+}
+
+
+// CRC32 (same algorithm as the NEORV32 CRC unit in CRC32 mode)
+static uint32_t crc32(const uint8_t *data, uint32_t num) {
+
+  uint32_t crc = 0xffffffffU, i, j;
+
+  for (i=0; i<num; i++) {
+    crc ^= (uint32_t)data[i] << 24;
+    for (j=0; j<8; j++) {
+      crc = (crc & 0x80000000U) ? ((crc << 1) ^ CRC_POLY) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+
+// send frame (optional block index, data, CRC32) and get response; returns -1 on timeout
+static int send_frame(int fd, uint32_t baud, int idx, const uint8_t *data, uint32_t num) {
+
+  uint8_t buf[4];
+  uint32_t crc;
+
+  if (idx >= 0) {
+    buf[0] = (uint8_t)(idx >> 0);
+    buf[1] = (uint8_t)(idx >> 8);
+    buf[2] = (uint8_t)(~idx >> 0);
+    buf[3] = (uint8_t)(~idx >> 8);
+    if (put_data(fd, buf, 4)) {
+      return -1;
+    }
+  }
+  if (num) {
+    crc = crc32(data, num);
+    buf[0] = (uint8_t)(crc >> 0);
+    buf[1] = (uint8_t)(crc >> 8);
+    buf[2] = (uint8_t)(crc >> 16);
+    buf[3] = (uint8_t)(crc >> 24);
+    if (put_data(fd, data, num) || put_data(fd, buf, 4)) {
+      return -1;
+    }
+  }
+
+  // the bootloader answers within one second after the frame has been sent
+  return get_byte(fd, 1000 + (int)((10000ULL * (num + 8)) / baud));
+}
+
+
+// upload executable using the given BAUD rate
+static int upload(int fd, speed_t boot_speed, uint32_t baud, speed_t speed, const uint8_t *exe, uint32_t exe_size, uint32_t *resends) {
+
+  uint8_t buf[4];
+  uint32_t block_size, offs, num;
+  int c, i, idx;
+
+  // start fast upload at default BAUD rate, wait for console echo
+  set_baud(fd, boot_speed);
+  flush_input(fd, 100);
+  buf[0] = 'f';
+  put_data(fd, buf, 1);
+  while ((c = get_byte(fd, 500)) != '\n') {
+    if (c < 0) {
+      printf("No bootloader response. Reset processor before starting the upload.\n");
+      return RES_ERROR;
+    }
+  }
+
+  // request BAUD rate
+  buf[0] = (uint8_t)(baud >> 0);
+  buf[1] = (uint8_t)(baud >> 8);
+  buf[2] = (uint8_t)(baud >> 16);
+  buf[3] = (uint8_t)(baud >> 24);
+  put_data(fd, buf, 4);
+  c = get_byte(fd, 500);
+  if (c == PROT_NAK) { // BAUD rate cannot be generated by the processor
+    return fallback(fd, boot_speed);
+  }
+  else if (c != PROT_ACK) {
+    printf("Bootloader protocol error.\n");
+    return RES_ERROR;
+  }
+
+  // synchronize at new BAUD rate and get block size
+  tcdrain(fd);
+  set_baud(fd, speed);
+  tcflush(fd, TCIFLUSH);
+  buf[0] = PROT_SYNC;
+  put_data(fd, buf, 1);
+  c = get_byte(fd, 100);
+  block_size  = (uint32_t)get_byte(fd, 100) << 0;
+  block_size |= (uint32_t)get_byte(fd, 100) << 8;
+  if ((c != PROT_SYNC) || (block_size == 0) || (block_size > 0xffff)) {
+    return fallback(fd, boot_speed);
+  }
+
+  // header frame
+  for (i=0; i<RETRIES; i++) {
+    c = send_frame(fd, baud, -1, exe, 12);
+    if (c != PROT_NAK) {
+      break;
+    }
+    (*resends)++;
+  }
+  if (c == PROT_CAN) {
+    set_baud(fd, boot_speed);
+    printf("Invalid executable (signature).\n");
+    return RES_ERROR;
+  }
+  if (c != PROT_ACK) {
+    return fallback(fd, boot_speed);
+  }
+
+  // data blocks; only blocks that were rejected are sent again
+  for (offs=0, idx=0; offs<exe_size; offs+=block_size, idx++) {
+    num = ((exe_size - offs) < block_size) ? (exe_size - offs) : block_size;
+    for (i=0; i<RETRIES; i++) {
+      c = send_frame(fd, baud, idx, &exe[12 + offs], num);
+      if (c != PROT_NAK) {
+        break;
+      }
+      (*resends)++;
+    }
+    if (c != PROT_ACK) { // aborted or no response: try again at a lower BAUD rate
+      return fallback(fd, boot_speed);
+    }
+  }
+
+  // end of transfer; bootloader checks the executable's checksum
+  c = send_frame(fd, baud, PROT_END, NULL, 0);
+  set_baud(fd, boot_speed);
+  if (c == PROT_NAK) {
+    printf("Checksum error.\n");
+    return RES_ERROR;
+  }
+  else if (c != PROT_ACK) {
+    return fallback(fd, boot_speed);
+  }
+  return RES_OK;
+}
+
+
+int main(int argc, char *argv[]) {
+
+  if ((argc < 3) || (argc > 5)) {
+    printf("Upload executable via serial port (UART) to the NEORV32 bootloader using the high-speed block protocol.\n"
+           "The highest BAUD rate that works is selected automatically.\n"
+           "Reset processor before starting the upload.\n"
+           "Usage:   uart_upload <serial port> <NEORV32 executable> [max BAUD rate] [bootloader BAUD rate]\n"
+           "Example: uart_upload /dev/ttyUSB0 path/to/project/neorv32_exe.bin 3000000 19200\n");
+    return 0;
+  }
+
+  uint32_t max_baud = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 3000000;
+  uint32_t boot_baud = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : 19200;
+  speed_t boot_speed = 0;
+  uint32_t i, exe_size, resends = 0;
+  int res = RES_RETRY;
+
+  for (i=0; i<BAUD_LIST_SIZE; i++) {
+    if (baud_list[i].baud == boot_baud) {
+      boot_speed = baud_list[i].speed;
+    }
+  }
+  if (boot_speed == 0) {
+    printf("Unsupported bootloader BAUD rate!\n");
+    return -1;
+  }
+
+  // get executable
+  FILE *input = fopen(argv[2], "rb");
+  if (input == NULL) {
+    printf("Input file error!\n");
+    return -2;
+  }
+  fseek(input, 0L, SEEK_END);
+  long file_size = ftell(input);
+  rewind(input);
+  uint8_t *exe = malloc((file_size > 12) ? (size_t)file_size : 12);
+  if ((exe == NULL) || (file_size < 12) || (fread(exe, 1, (size_t)file_size, input) != (size_t)file_size)) {
+    printf("Input file error!\n");
+    fclose(input);
+    free(exe);
+    return -2;
+  }
+  fclose(input);
+  exe_size = (uint32_t)exe[4] | ((uint32_t)exe[5] << 8) | ((uint32_t)exe[6] << 16) | ((uint32_t)exe[7] << 24);
+  i = (uint32_t)exe[0] | ((uint32_t)exe[1] << 8) | ((uint32_t)exe[2] << 16) | ((uint32_t)exe[3] << 24);
+  if ((i == signature_lz) || (i == signature_seg)) {
+    printf("Compressed/segment-based executables are not supported by the high-speed protocol!\n"
+           "Use neorv32_exe.bin or upload via uart_upload.sh without a max BAUD rate (bootloader command 'u').\n");
+    free(exe);
+    return -3;
+  }
+  if ((i != signature) || ((uint32_t)file_size < (12 + exe_size))) {
+    printf("Invalid executable! Use neorv32_exe.bin (image_gen -app_bin).\n");
+    free(exe);
+    return -3;
+  }
+
+  // open serial port
+  int fd = open(argv[1], O_RDWR | O_NOCTTY);
+  if ((fd < 0) || set_baud(fd, boot_speed)) {
+    printf("Serial port error!\n");
+    free(exe);
+    return -4;
+  }
+
+  // abort auto-boot
+  const uint8_t key = 'h';
+  put_data(fd, &key, 1);
+  flush_input(fd, 300);
+
+  // try BAUD rates in descending order
+  struct timespec t0, t1;
+  for (i=0; (i<BAUD_LIST_SIZE) && (res == RES_RETRY); i++) {
+    if (baud_list[i].baud > max_baud) {
+      continue;
+    }
+    printf("Uploading %u bytes at %u baud... ", (unsigned int)exe_size, (unsigned int)baud_list[i].baud);
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    res = upload(fd, boot_speed, baud_list[i].baud, baud_list[i].speed, exe, exe_size, &resends);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (res == RES_RETRY) {
+      printf("failed.\n");
+    }
+  }
+
+  if (res == RES_OK) {
+    printf("Done (%.2fs, %u retransmissions).\n",
+           (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9, (unsigned int)resends);
+  }
+  else if (res == RES_RETRY) {
+    printf("Upload error.\n");
+  }
+
+  close(fd);
+  free(exe);
+  return (res == RES_OK) ? 0 : -5;
+}
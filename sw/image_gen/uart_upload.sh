@@ -4,15 +4,27 @@ set -e
 
 # Simple script to upload executable via bootloader
 
-if [ $# -ne 2 ]
+if [ $# -ne 2 ] && [ $# -ne 3 ]
 then
   echo "Upload image via serial port (UART) to the NEORV32 bootloader."
   echo "Reset processor before starting the upload."
-  echo "Usage:   [sudo] sh uart_upload.sh <serial port> <NEORV32 executable>"
+  echo "Usage:   [sudo] sh uart_upload.sh <serial port> <NEORV32 executable> [max BAUD rate]"
   echo "Example: sudo sh uart_upload.sh /dev/ttyS6 path/to/project/neorv32_exe.bin"
+  echo "Specifying a max BAUD rate uses the high-speed block protocol (bootloader command 'f', requires a bootloader built with UART_FAST_EN=1 and a native GCC)."
   exit
 fi
 
+# high-speed block protocol with CRC32 and automatic BAUD rate selection via host tool
+if [ $# -eq 3 ]
+then
+  TOOL_DIR=$(dirname "$0")
+  if [ ! -x "$TOOL_DIR/uart_upload" ] || [ "$TOOL_DIR/uart_upload.c" -nt "$TOOL_DIR/uart_upload" ]
+  then
+    gcc -O2 "$TOOL_DIR/uart_upload.c" -o "$TOOL_DIR/uart_upload"
+  fi
+  exec "$TOOL_DIR/uart_upload" "$1" "$2" "$3"
+fi
+
 # configure serial port
 stty -F "$1" 19200 -hup raw -echo -echoe -echok -echoctl -echoke -crtscts cs8 -cstopb noflsh clocal cread
 
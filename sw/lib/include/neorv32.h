@@ -199,9 +199,27 @@ enum NEORV32_CLOCK_PRSC_enum {
 #include "neorv32_cpu_csr.h"
 #include "neorv32_cpu_cfu.h"
 
+// lock-free ring buffers
+#include "neorv32_ringbuf.h"
+
 // NEORV32 runtime environment
 #include "neorv32_rte.h"
 
+// cooperative coroutine scheduler
+#include "neorv32_coro.h"
+
+// preemptive kernel
+#include "neorv32_kernel.h"
+
+// O(1) memory allocator
+#include "neorv32_malloc.h"
+
+// optimized memory/string functions
+#include "neorv32_string.h"
+
+// carry-less multiplication kernels (CRC, GHASH)
+#include "neorv32_clmul.h"
+
 // IO/peripheral devices
 #include "neorv32_cfs.h"
 #include "neorv32_crc.h"
@@ -0,0 +1,31 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_clmul.h
+ * @brief Carry-less multiplication kernels (CRC-32, CRC-32C, GHASH) using Zbc/Zbkc - header file.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_clmul_h
+#define neorv32_clmul_h
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+uint32_t neorv32_clmul_crc32(uint32_t crc, const void *data, size_t len);
+uint32_t neorv32_clmul_crc32c(uint32_t crc, const void *data, size_t len);
+void     neorv32_clmul_gf128_mul(uint8_t *r, const uint8_t *a, const uint8_t *b);
+void     neorv32_clmul_ghash(uint8_t *y, const uint8_t *h, const void *data, size_t len);
+/**@}*/
+
+
+#endif // neorv32_clmul_h
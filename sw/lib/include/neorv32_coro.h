@@ -0,0 +1,91 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_coro.h
+ * @brief Cooperative (stackful) coroutine scheduler - header file.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_coro_h
+#define neorv32_coro_h
+
+
+/**********************************************************************//**
+ * @name Coroutine states
+ **************************************************************************/
+enum NEORV32_CORO_STATE_enum {
+  CORO_STATE_READY   = 0, /**< Coroutine is ready to run */
+  CORO_STATE_WAITING = 1, /**< Coroutine is waiting for an event */
+  CORO_STATE_DONE    = 2  /**< Coroutine has returned from its entry function */
+};
+
+
+/**********************************************************************//**
+ * Coroutine control block.
+ **************************************************************************/
+typedef struct neorv32_coro_struct {
+  uint32_t sp;                      /**< saved stack pointer */
+  volatile int state;               /**< current state (#NEORV32_CORO_STATE_enum) */
+  void (*entry)(void *arg);         /**< entry function */
+  void *arg;                        /**< argument for entry function */
+  struct neorv32_coro_struct *next; /**< next coroutine in scheduler list */
+} neorv32_coro_t;
+
+
+/**********************************************************************//**
+ * Awaitable event. An event is "sticky": a signal that occurs while
+ * no coroutine is waiting is kept until the next wait.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t pending;        /**< event has been signaled */
+  neorv32_coro_t *volatile waiter;  /**< coroutine waiting for this event */
+} neorv32_coro_event_t;
+
+
+/**********************************************************************//**
+ * @name Peripheral events (signaled by the handlers installed via neorv32_coro_irq_setup())
+ **************************************************************************/
+/**@{*/
+extern neorv32_coro_event_t neorv32_coro_event_uart0_rx; /**< UART0 RX FIFO not empty */
+extern neorv32_coro_event_t neorv32_coro_event_dma;      /**< DMA transfer done */
+extern neorv32_coro_event_t neorv32_coro_event_gptmr;    /**< GPTMR timer match */
+/**@}*/
+
+
+/**********************************************************************//**
+ * The peripheral event functions install RTE trap handlers at runtime, which is not
+ * supported if the RTE is compiled with RTE_STATIC. Using them in this mode is a compile error.
+ **************************************************************************/
+#ifdef RTE_STATIC
+#define __NEORV32_CORO_RTE_DYNAMIC __attribute__((error("neorv32_coro: peripheral events are not supported with RTE_STATIC")))
+#else
+#define __NEORV32_CORO_RTE_DYNAMIC
+#endif
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+void neorv32_coro_create(neorv32_coro_t *coro, void (*entry)(void *arg), void *arg, uint32_t *stack, uint32_t stack_size);
+void neorv32_coro_run(void);
+void neorv32_coro_yield(void);
+neorv32_coro_t *neorv32_coro_self(void);
+void neorv32_coro_event_init(neorv32_coro_event_t *event);
+void neorv32_coro_wait(neorv32_coro_event_t *event);
+void neorv32_coro_signal(neorv32_coro_event_t *event);
+void neorv32_coro_irq_setup(void) __NEORV32_CORO_RTE_DYNAMIC;
+char neorv32_coro_uart0_getc(void) __NEORV32_CORO_RTE_DYNAMIC;
+int  neorv32_coro_dma_wait(void) __NEORV32_CORO_RTE_DYNAMIC;
+void neorv32_coro_gptmr_wait(void) __NEORV32_CORO_RTE_DYNAMIC;
+/**@}*/
+
+
+#endif // neorv32_coro_h
@@ -361,6 +361,63 @@ inline void __attribute__ ((always_inline)) neorv32_cpu_invalidate_reservations(
 }
 
 
+// #################################################################################################
+// Cache-block management operations (Zicbom / Zicboz)
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * Cache-block operation: invalidate data cache block (discard modifications).
+ *
+ * @warning This function requires the Zicbom ISA extension (and machine-mode).
+ *
+ * @param[in] addr Any address within the cache block.
+ **************************************************************************/
+inline void __attribute__ ((always_inline)) neorv32_cpu_cbo_inval(uint32_t addr) {
+
+  asm volatile (".insn i 0x0f, 2, x0, %[rs1], 0" : : [rs1] "r" (addr) : "memory"); // cbo.inval
+}
+
+
+/**********************************************************************//**
+ * Cache-block operation: clean data cache block (write back if modified).
+ *
+ * @warning This function requires the Zicbom ISA extension (and machine-mode).
+ *
+ * @param[in] addr Any address within the cache block.
+ **************************************************************************/
+inline void __attribute__ ((always_inline)) neorv32_cpu_cbo_clean(uint32_t addr) {
+
+  asm volatile (".insn i 0x0f, 2, x0, %[rs1], 1" : : [rs1] "r" (addr) : "memory"); // cbo.clean
+}
+
+
+/**********************************************************************//**
+ * Cache-block operation: flush data cache block (clean + invalidate).
+ *
+ * @warning This function requires the Zicbom ISA extension (and machine-mode).
+ *
+ * @param[in] addr Any address within the cache block.
+ **************************************************************************/
+inline void __attribute__ ((always_inline)) neorv32_cpu_cbo_flush(uint32_t addr) {
+
+  asm volatile (".insn i 0x0f, 2, x0, %[rs1], 2" : : [rs1] "r" (addr) : "memory"); // cbo.flush
+}
+
+
+/**********************************************************************//**
+ * Cache-block operation: zero data cache block (allocate without fetching).
+ *
+ * @warning This function requires the Zicboz ISA extension (and machine-mode).
+ *
+ * @param[in] addr Any address within the cache block.
+ **************************************************************************/
+inline void __attribute__ ((always_inline)) neorv32_cpu_cbo_zero(uint32_t addr) {
+
+  asm volatile (".insn i 0x0f, 2, x0, %[rs1], 4" : : [rs1] "r" (addr) : "memory"); // cbo.zero
+}
+
+
 // #################################################################################################
 // CSR access helpers
 // #################################################################################################
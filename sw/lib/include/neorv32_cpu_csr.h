@@ -334,13 +334,26 @@ enum NEORV32_CSR_XISA_enum {
   CSR_MXISA_ZIHPM     =  9, /**< CPU mxisa CSR  (9): hardware performance monitors (r/-)*/
   CSR_MXISA_SDEXT     = 10, /**< CPU mxisa CSR (10): RISC-V debug mode (r/-)*/
   CSR_MXISA_SDTRIG    = 11, /**< CPU mxisa CSR (11): RISC-V trigger module (r/-)*/
+  CSR_MXISA_ZICBOM    = 12, /**< CPU mxisa CSR (12): cache-block management operations (r/-)*/
+  CSR_MXISA_ZICBOZ    = 13, /**< CPU mxisa CSR (13): cache-block zero operation (r/-)*/
+  CSR_MXISA_ZCB       = 14, /**< CPU mxisa CSR (14): additional simple compressed instructions (r/-)*/
+  CSR_MXISA_ZCMP      = 15, /**< CPU mxisa CSR (15): compressed push/pop and register-move instructions (r/-)*/
+  CSR_MXISA_ZBKB      = 16, /**< CPU mxisa CSR (16): bit-manipulation instructions for cryptography (r/-)*/
+  CSR_MXISA_ZBKC      = 17, /**< CPU mxisa CSR (17): carry-less multiplication instructions (r/-)*/
+  CSR_MXISA_ZBKX      = 18, /**< CPU mxisa CSR (18): cryptography crossbar permutation instructions (r/-)*/
+  CSR_MXISA_ZKND      = 19, /**< CPU mxisa CSR (19): NIST suite AES decryption instructions (r/-)*/
+
+  CSR_MXISA_ZKNE      = 21, /**< CPU mxisa CSR (21): NIST suite AES encryption instructions (r/-)*/
+  CSR_MXISA_ZKNH      = 22, /**< CPU mxisa CSR (22): NIST suite hash function instructions (r/-)*/
+  CSR_MXISA_ZBC       = 23, /**< CPU mxisa CSR (23): carry-less multiplication instructions (r/-)*/
+  CSR_MXISA_ZXPSIMD   = 24, /**< CPU mxisa CSR (24): packed-SIMD DSP instructions (r/-)*/
 
   // Misc
   CSR_MXISA_IS_SIM    = 20, /**< CPU mxisa CSR (20): this might be a simulation when set (r/-)*/
 
   // Tuning options
   CSR_MXISA_RFHWRST   = 29, /**< CPU mxisa CSR (29): Register file has full hardware reset (r/-)*/
-  CSR_MXISA_FASTMUL   = 30, /**< CPU mxisa CSR (30): DSP-based multiplication (M extensions only) (r/-)*/
+  CSR_MXISA_FASTMUL   = 30, /**< CPU mxisa CSR (30): DSP-based multiplication (M extensions), parallel carry-less multiplication (r/-)*/
   CSR_MXISA_FASTSHIFT = 31  /**< CPU mxisa CSR (31): parallel logic for shifts (barrel shifters) (r/-)*/
 };
 
@@ -105,6 +105,8 @@ void neorv32_dma_transfer(uint32_t base_src, uint32_t base_dst, uint32_t num, ui
 void neorv32_dma_transfer_auto(uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config, int firq_sel);
 int  neorv32_dma_status(void);
 int  neorv32_dma_done(void);
+void neorv32_dma_cache_clean(uint32_t base, uint32_t size);
+void neorv32_dma_cache_inval(uint32_t base, uint32_t size);
 /**@}*/
 
 
@@ -193,6 +193,35 @@ asm(".set RISCV_OPCODE_CUSTOM3 , 0b1111011");
 })
 
 
+/**********************************************************************//**
+ * @name R3-type instruction format with accumulation (rd is also a source operand)
+ **************************************************************************/
+#define CUSTOM_INSTR_R3_ACC_TYPE(funct7, rd, rs2, rs1, funct3, opcode) \
+({                                                                     \
+    uint32_t __return = (rd);                                          \
+    asm volatile (                                                     \
+      ""                                                               \
+      : [output] "+r" (__return)                                       \
+      : [input_i] "r" (rs1),                                           \
+        [input_j] "r" (rs2)                                            \
+    );                                                                 \
+    asm volatile (                                                     \
+      ".word (                                                         \
+        (((" #funct7 ") & 0x7f) << 25) |                               \
+        ((( regnum_%2 ) & 0x1f) << 20) |                               \
+        ((( regnum_%1 ) & 0x1f) << 15) |                               \
+        (((" #funct3 ") & 0x07) << 12) |                               \
+        ((( regnum_%0 ) & 0x1f) <<  7) |                               \
+        (((" #opcode ") & 0x7f) <<  0)                                 \
+      );"                                                              \
+      : [rd] "+r" (__return)                                           \
+      : "r" (rs1),                                                     \
+        "r" (rs2)                                                      \
+    );                                                                 \
+    __return;                                                          \
+})
+
+
 /**********************************************************************//**
  * @name R4-type instruction format, RISC-V-standard
  **************************************************************************/
@@ -312,4 +341,253 @@ asm(".set RISCV_OPCODE_CUSTOM3 , 0b1111011");
 })
 
 
+// ****************************************************************************************************************************
+// Scalar Cryptography Intrinsics (Zbkb, Zbkc, Zbkx, Zknd, Zkne, Zknh) and Carry-Less Multiplication (Zbc)
+// These are available if the according CPU_EXTENSION_RISCV_Z* generics are enabled (check the mxisa CSR).
+// ****************************************************************************************************************************
+
+/**********************************************************************//**
+ * @name Zbkb: Bit-manipulation for cryptography
+ **************************************************************************/
+/**@{*/
+/** Pack low halves of rs1 (low) and rs2 (high) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_pack(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000100, rs2, rs1, 0b100, 0b0110011);
+}
+/** Pack low bytes of rs1 (byte 0) and rs2 (byte 1) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_packh(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000100, rs2, rs1, 0b111, 0b0110011);
+}
+/** Reverse bits in each byte */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_brev8(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b011010000111, rs1, 0b101, 0b0010011);
+}
+/** Bit interleave: low half to even bits, high half to odd bits */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_zip(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000010001111, rs1, 0b001, 0b0010011);
+}
+/** Bit de-interleave: even bits to low half, odd bits to high half */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_unzip(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000010001111, rs1, 0b101, 0b0010011);
+}
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Zbc / Zbkc: Carry-less multiplication
+ **************************************************************************/
+/**@{*/
+/** Carry-less multiply, low word of the 64-bit product */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_clmul(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000101, rs2, rs1, 0b001, 0b0110011);
+}
+/** Carry-less multiply, high word of the 64-bit product */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_clmulh(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000101, rs2, rs1, 0b011, 0b0110011);
+}
+/** Carry-less multiply, bits 62..31 of the 64-bit product (Zbc only) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_clmulr(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000101, rs2, rs1, 0b010, 0b0110011);
+}
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Zbkx: Crossbar permutations
+ **************************************************************************/
+/**@{*/
+/** Nibble-wise lookup: each nibble of rs2 selects a nibble of rs1 (0 if index >= 8) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_xperm4(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010100, rs2, rs1, 0b010, 0b0110011);
+}
+/** Byte-wise lookup: each byte of rs2 selects a byte of rs1 (0 if index >= 4) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_xperm8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010100, rs2, rs1, 0b100, 0b0110011);
+}
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Zkne / Zknd: AES encryption / decryption (RV32)
+ *
+ * All functions return rs1 XOR rotl32(f(byte bs of rs2), 8*bs).
+ * @note The byte select "bs" is encoded into the instruction word and has to be a literal constant (0..3).
+ **************************************************************************/
+/**@{*/
+/** AES final round encryption: SubBytes only */
+#define riscv_intrinsic_aes32esi(rs1, rs2, bs)  CUSTOM_INSTR_R3_TYPE(((((bs) & 3) << 5) | 0b10001), rs2, rs1, 0b000, 0b0110011)
+/** AES middle round encryption: SubBytes + partial MixColumns */
+#define riscv_intrinsic_aes32esmi(rs1, rs2, bs) CUSTOM_INSTR_R3_TYPE(((((bs) & 3) << 5) | 0b10011), rs2, rs1, 0b000, 0b0110011)
+/** AES final round decryption: InvSubBytes only */
+#define riscv_intrinsic_aes32dsi(rs1, rs2, bs)  CUSTOM_INSTR_R3_TYPE(((((bs) & 3) << 5) | 0b10101), rs2, rs1, 0b000, 0b0110011)
+/** AES middle round decryption: InvSubBytes + partial InvMixColumns */
+#define riscv_intrinsic_aes32dsmi(rs1, rs2, bs) CUSTOM_INSTR_R3_TYPE(((((bs) & 3) << 5) | 0b10111), rs2, rs1, 0b000, 0b0110011)
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Zknh: SHA-256 and SHA-512 (RV32) hash functions
+ **************************************************************************/
+/**@{*/
+/** SHA-256 Sigma0 (compression function) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha256sum0(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000100000000, rs1, 0b001, 0b0010011);
+}
+/** SHA-256 Sigma1 (compression function) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha256sum1(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000100000001, rs1, 0b001, 0b0010011);
+}
+/** SHA-256 sigma0 (message schedule) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha256sig0(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000100000010, rs1, 0b001, 0b0010011);
+}
+/** SHA-256 sigma1 (message schedule) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha256sig1(uint32_t rs1) {
+  return CUSTOM_INSTR_I_TYPE(0b000100000011, rs1, 0b001, 0b0010011);
+}
+/** SHA-512 Sigma0, one 32-bit half (rs1 = low/high word, rs2 = high/low word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sum0r(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101000, rs2, rs1, 0b000, 0b0110011);
+}
+/** SHA-512 Sigma1, one 32-bit half (rs1 = low/high word, rs2 = high/low word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sum1r(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101001, rs2, rs1, 0b000, 0b0110011);
+}
+/** SHA-512 sigma0, low word (rs1 = low word, rs2 = high word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sig0l(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101010, rs2, rs1, 0b000, 0b0110011);
+}
+/** SHA-512 sigma0, high word (rs1 = high word, rs2 = low word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sig0h(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101110, rs2, rs1, 0b000, 0b0110011);
+}
+/** SHA-512 sigma1, low word (rs1 = low word, rs2 = high word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sig1l(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101011, rs2, rs1, 0b000, 0b0110011);
+}
+/** SHA-512 sigma1, high word (rs1 = high word, rs2 = low word) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sha512sig1h(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0101111, rs2, rs1, 0b000, 0b0110011);
+}
+/**@}*/
+
+
+// ****************************************************************************************************************************
+// Packed-SIMD DSP Intrinsics (Zxpsimd, subset of the draft RISC-V 'P' extension)
+// These are available if the CPU_EXTENSION_RISCV_Zxpsimd generic is enabled (check the mxisa CSR).
+// ****************************************************************************************************************************
+
+/**********************************************************************//**
+ * @name Zxpsimd: Packed addition / subtraction (2x16-bit and 4x8-bit lanes)
+ *
+ * Prefixes: none = wrap-around, R = signed halving, UR = unsigned halving,
+ * K = signed saturating, UK = unsigned saturating.
+ **************************************************************************/
+/**@{*/
+/** 2x16-bit wrap-around addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_add16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0100000, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit wrap-around subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sub16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0100001, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit wrap-around addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_add8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0100100, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit wrap-around subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_sub8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0100101, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit signed halving addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_radd16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000000, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit signed halving subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_rsub16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000001, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit signed halving addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_radd8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000100, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit signed halving subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_rsub8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0000101, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit signed saturating addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_kadd16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0001000, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit signed saturating subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ksub16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0001001, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit signed saturating addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_kadd8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0001100, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit signed saturating subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ksub8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0001101, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit unsigned halving addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_uradd16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010000, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit unsigned halving subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ursub16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010001, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit unsigned halving addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_uradd8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010100, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit unsigned halving subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ursub8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0010101, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit unsigned saturating addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ukadd16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0011000, rs2, rs1, 0b000, 0b1110111);
+}
+/** 2x16-bit unsigned saturating subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_uksub16(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0011001, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit unsigned saturating addition */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_ukadd8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0011100, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit unsigned saturating subtraction */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_uksub8(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0011101, rs2, rs1, 0b000, 0b1110111);
+}
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Zxpsimd: Packed dot-products (multiply-accumulate)
+ **************************************************************************/
+/**@{*/
+/** 2x16-bit signed dot-product, saturated to int32: sat(rs1.h1*rs2.h1 + rs1.h0*rs2.h0) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_kmda(uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_TYPE(0b0011100, rs2, rs1, 0b001, 0b1110111);
+}
+/** 2x16-bit signed dot-product with accumulation, saturated to int32: sat(rd + rs1.h1*rs2.h1 + rs1.h0*rs2.h0) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_kmada(uint32_t rd, uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_ACC_TYPE(0b0100100, rd, rs2, rs1, 0b001, 0b1110111);
+}
+/** 4x8-bit signed dot-product with accumulation (wrap-around): rd + sum(rs1.b[i]*rs2.b[i]) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_smaqa(uint32_t rd, uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_ACC_TYPE(0b1100100, rd, rs2, rs1, 0b000, 0b1110111);
+}
+/** 4x8-bit unsigned dot-product with accumulation (wrap-around): rd + sum(rs1.b[i]*rs2.b[i]) */
+inline uint32_t __attribute__ ((always_inline)) riscv_intrinsic_umaqa(uint32_t rd, uint32_t rs1, uint32_t rs2) {
+  return CUSTOM_INSTR_R3_ACC_TYPE(0b1100110, rd, rs2, rs1, 0b000, 0b1110111);
+}
+/**@}*/
+
+
 #endif // neorv32_intrinsics_h
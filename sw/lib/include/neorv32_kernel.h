@@ -0,0 +1,120 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_kernel.h
+ * @brief Preemptive fixed-priority kernel (based on the NEORV32 RTE) - header file.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_kernel_h
+#define neorv32_kernel_h
+
+
+/**********************************************************************//**
+ * Maximum number of tasks (including the kernel's idle task).
+ **************************************************************************/
+#ifndef NEORV32_KERNEL_MAX_TASKS
+#define NEORV32_KERNEL_MAX_TASKS 8
+#endif
+
+
+/**********************************************************************//**
+ * Stack size of the kernel's idle task in bytes.
+ **************************************************************************/
+#ifndef NEORV32_KERNEL_IDLE_STACK
+#define NEORV32_KERNEL_IDLE_STACK 512
+#endif
+
+
+/**********************************************************************//**
+ * @name Task states
+ **************************************************************************/
+enum NEORV32_KERNEL_STATE_enum {
+  KERNEL_TASK_READY    = 0, /**< Task is ready to run (or running) */
+  KERNEL_TASK_BLOCKED  = 1, /**< Task is waiting for a semaphore/queue */
+  KERNEL_TASK_SLEEPING = 2, /**< Task is waiting for a number of ticks */
+  KERNEL_TASK_DONE     = 3  /**< Task has returned from its entry function */
+};
+
+
+/**********************************************************************//**
+ * Task control block.
+ **************************************************************************/
+typedef struct {
+  uint32_t frame;     /**< base address of the task's RTE context frame */
+  uint32_t pc;        /**< resume address */
+  uint32_t mpie;      /**< task's mstatus.MPIE (interrupt enable after resume) */
+  uint32_t prio;      /**< priority; 0 = idle task (lowest) */
+  volatile int state; /**< current state (#NEORV32_KERNEL_STATE_enum) */
+  uint32_t wake;      /**< wake-up tick (sleeping tasks) */
+  void *wait;         /**< object a blocked task is waiting for */
+  int id;             /**< task index */
+} neorv32_kernel_task_t;
+
+
+/**********************************************************************//**
+ * Counting semaphore.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t count; /**< current count */
+} neorv32_kernel_sem_t;
+
+
+/**********************************************************************//**
+ * Message queue (fixed-size items).
+ **************************************************************************/
+typedef struct {
+  uint8_t *buf;                /**< item buffer (num_items * item_size bytes) */
+  uint32_t item_size;          /**< size of one item in bytes */
+  uint32_t num_items;          /**< capacity in items */
+  uint32_t head;               /**< write index */
+  uint32_t tail;               /**< read index */
+  neorv32_kernel_sem_t items;  /**< number of items in queue */
+  neorv32_kernel_sem_t spaces; /**< number of free slots in queue */
+} neorv32_kernel_queue_t;
+
+
+/**********************************************************************//**
+ * The kernel installs its RTE trap handlers at runtime, which is not supported if the
+ * RTE is compiled with RTE_STATIC. Starting the kernel in this mode is a compile error.
+ **************************************************************************/
+#ifdef RTE_STATIC
+#define __NEORV32_KERNEL_RTE_DYNAMIC __attribute__((error("neorv32_kernel: not supported with RTE_STATIC")))
+#else
+#define __NEORV32_KERNEL_RTE_DYNAMIC
+#endif
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+int  neorv32_kernel_task_create(neorv32_kernel_task_t *task, void (*entry)(void *arg), void *arg, uint32_t prio, uint32_t *stack, uint32_t stack_size);
+void neorv32_kernel_start(uint32_t tick_cycles) __NEORV32_KERNEL_RTE_DYNAMIC;
+void neorv32_kernel_yield(void);
+void neorv32_kernel_sleep(uint32_t ticks);
+uint32_t neorv32_kernel_get_ticks(void);
+neorv32_kernel_task_t *neorv32_kernel_self(void);
+
+void neorv32_kernel_sem_init(neorv32_kernel_sem_t *sem, uint32_t count);
+void neorv32_kernel_sem_take(neorv32_kernel_sem_t *sem);
+int  neorv32_kernel_sem_try_take(neorv32_kernel_sem_t *sem);
+void neorv32_kernel_sem_give(neorv32_kernel_sem_t *sem);
+void neorv32_kernel_sem_give_isr(neorv32_kernel_sem_t *sem);
+
+void neorv32_kernel_queue_init(neorv32_kernel_queue_t *queue, void *buf, uint32_t item_size, uint32_t num_items);
+void neorv32_kernel_queue_send(neorv32_kernel_queue_t *queue, const void *item);
+void neorv32_kernel_queue_receive(neorv32_kernel_queue_t *queue, void *item);
+int  neorv32_kernel_queue_send_isr(neorv32_kernel_queue_t *queue, const void *item);
+int  neorv32_kernel_queue_receive_isr(neorv32_kernel_queue_t *queue, void *item);
+/**@}*/
+
+
+#endif // neorv32_kernel_h
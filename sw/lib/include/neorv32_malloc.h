@@ -0,0 +1,74 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_malloc.h
+ * @brief O(1) memory allocator (TLSF) and fixed-size block pools - header file.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_malloc_h
+#define neorv32_malloc_h
+
+
+/**********************************************************************//**
+ * @name Allocator configuration
+ **************************************************************************/
+/**@{*/
+/** Log2 of the number of second-level size classes per first-level class */
+#ifndef NEORV32_MALLOC_SL_LOG2
+#define NEORV32_MALLOC_SL_LOG2 3
+#endif
+/** Log2 of the largest supported block size (in bytes) */
+#ifndef NEORV32_MALLOC_FL_MAX
+#define NEORV32_MALLOC_FL_MAX 20
+#endif
+/**@}*/
+
+
+/**********************************************************************//**
+ * Allocator statistics.
+ **************************************************************************/
+typedef struct {
+  uint32_t heap_size;  /**< total heap size in bytes */
+  uint32_t used;       /**< currently allocated bytes (including block headers) */
+  uint32_t used_peak;  /**< maximum of used */
+  uint32_t num_malloc; /**< number of successful allocations */
+  uint32_t num_free;   /**< number of de-allocations */
+  uint32_t num_fail;   /**< number of failed allocations */
+} neorv32_malloc_stats_t;
+
+
+/**********************************************************************//**
+ * Fixed-size block pool.
+ **************************************************************************/
+typedef struct {
+  void *free_list;     /**< first free block */
+  uint32_t block_size; /**< block size in bytes */
+  uint32_t num_free;   /**< number of free blocks */
+} neorv32_pool_t;
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+void *neorv32_malloc(size_t size);
+void  neorv32_free(void *ptr);
+void *neorv32_calloc(size_t num, size_t size);
+void *neorv32_realloc(void *ptr, size_t size);
+void  neorv32_malloc_get_stats(neorv32_malloc_stats_t *stats);
+
+void  neorv32_pool_init(neorv32_pool_t *pool, void *buf, uint32_t block_size, uint32_t num_blocks);
+void *neorv32_pool_alloc(neorv32_pool_t *pool);
+void  neorv32_pool_free(neorv32_pool_t *pool, void *ptr);
+/**@}*/
+
+
+#endif // neorv32_malloc_h
@@ -0,0 +1,371 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_ringbuf.h
+ * @brief Lock-free ring buffers (header-only) for ISR <-> main-loop communication.
+ *
+ * @note All buffers store 32-bit entries; the number of entries has to be a power of two.
+ * Indices are free-running 32-bit counters.
+ *
+ * @note SPSC (single producer, single consumer): only aligned word loads/stores are used.
+ * MPSC (multiple producers, single consumer): producers claim slots via LR/SC (A ISA extension);
+ * without the A extension a short critical section (interrupts disabled) is used instead.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_ringbuf_h
+#define neorv32_ringbuf_h
+
+
+/**********************************************************************//**
+ * Compiler memory barrier (single hart: orders buffer accesses against index updates).
+ **************************************************************************/
+#define neorv32_ringbuf_barrier() asm volatile ("" : : : "memory")
+
+
+/**********************************************************************//**
+ * Single-producer single-consumer ring buffer.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t head; /**< write index (modified by producer only) */
+  volatile uint32_t tail; /**< read index (modified by consumer only) */
+  uint32_t mask;          /**< number of entries - 1 */
+  volatile uint32_t *buf; /**< entry buffer */
+} neorv32_spsc_t;
+
+
+/**********************************************************************//**
+ * Multi-producer single-consumer ring buffer slot.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t seq;  /**< index + 1 of the entry stored in this slot (= published) */
+  volatile uint32_t data; /**< entry */
+} neorv32_mpsc_slot_t;
+
+
+/**********************************************************************//**
+ * Multi-producer single-consumer ring buffer.
+ **************************************************************************/
+typedef struct {
+  volatile uint32_t head;    /**< claim index (modified by producers via LR/SC) */
+  volatile uint32_t tail;    /**< read index (modified by consumer only) */
+  uint32_t mask;             /**< number of slots - 1 */
+  neorv32_mpsc_slot_t *buf;  /**< slot buffer */
+} neorv32_mpsc_t;
+
+
+// #################################################################################################
+// SPSC
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * Initialize SPSC ring buffer.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_spsc_t).
+ * @param[in] buf Entry buffer (size words).
+ * @param[in] size Number of entries; has to be a power of two.
+ * @return 0 if success, -1 if size is not a power of two.
+ **************************************************************************/
+static inline int neorv32_spsc_init(neorv32_spsc_t *rb, uint32_t *buf, uint32_t size) {
+
+  if ((size == 0) || (size & (size - 1))) {
+    return -1;
+  }
+  rb->head = 0;
+  rb->tail = 0;
+  rb->mask = size - 1;
+  rb->buf  = buf;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Get number of entries in SPSC ring buffer.
+ *
+ * @param[in] rb Ring buffer handle (#neorv32_spsc_t).
+ * @return Number of available entries.
+ **************************************************************************/
+static inline uint32_t neorv32_spsc_count(neorv32_spsc_t *rb) {
+
+  return rb->head - rb->tail;
+}
+
+
+/**********************************************************************//**
+ * Get number of free entries in SPSC ring buffer.
+ *
+ * @param[in] rb Ring buffer handle (#neorv32_spsc_t).
+ * @return Number of free entries.
+ **************************************************************************/
+static inline uint32_t neorv32_spsc_space(neorv32_spsc_t *rb) {
+
+  return (rb->mask + 1) - (rb->head - rb->tail);
+}
+
+
+/**********************************************************************//**
+ * Push single entry to SPSC ring buffer (producer side).
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_spsc_t).
+ * @param[in] data Entry.
+ * @return 0 if success, -1 if buffer is full.
+ **************************************************************************/
+static inline int neorv32_spsc_push(neorv32_spsc_t *rb, uint32_t data) {
+
+  uint32_t head = rb->head;
+  if ((head - rb->tail) > rb->mask) {
+    return -1;
+  }
+  rb->buf[head & rb->mask] = data;
+  neorv32_ringbuf_barrier();
+  rb->head = head + 1; // publish
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Pop single entry from SPSC ring buffer (consumer side).
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_spsc_t).
+ * @param[out] data Entry.
+ * @return 0 if success, -1 if buffer is empty.
+ **************************************************************************/
+static inline int neorv32_spsc_pop(neorv32_spsc_t *rb, uint32_t *data) {
+
+  uint32_t tail = rb->tail;
+  if (rb->head == tail) {
+    return -1;
+  }
+  *data = rb->buf[tail & rb->mask];
+  neorv32_ringbuf_barrier();
+  rb->tail = tail + 1; // release
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Push multiple entries to SPSC ring buffer (producer side). The write
+ * index is updated only once.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_spsc_t).
+ * @param[in] data Source array.
+ * @param[in] num Number of entries to push.
+ * @return Number of entries actually pushed.
+ **************************************************************************/
+static inline uint32_t neorv32_spsc_push_batch(neorv32_spsc_t *rb, const uint32_t *data, uint32_t num) {
+
+  uint32_t head = rb->head;
+  uint32_t space = (rb->mask + 1) - (head - rb->tail);
+  if (num > space) {
+    num = space;
+  }
+  uint32_t i;
+  for (i=0; i<num; i++) {
+    rb->buf[(head + i) & rb->mask] = data[i];
+  }
+  neorv32_ringbuf_barrier();
+  rb->head = head + num;
+  return num;
+}
+
+
+/**********************************************************************//**
+ * Pop multiple entries from SPSC ring buffer (consumer side). The read
+ * index is updated only once.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_spsc_t).
+ * @param[out] data Destination array.
+ * @param[in] num Maximum number of entries to pop.
+ * @return Number of entries actually popped.
+ **************************************************************************/
+static inline uint32_t neorv32_spsc_pop_batch(neorv32_spsc_t *rb, uint32_t *data, uint32_t num) {
+
+  uint32_t tail = rb->tail;
+  uint32_t avail = rb->head - tail;
+  if (num > avail) {
+    num = avail;
+  }
+  uint32_t i;
+  for (i=0; i<num; i++) {
+    data[i] = rb->buf[(tail + i) & rb->mask];
+  }
+  neorv32_ringbuf_barrier();
+  rb->tail = tail + num;
+  return num;
+}
+
+
+// #################################################################################################
+// MPSC
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * Claim entries of MPSC ring buffer (advance head by up to num entries).
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[in,out] num Number of entries to claim; actual number of claimed entries.
+ * @return Index of the first claimed entry.
+ **************************************************************************/
+static inline uint32_t __neorv32_mpsc_claim(neorv32_mpsc_t *rb, uint32_t *num) {
+
+  uint32_t head, n;
+
+#if defined __riscv_atomic
+  while (1) {
+    head = neorv32_cpu_load_reservate_word((uint32_t)&rb->head);
+    n = (rb->mask + 1) - (head - rb->tail);
+    if (n > *num) {
+      n = *num;
+    }
+    if (neorv32_cpu_store_conditional_word((uint32_t)&rb->head, head + n) == 0) {
+      break;
+    }
+  }
+#else
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  head = rb->head;
+  n = (rb->mask + 1) - (head - rb->tail);
+  if (n > *num) {
+    n = *num;
+  }
+  rb->head = head + n;
+  neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+#endif
+
+  *num = n;
+  return head;
+}
+
+
+/**********************************************************************//**
+ * Initialize MPSC ring buffer.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[in] buf Slot buffer (size slots).
+ * @param[in] size Number of slots; has to be a power of two.
+ * @return 0 if success, -1 if size is not a power of two.
+ **************************************************************************/
+static inline int neorv32_mpsc_init(neorv32_mpsc_t *rb, neorv32_mpsc_slot_t *buf, uint32_t size) {
+
+  if ((size == 0) || (size & (size - 1))) {
+    return -1;
+  }
+  uint32_t i;
+  for (i=0; i<size; i++) {
+    buf[i].seq = 0; // index 0 is published when seq = 1
+  }
+  rb->head = 0;
+  rb->tail = 0;
+  rb->mask = size - 1;
+  rb->buf  = buf;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Push single entry to MPSC ring buffer (any producer, also from nested ISRs).
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[in] data Entry.
+ * @return 0 if success, -1 if buffer is full.
+ **************************************************************************/
+static inline int neorv32_mpsc_push(neorv32_mpsc_t *rb, uint32_t data) {
+
+  uint32_t num = 1;
+  uint32_t idx = __neorv32_mpsc_claim(rb, &num);
+  if (num == 0) {
+    return -1;
+  }
+  neorv32_mpsc_slot_t *slot = &rb->buf[idx & rb->mask];
+  slot->data = data;
+  neorv32_ringbuf_barrier();
+  slot->seq = idx + 1; // publish
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Push multiple entries to MPSC ring buffer (any producer). All entries
+ * are claimed with a single LR/SC sequence.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[in] data Source array.
+ * @param[in] num Number of entries to push.
+ * @return Number of entries actually pushed.
+ **************************************************************************/
+static inline uint32_t neorv32_mpsc_push_batch(neorv32_mpsc_t *rb, const uint32_t *data, uint32_t num) {
+
+  uint32_t idx = __neorv32_mpsc_claim(rb, &num);
+  uint32_t i;
+  for (i=0; i<num; i++) {
+    neorv32_mpsc_slot_t *slot = &rb->buf[(idx + i) & rb->mask];
+    slot->data = data[i];
+    neorv32_ringbuf_barrier();
+    slot->seq = idx + i + 1;
+  }
+  return num;
+}
+
+
+/**********************************************************************//**
+ * Pop single entry from MPSC ring buffer (consumer side).
+ *
+ * @note An entry that has been claimed but not yet published by its producer
+ * (e.g. a preempted producer) blocks all following entries until it is published.
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[out] data Entry.
+ * @return 0 if success, -1 if buffer is empty.
+ **************************************************************************/
+static inline int neorv32_mpsc_pop(neorv32_mpsc_t *rb, uint32_t *data) {
+
+  uint32_t tail = rb->tail;
+  neorv32_mpsc_slot_t *slot = &rb->buf[tail & rb->mask];
+  if (slot->seq != (tail + 1)) {
+    return -1;
+  }
+  neorv32_ringbuf_barrier();
+  *data = slot->data;
+  neorv32_ringbuf_barrier();
+  rb->tail = tail + 1; // release
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Pop multiple entries from MPSC ring buffer (consumer side).
+ *
+ * @param[in,out] rb Ring buffer handle (#neorv32_mpsc_t).
+ * @param[out] data Destination array.
+ * @param[in] num Maximum number of entries to pop.
+ * @return Number of entries actually popped.
+ **************************************************************************/
+static inline uint32_t neorv32_mpsc_pop_batch(neorv32_mpsc_t *rb, uint32_t *data, uint32_t num) {
+
+  uint32_t tail = rb->tail;
+  uint32_t i;
+  for (i=0; i<num; i++) {
+    neorv32_mpsc_slot_t *slot = &rb->buf[(tail + i) & rb->mask];
+    if (slot->seq != (tail + i + 1)) {
+      break;
+    }
+    neorv32_ringbuf_barrier();
+    data[i] = slot->data;
+  }
+  neorv32_ringbuf_barrier();
+  rb->tail = tail + i;
+  return i;
+}
+
+
+#endif // neorv32_ringbuf_h
@@ -59,6 +59,31 @@ enum NEORV32_RTE_TRAP_enum {
 };
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment: Static trap handler binding.
+ *
+ * If the RTE is compiled with RTE_STATIC (e.g. USER_FLAGS+=-DRTE_STATIC)
+ * the trap handlers are bound at compile/link time instead of using
+ * neorv32_rte_handler_install(). The RTE core then calls the handlers directly
+ * (no look-up table, no indirect call). Traps without a bound handler use
+ * the RTE debug handler.
+ *
+ * Example: void mti_handler(void) {...} NEORV32_RTE_HANDLER(RTE_TRAP_MTI, mti_handler);
+ * Example: void gptmr_handler(void) {...} NEORV32_RTE_HANDLER(GPTMR_RTE_ID, gptmr_handler);
+ *
+ * @note The handler function has to be defined in the same compilation unit
+ * before using this macro. Each trap ID can only be bound once.
+ *
+ * @param[in] id Trap ID (#NEORV32_RTE_TRAP_enum entry name, e.g. RTE_TRAP_MTI, or
+ * a macro expanding to one, e.g. GPTMR_RTE_ID).
+ * @param[in] handler Handler function (type "void function(void);").
+ **************************************************************************/
+#define NEORV32_RTE_HANDLER(id, handler) __NEORV32_RTE_HANDLER(id, handler)
+/** Helper for NEORV32_RTE_HANDLER: token pasting happens here, after "id" has been macro-expanded */
+#define __NEORV32_RTE_HANDLER(id, handler) \
+  void __neorv32_rte_handler_##id(void) __attribute__((alias(#handler)))
+
+
 /**********************************************************************//**
  * @name Prototypes
  **************************************************************************/
@@ -69,6 +69,8 @@ int     neorv32_sdi_put(uint8_t data);
 void    neorv32_sdi_put_nonblocking(uint8_t data);
 int     neorv32_sdi_get(uint8_t* data);
 uint8_t neorv32_sdi_get_nonblocking(void);
+int     neorv32_sdi_irq_rx(neorv32_spsc_t *rb);
+int     neorv32_sdi_irq_tx(neorv32_spsc_t *rb);
 /**@}*/
 
 
@@ -83,6 +83,8 @@ void     neorv32_slink_put(uint32_t tx_data);
 void     neorv32_slink_put_last(uint32_t tx_data);
 int      neorv32_slink_rx_status(void);
 int      neorv32_slink_tx_status(void);
+int      neorv32_slink_irq_rx(neorv32_spsc_t *rb);
+int      neorv32_slink_irq_tx(neorv32_spsc_t *rb);
 /**@}*/
 
 
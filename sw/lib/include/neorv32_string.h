@@ -0,0 +1,43 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_string.h
+ * @brief Optimized memory and string functions (word-at-a-time, Zbb, DMA) - header file.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#ifndef neorv32_string_h
+#define neorv32_string_h
+
+
+/**********************************************************************//**
+ * Minimal neorv32_memcpy() size in bytes to offload the copy to the DMA
+ * controller; 0 disables DMA offloading.
+ **************************************************************************/
+#ifndef NEORV32_STRING_DMA_MIN
+#define NEORV32_STRING_DMA_MIN 0
+#endif
+
+
+/**********************************************************************//**
+ * @name Prototypes
+ **************************************************************************/
+/**@{*/
+void  *neorv32_memcpy(void *dst, const void *src, size_t n);
+void  *neorv32_memmove(void *dst, const void *src, size_t n);
+void  *neorv32_memset(void *dst, int c, size_t n);
+int    neorv32_memcmp(const void *s1, const void *s2, size_t n);
+void  *neorv32_memchr(const void *s, int c, size_t n);
+size_t neorv32_strlen(const char *s);
+int    neorv32_strcmp(const char *s1, const char *s2);
+/**@}*/
+
+
+#endif // neorv32_string_h
@@ -40,6 +40,8 @@
 #define neorv32_uart0_puts(s)                      neorv32_uart_puts(NEORV32_UART0, s)
 #define neorv32_uart0_printf(...)                  neorv32_uart_printf(NEORV32_UART0, __VA_ARGS__)
 #define neorv32_uart0_scan(buffer, max_size, echo) neorv32_uart_scan(NEORV32_UART0, buffer, max_size, echo)
+#define neorv32_uart0_irq_rx(rb)                   neorv32_uart_irq_rx(NEORV32_UART0, rb)
+#define neorv32_uart0_irq_tx(rb)                   neorv32_uart_irq_tx(NEORV32_UART0, rb)
 /**@}*/
 
 /**********************************************************************//**
@@ -62,6 +64,8 @@
 #define neorv32_uart1_puts(s)                      neorv32_uart_puts(NEORV32_UART1, s)
 #define neorv32_uart1_printf(...)                  neorv32_uart_printf(NEORV32_UART1, __VA_ARGS__)
 #define neorv32_uart1_scan(buffer, max_size, echo) neorv32_uart_scan(NEORV32_UART1, buffer, max_size, echo)
+#define neorv32_uart1_irq_rx(rb)                   neorv32_uart_irq_rx(NEORV32_UART1, rb)
+#define neorv32_uart1_irq_tx(rb)                   neorv32_uart_irq_tx(NEORV32_UART1, rb)
 /**@}*/
 
 
@@ -152,6 +156,8 @@ void neorv32_uart_puts(neorv32_uart_t *UARTx, const char *s);
 void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args);
 void neorv32_uart_printf(neorv32_uart_t *UARTx, const char *format, ...);
 int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int echo);
+int  neorv32_uart_irq_rx(neorv32_uart_t *UARTx, neorv32_spsc_t *rb);
+int  neorv32_uart_irq_tx(neorv32_uart_t *UARTx, neorv32_spsc_t *rb);
 /**@}*/
 
 
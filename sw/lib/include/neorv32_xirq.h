@@ -33,12 +33,23 @@ typedef volatile struct __attribute__((packed,aligned(4))) {
 /**@}*/
 
 
+/**********************************************************************//**
+ * The XIRQ setup installs the XIRQ dispatcher as RTE trap handler at runtime, which is not
+ * supported if the RTE is compiled with RTE_STATIC. Using it in this mode is a compile error.
+ **************************************************************************/
+#ifdef RTE_STATIC
+#define __NEORV32_XIRQ_RTE_DYNAMIC __attribute__((error("neorv32_xirq: not supported with RTE_STATIC")))
+#else
+#define __NEORV32_XIRQ_RTE_DYNAMIC
+#endif
+
+
 /**********************************************************************//**
  * @name Prototypes
  **************************************************************************/
 /**@{*/
 int  neorv32_xirq_available(void);
-int  neorv32_xirq_setup(void);
+int  neorv32_xirq_setup(void) __NEORV32_XIRQ_RTE_DYNAMIC;
 void neorv32_xirq_global_enable(void);
 void neorv32_xirq_global_disable(void);
 int  neorv32_xirq_get_num(void);
@@ -0,0 +1,332 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_clmul.c
+ * @brief Carry-less multiplication kernels (CRC-32, CRC-32C, GHASH) using Zbc/Zbkc - source file.
+ *
+ * @note If the Zbc ISA extension is enabled via MARCH (__riscv_zbc) the kernels use clmul,
+ * clmulh and clmulr. With Zbkc only (__riscv_zbkc) clmulr is emulated using clmul and clmulh.
+ * Without any of these extensions the CRCs use a small (64 bytes) nibble table and GHASH
+ * uses a bit-serial software multiplication.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#include "neorv32.h"
+#include "neorv32_clmul.h"
+
+
+/**********************************************************************//**
+ * CRC polynomials (bit-reflected) and Barrett reduction constants
+ * (bit-reflected lower 32 bits of floor(x^64 / P(x))).
+ **************************************************************************/
+/**@{*/
+#define CRC32_POLY   0xEDB88320U /**< CRC-32 (IEEE 802.3) */
+#define CRC32_QT     0xFB808B20U /**< CRC-32 Barrett constant */
+#define CRC32C_POLY  0x82F63B78U /**< CRC-32C (Castagnoli) */
+#define CRC32C_QT    0x6F5389F8U /**< CRC-32C Barrett constant */
+/**@}*/
+
+
+#if defined __riscv_zbc || defined __riscv_zbkc
+/**********************************************************************//**
+ * Carry-less multiplication, lower half of the product (Zbc/Zbkc clmul).
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_clmul_lo(uint32_t a, uint32_t b) {
+  uint32_t res;
+  asm ("clmul %[rd], %[rs1], %[rs2]" : [rd] "=r" (res) : [rs1] "r" (a), [rs2] "r" (b));
+  return res;
+}
+
+/**********************************************************************//**
+ * Carry-less multiplication, upper half of the product (Zbc/Zbkc clmulh).
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_clmul_hi(uint32_t a, uint32_t b) {
+  uint32_t res;
+  asm ("clmulh %[rd], %[rs1], %[rs2]" : [rd] "=r" (res) : [rs1] "r" (a), [rs2] "r" (b));
+  return res;
+}
+#else
+/**********************************************************************//**
+ * Carry-less multiplication, lower half of the product (software).
+ **************************************************************************/
+static uint32_t __neorv32_clmul_lo(uint32_t a, uint32_t b) {
+  uint32_t res = 0;
+  int i;
+  for (i=0; i<32; i++) {
+    if ((b >> i) & 1) {
+      res ^= a << i;
+    }
+  }
+  return res;
+}
+
+/**********************************************************************//**
+ * Carry-less multiplication, upper half of the product (software).
+ **************************************************************************/
+static uint32_t __neorv32_clmul_hi(uint32_t a, uint32_t b) {
+  uint32_t res = 0;
+  int i;
+  for (i=1; i<32; i++) {
+    if ((b >> i) & 1) {
+      res ^= a >> (32 - i);
+    }
+  }
+  return res;
+}
+#endif
+
+
+/**********************************************************************//**
+ * Carry-less multiplication, product bits 62..31 (Zbc clmulr).
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_clmul_rev(uint32_t a, uint32_t b) {
+#if defined __riscv_zbc
+  uint32_t res;
+  asm ("clmulr %[rd], %[rs1], %[rs2]" : [rd] "=r" (res) : [rs1] "r" (a), [rs2] "r" (b));
+  return res;
+#else
+  return (__neorv32_clmul_hi(a, b) << 1) | (__neorv32_clmul_lo(a, b) >> 31);
+#endif
+}
+
+
+#if defined __riscv_zbc || defined __riscv_zbkc
+/**********************************************************************//**
+ * Barrett reduction of a 32-bit (bit-reflected) CRC remainder.
+ *
+ * @param[in] s CRC register XOR data word.
+ * @param[in] poly Bit-reflected polynomial.
+ * @param[in] qt Barrett constant.
+ * @return New CRC register.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_clmul_crc_reduce(uint32_t s, uint32_t poly, uint32_t qt) {
+  uint32_t tmp = (__neorv32_clmul_lo(s, qt) << 1) ^ s;
+  return __neorv32_clmul_rev(tmp, poly);
+}
+#else
+/** CRC-32 nibble table */
+static const uint32_t crc32_nibble_tab[16] = {
+  0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU, 0x76dc4190U, 0x6b6b51f4U, 0x4db26158U, 0x5005713cU,
+  0xedb88320U, 0xf00f9344U, 0xd6d6a3e8U, 0xcb61b38cU, 0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU
+};
+
+/** CRC-32C nibble table */
+static const uint32_t crc32c_nibble_tab[16] = {
+  0x00000000U, 0x105ec76fU, 0x20bd8edeU, 0x30e349b1U, 0x417b1dbcU, 0x5125dad3U, 0x61c69362U, 0x7198540dU,
+  0x82f63b78U, 0x92a8fc17U, 0xa24bb5a6U, 0xb21572c9U, 0xc38d26c4U, 0xd3d3e1abU, 0xe330a81aU, 0xf36e6f75U
+};
+#endif
+
+
+/**********************************************************************//**
+ * Bit-reflected 32-bit CRC (pre- and post-inverted).
+ *
+ * @param[in] crc Previous CRC value (0 for the first block).
+ * @param[in] p Data.
+ * @param[in] len Number of bytes.
+ * @param[in] poly Bit-reflected polynomial.
+ * @param[in] qt Barrett constant (Zbc/Zbkc only).
+ * @param[in] tab Nibble table (software only).
+ * @return Updated CRC value.
+ **************************************************************************/
+static uint32_t __neorv32_clmul_crc(uint32_t crc, const uint8_t *p, size_t len, uint32_t poly, uint32_t qt, const uint32_t *tab) {
+
+  crc = ~crc;
+
+#if defined __riscv_zbc || defined __riscv_zbkc
+  (void)tab;
+
+  while (len && ((uint32_t)p & 3)) { // single bytes until word-aligned
+    crc = (crc >> 8) ^ __neorv32_clmul_crc_reduce((crc ^ *p++) << 24, poly, qt);
+    len--;
+  }
+  while (len >= 4) { // aligned words
+    crc = __neorv32_clmul_crc_reduce(crc ^ *(const uint32_t*)p, poly, qt);
+    p += 4;
+    len -= 4;
+  }
+  while (len--) { // remaining bytes
+    crc = (crc >> 8) ^ __neorv32_clmul_crc_reduce((crc ^ *p++) << 24, poly, qt);
+  }
+#else
+  (void)poly;
+  (void)qt;
+
+  while (len--) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ tab[crc & 0xf];
+    crc = (crc >> 4) ^ tab[crc & 0xf];
+  }
+#endif
+
+  return ~crc;
+}
+
+
+/**********************************************************************//**
+ * Compute CRC-32 (IEEE 802.3 / zlib: polynomial 0x04C11DB7, reflected,
+ * initial value and final XOR 0xFFFFFFFF).
+ *
+ * @param[in] crc Previous CRC value (0 for the first block).
+ * @param[in] data Data.
+ * @param[in] len Number of bytes.
+ * @return Updated CRC value.
+ **************************************************************************/
+uint32_t neorv32_clmul_crc32(uint32_t crc, const void *data, size_t len) {
+
+#if defined __riscv_zbc || defined __riscv_zbkc
+  return __neorv32_clmul_crc(crc, (const uint8_t*)data, len, CRC32_POLY, CRC32_QT, NULL);
+#else
+  return __neorv32_clmul_crc(crc, (const uint8_t*)data, len, CRC32_POLY, CRC32_QT, crc32_nibble_tab);
+#endif
+}
+
+
+/**********************************************************************//**
+ * Compute CRC-32C (Castagnoli / iSCSI: polynomial 0x1EDC6F41, reflected,
+ * initial value and final XOR 0xFFFFFFFF).
+ *
+ * @param[in] crc Previous CRC value (0 for the first block).
+ * @param[in] data Data.
+ * @param[in] len Number of bytes.
+ * @return Updated CRC value.
+ **************************************************************************/
+uint32_t neorv32_clmul_crc32c(uint32_t crc, const void *data, size_t len) {
+
+#if defined __riscv_zbc || defined __riscv_zbkc
+  return __neorv32_clmul_crc(crc, (const uint8_t*)data, len, CRC32C_POLY, CRC32C_QT, NULL);
+#else
+  return __neorv32_clmul_crc(crc, (const uint8_t*)data, len, CRC32C_POLY, CRC32C_QT, crc32c_nibble_tab);
+#endif
+}
+
+
+/**********************************************************************//**
+ * Load big-endian word.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_clmul_load_be(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+
+/**********************************************************************//**
+ * Store big-endian word.
+ **************************************************************************/
+inline static void __attribute__((always_inline)) __neorv32_clmul_store_be(uint8_t *p, uint32_t w) {
+  p[0] = (uint8_t)(w >> 24);
+  p[1] = (uint8_t)(w >> 16);
+  p[2] = (uint8_t)(w >> 8);
+  p[3] = (uint8_t)w;
+}
+
+
+/**********************************************************************//**
+ * GF(2^128) multiplication in GCM bit order (word 0 = most significant
+ * big-endian word = lowest polynomial coefficients).
+ *
+ * @note The operands are bit-reflected polynomials. The carry-less product of
+ * two bit-reflected values is the bit-reflected product shifted right by one,
+ * which clmulr (product bits 62..31) compensates for free. The reduction modulo
+ * x^128 + x^7 + x^2 + x + 1 is done by shifts in the reflected domain.
+ *
+ * @param[in,out] r Result (4 words, may alias a or b).
+ * @param[in] a First operand (4 words).
+ * @param[in] b Second operand (4 words).
+ **************************************************************************/
+static void __neorv32_clmul_gf128(uint32_t *r, const uint32_t *a, const uint32_t *b) {
+
+  uint32_t z[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  int i, j;
+
+  // 256-bit product (left-shifted by one); z[0] = most significant word
+  for (i=0; i<4; i++) {
+    for (j=0; j<4; j++) {
+      z[i+j]   ^= __neorv32_clmul_rev(a[i], b[j]);
+      z[i+j+1] ^= __neorv32_clmul_lo(a[i], b[j]) << 1;
+    }
+  }
+
+  // fold bits beyond x^127 (lower half) into the upper half
+  uint32_t d0 = z[4] ^ (z[7] << 31) ^ (z[7] << 30) ^ (z[7] << 25);
+  uint32_t d1 = z[5];
+  uint32_t d2 = z[6];
+  uint32_t d3 = z[7];
+
+  r[0] = z[0] ^ d0 ^ (d0 >> 1) ^ (d0 >> 2) ^ (d0 >> 7);
+  r[1] = z[1] ^ d1 ^ ((d1 >> 1) | (d0 << 31)) ^ ((d1 >> 2) | (d0 << 30)) ^ ((d1 >> 7) | (d0 << 25));
+  r[2] = z[2] ^ d2 ^ ((d2 >> 1) | (d1 << 31)) ^ ((d2 >> 2) | (d1 << 30)) ^ ((d2 >> 7) | (d1 << 25));
+  r[3] = z[3] ^ d3 ^ ((d3 >> 1) | (d2 << 31)) ^ ((d3 >> 2) | (d2 << 30)) ^ ((d3 >> 7) | (d2 << 25));
+}
+
+
+/**********************************************************************//**
+ * GF(2^128) multiplication as used by GCM/GMAC (NIST SP 800-38D).
+ *
+ * @param[in,out] r Result (16 bytes, may alias a or b).
+ * @param[in] a First operand (16 bytes).
+ * @param[in] b Second operand (16 bytes).
+ **************************************************************************/
+void neorv32_clmul_gf128_mul(uint8_t *r, const uint8_t *a, const uint8_t *b) {
+
+  uint32_t wa[4], wb[4];
+  int i;
+
+  for (i=0; i<4; i++) {
+    wa[i] = __neorv32_clmul_load_be(&a[4*i]);
+    wb[i] = __neorv32_clmul_load_be(&b[4*i]);
+  }
+  __neorv32_clmul_gf128(wa, wa, wb);
+  for (i=0; i<4; i++) {
+    __neorv32_clmul_store_be(&r[4*i], wa[i]);
+  }
+}
+
+
+/**********************************************************************//**
+ * GHASH: Y = (Y ^ X_i) * H for all 16-byte blocks X_i of the data.
+ * A trailing partial block is zero-padded.
+ *
+ * @param[in,out] y Hash state (16 bytes; all-zero for a new hash).
+ * @param[in] h Hash subkey (16 bytes).
+ * @param[in] data Data.
+ * @param[in] len Number of bytes.
+ **************************************************************************/
+void neorv32_clmul_ghash(uint8_t *y, const uint8_t *h, const void *data, size_t len) {
+
+  const uint8_t *p = (const uint8_t*)data;
+  uint32_t wy[4], wh[4];
+  uint8_t tmp[16];
+  int i;
+
+  for (i=0; i<4; i++) {
+    wy[i] = __neorv32_clmul_load_be(&y[4*i]);
+    wh[i] = __neorv32_clmul_load_be(&h[4*i]);
+  }
+
+  while (len) {
+    if (len < 16) { // zero-padded partial block
+      for (i=0; i<16; i++) {
+        tmp[i] = (i < (int)len) ? p[i] : 0;
+      }
+      p = tmp;
+      len = 16;
+    }
+    for (i=0; i<4; i++) {
+      wy[i] ^= __neorv32_clmul_load_be(&p[4*i]);
+    }
+    __neorv32_clmul_gf128(wy, wy, wh);
+    p += 16;
+    len -= 16;
+  }
+
+  for (i=0; i<4; i++) {
+    __neorv32_clmul_store_be(&y[4*i], wy[i]);
+  }
+}
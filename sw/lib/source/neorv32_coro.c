@@ -0,0 +1,422 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_coro.c
+ * @brief Cooperative (stackful) coroutine scheduler - source file.
+ *
+ * @note Each coroutine runs on its own stack. A context switch only saves/restores
+ * the callee-saved registers (ra, s0..s11) as the switch is a regular function call.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#include "neorv32.h"
+#include "neorv32_coro.h"
+
+
+/**********************************************************************//**
+ * Size of the context frame on the coroutine stack in bytes
+ * (ra + callee-saved registers, rounded up to keep the stack 16-byte aligned).
+ **************************************************************************/
+#ifndef __riscv_32e
+#define CORO_FRAME_SIZE (16*4)
+#else
+#define CORO_FRAME_SIZE (4*4)
+#endif
+
+
+/**********************************************************************//**
+ * Peripheral events.
+ **************************************************************************/
+neorv32_coro_event_t neorv32_coro_event_uart0_rx;
+neorv32_coro_event_t neorv32_coro_event_dma;
+neorv32_coro_event_t neorv32_coro_event_gptmr;
+
+// private variables
+static neorv32_coro_t *__neorv32_coro_list = NULL;    // list of all coroutines
+static neorv32_coro_t *__neorv32_coro_current = NULL; // currently running coroutine
+static uint32_t __neorv32_coro_sched_sp;              // saved stack pointer of the scheduler
+
+// private functions
+static void __attribute__((__naked__,noinline)) __neorv32_coro_switch(uint32_t *save_sp, uint32_t new_sp);
+static void __attribute__((noreturn)) __neorv32_coro_trampoline(void);
+static int  __neorv32_coro_any_ready(void);
+static void __neorv32_coro_uart0_rx_handler(void);
+static void __neorv32_coro_dma_handler(void);
+static void __neorv32_coro_gptmr_handler(void);
+
+
+/**********************************************************************//**
+ * Create a new coroutine and add it to the scheduler.
+ *
+ * @param[in,out] coro Coroutine control block (#neorv32_coro_t).
+ * @param[in] entry Coroutine entry function (type "void function(void *arg);").
+ * @param[in] arg Argument for the entry function.
+ * @param[in] stack Base address of the coroutine's stack memory.
+ * @param[in] stack_size Size of the coroutine's stack memory in bytes.
+ **************************************************************************/
+void neorv32_coro_create(neorv32_coro_t *coro, void (*entry)(void *arg), void *arg, uint32_t *stack, uint32_t stack_size) {
+
+  // initial context frame at the (16-byte aligned) top of the stack
+  uint32_t top = ((uint32_t)stack + stack_size) & ~((uint32_t)15);
+  uint32_t *frame = (uint32_t*)(top - CORO_FRAME_SIZE);
+  int i;
+  for (i=0; i<(CORO_FRAME_SIZE/4); i++) {
+    frame[i] = 0;
+  }
+  frame[0] = (uint32_t)(&__neorv32_coro_trampoline); // "return address" of the first switch
+
+  coro->sp    = (uint32_t)frame;
+  coro->state = CORO_STATE_READY;
+  coro->entry = entry;
+  coro->arg   = arg;
+  coro->next  = NULL;
+
+  // append to scheduler list
+  if (__neorv32_coro_list == NULL) {
+    __neorv32_coro_list = coro;
+  }
+  else {
+    neorv32_coro_t *tmp = __neorv32_coro_list;
+    while (tmp->next != NULL) {
+      tmp = tmp->next;
+    }
+    tmp->next = coro;
+  }
+}
+
+
+/**********************************************************************//**
+ * Run the scheduler (round-robin) until all coroutines have finished.
+ * The CPU is put to sleep (wfi) if all coroutines are waiting for events.
+ *
+ * @note Events from interrupt handlers require the according interrupt
+ * channels to be enabled and global interrupts (mstatus.mie) to be enabled.
+ **************************************************************************/
+void neorv32_coro_run(void) {
+
+  neorv32_coro_t *coro;
+  int active;
+  uint32_t mstatus;
+
+  while (1) {
+
+    // one pass over all coroutines
+    active = 0;
+    for (coro = __neorv32_coro_list; coro != NULL; coro = coro->next) {
+      if (coro->state == CORO_STATE_READY) {
+        __neorv32_coro_current = coro;
+        __neorv32_coro_switch(&__neorv32_coro_sched_sp, coro->sp);
+        __neorv32_coro_current = NULL;
+      }
+      if (coro->state != CORO_STATE_DONE) {
+        active = 1;
+      }
+    }
+
+    if (active == 0) {
+      break; // all coroutines have finished
+    }
+
+    // go to sleep if there is nothing to do; the wake-up interrupt
+    // is taken as soon as global interrupts are re-enabled
+    mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    if (__neorv32_coro_any_ready() == 0) {
+      asm volatile ("wfi");
+    }
+    neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+  }
+
+  __neorv32_coro_list = NULL;
+}
+
+
+/**********************************************************************//**
+ * Give control back to the scheduler. Has no effect if not called from
+ * within a coroutine.
+ **************************************************************************/
+void neorv32_coro_yield(void) {
+
+  neorv32_coro_t *self = __neorv32_coro_current;
+  if (self != NULL) {
+    __neorv32_coro_switch(&self->sp, __neorv32_coro_sched_sp);
+  }
+}
+
+
+/**********************************************************************//**
+ * Get currently running coroutine.
+ *
+ * @return Pointer to the current coroutine's control block; NULL if not called from within a coroutine.
+ **************************************************************************/
+neorv32_coro_t *neorv32_coro_self(void) {
+
+  return __neorv32_coro_current;
+}
+
+
+/**********************************************************************//**
+ * Initialize event.
+ *
+ * @param[in,out] event Event handle (#neorv32_coro_event_t).
+ **************************************************************************/
+void neorv32_coro_event_init(neorv32_coro_event_t *event) {
+
+  event->pending = 0;
+  event->waiter  = NULL;
+}
+
+
+/**********************************************************************//**
+ * Wait for event. The calling coroutine is suspended until the event
+ * is signaled. Returns immediately if the event is already pending.
+ * If not called from within a coroutine the CPU sleeps until the event
+ * is signaled.
+ *
+ * @note Only one coroutine can wait for a specific event at a time.
+ *
+ * @param[in,out] event Event handle (#neorv32_coro_event_t).
+ **************************************************************************/
+void neorv32_coro_wait(neorv32_coro_event_t *event) {
+
+  neorv32_coro_t *self = __neorv32_coro_current;
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+
+  if (self == NULL) { // not within a coroutine
+    // check and sleep with interrupts disabled so a signal cannot get lost in between;
+    // the wake-up interrupt is taken as soon as global interrupts are re-enabled
+    while (1) {
+      neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+      if (event->pending != 0) {
+        break;
+      }
+      asm volatile ("wfi");
+      neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+    }
+    neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+  }
+  else {
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    if (event->pending == 0) {
+      event->waiter = self;
+      self->state = CORO_STATE_WAITING;
+      neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+      __neorv32_coro_switch(&self->sp, __neorv32_coro_sched_sp); // resumed after signal
+    }
+    neorv32_cpu_csr_set(CSR_MSTATUS, mstatus & (1 << CSR_MSTATUS_MIE));
+  }
+
+  event->pending = 0;
+}
+
+
+/**********************************************************************//**
+ * Signal event. Can be called from coroutines and interrupt handlers.
+ *
+ * @param[in,out] event Event handle (#neorv32_coro_event_t).
+ **************************************************************************/
+void neorv32_coro_signal(neorv32_coro_event_t *event) {
+
+  event->pending = 1;
+
+  neorv32_coro_t *waiter = event->waiter;
+  if (waiter != NULL) {
+    event->waiter = NULL;
+    waiter->state = CORO_STATE_READY;
+  }
+}
+
+
+/**********************************************************************//**
+ * Install RTE handlers for the peripheral events (UART0 RX, DMA, GPTMR).
+ * The according interrupt channels are enabled by the await functions.
+ *
+ * @note The RTE has to be initialized before. This is not supported if the
+ * RTE is compiled with RTE_STATIC.
+ **************************************************************************/
+void neorv32_coro_irq_setup(void) {
+
+  neorv32_coro_event_init(&neorv32_coro_event_uart0_rx);
+  neorv32_coro_event_init(&neorv32_coro_event_dma);
+  neorv32_coro_event_init(&neorv32_coro_event_gptmr);
+
+  neorv32_rte_handler_install(UART0_RX_RTE_ID, __neorv32_coro_uart0_rx_handler);
+  neorv32_rte_handler_install(DMA_RTE_ID, __neorv32_coro_dma_handler);
+  neorv32_rte_handler_install(GPTMR_RTE_ID, __neorv32_coro_gptmr_handler);
+}
+
+
+/**********************************************************************//**
+ * Get char from UART0; suspends the calling coroutine until data is available.
+ *
+ * @note Requires neorv32_coro_irq_setup().
+ *
+ * @return Received char.
+ **************************************************************************/
+char neorv32_coro_uart0_getc(void) {
+
+  while (neorv32_uart0_char_received() == 0) {
+    NEORV32_UART0->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_RX_NEMPTY);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << UART0_RX_FIRQ_ENABLE);
+    neorv32_coro_wait(&neorv32_coro_event_uart0_rx);
+  }
+  return neorv32_uart0_char_received_get();
+}
+
+
+/**********************************************************************//**
+ * Wait for the current DMA transfer to complete; suspends the calling coroutine.
+ *
+ * @note Requires neorv32_coro_irq_setup().
+ *
+ * @return DMA status after transfer (#NEORV32_DMA_STATUS_enum).
+ **************************************************************************/
+int neorv32_coro_dma_wait(void) {
+
+  while (neorv32_dma_status() == DMA_STATUS_BUSY) {
+    neorv32_cpu_csr_set(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+    neorv32_coro_wait(&neorv32_coro_event_dma);
+  }
+  return neorv32_dma_status();
+}
+
+
+/**********************************************************************//**
+ * Wait for the next GPTMR timer match; suspends the calling coroutine.
+ * The GPTMR has to be configured (with match interrupt enabled) before.
+ *
+ * @note Requires neorv32_coro_irq_setup().
+ **************************************************************************/
+void neorv32_coro_gptmr_wait(void) {
+
+  neorv32_cpu_csr_set(CSR_MIE, 1 << GPTMR_FIRQ_ENABLE);
+  neorv32_coro_wait(&neorv32_coro_event_gptmr);
+}
+
+
+/**********************************************************************//**
+ * Context switch: save callee-saved registers and stack pointer of the
+ * current context and restore the new context.
+ *
+ * @param[in,out] save_sp Stack pointer of the current context is stored here (a0).
+ * @param[in] new_sp Stack pointer of the context to switch to (a1).
+ **************************************************************************/
+static void __attribute__((__naked__,noinline)) __neorv32_coro_switch(uint32_t *save_sp, uint32_t new_sp) {
+
+  asm volatile (
+#ifndef __riscv_32e
+    "addi sp, sp, -16*4 \n"
+#else
+    "addi sp, sp, -4*4  \n"
+#endif
+    "sw ra,   0*4(sp) \n"
+    "sw s0,   1*4(sp) \n"
+    "sw s1,   2*4(sp) \n"
+#ifndef __riscv_32e
+    "sw s2,   3*4(sp) \n"
+    "sw s3,   4*4(sp) \n"
+    "sw s4,   5*4(sp) \n"
+    "sw s5,   6*4(sp) \n"
+    "sw s6,   7*4(sp) \n"
+    "sw s7,   8*4(sp) \n"
+    "sw s8,   9*4(sp) \n"
+    "sw s9,  10*4(sp) \n"
+    "sw s10, 11*4(sp) \n"
+    "sw s11, 12*4(sp) \n"
+#endif
+
+    "sw sp, 0(a0)     \n" // save current stack pointer
+    "mv sp, a1        \n" // switch stack
+
+    "lw ra,   0*4(sp) \n"
+    "lw s0,   1*4(sp) \n"
+    "lw s1,   2*4(sp) \n"
+#ifndef __riscv_32e
+    "lw s2,   3*4(sp) \n"
+    "lw s3,   4*4(sp) \n"
+    "lw s4,   5*4(sp) \n"
+    "lw s5,   6*4(sp) \n"
+    "lw s6,   7*4(sp) \n"
+    "lw s7,   8*4(sp) \n"
+    "lw s8,   9*4(sp) \n"
+    "lw s9,  10*4(sp) \n"
+    "lw s10, 11*4(sp) \n"
+    "lw s11, 12*4(sp) \n"
+    "addi sp, sp, 16*4 \n"
+#else
+    "addi sp, sp, 4*4  \n"
+#endif
+    "ret              \n"
+  );
+}
+
+
+/**********************************************************************//**
+ * First function executed by a new coroutine.
+ **************************************************************************/
+static void __attribute__((noreturn)) __neorv32_coro_trampoline(void) {
+
+  neorv32_coro_t *self = __neorv32_coro_current;
+
+  self->entry(self->arg);
+
+  // coroutine has finished; never resumed again
+  self->state = CORO_STATE_DONE;
+  __neorv32_coro_switch(&self->sp, __neorv32_coro_sched_sp);
+  while(1);
+}
+
+
+/**********************************************************************//**
+ * Check if any coroutine is ready to run.
+ *
+ * @return 1 if at least one coroutine is ready, 0 otherwise.
+ **************************************************************************/
+static int __neorv32_coro_any_ready(void) {
+
+  neorv32_coro_t *coro;
+  for (coro = __neorv32_coro_list; coro != NULL; coro = coro->next) {
+    if (coro->state == CORO_STATE_READY) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * UART0 RX interrupt handler: the RX interrupt is level-triggered (RX FIFO
+ * not empty), so the channel is disabled until the next await.
+ **************************************************************************/
+static void __neorv32_coro_uart0_rx_handler(void) {
+
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << UART0_RX_FIRQ_ENABLE);
+  neorv32_coro_signal(&neorv32_coro_event_uart0_rx);
+}
+
+
+/**********************************************************************//**
+ * DMA interrupt handler.
+ **************************************************************************/
+static void __neorv32_coro_dma_handler(void) {
+
+  NEORV32_DMA->CTRL &= ~((uint32_t)(1 << DMA_CTRL_DONE)); // clear DMA-done interrupt
+  neorv32_coro_signal(&neorv32_coro_event_dma);
+}
+
+
+/**********************************************************************//**
+ * GPTMR interrupt handler.
+ **************************************************************************/
+static void __neorv32_coro_gptmr_handler(void) {
+
+  neorv32_gptmr_trigger_matched(); // clear timer-match interrupt
+  neorv32_coro_signal(&neorv32_coro_event_gptmr);
+}
@@ -151,3 +151,77 @@ int neorv32_dma_done(void) {
     return 0; // no transfer executed
   }
 }
+
+
+/**********************************************************************//**
+ * Get d-cache block size for the buffer maintenance functions.
+ *
+ * @return Block size in bytes; 0 if cache-block operations are not available.
+ **************************************************************************/
+static uint32_t neorv32_dma_cache_block_size(void) {
+
+  if (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICBOM)) {
+    return (uint32_t)(1 << ((NEORV32_SYSINFO->CACHE >> SYSINFO_CACHE_DATA_BLOCK_SIZE_0) & 0x0F));
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Write back all modified d-cache blocks of a buffer before the DMA reads it.
+ * Other cache contents are not affected.
+ *
+ * @note Falls back to a full cache flush (fence) if the Zicbom ISA extension is not available.
+ *
+ * @param[in] base Buffer base address.
+ * @param[in] size Buffer size in bytes.
+ **************************************************************************/
+void neorv32_dma_cache_clean(uint32_t base, uint32_t size) {
+
+  uint32_t bsize = neorv32_dma_cache_block_size();
+  uint32_t addr;
+
+  if (bsize == 0) {
+    asm volatile ("fence");
+    return;
+  }
+
+  for (addr = base & ~(bsize - 1); addr < (base + size); addr += bsize) {
+    neorv32_cpu_cbo_clean(addr);
+  }
+}
+
+
+/**********************************************************************//**
+ * Invalidate all d-cache blocks of a buffer after the DMA has written it, so
+ * the CPU re-fetches the new data from main memory. Other cache contents are not affected.
+ *
+ * @note Blocks that are only partially covered by the buffer are flushed (written back and
+ * invalidated) to preserve adjacent data. Hence, these blocks must not be modified by the CPU
+ * while the DMA transfer is in progress. Falls back to a full cache flush (fence) if the Zicbom
+ * ISA extension is not available.
+ *
+ * @param[in] base Buffer base address.
+ * @param[in] size Buffer size in bytes.
+ **************************************************************************/
+void neorv32_dma_cache_inval(uint32_t base, uint32_t size) {
+
+  uint32_t bsize = neorv32_dma_cache_block_size();
+  uint32_t addr, end = base + size;
+
+  if (bsize == 0) {
+    asm volatile ("fence");
+    return;
+  }
+
+  for (addr = base & ~(bsize - 1); addr < end; addr += bsize) {
+    if ((addr < base) || ((addr + bsize) > end)) { // partially covered block
+      neorv32_cpu_cbo_flush(addr);
+    }
+    else {
+      neorv32_cpu_cbo_inval(addr);
+    }
+  }
+}
@@ -0,0 +1,600 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_kernel.c
+ * @brief Preemptive fixed-priority kernel (based on the NEORV32 RTE) - source file.
+ *
+ * @note The kernel does not have its own context save/restore: the RTE core
+ * already stores the entire context of the interrupted task to the task's stack
+ * and restores the context from the frame pointed to by mscratch. A context
+ * switch just replaces mscratch (and mepc) by the frame (and resume address) of
+ * the next task. The kernel uses the MTIME interrupt for the system tick and the
+ * machine-mode environment call (ECALL) to enter the kernel from task context.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#include "neorv32.h"
+#include "neorv32_kernel.h"
+
+
+/**********************************************************************//**
+ * Size of the RTE context frame in bytes.
+ **************************************************************************/
+#ifndef __riscv_32e
+#define KERNEL_FRAME_SIZE (32*4)
+#else
+#define KERNEL_FRAME_SIZE (16*4)
+#endif
+
+// private variables
+static neorv32_kernel_task_t *__neorv32_kernel_task[NEORV32_KERNEL_MAX_TASKS]; // all tasks
+static int __neorv32_kernel_num_tasks = 0;                                     // number of tasks
+static neorv32_kernel_task_t *__neorv32_kernel_current = NULL;                 // currently running task
+static volatile uint32_t __neorv32_kernel_ticks = 0;                           // system tick counter
+static uint32_t __neorv32_kernel_tick_cycles;                                  // tick period in clock cycles
+static neorv32_kernel_task_t __neorv32_kernel_idle_task;                       // idle task
+static uint32_t __neorv32_kernel_idle_stack[NEORV32_KERNEL_IDLE_STACK/4] __attribute__((aligned(16)));
+
+// private functions
+static void __neorv32_kernel_tick_handler(void);
+static void __neorv32_kernel_ecall_handler(void);
+static void __neorv32_kernel_switch(int rotate);
+static neorv32_kernel_task_t *__neorv32_kernel_select(int rotate);
+static neorv32_kernel_task_t *__neorv32_kernel_wake(void *object);
+static uint32_t __neorv32_kernel_mepc_adj(void);
+static void __neorv32_kernel_task_exit(void);
+static void __neorv32_kernel_idle(void *arg);
+
+
+/**********************************************************************//**
+ * Enter critical section (disable interrupts).
+ *
+ * @return Previous interrupt enable state.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_kernel_lock(void) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  return mstatus & (1 << CSR_MSTATUS_MIE);
+}
+
+
+/**********************************************************************//**
+ * Leave critical section (restore interrupt enable state).
+ *
+ * @param[in] state Interrupt enable state returned by #__neorv32_kernel_lock.
+ **************************************************************************/
+inline static void __attribute__((always_inline)) __neorv32_kernel_unlock(uint32_t state) {
+
+  neorv32_cpu_csr_set(CSR_MSTATUS, state);
+}
+
+
+/**********************************************************************//**
+ * Enter kernel from task context (the kernel's ECALL handler re-schedules).
+ **************************************************************************/
+inline static void __attribute__((always_inline)) __neorv32_kernel_enter(void) {
+
+  asm volatile ("ecall" : : : "memory");
+}
+
+
+/**********************************************************************//**
+ * Create a new task.
+ *
+ * @note Interrupt handlers are executed on the stack of the interrupted task,
+ * so each task stack has to provide space for the RTE context frame and the
+ * stack usage of the interrupt handlers.
+ *
+ * @param[in,out] task Task control block (#neorv32_kernel_task_t).
+ * @param[in] entry Task entry function (type "void function(void *arg);").
+ * @param[in] arg Argument for the entry function.
+ * @param[in] prio Task priority (higher value = higher priority; 0 is reserved for the idle task).
+ * @param[in] stack Base address of the task's stack memory.
+ * @param[in] stack_size Size of the task's stack memory in bytes.
+ * @return 0 if success, -1 if error (too many tasks or stack too small).
+ **************************************************************************/
+int neorv32_kernel_task_create(neorv32_kernel_task_t *task, void (*entry)(void *arg), void *arg, uint32_t prio, uint32_t *stack, uint32_t stack_size) {
+
+  if ((__neorv32_kernel_num_tasks >= NEORV32_KERNEL_MAX_TASKS) || (stack_size < (2*KERNEL_FRAME_SIZE))) {
+    return -1;
+  }
+
+  // initial RTE context frame at the (16-byte aligned) top of the stack
+  uint32_t top = ((uint32_t)stack + stack_size) & ~((uint32_t)15);
+  uint32_t *frame = (uint32_t*)(top - KERNEL_FRAME_SIZE);
+  uint32_t gp, tp;
+  int i;
+
+  asm volatile ("mv %[gp], gp" : [gp] "=r" (gp));
+  asm volatile ("mv %[tp], tp" : [tp] "=r" (tp));
+  for (i=0; i<(KERNEL_FRAME_SIZE/4); i++) {
+    frame[i] = 0;
+  }
+  frame[1]  = (uint32_t)(&__neorv32_kernel_task_exit); // ra: return from entry function
+  frame[2]  = top; // sp
+  frame[3]  = gp;
+  frame[4]  = tp;
+  frame[10] = (uint32_t)arg; // a0
+
+  task->frame = (uint32_t)frame;
+  task->pc    = (uint32_t)entry;
+  task->mpie  = 1 << CSR_MSTATUS_MPIE; // interrupts enabled
+  task->prio  = prio;
+  task->state = KERNEL_TASK_READY;
+  task->wake  = 0;
+  task->wait  = NULL;
+
+  uint32_t irq = __neorv32_kernel_lock();
+  task->id = __neorv32_kernel_num_tasks;
+  __neorv32_kernel_task[__neorv32_kernel_num_tasks++] = task;
+  __neorv32_kernel_unlock(irq);
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Start kernel. This function does not return; the main() context is discarded.
+ *
+ * @note The RTE has to be initialized before (not supported if the RTE is compiled
+ * with RTE_STATIC). The kernel takes over the MTI and MENV_CALL trap handlers.
+ *
+ * @param[in] tick_cycles System tick period in clock cycles.
+ **************************************************************************/
+void neorv32_kernel_start(uint32_t tick_cycles) {
+
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  // idle task
+  neorv32_kernel_task_create(&__neorv32_kernel_idle_task, __neorv32_kernel_idle, NULL, 0,
+                             __neorv32_kernel_idle_stack, sizeof(__neorv32_kernel_idle_stack));
+
+  // kernel entries
+  neorv32_rte_handler_install(RTE_TRAP_MTI, __neorv32_kernel_tick_handler);
+  neorv32_rte_handler_install(RTE_TRAP_MENV_CALL, __neorv32_kernel_ecall_handler);
+
+  // system tick
+  __neorv32_kernel_tick_cycles = tick_cycles;
+  neorv32_mtime_set_timecmp(neorv32_mtime_get_time() + tick_cycles);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MTIE);
+
+  // switch to the first task
+  __neorv32_kernel_current = NULL;
+  __neorv32_kernel_enter();
+
+  while(1); // should never be reached
+}
+
+
+/**********************************************************************//**
+ * Give CPU to the next ready task of the same (or higher) priority.
+ **************************************************************************/
+void neorv32_kernel_yield(void) {
+
+  __neorv32_kernel_enter();
+}
+
+
+/**********************************************************************//**
+ * Suspend the calling task for a number of system ticks.
+ *
+ * @param[in] ticks Number of ticks to sleep (0 = yield).
+ **************************************************************************/
+void neorv32_kernel_sleep(uint32_t ticks) {
+
+  uint32_t irq = __neorv32_kernel_lock();
+  if (ticks != 0) {
+    __neorv32_kernel_current->wake  = __neorv32_kernel_ticks + ticks;
+    __neorv32_kernel_current->state = KERNEL_TASK_SLEEPING;
+  }
+  __neorv32_kernel_enter();
+  __neorv32_kernel_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Get number of system ticks since kernel start.
+ *
+ * @return System ticks.
+ **************************************************************************/
+uint32_t neorv32_kernel_get_ticks(void) {
+
+  return __neorv32_kernel_ticks;
+}
+
+
+/**********************************************************************//**
+ * Get currently running task.
+ *
+ * @return Pointer to the current task's control block.
+ **************************************************************************/
+neorv32_kernel_task_t *neorv32_kernel_self(void) {
+
+  return __neorv32_kernel_current;
+}
+
+
+/**********************************************************************//**
+ * Initialize semaphore.
+ *
+ * @param[in,out] sem Semaphore handle (#neorv32_kernel_sem_t).
+ * @param[in] count Initial count.
+ **************************************************************************/
+void neorv32_kernel_sem_init(neorv32_kernel_sem_t *sem, uint32_t count) {
+
+  sem->count = count;
+}
+
+
+/**********************************************************************//**
+ * Take semaphore; blocks the calling task until the semaphore is available.
+ * Task context only.
+ *
+ * @param[in,out] sem Semaphore handle (#neorv32_kernel_sem_t).
+ **************************************************************************/
+void neorv32_kernel_sem_take(neorv32_kernel_sem_t *sem) {
+
+  uint32_t irq = __neorv32_kernel_lock();
+  while (sem->count == 0) {
+    __neorv32_kernel_current->wait  = (void*)sem;
+    __neorv32_kernel_current->state = KERNEL_TASK_BLOCKED;
+    __neorv32_kernel_enter(); // resumed with interrupts still disabled
+  }
+  sem->count--;
+  __neorv32_kernel_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Try to take semaphore (non-blocking). Task and interrupt context.
+ *
+ * @param[in,out] sem Semaphore handle (#neorv32_kernel_sem_t).
+ * @return 0 if semaphore was taken, -1 if semaphore is not available.
+ **************************************************************************/
+int neorv32_kernel_sem_try_take(neorv32_kernel_sem_t *sem) {
+
+  int rc = -1;
+  uint32_t irq = __neorv32_kernel_lock();
+  if (sem->count != 0) {
+    sem->count--;
+    rc = 0;
+  }
+  __neorv32_kernel_unlock(irq);
+  return rc;
+}
+
+
+/**********************************************************************//**
+ * Give semaphore. Switches to the woken task if it has a higher priority.
+ * Task context only.
+ *
+ * @param[in,out] sem Semaphore handle (#neorv32_kernel_sem_t).
+ **************************************************************************/
+void neorv32_kernel_sem_give(neorv32_kernel_sem_t *sem) {
+
+  uint32_t irq = __neorv32_kernel_lock();
+  sem->count++;
+  neorv32_kernel_task_t *task = __neorv32_kernel_wake((void*)sem);
+  __neorv32_kernel_unlock(irq);
+
+  if ((task != NULL) && (task->prio > __neorv32_kernel_current->prio)) {
+    __neorv32_kernel_enter();
+  }
+}
+
+
+/**********************************************************************//**
+ * Give semaphore from an interrupt handler (installed via the RTE).
+ * The woken task is executed right after the handler if it has a higher
+ * priority than the interrupted task.
+ *
+ * @param[in,out] sem Semaphore handle (#neorv32_kernel_sem_t).
+ **************************************************************************/
+void neorv32_kernel_sem_give_isr(neorv32_kernel_sem_t *sem) {
+
+  sem->count++;
+  neorv32_kernel_task_t *task = __neorv32_kernel_wake((void*)sem);
+
+  if ((task != NULL) && (task->prio > __neorv32_kernel_current->prio)) {
+    __neorv32_kernel_switch(0);
+  }
+}
+
+
+/**********************************************************************//**
+ * Initialize message queue.
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[in] buf Item buffer (at least item_size * num_items bytes).
+ * @param[in] item_size Size of one item in bytes.
+ * @param[in] num_items Capacity of the queue in items.
+ **************************************************************************/
+void neorv32_kernel_queue_init(neorv32_kernel_queue_t *queue, void *buf, uint32_t item_size, uint32_t num_items) {
+
+  queue->buf       = (uint8_t*)buf;
+  queue->item_size = item_size;
+  queue->num_items = num_items;
+  queue->head      = 0;
+  queue->tail      = 0;
+  neorv32_kernel_sem_init(&queue->items, 0);
+  neorv32_kernel_sem_init(&queue->spaces, num_items);
+}
+
+
+/**********************************************************************//**
+ * Copy item into queue (space has to be reserved before).
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[in] item Item to be copied.
+ **************************************************************************/
+static void __neorv32_kernel_queue_put(neorv32_kernel_queue_t *queue, const void *item) {
+
+  uint32_t i, irq = __neorv32_kernel_lock();
+  uint8_t *dst = queue->buf + (queue->head * queue->item_size);
+  const uint8_t *src = (const uint8_t*)item;
+  for (i=0; i<queue->item_size; i++) {
+    dst[i] = src[i];
+  }
+  queue->head = (queue->head + 1 == queue->num_items) ? 0 : queue->head + 1;
+  __neorv32_kernel_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Copy item out of queue (item has to be reserved before).
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[out] item Item buffer.
+ **************************************************************************/
+static void __neorv32_kernel_queue_get(neorv32_kernel_queue_t *queue, void *item) {
+
+  uint32_t i, irq = __neorv32_kernel_lock();
+  const uint8_t *src = queue->buf + (queue->tail * queue->item_size);
+  uint8_t *dst = (uint8_t*)item;
+  for (i=0; i<queue->item_size; i++) {
+    dst[i] = src[i];
+  }
+  queue->tail = (queue->tail + 1 == queue->num_items) ? 0 : queue->tail + 1;
+  __neorv32_kernel_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Send item to queue; blocks while the queue is full. Task context only.
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[in] item Item to be sent (item_size bytes are copied).
+ **************************************************************************/
+void neorv32_kernel_queue_send(neorv32_kernel_queue_t *queue, const void *item) {
+
+  neorv32_kernel_sem_take(&queue->spaces);
+  __neorv32_kernel_queue_put(queue, item);
+  neorv32_kernel_sem_give(&queue->items);
+}
+
+
+/**********************************************************************//**
+ * Receive item from queue; blocks while the queue is empty. Task context only.
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[out] item Item buffer (item_size bytes are copied).
+ **************************************************************************/
+void neorv32_kernel_queue_receive(neorv32_kernel_queue_t *queue, void *item) {
+
+  neorv32_kernel_sem_take(&queue->items);
+  __neorv32_kernel_queue_get(queue, item);
+  neorv32_kernel_sem_give(&queue->spaces);
+}
+
+
+/**********************************************************************//**
+ * Send item to queue from an interrupt handler (non-blocking).
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[in] item Item to be sent (item_size bytes are copied).
+ * @return 0 if success, -1 if queue is full.
+ **************************************************************************/
+int neorv32_kernel_queue_send_isr(neorv32_kernel_queue_t *queue, const void *item) {
+
+  if (neorv32_kernel_sem_try_take(&queue->spaces)) {
+    return -1;
+  }
+  __neorv32_kernel_queue_put(queue, item);
+  neorv32_kernel_sem_give_isr(&queue->items);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Receive item from queue from an interrupt handler (non-blocking).
+ *
+ * @param[in,out] queue Queue handle (#neorv32_kernel_queue_t).
+ * @param[out] item Item buffer (item_size bytes are copied).
+ * @return 0 if success, -1 if queue is empty.
+ **************************************************************************/
+int neorv32_kernel_queue_receive_isr(neorv32_kernel_queue_t *queue, void *item) {
+
+  if (neorv32_kernel_sem_try_take(&queue->items)) {
+    return -1;
+  }
+  __neorv32_kernel_queue_get(queue, item);
+  neorv32_kernel_sem_give_isr(&queue->spaces);
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * MTIME interrupt handler: system tick.
+ **************************************************************************/
+static void __neorv32_kernel_tick_handler(void) {
+
+  neorv32_mtime_set_timecmp(neorv32_mtime_get_timecmp() + __neorv32_kernel_tick_cycles);
+  uint32_t ticks = ++__neorv32_kernel_ticks;
+
+  // wake-up sleeping tasks
+  int i;
+  neorv32_kernel_task_t *task;
+  for (i=0; i<__neorv32_kernel_num_tasks; i++) {
+    task = __neorv32_kernel_task[i];
+    if ((task->state == KERNEL_TASK_SLEEPING) && ((int32_t)(ticks - task->wake) >= 0)) {
+      task->state = KERNEL_TASK_READY;
+    }
+  }
+
+  __neorv32_kernel_switch(1); // time slicing between tasks of the same priority
+}
+
+
+/**********************************************************************//**
+ * Environment call handler: kernel entry from task context.
+ **************************************************************************/
+static void __neorv32_kernel_ecall_handler(void) {
+
+  __neorv32_kernel_switch(1);
+}
+
+
+/**********************************************************************//**
+ * Switch to the highest-priority ready task. Has to be called from
+ * within an RTE trap handler.
+ *
+ * @param[in] rotate Prefer other tasks of the same priority over the current task (round-robin).
+ **************************************************************************/
+static void __neorv32_kernel_switch(int rotate) {
+
+  neorv32_kernel_task_t *curr = __neorv32_kernel_current;
+  neorv32_kernel_task_t *next = __neorv32_kernel_select(rotate);
+
+  if (next == curr) {
+    return;
+  }
+
+  // the RTE core advances mepc after exceptions (ECALL) - compensate
+  uint32_t adj = __neorv32_kernel_mepc_adj();
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+
+  // save current task: RTE context frame, resume address, interrupt enable
+  if (curr != NULL) {
+    curr->frame = neorv32_cpu_csr_read(CSR_MSCRATCH);
+    curr->pc    = neorv32_cpu_csr_read(CSR_MEPC) + adj;
+    curr->mpie  = mstatus & (1 << CSR_MSTATUS_MPIE);
+  }
+
+  // restore next task; the RTE core restores the context from the frame in mscratch
+  __neorv32_kernel_current = next;
+  neorv32_cpu_csr_write(CSR_MSCRATCH, next->frame);
+  neorv32_cpu_csr_write(CSR_MEPC, next->pc - adj);
+  neorv32_cpu_csr_write(CSR_MSTATUS, (mstatus & ~(1 << CSR_MSTATUS_MPIE)) | next->mpie);
+}
+
+
+/**********************************************************************//**
+ * Select the highest-priority ready task. Tasks of the same priority are
+ * checked in round-robin order starting after the current task.
+ *
+ * @param[in] rotate Prefer other tasks of the same priority over the current task.
+ * @return Task to run.
+ **************************************************************************/
+static neorv32_kernel_task_t *__neorv32_kernel_select(int rotate) {
+
+  neorv32_kernel_task_t *curr = __neorv32_kernel_current;
+  neorv32_kernel_task_t *best = NULL, *task;
+  int i, idx = (curr != NULL) ? curr->id : -1;
+
+  for (i=0; i<__neorv32_kernel_num_tasks; i++) {
+    idx = (idx + 1 == __neorv32_kernel_num_tasks) ? 0 : idx + 1;
+    task = __neorv32_kernel_task[idx];
+    if ((task->state == KERNEL_TASK_READY) && ((best == NULL) || (task->prio > best->prio))) {
+      best = task;
+    }
+  }
+
+  // keep current task if not rotating and there is no task with higher priority
+  if ((rotate == 0) && (curr != NULL) && (curr->state == KERNEL_TASK_READY) && (curr->prio >= best->prio)) {
+    best = curr;
+  }
+
+  return best; // there is always the idle task
+}
+
+
+/**********************************************************************//**
+ * Wake-up the highest-priority task blocked on object.
+ *
+ * @param[in] object Object the task is waiting for.
+ * @return Woken task; NULL if no task was waiting.
+ **************************************************************************/
+static neorv32_kernel_task_t *__neorv32_kernel_wake(void *object) {
+
+  neorv32_kernel_task_t *best = NULL, *task;
+  int i;
+
+  for (i=0; i<__neorv32_kernel_num_tasks; i++) {
+    task = __neorv32_kernel_task[i];
+    if ((task->state == KERNEL_TASK_BLOCKED) && (task->wait == object) &&
+        ((best == NULL) || (task->prio > best->prio))) {
+      best = task;
+    }
+  }
+
+  if (best != NULL) {
+    best->wait  = NULL;
+    best->state = KERNEL_TASK_READY;
+  }
+  return best;
+}
+
+
+/**********************************************************************//**
+ * Return address adjustment applied by the RTE core after the trap handler.
+ *
+ * @return Number of bytes the RTE core adds to mepc.
+ **************************************************************************/
+static uint32_t __neorv32_kernel_mepc_adj(void) {
+
+  uint32_t cause = neorv32_cpu_csr_read(CSR_MCAUSE);
+
+  if (((cause >> 31) == 0) && (cause != TRAP_CODE_I_ACCESS)) { // exception
+    if ((neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_C)) &&
+        ((neorv32_cpu_csr_read(CSR_MTINST) & 3) != 3)) { // compressed instruction
+      return 2;
+    }
+    return 4;
+  }
+  return 0; // interrupt
+}
+
+
+/**********************************************************************//**
+ * Return address of all task entry functions.
+ **************************************************************************/
+static void __neorv32_kernel_task_exit(void) {
+
+  __neorv32_kernel_lock();
+  __neorv32_kernel_current->state = KERNEL_TASK_DONE;
+  __neorv32_kernel_enter();
+
+  while(1); // should never be reached
+}
+
+
+/**********************************************************************//**
+ * Idle task: sleep until the next interrupt.
+ *
+ * @param[in] arg Not used.
+ **************************************************************************/
+static void __neorv32_kernel_idle(void *arg) {
+
+  (void)arg;
+  while(1) {
+    asm volatile ("wfi");
+  }
+}
@@ -0,0 +1,502 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_malloc.c
+ * @brief O(1) memory allocator (TLSF) and fixed-size block pools - source file.
+ *
+ * @note The allocator manages the linker script's heap section (__heap_start to __heap_end);
+ * the heap size is configured via the __neorv32_heap_size linker symbol.
+ *
+ * @note If NEORV32_MALLOC_TLSF is defined (e.g. make MALLOC=tlsf) this allocator also
+ * replaces newlib's malloc/free/calloc/realloc (and thus also C++ new/delete).
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#include "neorv32.h"
+#include "neorv32_malloc.h"
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name TLSF configuration (derived)
+ **************************************************************************/
+/**@{*/
+#define TLSF_ALIGN_LOG2 3                                             // 8-byte alignment
+#define TLSF_ALIGN      (1 << TLSF_ALIGN_LOG2)
+#define TLSF_SL_COUNT   (1 << NEORV32_MALLOC_SL_LOG2)                 // second-level classes
+#define TLSF_FL_SHIFT   (NEORV32_MALLOC_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT   (NEORV32_MALLOC_FL_MAX - TLSF_FL_SHIFT + 2)   // first-level classes (incl. small blocks)
+#define TLSF_SMALL      (1 << TLSF_FL_SHIFT)                          // blocks below this size are in first-level class 0
+#define TLSF_HDR        8                                             // block header size
+#define TLSF_MIN        8                                             // minimal payload (free-list pointers)
+#define TLSF_BLOCK_MAX  ((1 << (NEORV32_MALLOC_FL_MAX + 1)) - TLSF_ALIGN) // largest block payload
+#define TLSF_FREE       1                                             // size flag: block is free
+#define TLSF_PREV_FREE  2                                             // size flag: previous physical block is free
+/**@}*/
+
+
+/**********************************************************************//**
+ * TLSF block header. Free-list pointers are only valid for free blocks
+ * (they are located in the first payload bytes).
+ **************************************************************************/
+typedef struct __neorv32_tlsf_block_struct {
+  struct __neorv32_tlsf_block_struct *prev_phys; // previous physical block (valid if TLSF_PREV_FREE)
+  uint32_t size;                                 // payload size | flags
+  struct __neorv32_tlsf_block_struct *next_free; // next block in free list
+  struct __neorv32_tlsf_block_struct *prev_free; // previous block in free list
+} tlsf_block_t;
+
+
+/**********************************************************************//**
+ * TLSF control structure.
+ **************************************************************************/
+static struct {
+  uint32_t fl_map;                                   // first-level bitmap
+  uint32_t sl_map[TLSF_FL_COUNT];                    // second-level bitmaps
+  tlsf_block_t *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT]; // free lists
+  int initialized;
+} __neorv32_tlsf;
+
+// allocator statistics
+static neorv32_malloc_stats_t __neorv32_malloc_stats;
+
+// heap section from linker script
+extern char __heap_start[];
+extern char __heap_end[];
+
+
+/**********************************************************************//**
+ * Enter critical section (disable interrupts).
+ *
+ * @return Previous interrupt enable state.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_malloc_lock(void) {
+
+  uint32_t mstatus = neorv32_cpu_csr_read(CSR_MSTATUS);
+  neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+  return mstatus & (1 << CSR_MSTATUS_MIE);
+}
+
+
+/**********************************************************************//**
+ * Leave critical section (restore interrupt enable state).
+ *
+ * @param[in] state Interrupt enable state returned by #__neorv32_malloc_lock.
+ **************************************************************************/
+inline static void __attribute__((always_inline)) __neorv32_malloc_unlock(uint32_t state) {
+
+  neorv32_cpu_csr_set(CSR_MSTATUS, state);
+}
+
+
+/**********************************************************************//**
+ * TLSF helpers.
+ **************************************************************************/
+inline static uint32_t __neorv32_tlsf_size(const tlsf_block_t *block) {
+  return block->size & ~((uint32_t)(TLSF_FREE | TLSF_PREV_FREE));
+}
+
+inline static tlsf_block_t *__neorv32_tlsf_next(const tlsf_block_t *block) {
+  return (tlsf_block_t*)((uint8_t*)block + TLSF_HDR + __neorv32_tlsf_size(block));
+}
+
+inline static int __neorv32_tlsf_fls(uint32_t x) {
+  return 31 - __builtin_clz(x); // x != 0
+}
+
+
+/**********************************************************************//**
+ * Map block size to first-level and second-level class.
+ *
+ * @param[in] size Block payload size.
+ * @param[out] fl First-level class.
+ * @param[out] sl Second-level class.
+ **************************************************************************/
+static void __neorv32_tlsf_mapping(uint32_t size, int *fl, int *sl) {
+
+  if (size < TLSF_SMALL) {
+    *fl = 0;
+    *sl = (int)(size >> TLSF_ALIGN_LOG2);
+  }
+  else {
+    int f = __neorv32_tlsf_fls(size);
+    *sl = (int)((size >> (f - NEORV32_MALLOC_SL_LOG2)) ^ TLSF_SL_COUNT);
+    *fl = f - TLSF_FL_SHIFT + 1;
+  }
+}
+
+
+/**********************************************************************//**
+ * Insert block into according free list.
+ *
+ * @param[in,out] block Free block.
+ **************************************************************************/
+static void __neorv32_tlsf_insert(tlsf_block_t *block) {
+
+  int fl, sl;
+  __neorv32_tlsf_mapping(__neorv32_tlsf_size(block), &fl, &sl);
+
+  tlsf_block_t *head = __neorv32_tlsf.blocks[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  __neorv32_tlsf.blocks[fl][sl] = block;
+  __neorv32_tlsf.fl_map |= 1U << fl;
+  __neorv32_tlsf.sl_map[fl] |= 1U << sl;
+}
+
+
+/**********************************************************************//**
+ * Remove block from its free list.
+ *
+ * @param[in,out] block Free block.
+ **************************************************************************/
+static void __neorv32_tlsf_remove(tlsf_block_t *block) {
+
+  int fl, sl;
+  __neorv32_tlsf_mapping(__neorv32_tlsf_size(block), &fl, &sl);
+
+  if (block->prev_free != NULL) {
+    block->prev_free->next_free = block->next_free;
+  }
+  else {
+    __neorv32_tlsf.blocks[fl][sl] = block->next_free;
+  }
+  if (block->next_free != NULL) {
+    block->next_free->prev_free = block->prev_free;
+  }
+
+  if (__neorv32_tlsf.blocks[fl][sl] == NULL) {
+    __neorv32_tlsf.sl_map[fl] &= ~(1U << sl);
+    if (__neorv32_tlsf.sl_map[fl] == 0) {
+      __neorv32_tlsf.fl_map &= ~(1U << fl);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Find a free block that is at least size bytes large (good fit).
+ *
+ * @param[in] size Requested payload size (aligned).
+ * @return Free block; NULL if there is no suitable block.
+ **************************************************************************/
+static tlsf_block_t *__neorv32_tlsf_find(uint32_t size) {
+
+  int fl, sl;
+
+  // round up to the next class so that every block in that class is large enough
+  if (size >= TLSF_SMALL) {
+    size += (1U << (__neorv32_tlsf_fls(size) - NEORV32_MALLOC_SL_LOG2)) - 1;
+  }
+  __neorv32_tlsf_mapping(size, &fl, &sl);
+  if (fl >= TLSF_FL_COUNT) {
+    return NULL;
+  }
+
+  uint32_t map = __neorv32_tlsf.sl_map[fl] & (~0U << sl);
+  if (map == 0) { // nothing in this first-level class; use next larger one
+    uint32_t fl_map = __neorv32_tlsf.fl_map & (~0U << (fl + 1));
+    if (fl_map == 0) {
+      return NULL; // out of memory
+    }
+    fl = __builtin_ctz(fl_map);
+    map = __neorv32_tlsf.sl_map[fl];
+  }
+  sl = __builtin_ctz(map);
+
+  return __neorv32_tlsf.blocks[fl][sl];
+}
+
+
+/**********************************************************************//**
+ * Initialize allocator: the whole heap is one free block followed
+ * by a zero-sized "used" sentinel block.
+ **************************************************************************/
+static void __neorv32_tlsf_init(void) {
+
+  uint32_t start = ((uint32_t)(&__heap_start[0]) + (TLSF_ALIGN-1)) & ~((uint32_t)(TLSF_ALIGN-1));
+  uint32_t end   = ((uint32_t)(&__heap_end[0])) & ~((uint32_t)(TLSF_ALIGN-1));
+
+  __neorv32_tlsf.initialized = 1;
+  if (end < (start + 2*TLSF_HDR + TLSF_MIN)) {
+    return; // no heap at all
+  }
+
+  uint32_t size = end - start - 2*TLSF_HDR;
+  if (size > TLSF_BLOCK_MAX) {
+    size = TLSF_BLOCK_MAX;
+  }
+
+  tlsf_block_t *block = (tlsf_block_t*)start;
+  block->prev_phys = NULL;
+  block->size = size | TLSF_FREE;
+
+  tlsf_block_t *sentinel = __neorv32_tlsf_next(block);
+  sentinel->prev_phys = block;
+  sentinel->size = TLSF_PREV_FREE;
+
+  __neorv32_tlsf_insert(block);
+  __neorv32_malloc_stats.heap_size = size + TLSF_HDR;
+}
+
+
+/**********************************************************************//**
+ * Allocate memory (O(1)).
+ *
+ * @param[in] size Number of bytes.
+ * @return Pointer to 8-byte aligned memory; NULL if out of memory.
+ **************************************************************************/
+void *neorv32_malloc(size_t size) {
+
+  void *ptr = NULL;
+  uint32_t irq = __neorv32_malloc_lock();
+
+  if (__neorv32_tlsf.initialized == 0) {
+    __neorv32_tlsf_init();
+  }
+
+  if ((size != 0) && (size <= TLSF_BLOCK_MAX)) {
+
+    uint32_t req = ((uint32_t)size + (TLSF_ALIGN-1)) & ~((uint32_t)(TLSF_ALIGN-1));
+    if (req < TLSF_MIN) {
+      req = TLSF_MIN;
+    }
+
+    tlsf_block_t *block = __neorv32_tlsf_find(req);
+    if (block != NULL) {
+      __neorv32_tlsf_remove(block);
+      uint32_t bsize = __neorv32_tlsf_size(block);
+
+      if (bsize >= (req + TLSF_HDR + TLSF_MIN)) { // split: return remainder to the free lists
+        tlsf_block_t *rem = (tlsf_block_t*)((uint8_t*)block + TLSF_HDR + req);
+        rem->prev_phys = block;
+        rem->size = (bsize - req - TLSF_HDR) | TLSF_FREE;
+        __neorv32_tlsf_next(rem)->prev_phys = rem; // TLSF_PREV_FREE is already set
+        __neorv32_tlsf_insert(rem);
+        block->size = req | (block->size & TLSF_PREV_FREE);
+      }
+      else {
+        block->size &= ~((uint32_t)TLSF_FREE);
+        __neorv32_tlsf_next(block)->size &= ~((uint32_t)TLSF_PREV_FREE);
+      }
+
+      __neorv32_malloc_stats.used += __neorv32_tlsf_size(block) + TLSF_HDR;
+      if (__neorv32_malloc_stats.used > __neorv32_malloc_stats.used_peak) {
+        __neorv32_malloc_stats.used_peak = __neorv32_malloc_stats.used;
+      }
+      __neorv32_malloc_stats.num_malloc++;
+      ptr = (void*)((uint8_t*)block + TLSF_HDR);
+    }
+  }
+
+  if ((ptr == NULL) && (size != 0)) {
+    __neorv32_malloc_stats.num_fail++;
+  }
+
+  __neorv32_malloc_unlock(irq);
+  return ptr;
+}
+
+
+/**********************************************************************//**
+ * Free memory (O(1)); merges with adjacent free blocks.
+ *
+ * @param[in] ptr Pointer returned by #neorv32_malloc (NULL is ignored).
+ **************************************************************************/
+void neorv32_free(void *ptr) {
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  uint32_t irq = __neorv32_malloc_lock();
+
+  tlsf_block_t *block = (tlsf_block_t*)((uint8_t*)ptr - TLSF_HDR);
+  __neorv32_malloc_stats.used -= __neorv32_tlsf_size(block) + TLSF_HDR;
+  __neorv32_malloc_stats.num_free++;
+  block->size |= TLSF_FREE;
+
+  // merge with previous block
+  if (block->size & TLSF_PREV_FREE) {
+    tlsf_block_t *prev = block->prev_phys;
+    __neorv32_tlsf_remove(prev);
+    prev->size += TLSF_HDR + __neorv32_tlsf_size(block);
+    block = prev;
+  }
+
+  // merge with next block
+  tlsf_block_t *next = __neorv32_tlsf_next(block);
+  if (next->size & TLSF_FREE) {
+    __neorv32_tlsf_remove(next);
+    block->size += TLSF_HDR + __neorv32_tlsf_size(next);
+    next = __neorv32_tlsf_next(block);
+  }
+
+  next->prev_phys = block;
+  next->size |= TLSF_PREV_FREE;
+  __neorv32_tlsf_insert(block);
+
+  __neorv32_malloc_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Allocate and clear memory.
+ *
+ * @param[in] num Number of elements.
+ * @param[in] size Size of one element in bytes.
+ * @return Pointer to zero-initialized memory; NULL if out of memory.
+ **************************************************************************/
+void *neorv32_calloc(size_t num, size_t size) {
+
+  if ((size != 0) && (num > (((size_t)-1) / size))) {
+    return NULL; // overflow
+  }
+
+  void *ptr = neorv32_malloc(num * size);
+  if (ptr != NULL) {
+    memset(ptr, 0, num * size);
+  }
+  return ptr;
+}
+
+
+/**********************************************************************//**
+ * Resize memory block.
+ *
+ * @param[in] ptr Pointer returned by #neorv32_malloc (NULL = allocate new block).
+ * @param[in] size New size in bytes (0 = free block).
+ * @return Pointer to resized memory; NULL if out of memory (original block is kept).
+ **************************************************************************/
+void *neorv32_realloc(void *ptr, size_t size) {
+
+  if (ptr == NULL) {
+    return neorv32_malloc(size);
+  }
+  if (size == 0) {
+    neorv32_free(ptr);
+    return NULL;
+  }
+
+  uint32_t old = __neorv32_tlsf_size((tlsf_block_t*)((uint8_t*)ptr - TLSF_HDR));
+  if (size <= old) {
+    return ptr; // block is large enough
+  }
+
+  void *tmp = neorv32_malloc(size);
+  if (tmp != NULL) {
+    memcpy(tmp, ptr, old);
+    neorv32_free(ptr);
+  }
+  return tmp;
+}
+
+
+/**********************************************************************//**
+ * Get allocator statistics.
+ *
+ * @param[out] stats Statistics (#neorv32_malloc_stats_t).
+ **************************************************************************/
+void neorv32_malloc_get_stats(neorv32_malloc_stats_t *stats) {
+
+  uint32_t irq = __neorv32_malloc_lock();
+  if (__neorv32_tlsf.initialized == 0) {
+    __neorv32_tlsf_init();
+  }
+  *stats = __neorv32_malloc_stats;
+  __neorv32_malloc_unlock(irq);
+}
+
+
+/**********************************************************************//**
+ * Initialize fixed-size block pool.
+ *
+ * @param[in,out] pool Pool handle (#neorv32_pool_t).
+ * @param[in] buf Pool memory (at least block_size * num_blocks bytes, 4-byte aligned).
+ * @param[in] block_size Block size in bytes (rounded up to a multiple of 4).
+ * @param[in] num_blocks Number of blocks.
+ **************************************************************************/
+void neorv32_pool_init(neorv32_pool_t *pool, void *buf, uint32_t block_size, uint32_t num_blocks) {
+
+  block_size = (block_size + 3) & ~((uint32_t)3);
+  if (block_size < sizeof(void*)) {
+    block_size = sizeof(void*);
+  }
+
+  pool->free_list  = NULL;
+  pool->block_size = block_size;
+  pool->num_free   = 0;
+
+  uint8_t *block = (uint8_t*)buf;
+  uint32_t i;
+  for (i=0; i<num_blocks; i++) {
+    neorv32_pool_free(pool, (void*)block);
+    block += block_size;
+  }
+}
+
+
+/**********************************************************************//**
+ * Allocate block from pool (O(1)).
+ *
+ * @param[in,out] pool Pool handle (#neorv32_pool_t).
+ * @return Pointer to block; NULL if pool is empty.
+ **************************************************************************/
+void *neorv32_pool_alloc(neorv32_pool_t *pool) {
+
+  uint32_t irq = __neorv32_malloc_lock();
+  void **block = (void**)pool->free_list;
+  if (block != NULL) {
+    pool->free_list = *block;
+    pool->num_free--;
+  }
+  __neorv32_malloc_unlock(irq);
+  return (void*)block;
+}
+
+
+/**********************************************************************//**
+ * Return block to pool (O(1)).
+ *
+ * @param[in,out] pool Pool handle (#neorv32_pool_t).
+ * @param[in] ptr Block returned by #neorv32_pool_alloc (NULL is ignored).
+ **************************************************************************/
+void neorv32_pool_free(neorv32_pool_t *pool, void *ptr) {
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  uint32_t irq = __neorv32_malloc_lock();
+  *(void**)ptr = pool->free_list;
+  pool->free_list = ptr;
+  pool->num_free++;
+  __neorv32_malloc_unlock(irq);
+}
+
+
+#ifdef NEORV32_MALLOC_TLSF
+// ---------------------------------------------------------------------------
+// Replace newlib's allocator (also used by C++ new/delete)
+// ---------------------------------------------------------------------------
+#include <reent.h>
+
+void *malloc(size_t size)                                    { return neorv32_malloc(size); }
+void  free(void *ptr)                                        { neorv32_free(ptr); }
+void *calloc(size_t num, size_t size)                        { return neorv32_calloc(num, size); }
+void *realloc(void *ptr, size_t size)                        { return neorv32_realloc(ptr, size); }
+void *_malloc_r(struct _reent *r, size_t size)               { (void)r; return neorv32_malloc(size); }
+void  _free_r(struct _reent *r, void *ptr)                   { (void)r; neorv32_free(ptr); }
+void *_calloc_r(struct _reent *r, size_t num, size_t size)   { (void)r; return neorv32_calloc(num, size); }
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)   { (void)r; return neorv32_realloc(ptr, size); }
+#endif
@@ -21,7 +21,9 @@
  * NEORV32 runtime environment (RTE):
  * The >private< trap vector look-up table of the NEORV32 RTE.
  **************************************************************************/
+#ifndef RTE_STATIC
 static uint32_t __neorv32_rte_vector_lut[NEORV32_RTE_NUM_TRAPS] __attribute__((unused)); // trap handler vector table
+#endif
 
 // private functions
 static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void);
@@ -29,6 +31,46 @@ static void __neorv32_rte_debug_handler(void);
 static void __neorv32_rte_print_hex_word(uint32_t num);
 
 
+#ifdef RTE_STATIC
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Static trap handlers. Each handler defaults to the debug handler and can
+ * be overridden at compile time via NEORV32_RTE_HANDLER(id, handler).
+ **************************************************************************/
+#define RTE_STATIC_DEFAULT(id) __RTE_STATIC_DEFAULT(id)
+#define __RTE_STATIC_DEFAULT(id) void __neorv32_rte_handler_##id(void) __attribute__((weak,alias("__neorv32_rte_debug_handler")))
+RTE_STATIC_DEFAULT(RTE_TRAP_I_ACCESS);
+RTE_STATIC_DEFAULT(RTE_TRAP_I_ILLEGAL);
+RTE_STATIC_DEFAULT(RTE_TRAP_I_MISALIGNED);
+RTE_STATIC_DEFAULT(RTE_TRAP_BREAKPOINT);
+RTE_STATIC_DEFAULT(RTE_TRAP_L_MISALIGNED);
+RTE_STATIC_DEFAULT(RTE_TRAP_L_ACCESS);
+RTE_STATIC_DEFAULT(RTE_TRAP_S_MISALIGNED);
+RTE_STATIC_DEFAULT(RTE_TRAP_S_ACCESS);
+RTE_STATIC_DEFAULT(RTE_TRAP_UENV_CALL);
+RTE_STATIC_DEFAULT(RTE_TRAP_MENV_CALL);
+RTE_STATIC_DEFAULT(RTE_TRAP_MSI);
+RTE_STATIC_DEFAULT(RTE_TRAP_MTI);
+RTE_STATIC_DEFAULT(RTE_TRAP_MEI);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_0);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_1);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_2);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_3);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_4);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_5);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_6);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_7);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_8);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_9);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_10);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_11);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_12);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_13);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_14);
+RTE_STATIC_DEFAULT(RTE_TRAP_FIRQ_15);
+#endif
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Setup RTE.
@@ -48,11 +90,13 @@ void neorv32_rte_setup(void) {
   // disable all IRQ channels
   neorv32_cpu_csr_write(CSR_MIE, 0);
 
+#ifndef RTE_STATIC
   // install debug handler for all trap sources
   int id;
   for (id = 0; id < ((int)NEORV32_RTE_NUM_TRAPS); id++) {
     neorv32_rte_handler_uninstall(id); // this will configure the debug handler
   }
+#endif
 }
 
 
@@ -63,15 +107,22 @@ void neorv32_rte_setup(void) {
  * @param[in] id Identifier (type) of the targeted trap. See #NEORV32_RTE_TRAP_enum.
  * @param[in] handler The actual handler function for the specified trap (function MUST be of type "void function(void);").
  * @return 0 if success, -1 if error (invalid id or targeted trap not supported).
+ *
+ * @note Not supported (always returns -1) if the RTE is compiled with RTE_STATIC.
  **************************************************************************/
 int neorv32_rte_handler_install(int id, void (*handler)(void)) {
 
+#ifndef RTE_STATIC
   // id valid?
   uint32_t index = (uint32_t)id;
   if (index < ((uint32_t)NEORV32_RTE_NUM_TRAPS)) {
     __neorv32_rte_vector_lut[index] = (uint32_t)handler; // install handler
     return 0;
   }
+#else
+  (void)id;
+  (void)handler;
+#endif
   return -1;
 }
 
@@ -83,15 +134,21 @@ int neorv32_rte_handler_install(int id, void (*handler)(void)) {
  *
  * @param[in] id Identifier (type) of the targeted trap. See #NEORV32_RTE_TRAP_enum.
  * @return 0 if success, -1 if error (invalid id or targeted trap not supported).
+ *
+ * @note Not supported (always returns -1) if the RTE is compiled with RTE_STATIC.
  **************************************************************************/
 int neorv32_rte_handler_uninstall(int id) {
 
+#ifndef RTE_STATIC
   // id valid?
   uint32_t index = (uint32_t)id;
   if (index < ((uint32_t)NEORV32_RTE_NUM_TRAPS)) {
     __neorv32_rte_vector_lut[index] = (uint32_t)(&__neorv32_rte_debug_handler); // use dummy handler in case the trap is accidentally triggered
     return 0;
   }
+#else
+  (void)id;
+#endif
   return -1;
 }
 
@@ -151,6 +208,41 @@ static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void) {
 #endif
   );
 
+#ifdef RTE_STATIC
+  // call according trap handler directly (resolved at link time)
+  switch (neorv32_cpu_csr_read(CSR_MCAUSE)) {
+    case TRAP_CODE_I_ACCESS:     __neorv32_rte_handler_RTE_TRAP_I_ACCESS();     break;
+    case TRAP_CODE_I_ILLEGAL:    __neorv32_rte_handler_RTE_TRAP_I_ILLEGAL();    break;
+    case TRAP_CODE_I_MISALIGNED: __neorv32_rte_handler_RTE_TRAP_I_MISALIGNED(); break;
+    case TRAP_CODE_BREAKPOINT:   __neorv32_rte_handler_RTE_TRAP_BREAKPOINT();   break;
+    case TRAP_CODE_L_MISALIGNED: __neorv32_rte_handler_RTE_TRAP_L_MISALIGNED(); break;
+    case TRAP_CODE_L_ACCESS:     __neorv32_rte_handler_RTE_TRAP_L_ACCESS();     break;
+    case TRAP_CODE_S_MISALIGNED: __neorv32_rte_handler_RTE_TRAP_S_MISALIGNED(); break;
+    case TRAP_CODE_S_ACCESS:     __neorv32_rte_handler_RTE_TRAP_S_ACCESS();     break;
+    case TRAP_CODE_UENV_CALL:    __neorv32_rte_handler_RTE_TRAP_UENV_CALL();    break;
+    case TRAP_CODE_MENV_CALL:    __neorv32_rte_handler_RTE_TRAP_MENV_CALL();    break;
+    case TRAP_CODE_MSI:          __neorv32_rte_handler_RTE_TRAP_MSI();          break;
+    case TRAP_CODE_MTI:          __neorv32_rte_handler_RTE_TRAP_MTI();          break;
+    case TRAP_CODE_MEI:          __neorv32_rte_handler_RTE_TRAP_MEI();          break;
+    case TRAP_CODE_FIRQ_0:       __neorv32_rte_handler_RTE_TRAP_FIRQ_0();       break;
+    case TRAP_CODE_FIRQ_1:       __neorv32_rte_handler_RTE_TRAP_FIRQ_1();       break;
+    case TRAP_CODE_FIRQ_2:       __neorv32_rte_handler_RTE_TRAP_FIRQ_2();       break;
+    case TRAP_CODE_FIRQ_3:       __neorv32_rte_handler_RTE_TRAP_FIRQ_3();       break;
+    case TRAP_CODE_FIRQ_4:       __neorv32_rte_handler_RTE_TRAP_FIRQ_4();       break;
+    case TRAP_CODE_FIRQ_5:       __neorv32_rte_handler_RTE_TRAP_FIRQ_5();       break;
+    case TRAP_CODE_FIRQ_6:       __neorv32_rte_handler_RTE_TRAP_FIRQ_6();       break;
+    case TRAP_CODE_FIRQ_7:       __neorv32_rte_handler_RTE_TRAP_FIRQ_7();       break;
+    case TRAP_CODE_FIRQ_8:       __neorv32_rte_handler_RTE_TRAP_FIRQ_8();       break;
+    case TRAP_CODE_FIRQ_9:       __neorv32_rte_handler_RTE_TRAP_FIRQ_9();       break;
+    case TRAP_CODE_FIRQ_10:      __neorv32_rte_handler_RTE_TRAP_FIRQ_10();      break;
+    case TRAP_CODE_FIRQ_11:      __neorv32_rte_handler_RTE_TRAP_FIRQ_11();      break;
+    case TRAP_CODE_FIRQ_12:      __neorv32_rte_handler_RTE_TRAP_FIRQ_12();      break;
+    case TRAP_CODE_FIRQ_13:      __neorv32_rte_handler_RTE_TRAP_FIRQ_13();      break;
+    case TRAP_CODE_FIRQ_14:      __neorv32_rte_handler_RTE_TRAP_FIRQ_14();      break;
+    case TRAP_CODE_FIRQ_15:      __neorv32_rte_handler_RTE_TRAP_FIRQ_15();      break;
+    default:                     __neorv32_rte_debug_handler();                 break;
+  }
+#else
   // find according trap handler base address
   uint32_t handler_base;
   switch (neorv32_cpu_csr_read(CSR_MCAUSE)) {
@@ -190,6 +282,7 @@ static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void) {
   void (*handler_pnt)(void);
   handler_pnt = (void*)handler_base;
   (*handler_pnt)();
+#endif
 
   // compute return address (for exceptions only)
   // do not alter return address if instruction access exception (fatal?)
@@ -212,6 +305,7 @@ static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void) {
 
   // restore context
   asm volatile (
+    "csrr sp, mscratch \n" // context frame base address (can be altered by the trap handler to switch contexts)
 //  "lw x0,   0*4(sp) \n"
     "lw x1,   1*4(sp) \n"
 //  restore 2x at the very end
@@ -427,12 +521,50 @@ void neorv32_rte_print_info(void) {
   neorv32_uart0_puts("Trap Name [ID]       Handler\n");
   neorv32_uart0_puts("-------------------------------\n");
 
+#ifdef RTE_STATIC
+  const uint32_t handler_base[NEORV32_RTE_NUM_TRAPS] = {
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_I_ACCESS,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_I_ILLEGAL,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_I_MISALIGNED,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_BREAKPOINT,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_L_MISALIGNED,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_L_ACCESS,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_S_MISALIGNED,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_S_ACCESS,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_UENV_CALL,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_MENV_CALL,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_MSI,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_MTI,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_MEI,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_0,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_1,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_2,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_3,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_4,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_5,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_6,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_7,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_8,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_9,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_10,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_11,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_12,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_13,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_14,
+    (uint32_t)&__neorv32_rte_handler_RTE_TRAP_FIRQ_15
+  };
+#endif
+
   uint32_t i;
   for (i=0; i<NEORV32_RTE_NUM_TRAPS; i++) {
     neorv32_uart0_puts("RTE_TRAP_");
     neorv32_uart0_puts(trap_name[i]);
     neorv32_uart0_puts("  ");
+#ifdef RTE_STATIC
+    __neorv32_rte_print_hex_word(handler_base[i]);
+#else
     __neorv32_rte_print_hex_word(__neorv32_rte_vector_lut[i]);
+#endif
     neorv32_uart0_puts("\n");
   }
 
@@ -514,14 +646,26 @@ void neorv32_rte_print_hw_config(void) {
   if (tmp & (1<<CSR_MXISA_SDEXT))     { neorv32_uart0_printf("Sdext ");     }
   if (tmp & (1<<CSR_MXISA_SDTRIG))    { neorv32_uart0_printf("Sdtrig ");    }
   if (tmp & (1<<CSR_MXISA_SMPMP))     { neorv32_uart0_printf("Smpmp ");     }
+  if (tmp & (1<<CSR_MXISA_ZBC))       { neorv32_uart0_printf("Zbc ");       }
+  if (tmp & (1<<CSR_MXISA_ZBKB))      { neorv32_uart0_printf("Zbkb ");      }
+  if (tmp & (1<<CSR_MXISA_ZBKC))      { neorv32_uart0_printf("Zbkc ");      }
+  if (tmp & (1<<CSR_MXISA_ZBKX))      { neorv32_uart0_printf("Zbkx ");      }
+  if (tmp & (1<<CSR_MXISA_ZCB))       { neorv32_uart0_printf("Zcb ");       }
+  if (tmp & (1<<CSR_MXISA_ZCMP))      { neorv32_uart0_printf("Zcmp ");      }
   if (tmp & (1<<CSR_MXISA_ZFINX))     { neorv32_uart0_printf("Zfinx ");     }
+  if (tmp & (1<<CSR_MXISA_ZICBOM))    { neorv32_uart0_printf("Zicbom ");    }
+  if (tmp & (1<<CSR_MXISA_ZICBOZ))    { neorv32_uart0_printf("Zicboz ");    }
   if (tmp & (1<<CSR_MXISA_ZICNTR))    { neorv32_uart0_printf("Zicntr ");    }
   if (tmp & (1<<CSR_MXISA_ZICOND))    { neorv32_uart0_printf("Zicond ");    }
   if (tmp & (1<<CSR_MXISA_ZICSR))     { neorv32_uart0_printf("Zicsr ");     }
   if (tmp & (1<<CSR_MXISA_ZIFENCEI))  { neorv32_uart0_printf("Zifencei ");  }
   if (tmp & (1<<CSR_MXISA_ZIHPM))     { neorv32_uart0_printf("Zihpm ");     }
+  if (tmp & (1<<CSR_MXISA_ZKND))      { neorv32_uart0_printf("Zknd ");      }
+  if (tmp & (1<<CSR_MXISA_ZKNE))      { neorv32_uart0_printf("Zkne ");      }
+  if (tmp & (1<<CSR_MXISA_ZKNH))      { neorv32_uart0_printf("Zknh ");      }
   if (tmp & (1<<CSR_MXISA_ZMMUL))     { neorv32_uart0_printf("Zmmul ");     }
   if (tmp & (1<<CSR_MXISA_ZXCFU))     { neorv32_uart0_printf("Zxcfu ");     }
+  if (tmp & (1<<CSR_MXISA_ZXPSIMD))   { neorv32_uart0_printf("Zxpsimd ");   }
   // CPU tuning options
   neorv32_uart0_printf("\nTuning options:      ");
   if (tmp & (1<<CSR_MXISA_FASTMUL))   { neorv32_uart0_printf("fast_mul ");   }
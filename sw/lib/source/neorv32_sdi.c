@@ -148,3 +148,56 @@ uint8_t neorv32_sdi_get_nonblocking(void) {
 
   return (uint8_t)NEORV32_SDI->DATA;
 }
+
+
+/**********************************************************************//**
+ * Move all received bytes from the RX FIFO to a ring buffer.
+ *
+ * @note This function is intended to be called from the SDI interrupt handler.
+ * The RX FIFO is always drained; bytes that do not fit into the ring buffer are discarded.
+ *
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t); one byte per entry.
+ * @return Number of bytes stored to the ring buffer.
+ **************************************************************************/
+int neorv32_sdi_irq_rx(neorv32_spsc_t *rb) {
+
+  uint32_t tmp[16], i;
+  int cnt = 0;
+
+  while (NEORV32_SDI->CTRL & (1 << SDI_CTRL_RX_AVAIL)) {
+    i = 0;
+    do {
+      tmp[i++] = NEORV32_SDI->DATA & 0xff;
+    } while ((i < 16) && (NEORV32_SDI->CTRL & (1 << SDI_CTRL_RX_AVAIL)));
+    cnt += (int)neorv32_spsc_push_batch(rb, tmp, i);
+  }
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Move bytes from a ring buffer to the TX FIFO until the FIFO is full or
+ * the ring buffer is empty.
+ *
+ * @note This function is intended to be called from the SDI interrupt handler.
+ * If it returns 0 (ring buffer empty) the application should disable the TX interrupt.
+ *
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t); one byte per entry.
+ * @return Number of bytes written to the TX FIFO.
+ **************************************************************************/
+int neorv32_sdi_irq_tx(neorv32_spsc_t *rb) {
+
+  uint32_t data;
+  int cnt = 0;
+
+  while ((NEORV32_SDI->CTRL & (1 << SDI_CTRL_TX_FULL)) == 0) {
+    if (neorv32_spsc_pop(rb, &data)) {
+      break;
+    }
+    NEORV32_SDI->DATA = data & 0xff;
+    cnt++;
+  }
+
+  return cnt;
+}
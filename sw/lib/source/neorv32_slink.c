@@ -196,3 +196,56 @@ int neorv32_slink_tx_status(void) {
     return -1;
   }
 }
+
+
+/**********************************************************************//**
+ * Move all received data words from the RX FIFO to a ring buffer.
+ *
+ * @note This function is intended to be called from the SLINK RX interrupt handler.
+ * The RX FIFO is always drained; words that do not fit into the ring buffer are discarded.
+ *
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t).
+ * @return Number of words stored to the ring buffer.
+ **************************************************************************/
+int neorv32_slink_irq_rx(neorv32_spsc_t *rb) {
+
+  uint32_t tmp[16], i;
+  int cnt = 0;
+
+  while ((NEORV32_SLINK->CTRL & (1 << SLINK_CTRL_RX_EMPTY)) == 0) {
+    i = 0;
+    do {
+      tmp[i++] = NEORV32_SLINK->DATA;
+    } while ((i < 16) && ((NEORV32_SLINK->CTRL & (1 << SLINK_CTRL_RX_EMPTY)) == 0));
+    cnt += (int)neorv32_spsc_push_batch(rb, tmp, i);
+  }
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Move data words from a ring buffer to the TX FIFO until the FIFO is full
+ * or the ring buffer is empty.
+ *
+ * @note This function is intended to be called from the SLINK TX interrupt handler.
+ * If it returns 0 (ring buffer empty) the application should disable the TX interrupt.
+ *
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t).
+ * @return Number of words written to the TX FIFO.
+ **************************************************************************/
+int neorv32_slink_irq_tx(neorv32_spsc_t *rb) {
+
+  uint32_t data;
+  int cnt = 0;
+
+  while ((NEORV32_SLINK->CTRL & (1 << SLINK_CTRL_TX_FULL)) == 0) {
+    if (neorv32_spsc_pop(rb, &data)) {
+      break;
+    }
+    NEORV32_SLINK->DATA = data;
+    cnt++;
+  }
+
+  return cnt;
+}
@@ -0,0 +1,439 @@
+// ================================================================================ //
+// The NEORV32 RISC-V Processor - https://github.com/stnolting/neorv32              //
+// Copyright (c) NEORV32 contributors.                                              //
+// Copyright (c) 2020 - 2024 Stephan Nolting. All rights reserved.                  //
+// Licensed under the BSD-3-Clause license, see LICENSE for details.                //
+// SPDX-License-Identifier: BSD-3-Clause                                            //
+// ================================================================================ //
+
+/**
+ * @file neorv32_string.c
+ * @brief Optimized memory and string functions (word-at-a-time, Zbb, DMA) - source file.
+ *
+ * @note All accesses are naturally aligned (no misaligned load/store exceptions). If the
+ * Zbb ISA extension is enabled via MARCH (__riscv_zbb) the zero-byte detection and byte
+ * position computation use orc.b, ctz and rev8.
+ *
+ * @note If NEORV32_STRING_OVERRIDE is defined (e.g. make STRING=neorv32) these functions
+ * also replace newlib's memcpy, memmove, memset, memcmp, memchr, strlen and strcmp.
+ *
+ * @see https://stnolting.github.io/neorv32/sw/files.html
+ */
+
+#include "neorv32.h"
+#include "neorv32_string.h"
+
+
+/**********************************************************************//**
+ * Do not let the compiler turn the copy/fill loops into (recursive) library calls.
+ **************************************************************************/
+#define NEORV32_STRING_FUNC __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+
+#if defined __riscv_zbb
+/**********************************************************************//**
+ * OR-combine bits within each byte (Zbb orc.b): 0xff for each non-zero byte.
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_string_orcb(uint32_t x) {
+  uint32_t res;
+  asm ("orc.b %[rd], %[rs]" : [rd] "=r" (res) : [rs] "r" (x));
+  return res;
+}
+
+/**********************************************************************//**
+ * Byte-reverse (Zbb rev8).
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_string_rev8(uint32_t x) {
+  uint32_t res;
+  asm ("rev8 %[rd], %[rs]" : [rd] "=r" (res) : [rs] "r" (x));
+  return res;
+}
+
+/** Non-zero if word contains a zero byte */
+#define HAS_ZERO(x) (__neorv32_string_orcb(x) != 0xffffffffU)
+/** Byte index (little-endian) of the first zero byte; word has to contain a zero byte */
+#define ZERO_IDX(x) (__builtin_ctz(~__neorv32_string_orcb(x)) >> 3)
+#else
+/** Non-zero if word contains a zero byte */
+#define HAS_ZERO(x) (((x) - 0x01010101U) & ~(x) & 0x80808080U)
+#endif
+
+
+/**********************************************************************//**
+ * Replicate byte to all four bytes of a word (without multiplication).
+ **************************************************************************/
+inline static uint32_t __attribute__((always_inline)) __neorv32_string_splat(int c) {
+  uint32_t tmp = (uint32_t)(c & 0xff);
+  tmp |= tmp << 8;
+  tmp |= tmp << 16;
+  return tmp;
+}
+
+
+#if (NEORV32_STRING_DMA_MIN > 0)
+/**********************************************************************//**
+ * Try to copy memory using the DMA controller (word transfers).
+ *
+ * @note The DMA has to be enabled by the application (neorv32_dma_enable()); the DMA is
+ * only used if it is idle and not configured for automatic (FIRQ-triggered) transfers.
+ *
+ * @return 0 if copy was done by the DMA, -1 if the CPU has to do it.
+ **************************************************************************/
+static int __neorv32_memcpy_dma(void *dst, const void *src, size_t n) {
+
+  if ((((uint32_t)dst | (uint32_t)src | (uint32_t)n) & 3) || ((n >> 2) > 0x00ffffffUL)) {
+    return -1;
+  }
+  if (neorv32_dma_available() == 0) {
+    return -1;
+  }
+  uint32_t ctrl = NEORV32_DMA->CTRL;
+  if (((ctrl & (1 << DMA_CTRL_EN)) == 0) || (ctrl & ((1 << DMA_CTRL_AUTO) | (1 << DMA_CTRL_BUSY)))) {
+    return -1;
+  }
+
+  asm volatile ("fence"); // make source data visible in main memory
+  neorv32_dma_transfer((uint32_t)src, (uint32_t)dst, (uint32_t)(n >> 2), DMA_CMD_W2W | DMA_CMD_SRC_INC | DMA_CMD_DST_INC);
+  while (neorv32_dma_status() == DMA_STATUS_BUSY);
+  asm volatile ("fence"); // discard stale cache lines of the destination
+
+  return (neorv32_dma_status() == DMA_STATUS_IDLE) ? 0 : -1;
+}
+#endif
+
+
+/**********************************************************************//**
+ * Forward copy: word-at-a-time (four words per iteration) if source and
+ * destination have the same alignment, aligned loads + shift-merge otherwise.
+ **************************************************************************/
+static void NEORV32_STRING_FUNC __neorv32_copy_fwd(uint8_t *d, const uint8_t *s, size_t n) {
+
+  if ((((uint32_t)d ^ (uint32_t)s) & 3) == 0) {
+    while (n && ((uint32_t)d & 3)) {
+      *d++ = *s++;
+      n--;
+    }
+    uint32_t *wd = (uint32_t*)d;
+    const uint32_t *ws = (const uint32_t*)s;
+    while (n >= 16) {
+      uint32_t t0 = ws[0], t1 = ws[1], t2 = ws[2], t3 = ws[3];
+      wd[0] = t0; wd[1] = t1; wd[2] = t2; wd[3] = t3;
+      wd += 4; ws += 4; n -= 16;
+    }
+    while (n >= 4) {
+      *wd++ = *ws++;
+      n -= 4;
+    }
+    d = (uint8_t*)wd;
+    s = (const uint8_t*)ws;
+  }
+  else if (n >= 8) {
+    while ((uint32_t)d & 3) {
+      *d++ = *s++;
+      n--;
+    }
+    uint32_t off = (uint32_t)s & 3; // 1..3
+    uint32_t shr = off << 3;
+    uint32_t shl = 32 - shr;
+    const uint32_t *ws = (const uint32_t*)(s - off);
+    uint32_t *wd = (uint32_t*)d;
+    uint32_t lo = *ws++;
+    while (n >= 4) {
+      uint32_t hi = *ws++;
+      *wd++ = (lo >> shr) | (hi << shl);
+      lo = hi;
+      n -= 4;
+      s += 4;
+    }
+    d = (uint8_t*)wd;
+  }
+
+  while (n--) {
+    *d++ = *s++;
+  }
+}
+
+
+/**********************************************************************//**
+ * Copy memory (non-overlapping).
+ *
+ * @param[in] dst Destination.
+ * @param[in] src Source.
+ * @param[in] n Number of bytes.
+ * @return dst.
+ **************************************************************************/
+void * NEORV32_STRING_FUNC neorv32_memcpy(void *dst, const void *src, size_t n) {
+
+#if (NEORV32_STRING_DMA_MIN > 0)
+  if ((n >= NEORV32_STRING_DMA_MIN) && (__neorv32_memcpy_dma(dst, src, n) == 0)) {
+    return dst;
+  }
+#endif
+
+  __neorv32_copy_fwd((uint8_t*)dst, (const uint8_t*)src, n);
+  return dst;
+}
+
+
+/**********************************************************************//**
+ * Copy memory (areas may overlap).
+ *
+ * @param[in] dst Destination.
+ * @param[in] src Source.
+ * @param[in] n Number of bytes.
+ * @return dst.
+ **************************************************************************/
+void * NEORV32_STRING_FUNC neorv32_memmove(void *dst, const void *src, size_t n) {
+
+  uint8_t *d = (uint8_t*)dst;
+  const uint8_t *s = (const uint8_t*)src;
+
+  if ((d <= s) || (d >= (s + n))) { // forward copy is safe
+    __neorv32_copy_fwd(d, s, n);
+    return dst;
+  }
+
+  // backward copy
+  d += n;
+  s += n;
+  if ((((uint32_t)d ^ (uint32_t)s) & 3) == 0) {
+    while (n && ((uint32_t)d & 3)) {
+      *--d = *--s;
+      n--;
+    }
+    uint32_t *wd = (uint32_t*)d;
+    const uint32_t *ws = (const uint32_t*)s;
+    while (n >= 4) {
+      *--wd = *--ws;
+      n -= 4;
+    }
+    d = (uint8_t*)wd;
+    s = (const uint8_t*)ws;
+  }
+  while (n--) {
+    *--d = *--s;
+  }
+  return dst;
+}
+
+
+/**********************************************************************//**
+ * Fill memory.
+ *
+ * @param[in] dst Destination.
+ * @param[in] c Fill byte.
+ * @param[in] n Number of bytes.
+ * @return dst.
+ **************************************************************************/
+void * NEORV32_STRING_FUNC neorv32_memset(void *dst, int c, size_t n) {
+
+  uint8_t *d = (uint8_t*)dst;
+
+  while (n && ((uint32_t)d & 3)) {
+    *d++ = (uint8_t)c;
+    n--;
+  }
+
+  uint32_t pattern = __neorv32_string_splat(c);
+  uint32_t *wd = (uint32_t*)d;
+  while (n >= 16) {
+    wd[0] = pattern; wd[1] = pattern; wd[2] = pattern; wd[3] = pattern;
+    wd += 4;
+    n -= 16;
+  }
+  while (n >= 4) {
+    *wd++ = pattern;
+    n -= 4;
+  }
+
+  d = (uint8_t*)wd;
+  while (n--) {
+    *d++ = (uint8_t)c;
+  }
+  return dst;
+}
+
+
+/**********************************************************************//**
+ * Compare memory.
+ *
+ * @param[in] s1 First memory area.
+ * @param[in] s2 Second memory area.
+ * @param[in] n Number of bytes.
+ * @return <0, 0, >0 if s1 is less than, equal to, greater than s2.
+ **************************************************************************/
+int NEORV32_STRING_FUNC neorv32_memcmp(const void *s1, const void *s2, size_t n) {
+
+  const uint8_t *a = (const uint8_t*)s1;
+  const uint8_t *b = (const uint8_t*)s2;
+
+  if ((((uint32_t)a ^ (uint32_t)b) & 3) == 0) {
+    while (n && ((uint32_t)a & 3)) {
+      if (*a != *b) {
+        return (int)*a - (int)*b;
+      }
+      a++; b++; n--;
+    }
+    while (n >= 4) {
+      uint32_t wa = *(const uint32_t*)a;
+      uint32_t wb = *(const uint32_t*)b;
+      if (wa != wb) {
+#if defined __riscv_zbb
+        return (__neorv32_string_rev8(wa) > __neorv32_string_rev8(wb)) ? 1 : -1;
+#else
+        break; // resolve byte-wise
+#endif
+      }
+      a += 4; b += 4; n -= 4;
+    }
+  }
+
+  while (n--) {
+    if (*a != *b) {
+      return (int)*a - (int)*b;
+    }
+    a++; b++;
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Find byte in memory.
+ *
+ * @param[in] s Memory area.
+ * @param[in] c Byte to search for.
+ * @param[in] n Number of bytes.
+ * @return Pointer to first occurrence of c; NULL if not found.
+ **************************************************************************/
+void * NEORV32_STRING_FUNC neorv32_memchr(const void *s, int c, size_t n) {
+
+  const uint8_t *p = (const uint8_t*)s;
+  uint8_t ch = (uint8_t)c;
+
+  while (n && ((uint32_t)p & 3)) {
+    if (*p == ch) {
+      return (void*)p;
+    }
+    p++; n--;
+  }
+
+  uint32_t pattern = __neorv32_string_splat(c);
+  while (n >= 4) {
+    uint32_t tmp = *(const uint32_t*)p ^ pattern; // matching bytes become zero
+    if (HAS_ZERO(tmp)) {
+#if defined __riscv_zbb
+      return (void*)(p + ZERO_IDX(tmp));
+#else
+      break; // resolve byte-wise
+#endif
+    }
+    p += 4; n -= 4;
+  }
+
+  while (n--) {
+    if (*p == ch) {
+      return (void*)p;
+    }
+    p++;
+  }
+  return NULL;
+}
+
+
+/**********************************************************************//**
+ * Get length of string.
+ *
+ * @note Reads full aligned words, i.e. up to three bytes beyond the terminating zero.
+ *
+ * @param[in] s Zero-terminated string.
+ * @return Length of string (without terminating zero).
+ **************************************************************************/
+size_t NEORV32_STRING_FUNC neorv32_strlen(const char *s) {
+
+  const char *p = s;
+
+  while ((uint32_t)p & 3) {
+    if (*p == '\0') {
+      return (size_t)(p - s);
+    }
+    p++;
+  }
+
+  const uint32_t *w = (const uint32_t*)p;
+  uint32_t tmp;
+  while (1) {
+    tmp = *w;
+    if (HAS_ZERO(tmp)) {
+      break;
+    }
+    w++;
+  }
+
+  p = (const char*)w;
+#if defined __riscv_zbb
+  return (size_t)(p - s) + ZERO_IDX(tmp);
+#else
+  while (*p) {
+    p++;
+  }
+  return (size_t)(p - s);
+#endif
+}
+
+
+/**********************************************************************//**
+ * Compare strings.
+ *
+ * @param[in] s1 First zero-terminated string.
+ * @param[in] s2 Second zero-terminated string.
+ * @return <0, 0, >0 if s1 is less than, equal to, greater than s2.
+ **************************************************************************/
+int NEORV32_STRING_FUNC neorv32_strcmp(const char *s1, const char *s2) {
+
+  const uint8_t *a = (const uint8_t*)s1;
+  const uint8_t *b = (const uint8_t*)s2;
+
+  if ((((uint32_t)a ^ (uint32_t)b) & 3) == 0) {
+    while ((uint32_t)a & 3) {
+      if ((*a == 0) || (*a != *b)) {
+        return (int)*a - (int)*b;
+      }
+      a++; b++;
+    }
+    while (1) {
+      uint32_t wa = *(const uint32_t*)a;
+      uint32_t wb = *(const uint32_t*)b;
+      if ((wa != wb) || HAS_ZERO(wa)) {
+#if defined __riscv_zbb
+        // first byte that differs or terminates s1
+        uint32_t sel = __neorv32_string_orcb(wa ^ wb) | ~__neorv32_string_orcb(wa);
+        uint32_t sh  = (uint32_t)__builtin_ctz(sel) & ~7U;
+        return (int)((wa >> sh) & 0xff) - (int)((wb >> sh) & 0xff);
+#else
+        break; // resolve byte-wise
+#endif
+      }
+      a += 4; b += 4;
+    }
+  }
+
+  while ((*a != 0) && (*a == *b)) {
+    a++; b++;
+  }
+  return (int)*a - (int)*b;
+}
+
+
+#ifdef NEORV32_STRING_OVERRIDE
+// ---------------------------------------------------------------------------
+// Replace newlib's generic implementations
+// ---------------------------------------------------------------------------
+void  *memcpy(void *dst, const void *src, size_t n)     { return neorv32_memcpy(dst, src, n); }
+void  *memmove(void *dst, const void *src, size_t n)    { return neorv32_memmove(dst, src, n); }
+void  *memset(void *dst, int c, size_t n)               { return neorv32_memset(dst, c, n); }
+int    memcmp(const void *s1, const void *s2, size_t n) { return neorv32_memcmp(s1, s2, n); }
+void  *memchr(const void *s, int c, size_t n)           { return neorv32_memchr(s, c, n); }
+size_t strlen(const char *s)                            { return neorv32_strlen(s); }
+int    strcmp(const char *s1, const char *s2)           { return neorv32_strcmp(s1, s2); }
+#endif
@@ -424,6 +424,61 @@ int neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int ech
 }
 
 
+/**********************************************************************//**
+ * Move all received chars from the RX FIFO to a ring buffer.
+ *
+ * @note This function is intended to be called from the UART's RX interrupt handler.
+ * The RX FIFO is always drained; chars that do not fit into the ring buffer are discarded.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t); one char per entry.
+ * @return Number of chars stored to the ring buffer.
+ **************************************************************************/
+int neorv32_uart_irq_rx(neorv32_uart_t *UARTx, neorv32_spsc_t *rb) {
+
+  uint32_t tmp[16], i;
+  int cnt = 0;
+
+  while (UARTx->CTRL & (1<<UART_CTRL_RX_NEMPTY)) {
+    i = 0;
+    do {
+      tmp[i++] = (UARTx->DATA >> UART_DATA_RTX_LSB) & 0xff;
+    } while ((i < 16) && (UARTx->CTRL & (1<<UART_CTRL_RX_NEMPTY)));
+    cnt += (int)neorv32_spsc_push_batch(rb, tmp, i);
+  }
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Move chars from a ring buffer to the TX FIFO until the FIFO is full or
+ * the ring buffer is empty.
+ *
+ * @note This function is intended to be called from the UART's TX interrupt handler.
+ * If it returns 0 (ring buffer empty) the application should disable the TX interrupt.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] rb Ring buffer (#neorv32_spsc_t); one char per entry.
+ * @return Number of chars written to the TX FIFO.
+ **************************************************************************/
+int neorv32_uart_irq_tx(neorv32_uart_t *UARTx, neorv32_spsc_t *rb) {
+
+  uint32_t data;
+  int cnt = 0;
+
+  while ((UARTx->CTRL & (1<<UART_CTRL_TX_FULL)) == 0) {
+    if (neorv32_spsc_pop(rb, &data)) {
+      break;
+    }
+    UARTx->DATA = (data & 0xff) << UART_DATA_RTX_LSB;
+    cnt++;
+  }
+
+  return cnt;
+}
+
+
 /**********************************************************************//**
  * Private function for 'neorv32_printf' to convert into decimal.
  *
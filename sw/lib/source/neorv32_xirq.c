@@ -74,6 +74,8 @@ int neorv32_xirq_available(void) {
  * @note All interrupt channels will be deactivated, all pending IRQs will be deleted and all
  * handler addresses will be deleted.
  *
+ * @note Not supported (compile error) if the RTE is compiled with RTE_STATIC.
+ *
  * @return 0 if success, != 0 if error.
  **************************************************************************/
 int neorv32_xirq_setup(void) {
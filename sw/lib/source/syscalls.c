@@ -293,14 +293,11 @@ void *_sbrk(ptrdiff_t incr)
 {
     char *old_brk = brk;
 
-    if (&__heap_start[0] == &__heap_end[0]) {
-        return NULL;
+    if ((incr > (&__heap_end[0] - brk)) || (incr < (&__heap_start[0] - brk))) {
+        errno = ENOMEM;
+        return (void *)-1;
     }
 
-    if ((brk += incr) < &__heap_end[0]) {
-        brk += incr;
-    } else {
-        brk = &__heap_end[0];
-    }
+    brk += incr;
     return old_brk;
 }